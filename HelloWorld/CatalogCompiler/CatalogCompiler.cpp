@@ -0,0 +1,67 @@
+﻿// =====================================================
+// CatalogCompiler — 텍스트 천체 카탈로그를 맵핑용 바이너리(.bcat)로 변환하는 오프라인 도구
+//  - 기본 출력은 입력 옆의 같은 이름 .bcat (catalogs/solar_system.txt -> catalogs/solar_system.bcat)
+//  - 렌더러는 텍스트보다 새로운 .bcat 가 있으면 파싱 없이 맵핑해서 그대로 씀
+//  - 카탈로그의 mpc 항목(MPCORB.DAT 형식)은 여기서 한 번만 파싱 → 10 만 개 단위 소천체도 실행 시 수 ms
+//  - 텍스트 / 파일 형식: ../ConsoleApplication1/BodyCatalog.cpp, BodyCatalog.h
+//
+// 빌드:
+//  g++ -std=c++14 -O2 -I../ConsoleApplication1 -I"../../External Libs/glm" CatalogCompiler.cpp ../ConsoleApplication1/BodyCatalog.cpp ../ConsoleApplication1/MappedFile.cpp -o CatalogCompiler
+// 사용:
+//  CatalogCompiler CATALOG.txt [OUT.bcat]
+//  예) CatalogCompiler ../ConsoleApplication1/catalogs/solar_system.txt
+// =====================================================
+#ifdef _WIN32
+#define _CRT_SECURE_NO_WARNINGS
+#endif
+
+#include "BodyCatalog.h"
+
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+int main(int argc, char** argv)
+{
+    if (argc < 2 || argc > 3)
+    {
+        std::cerr << "Usage: CatalogCompiler CATALOG.txt [OUT.bcat]\n";
+        return 1;
+    }
+
+    std::string input = argv[1];
+    std::string output = argc == 3 ? argv[2] : bcat::pathFor(input);
+    if (output == input)
+    {
+        std::cerr << "Output would overwrite the input: " << input << "\n";
+        return 1;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<unsigned char> image;
+    std::string error;
+    if (!compileBodyCatalog(input, image, error))
+    {
+        std::cerr << error << "\n";
+        return 1;
+    }
+
+    FILE* fp = fopen(output.c_str(), "wb");
+    if (!fp || fwrite(image.data(), 1, image.size(), fp) != image.size())
+    {
+        std::cerr << "Failed to write " << output << "\n";
+        if (fp) fclose(fp);
+        remove(output.c_str());
+        return 1;
+    }
+    fclose(fp);
+
+    const bcat::FileHeader* h = (const bcat::FileHeader*)image.data();
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    printf("%s: %u bodies, %u small bodies, %.1f KiB, %.0f ms\n", output.c_str(),
+        h->bodyCount, h->smallBodyCount, image.size() / 1024.0, ms);
+    return 0;
+}
@@ -0,0 +1,74 @@
+﻿#include "AsteroidBelt.h"
+#include "BodyCatalog.h"
+#include "Shader.h"
+
+#include <GL/glew.h>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+
+AsteroidBelt::AsteroidBelt()
+    : shader(nullptr), count(0), density(1.0f)
+{
+}
+
+void AsteroidBelt::init(const BodyCatalog& catalog)
+{
+    count = catalog.smallBodyCount();
+    if (count == 0) return;
+
+    size_t bytes = (size_t)count * sizeof(bcat::SmallBody);
+
+    vao = GpuVertexArray("belt VAO");
+    elementVBO = GpuBuffer("belt elements");
+
+    glBindVertexArray(vao.get());
+    glBindBuffer(GL_ARRAY_BUFFER, elementVBO.get());
+    glBufferData(GL_ARRAY_BUFFER, bytes, catalog.smallBodies(), GL_STATIC_DRAW);
+    elementVBO.setBytes(bytes);
+
+    // location 0 = (a, e, i, Ω), 1 = (ω, M0, 주기, H)
+    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, sizeof(bcat::SmallBody),
+        (void*)offsetof(bcat::SmallBody, semiMajorAxis));
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(bcat::SmallBody),
+        (void*)offsetof(bcat::SmallBody, argPeriDeg));
+    glEnableVertexAttribArray(1);
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    std::cout << "[Belt] " << count << " small bodies, " << bytes / 1024 << " KiB of elements\n";
+}
+
+void AsteroidBelt::setDensity(float fraction)
+{
+    density = std::min(std::max(fraction, 0.0f), 1.0f);
+}
+
+int AsteroidBelt::getDrawCount() const
+{
+    return (int)std::lround(count * (double)density);
+}
+
+void AsteroidBelt::render(const glm::mat4& view, const glm::mat4& proj,
+    float simYears, float worldScale, float fovDeg, int viewportHeight)
+{
+    int drawCount = getDrawCount();
+    if (drawCount <= 0 || !shader || !vao.valid()) return;
+
+    shader->use();
+    shader->setMat4("view", view);
+    shader->setMat4("proj", proj);
+    shader->setFloat("simYears", simYears);
+    shader->setFloat("worldScale", worldScale);
+    shader->setFloat("pixelsPerUnit", (float)viewportHeight * 0.5f / tanf(glm::radians(fovDeg) * 0.5f));
+    shader->setFloat("maxPointSize", MAX_POINT_PIXELS);
+
+    glEnable(GL_PROGRAM_POINT_SIZE);
+    glBindVertexArray(vao.get());
+    glDrawArrays(GL_POINTS, 0, drawCount);
+    glBindVertexArray(0);
+    glDisable(GL_PROGRAM_POINT_SIZE);
+}
@@ -0,0 +1,54 @@
+﻿#ifndef ASTEROID_BELT_H
+#define ASTEROID_BELT_H
+
+#include <glm/glm.hpp>
+
+#include "GpuResource.h"
+
+class Shader;
+class BodyCatalog;
+
+// =====================================================
+// AsteroidBelt
+//  - 카탈로그 소천체(bcat::SmallBody, 궤도 요소 32 바이트)를 맵핑된 메모리에서 그대로
+//    정점 버퍼 한 번에 올림 → 레코드가 곧 정점 (vec4 두 개)
+//  - 정점 셰이더가 simYears 로 케플러 방정식을 풀어 위치를 구하고 점 스프라이트로 그림
+//    (CPU 는 입자별 작업 없음, 프레임마다 glDrawArrays 한 번)
+//  - 밀도: 버퍼 앞에서부터 그릴 개수만 줄임 (재업로드 없음)
+//    카탈로그가 소천체를 섞어서 저장하므로 모든 벨트가 고르게 줄어듦
+//  - 점 크기는 절대등급 H 로 정한 반지름의 화면 크기 (최소 1 픽셀, MAX_POINT_PIXELS 까지)
+//    가까우면 점 안에서 구 법선으로 햇빛 음영 (작은 임포스터)
+//  - 움직임 벡터는 카메라 이동만 반영 (한 프레임 동안의 공전 이동은 1 픽셀 미만)
+// =====================================================
+class AsteroidBelt
+{
+public:
+    static constexpr float MAX_POINT_PIXELS = 8.0f;
+
+    AsteroidBelt();
+
+    // 카탈로그 소천체 업로드 (없으면 아무것도 그리지 않음)
+    void init(const BodyCatalog& catalog);
+    void setShader(Shader* shaderPtr) { shader = shaderPtr; }
+
+    // 그릴 비율 (0~1)
+    void setDensity(float fraction);
+    float getDensity() const { return density; }
+
+    int getCount() const { return count; }
+    int getDrawCount() const;
+
+    // 조명 / 움직임 벡터 uniform 은 호출 측에서 설정 (sceneShader 와 같은 이름)
+    void render(const glm::mat4& view, const glm::mat4& proj,
+        float simYears, float worldScale, float fovDeg, int viewportHeight);
+
+private:
+    Shader* shader;
+
+    GpuVertexArray vao;
+    GpuBuffer elementVBO;
+    int count;
+    float density;
+};
+
+#endif
@@ -0,0 +1,387 @@
+﻿#include "Atmosphere.h"
+#include "Shader.h"
+#include "Texture.h"
+#include "GpuResource.h"
+
+#include <GL/glew.h>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <thread>
+
+// -------------------------------------------------------------
+// LUT 계산 (CPU) — 단위: 행성 반지름 = 1
+// -------------------------------------------------------------
+struct AtmosphereMedium
+{
+    float top;            // 대기 상단 반지름
+    glm::vec3 betaR;      // 레일리 산란 계수
+    float betaM;          // 미 산란 계수
+    float HR, HM;         // 척도 높이
+};
+
+static AtmosphereMedium makeMedium(const AtmosphereParams& p)
+{
+    AtmosphereMedium m;
+    m.top = 1.0f + p.thickness;
+    m.betaR = p.rayleighScattering;
+    m.betaM = p.mieScattering;
+    m.HR = p.rayleighScaleHeight;
+    m.HM = p.mieScaleHeight;
+    return m;
+}
+
+// 반지름 r 에서 지평선 방향의 mu (이보다 작으면 지면에 닿음)
+static float muHorizon(float r)
+{
+    return -std::sqrt(std::max(0.0f, 1.0f - 1.0f / (r * r)));
+}
+
+// 텍스처 좌표 u → mu (셰이더의 atmoMuToU 역함수)
+static float uToMu(float u, float r)
+{
+    float muH = muHorizon(r);
+    if (u < 0.5f)
+        return -1.0f + (u / 0.5f) * (muH + 1.0f);
+    return muH + ((u - 0.5f) / 0.5f) * (1.0f - muH);
+}
+
+static float muToU(float mu, float r)
+{
+    float muH = muHorizon(r);
+    return (mu < muH) ? 0.5f * (mu + 1.0f) / (muH + 1.0f)
+                      : 0.5f + 0.5f * (mu - muH) / (1.0f - muH);
+}
+
+// 반지름 r, 방향 mu 광선이 대기 밖으로 나가거나 지면에 닿을 때까지의 거리
+static float rayLength(const AtmosphereMedium& m, float r, float mu)
+{
+    float disc = r * r * (mu * mu - 1.0f);
+    if (mu < muHorizon(r))
+        return std::max(0.0f, -r * mu - std::sqrt(std::max(0.0f, disc + 1.0f)));
+    return std::max(0.0f, -r * mu + std::sqrt(std::max(0.0f, disc + m.top * m.top)));
+}
+
+// 소광 계수 (미 산란은 산란/소광 비 0.9)
+static glm::vec3 extinctionAt(const AtmosphereMedium& m, float h)
+{
+    return m.betaR * std::exp(-h / m.HR) + glm::vec3(m.betaM / 0.9f * std::exp(-h / m.HM));
+}
+
+static glm::vec3 opticalDepth(const AtmosphereMedium& m, float r, float mu)
+{
+    const int STEPS = 64;
+    float ds = rayLength(m, r, mu) / STEPS;
+
+    glm::vec3 tau(0.0f);
+    for (int i = 0; i < STEPS; i++)
+    {
+        float t = (i + 0.5f) * ds;
+        float ri = std::sqrt(r * r + t * t + 2.0f * r * mu * t);
+        tau += extinctionAt(m, std::max(ri - 1.0f, 0.0f)) * ds;
+    }
+    return tau;
+}
+
+// 투과율 표에서 (r, mu) 쌍선형 보간 조회
+static glm::vec3 sampleTransmittance(const std::vector<glm::vec3>& table,
+    const AtmosphereMedium& m, float r, float mu)
+{
+    const int W = AtmosphereRenderer::TRANSMITTANCE_W;
+    const int H = AtmosphereRenderer::TRANSMITTANCE_H;
+
+    float x = muToU(mu, r) * W - 0.5f;
+    float y = glm::clamp((r - 1.0f) / (m.top - 1.0f), 0.0f, 1.0f) * H - 0.5f;
+
+    int x0 = glm::clamp((int)std::floor(x), 0, W - 1);
+    int y0 = glm::clamp((int)std::floor(y), 0, H - 1);
+    int x1 = std::min(x0 + 1, W - 1);
+    int y1 = std::min(y0 + 1, H - 1);
+    float fx = glm::clamp(x - x0, 0.0f, 1.0f);
+    float fy = glm::clamp(y - y0, 0.0f, 1.0f);
+
+    glm::vec3 a = glm::mix(table[y0 * W + x0], table[y0 * W + x1], fx);
+    glm::vec3 b = glm::mix(table[y1 * W + x0], table[y1 * W + x1], fx);
+    return glm::mix(a, b, fy);
+}
+
+static void precomputeLayer(const AtmosphereParams& params,
+    glm::vec4* transmittanceOut,
+    glm::vec4* inscatterOut)
+{
+    const int TW = AtmosphereRenderer::TRANSMITTANCE_W;
+    const int TH = AtmosphereRenderer::TRANSMITTANCE_H;
+    const int SW = AtmosphereRenderer::INSCATTER_W;
+    const int SH = AtmosphereRenderer::INSCATTER_H;
+
+    AtmosphereMedium m = makeMedium(params);
+
+    // 1) 투과율 T(r, mu)
+    std::vector<glm::vec3> transmittance(TW * TH);
+    for (int j = 0; j < TH; j++)
+    {
+        float r = 1.0f + (m.top - 1.0f) * (j + 0.5f) / TH;
+        for (int i = 0; i < TW; i++)
+        {
+            float mu = uToMu((i + 0.5f) / TW, r);
+            glm::vec3 t = glm::exp(-opticalDepth(m, r, mu));
+            transmittance[j * TW + i] = t;
+            transmittanceOut[j * TW + i] = glm::vec4(t, 1.0f);
+        }
+    }
+
+    // 2) 대기 상단에서 들어가는 시선의 단일 산란 S(mu, mu_s)
+    //    - 태양은 시선과 같은 평면에 있다고 가정 (방위각 차이는 위상 함수로만 반영)
+    const int STEPS = 48;
+    for (int j = 0; j < SH; j++)
+    {
+        float mus = -1.0f + 2.0f * (j + 0.5f) / SH;
+        glm::vec2 s(std::sqrt(std::max(0.0f, 1.0f - mus * mus)), mus);
+
+        for (int i = 0; i < SW; i++)
+        {
+            float mu = uToMu((i + 0.5f) / SW, m.top);
+            glm::vec2 d(std::sqrt(std::max(0.0f, 1.0f - mu * mu)), mu);
+            glm::vec2 x(0.0f, m.top);
+
+            float ds = rayLength(m, m.top, mu) / STEPS;
+
+            glm::vec3 tau(0.0f);
+            glm::vec3 sumR(0.0f), sumM(0.0f);
+            for (int k = 0; k < STEPS; k++)
+            {
+                glm::vec2 y = x + d * ((k + 0.5f) * ds);
+                float ry = glm::length(y);
+                float h = std::max(ry - 1.0f, 0.0f);
+
+                glm::vec3 ext = extinctionAt(m, h) * ds;
+                glm::vec3 tMid = glm::exp(-(tau + ext * 0.5f));   // 입구 → y
+                tau += ext;
+
+                float musY = glm::dot(y, s) / ry;
+                if (musY < muHorizon(ry)) continue;           // 행성 그림자 안
+
+                glm::vec3 tSun = sampleTransmittance(transmittance, m, ry, musY);
+                glm::vec3 w = tMid * tSun * ds;
+                sumR += w * std::exp(-h / m.HR);
+                sumM += w * std::exp(-h / m.HM);
+            }
+
+            glm::vec3 rayleigh = m.betaR * sumR;
+            glm::vec3 mie = m.betaM * sumM;
+            inscatterOut[j * SW + i] = glm::vec4(rayleigh, mie.r);
+        }
+    }
+}
+
+// 2D 배열 텍스처 생성 (RGBA16F, 레지스트리 소유)
+static unsigned int createLutArray(const char* label, int w, int h, int layers,
+    const std::vector<glm::vec4>& data)
+{
+    unsigned int tex = GpuRegistry::createOwned(GpuKind::Texture, GpuClass::Texture,
+        label, GpuRegistry::imageBytes(w, h, layers, 8, false));
+
+    glBindTexture(GL_TEXTURE_2D_ARRAY, tex);
+    glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA16F, w, h, layers,
+        0, GL_RGBA, GL_FLOAT, data.data());
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+    return tex;
+}
+
+// =====================================================
+// AtmosphereRenderer
+// =====================================================
+AtmosphereRenderer::AtmosphereRenderer()
+    : transmittanceArray(0), inscatterArray(0),
+    precomputeMs(0.0), shader(nullptr)
+{
+}
+
+int AtmosphereRenderer::addAtmosphere(const AtmosphereParams& params)
+{
+    Layer l;
+    l.params = params;
+    layers.push_back(l);
+    return (int)layers.size() - 1;
+}
+
+void AtmosphereRenderer::setShader(Shader* shaderPtr)
+{
+    shader = shaderPtr;
+}
+
+void AtmosphereRenderer::init()
+{
+    if (layers.empty()) return;
+
+    int n = (int)layers.size();
+    const size_t tSize = (size_t)TRANSMITTANCE_W * TRANSMITTANCE_H;
+    const size_t sSize = (size_t)INSCATTER_W * INSCATTER_H;
+
+    std::vector<glm::vec4> transmittance(tSize * n);
+    std::vector<glm::vec4> inscatter(sSize * n);
+
+    // 레이어마다 작업 스레드 하나 (서로 독립)
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> workers;
+    for (int i = 0; i < n; i++)
+    {
+        workers.emplace_back(precomputeLayer, std::cref(layers[i].params),
+            transmittance.data() + tSize * i,
+            inscatter.data() + sSize * i);
+    }
+    for (auto& w : workers)
+        w.join();
+
+    precomputeMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+
+    transmittanceArray = createLutArray("atmosphere transmittance LUT",
+        TRANSMITTANCE_W, TRANSMITTANCE_H, n, transmittance);
+    inscatterArray = createLutArray("atmosphere inscatter LUT",
+        INSCATTER_W, INSCATTER_H, n, inscatter);
+
+    // 밤 / 구름 텍스처
+    for (auto& l : layers)
+    {
+        if (!l.params.nightTexturePath.empty())
+            l.nightTex = loadTexture(l.params.nightTexturePath, 0x000000FFu); // 불빛 없음
+        if (!l.params.cloudTexturePath.empty())
+            l.cloudTex = loadTexture(l.params.cloudTexturePath);
+    }
+
+    std::cout << "[Atmosphere] " << n << " LUT sets precomputed in "
+        << (int)precomputeMs << " ms\n";
+}
+
+void AtmosphereRenderer::applySurface(const Shader& shader,
+    int layer,
+    const glm::vec3& center,
+    float radius) const
+{
+    if (layer < 0 || layer >= (int)layers.size() || !transmittanceArray)
+    {
+        shader.setFloat("atmoLayer", -1.0f);
+        shader.setInt("hasNightMap", 0);
+        shader.setFloat("cloudOpacity", 0.0f);
+        return;
+    }
+
+    const Layer& l = layers[layer];
+
+    shader.setFloat("atmoLayer", (float)layer);
+    shader.setVec3("atmoCenter", center);
+    shader.setFloat("atmoRadius", radius);
+    shader.setFloat("atmoTop", 1.0f + l.params.thickness);
+
+    glActiveTexture(GL_TEXTURE4);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, transmittanceArray);
+    shader.setInt("transmittanceLUT", 4);
+
+    shader.setInt("hasNightMap", l.nightTex ? 1 : 0);
+    if (l.nightTex)
+    {
+        glActiveTexture(GL_TEXTURE2);
+        glBindTexture(GL_TEXTURE_2D, l.nightTex.get());
+        shader.setInt("nightMap", 2);
+    }
+
+    shader.setFloat("cloudOpacity", l.cloudTex ? l.params.cloudOpacity : 0.0f);
+    if (l.cloudTex)
+    {
+        glActiveTexture(GL_TEXTURE3);
+        glBindTexture(GL_TEXTURE_2D, l.cloudTex.get());
+        shader.setInt("cloudMap", 3);
+    }
+
+    glActiveTexture(GL_TEXTURE0);
+}
+
+void AtmosphereRenderer::begin()
+{
+    instances.clear();
+}
+
+void AtmosphereRenderer::add(int layer, const glm::vec3& center, float radius)
+{
+    if (layer < 0 || layer >= (int)layers.size()) return;
+
+    Instance inst;
+    inst.layer = layer;
+    inst.center = center;
+    inst.radius = radius;
+    instances.push_back(inst);
+}
+
+void AtmosphereRenderer::render(const glm::mat4& view,
+    const glm::mat4& proj,
+    const glm::vec3& camPos,
+    const glm::vec3& lightPos,
+    unsigned int sphereVAO,
+    unsigned int sphereIndexCount)
+{
+    if (!shader || instances.empty() || !inscatterArray) return;
+
+    shader->use();
+    shader->setMat4("view", view);
+    shader->setMat4("proj", proj);
+    shader->setVec3("camPos", camPos);
+    shader->setVec3("lightPos", lightPos);
+
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, transmittanceArray);
+    shader->setInt("transmittanceLUT", 0);
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, inscatterArray);
+    shader->setInt("inscatterLUT", 1);
+
+    // 산란광은 더하고, 뒤쪽(지표/배경)은 시선 투과율만큼 감쇠
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+    glDepthMask(GL_FALSE);
+    glEnable(GL_CULL_FACE);
+    glCullFace(GL_BACK);
+
+    glBindVertexArray(sphereVAO);
+
+    for (const Instance& inst : instances)
+    {
+        const AtmosphereParams& p = layers[inst.layer].params;
+        float top = 1.0f + p.thickness;
+
+        // 구 메쉬는 다각형이라 실제 구보다 약간 안쪽 → 살짝 키워서 그림
+        glm::mat4 model = glm::translate(glm::mat4(1.0f), inst.center);
+        model = glm::scale(model, glm::vec3(inst.radius * top * 1.01f));
+
+        shader->setMat4("model", model);
+        shader->setVec3("atmoCenter", inst.center);
+        shader->setFloat("atmoRadius", inst.radius);
+        shader->setFloat("atmoTop", top);
+        shader->setFloat("atmoLayer", (float)inst.layer);
+        shader->setVec3("betaR", p.rayleighScattering);
+        shader->setFloat("mieG", p.mieG);
+        shader->setFloat("sunIntensity", p.sunIntensity);
+
+        glDrawElements(GL_TRIANGLES, sphereIndexCount, GL_UNSIGNED_INT, 0);
+    }
+
+    glBindVertexArray(0);
+
+    glDisable(GL_CULL_FACE);
+    glDepthMask(GL_TRUE);
+    glDisable(GL_BLEND);
+
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+}
@@ -0,0 +1,103 @@
+﻿#ifndef ATMOSPHERE_H
+#define ATMOSPHERE_H
+
+#include <string>
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "Planet.h"
+#include "TextureCache.h"
+
+class Shader;
+
+// -----------------------------------------------------
+// LUT 좌표 변환 + 투과율 조회 GLSL 조각 (sceneFrag / atmosphereFrag 공용)
+//  - 길이 단위: 행성 반지름 = 1, 대기 상단 = atmoTop
+//  - mu(시선/태양 천정각 코사인)는 지평선 기준으로 두 구간으로 나눠 저장
+//    (지면에 닿는 광선 [0, 0.5) / 닿지 않는 광선 [0.5, 1])
+// -----------------------------------------------------
+#define ATMOSPHERE_GLSL \
+    "uniform sampler2DArray transmittanceLUT;\n" \
+    "float atmoMuToU(float mu, float r){\n" \
+    "  float muH = -sqrt(max(0.0, 1.0 - 1.0 / (r * r)));\n" \
+    "  return (mu < muH) ? 0.5 * (mu + 1.0) / (muH + 1.0)\n" \
+    "                    : 0.5 + 0.5 * (mu - muH) / (1.0 - muH);\n" \
+    "}\n" \
+    "vec3 atmoTransmittance(float r, float mu, float top, float layer){\n" \
+    "  float v = clamp((r - 1.0) / (top - 1.0), 0.0, 1.0);\n" \
+    "  return texture(transmittanceLUT, vec3(atmoMuToU(mu, r), v, layer)).rgb;\n" \
+    "}\n"
+
+// =====================================================
+// AtmosphereRenderer
+//  - 행성별 대기 파라미터로 시작 시 LUT 를 미리 계산 (Bruneton 방식 단순화)
+//      투과율 LUT  T(r, mu)      : 대기 밖 또는 지면까지의 투과율
+//      산란 LUT    S(mu, mu_s)   : 대기 상단에서 들어가는 시선의 단일 산란
+//                                  (rgb = 레일리, a = 미 산란 빨강 채널)
+//  - 매 프레임: 행성보다 약간 큰 구(대기 껍질)를 그리고
+//    프래그먼트마다 LUT 두 번 조회로 산란광 + 시선 투과율 계산
+//  - 지표: sceneFrag 에서 햇빛 투과율(붉은 노을) + 밤 쪽 불빛 + 구름층
+// =====================================================
+class AtmosphereRenderer
+{
+public:
+    static const int TRANSMITTANCE_W = 256;  // mu
+    static const int TRANSMITTANCE_H = 64;   // r
+    static const int INSCATTER_W = 128;      // mu
+    static const int INSCATTER_H = 64;       // mu_s
+
+    AtmosphereRenderer();
+
+    // 대기 등록 → LUT 레이어 번호 (init() 전에 호출)
+    int addAtmosphere(const AtmosphereParams& params);
+
+    // LUT 계산(레이어별 작업 스레드) + 업로드 + 밤/구름 텍스처 로드
+    void init();
+
+    void setShader(Shader* shaderPtr);
+
+    // sceneShader 지표 uniform 설정
+    //  - layer < 0 이면 대기 효과 끔 (위성, 대기 없는 행성)
+    void applySurface(const Shader& shader,
+        int layer,
+        const glm::vec3& center,
+        float radius) const;
+
+    // 프레임마다: begin() → add() * N → render()
+    void begin();
+    void add(int layer, const glm::vec3& center, float radius);
+    void render(const glm::mat4& view,
+        const glm::mat4& proj,
+        const glm::vec3& camPos,
+        const glm::vec3& lightPos,
+        unsigned int sphereVAO,
+        unsigned int sphereIndexCount);
+
+    double getPrecomputeMs() const { return precomputeMs; }
+
+private:
+    struct Layer
+    {
+        AtmosphereParams params;
+        TextureRef nightTex;    // 없으면 빈 참조
+        TextureRef cloudTex;
+    };
+
+    struct Instance
+    {
+        int layer;
+        glm::vec3 center;
+        float radius;
+    };
+
+    std::vector<Layer> layers;
+    std::vector<Instance> instances;
+
+    unsigned int transmittanceArray;  // 레지스트리 소유
+    unsigned int inscatterArray;      // 레지스트리 소유
+    double precomputeMs;
+
+    Shader* shader;
+};
+
+#endif
@@ -0,0 +1,149 @@
+﻿#include "AutoExposure.h"
+#include "Shader.h"
+
+#include <GL/glew.h>
+#include <algorithm>
+
+// 렌더 타깃 하나 생성 (필터링 없음, 가장자리 고정)
+static void createTarget(GpuRenderTexture& tex, GpuFramebuffer& fbo,
+    const char* texLabel, const char* fboLabel,
+    int w, int h, GLenum internalFormat, GLenum type, size_t bpp)
+{
+    tex = GpuRenderTexture(texLabel);
+    glBindTexture(GL_TEXTURE_2D, tex.get());
+    glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, w, h, 0, GL_RED, type, nullptr);
+    tex.setBytes(GpuRegistry::imageBytes(w, h, 1, bpp, false));
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+    fbo = GpuFramebuffer(fboLabel);
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo.get());
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+        GL_TEXTURE_2D, tex.get(), 0);
+}
+
+AutoExposure::AutoExposure()
+    : lumWidth(0), lumHeight(0), current(0), resetPending(true),
+    luminanceShader(nullptr), histogramShader(nullptr), adaptShader(nullptr)
+{
+}
+
+void AutoExposure::init(int width, int height)
+{
+    lumWidth = std::max(1, width / DOWNSAMPLE);
+    lumHeight = std::max(1, height / DOWNSAMPLE);
+
+    createTarget(luminanceTex, luminanceFBO, "exposure luminance", "exposure luminance FBO",
+        lumWidth, lumHeight, GL_R16F, GL_HALF_FLOAT, 2);
+    createTarget(histogramTex, histogramFBO, "exposure histogram", "exposure histogram FBO",
+        HISTOGRAM_BINS, 1, GL_R32F, GL_FLOAT, 4);
+    createTarget(exposureTex[0], exposureFBO[0], "exposure value A", "exposure FBO A",
+        1, 1, GL_R32F, GL_FLOAT, 4);
+    createTarget(exposureTex[1], exposureFBO[1], "exposure value B", "exposure FBO B",
+        1, 1, GL_R32F, GL_FLOAT, 4);
+
+    // 첫 프레임 전에도 읽을 수 있도록 기본 노출값 1.0
+    for (int i = 0; i < 2; i++)
+    {
+        glBindFramebuffer(GL_FRAMEBUFFER, exposureFBO[i].get());
+        glClearColor(1.0f, 0.0f, 0.0f, 0.0f);
+        glClear(GL_COLOR_BUFFER_BIT);
+    }
+    glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    pointVAO = GpuVertexArray("exposure point VAO");
+
+    current = 0;
+    resetPending = true;
+}
+
+void AutoExposure::setShaders(Shader* luminance, Shader* histogram, Shader* adapt)
+{
+    luminanceShader = luminance;
+    histogramShader = histogram;
+    adaptShader = adapt;
+}
+
+void AutoExposure::update(unsigned int hdrTex, unsigned int quadVAO, float dtSeconds)
+{
+    if (!luminanceShader || !histogramShader || !adaptShader || !luminanceFBO.valid())
+        return;
+
+    glDisable(GL_DEPTH_TEST);
+    glDisable(GL_BLEND);
+
+    // 1) 축소 휘도 ------------------------------------------------
+    glBindFramebuffer(GL_FRAMEBUFFER, luminanceFBO.get());
+    glViewport(0, 0, lumWidth, lumHeight);
+
+    luminanceShader->use();
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, hdrTex);
+    luminanceShader->setInt("sceneTex", 0);
+
+    glBindVertexArray(quadVAO);
+    glDrawArrays(GL_TRIANGLES, 0, 6);
+
+    // 2) 히스토그램 (점 산포 + 가산 블렌딩) ---------------------------
+    glBindFramebuffer(GL_FRAMEBUFFER, histogramFBO.get());
+    glViewport(0, 0, HISTOGRAM_BINS, 1);
+    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+    glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+
+    histogramShader->use();
+    glBindTexture(GL_TEXTURE_2D, luminanceTex.get());
+    histogramShader->setInt("lumTex", 0);
+    histogramShader->setInt("lumWidth", lumWidth);
+    histogramShader->setInt("bins", HISTOGRAM_BINS);
+    histogramShader->setFloat("minLog2", minLog2Luminance);
+    histogramShader->setFloat("rangeLog2", maxLog2Luminance - minLog2Luminance);
+
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_ONE, GL_ONE);
+
+    glBindVertexArray(pointVAO.get());
+    glDrawArrays(GL_POINTS, 0, lumWidth * lumHeight);
+
+    glDisable(GL_BLEND);
+
+    // 3) 노출 적응 (이전 값 → 새 값, 1x1 핑퐁) ------------------------
+    int next = 1 - current;
+    glBindFramebuffer(GL_FRAMEBUFFER, exposureFBO[next].get());
+    glViewport(0, 0, 1, 1);
+
+    adaptShader->use();
+    glBindTexture(GL_TEXTURE_2D, histogramTex.get());
+    adaptShader->setInt("histogramTex", 0);
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D, exposureTex[current].get());
+    adaptShader->setInt("prevExposure", 1);
+
+    adaptShader->setInt("bins", HISTOGRAM_BINS);
+    adaptShader->setFloat("minLog2", minLog2Luminance);
+    adaptShader->setFloat("rangeLog2", maxLog2Luminance - minLog2Luminance);
+    adaptShader->setFloat("lowPercent", lowPercent);
+    adaptShader->setFloat("highPercent", highPercent);
+    adaptShader->setFloat("keyValue", key);
+    adaptShader->setFloat("minExposure", minExposure);
+    adaptShader->setFloat("maxExposure", maxExposure);
+    adaptShader->setFloat("speedToBright", speedToBright);
+    adaptShader->setFloat("speedToDark", speedToDark);
+    adaptShader->setFloat("dt", dtSeconds);
+    adaptShader->setInt("resetExposure", resetPending ? 1 : 0);
+
+    glBindVertexArray(quadVAO);
+    glDrawArrays(GL_TRIANGLES, 0, 6);
+
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    current = next;
+    resetPending = false;
+}
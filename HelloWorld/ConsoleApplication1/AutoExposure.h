@@ -0,0 +1,71 @@
+﻿#ifndef AUTO_EXPOSURE_H
+#define AUTO_EXPOSURE_H
+
+#include "GpuResource.h"
+
+class Shader;
+
+// =====================================================
+// AutoExposure
+//  - HDR 장면 색 버퍼에서 노출값을 자동으로 결정 (모두 GPU, 리드백 없음)
+//    1) 축소: 1/8 해상도 휘도 텍스처 (R16F)
+//    2) 히스토그램: 축소 픽셀마다 점 하나를 log2 휘도 구간으로 보내고
+//       가산 블렌딩으로 개수 누적 (HISTOGRAM_BINS x 1, R32F)
+//    3) 적응: 어두운 쪽/밝은 쪽 꼬리를 뺀 평균 휘도로 목표 노출 계산 후
+//       이전 노출값(1x1 텍스처 핑퐁)에서 시간에 따라 부드럽게 이동
+//  - finalShader 는 결과 1x1 텍스처를 texelFetch 로 읽음
+//  - 0 번 구간은 휘도 0 (빈 우주 공간) 전용이며 평균에서 제외
+// =====================================================
+class AutoExposure
+{
+public:
+    static const int HISTOGRAM_BINS = 64;
+    static const int DOWNSAMPLE = 8;
+
+    AutoExposure();
+
+    // 렌더 타깃 생성 (HDR 버퍼 해상도 기준)
+    void init(int width, int height);
+
+    // luminance: 축소 / histogram: 점 누적 / adapt: 노출 갱신
+    void setShaders(Shader* luminance, Shader* histogram, Shader* adapt);
+
+    // hdrTex 로부터 노출값 갱신 (viewport / FBO 바인딩은 호출 측에서 복원)
+    void update(unsigned int hdrTex, unsigned int quadVAO, float dtSeconds);
+
+    // 다음 update() 에서 부드러운 이동 없이 목표값으로 바로 설정
+    void reset() { resetPending = true; }
+
+    // 현재 노출값이 담긴 1x1 R32F 텍스처
+    unsigned int getExposureTexture() const { return exposureTex[current].get(); }
+
+    // 조절값
+    float minLog2Luminance = -10.0f;  // 히스토그램 범위 (log2)
+    float maxLog2Luminance = 6.0f;
+    float lowPercent = 0.50f;         // 평균에서 뺄 어두운 쪽 비율
+    float highPercent = 0.95f;        // 평균에 넣을 밝은 쪽 상한
+    float key = 0.5f;                 // 평균 휘도가 맞춰질 값
+    float minExposure = 0.1f;
+    float maxExposure = 8.0f;
+    float speedToBright = 3.0f;       // 장면이 밝아질 때 적응 속도 (1/초)
+    float speedToDark = 1.0f;         // 장면이 어두워질 때 적응 속도 (1/초, 더 느림)
+
+private:
+    int lumWidth, lumHeight;
+    int current;                      // 최신 노출값 핑퐁 인덱스
+    bool resetPending;
+
+    GpuRenderTexture luminanceTex;
+    GpuFramebuffer luminanceFBO;
+    GpuRenderTexture histogramTex;
+    GpuFramebuffer histogramFBO;
+    GpuRenderTexture exposureTex[2];
+    GpuFramebuffer exposureFBO[2];
+    GpuVertexArray pointVAO;          // 속성 없는 점 그리기용 (gl_VertexID 사용)
+
+    Shader* luminanceShader;
+    Shader* histogramShader;
+    Shader* adaptShader;
+};
+
+#endif
@@ -0,0 +1,364 @@
+﻿#include "Benchmark.h"
+#include "Camera.h"
+
+#include <GL/glew.h>
+#include <glm/gtc/constants.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+
+static double nowMs()
+{
+    using namespace std::chrono;
+    return duration<double, std::milli>(steady_clock::now().time_since_epoch()).count();
+}
+
+static void printUsage()
+{
+    std::cerr << "usage: HelloWorld [--headless] [--frames N] [--dt SEC] [--speed X]\n"
+        << "                  [--size WxH] [--context egl|osmesa] [--warmup N]\n"
+        << "                  [--capture DIR | --capture-raw DIR | --capture-pipe CMD]\n"
+        << "                  [--no-shader-cache] [--vram-budget MB]\n"
+        << "                  [--bodies N]\n"
+        << "                  [--fps N] [--no-pacing] [--render-scale S]\n"
+        << "                  [--sync-textures] [--no-cooked-textures] [--no-virtual-textures]\n"
+        << "                  [--catalog FILE] [--belt-density F] [--serve SOCKET]\n";
+}
+
+bool parseBenchmarkArgs(int argc, char** argv, BenchmarkOptions& out)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        const char* arg = argv[i];
+        bool hasValue = (i + 1 < argc);
+
+        if (strcmp(arg, "--headless") == 0)
+        {
+            out.headless = true;
+        }
+        else if (strcmp(arg, "--frames") == 0 && hasValue)
+        {
+            out.frames = atoi(argv[++i]);
+        }
+        else if (strcmp(arg, "--dt") == 0 && hasValue)
+        {
+            out.fixedDtSec = (float)atof(argv[++i]);
+        }
+        else if (strcmp(arg, "--speed") == 0 && hasValue)
+        {
+            out.simSpeed = (float)atof(argv[++i]);
+        }
+        else if (strcmp(arg, "--size") == 0 && hasValue)
+        {
+            unsigned int w = 0, h = 0;
+            std::string s = argv[++i];
+            size_t x = s.find('x');
+            if (x != std::string::npos)
+            {
+                w = (unsigned int)atoi(s.substr(0, x).c_str());
+                h = (unsigned int)atoi(s.substr(x + 1).c_str());
+            }
+            if (w == 0 || h == 0)
+            {
+                std::cerr << "[Benchmark] Invalid size: " << s << "\n";
+                printUsage();
+                return false;
+            }
+            out.width = w;
+            out.height = h;
+        }
+        else if (strcmp(arg, "--context") == 0 && hasValue)
+        {
+            out.contextApi = argv[++i];
+            if (out.contextApi != "egl" && out.contextApi != "osmesa")
+            {
+                std::cerr << "[Benchmark] Unknown context API: " << out.contextApi << "\n";
+                printUsage();
+                return false;
+            }
+        }
+        else if (strcmp(arg, "--warmup") == 0 && hasValue)
+        {
+            out.warmupFrames = atoi(argv[++i]);
+        }
+        else if (strcmp(arg, "--capture") == 0 && hasValue)
+        {
+            out.capture.enabled = true;
+            out.capture.format = CaptureFormat::Png;
+            out.capture.outputDir = argv[++i];
+        }
+        else if (strcmp(arg, "--capture-raw") == 0 && hasValue)
+        {
+            out.capture.enabled = true;
+            out.capture.format = CaptureFormat::Raw;
+            out.capture.outputDir = argv[++i];
+        }
+        else if (strcmp(arg, "--capture-pipe") == 0 && hasValue)
+        {
+            out.capture.enabled = true;
+            out.capture.format = CaptureFormat::Pipe;
+            out.capture.pipeCommand = argv[++i];
+        }
+        else if (strcmp(arg, "--no-shader-cache") == 0)
+        {
+            out.shaderCache = false;
+        }
+        else if (strcmp(arg, "--vram-budget") == 0 && hasValue)
+        {
+            int mb = atoi(argv[++i]);
+            out.vramBudgetMB = (mb > 0) ? (unsigned int)mb : 0;
+        }
+        else if (strcmp(arg, "--bodies") == 0 && hasValue)
+        {
+            out.extraBodies = std::max(0, atoi(argv[++i]));
+        }
+        else if (strcmp(arg, "--fps") == 0 && hasValue)
+        {
+            out.targetFps = std::max(0, atoi(argv[++i]));
+        }
+        else if (strcmp(arg, "--no-pacing") == 0)
+        {
+            out.framePacing = false;
+        }
+        else if (strcmp(arg, "--render-scale") == 0 && hasValue)
+        {
+            out.renderScale = (float)atof(argv[++i]);
+            if (out.renderScale < 0.25f || out.renderScale > 1.0f)
+            {
+                std::cerr << "[Benchmark] --render-scale must be between 0.25 and 1\n";
+                return false;
+            }
+        }
+        else if (strcmp(arg, "--sync-textures") == 0)
+        {
+            out.asyncTextures = false;
+        }
+        else if (strcmp(arg, "--no-cooked-textures") == 0)
+        {
+            out.cookedTextures = false;
+        }
+        else if (strcmp(arg, "--no-virtual-textures") == 0)
+        {
+            out.virtualTextures = false;
+        }
+        else if (strcmp(arg, "--catalog") == 0 && hasValue)
+        {
+            out.catalogPath = argv[++i];
+        }
+        else if (strcmp(arg, "--belt-density") == 0 && hasValue)
+        {
+            out.beltDensity = (float)atof(argv[++i]);
+            if (out.beltDensity < 0.0f || out.beltDensity > 1.0f)
+            {
+                std::cerr << "[Benchmark] --belt-density must be between 0 and 1\n";
+                return false;
+            }
+        }
+        else if (strcmp(arg, "--serve") == 0 && hasValue)
+        {
+            // 서버 모드는 항상 헤드리스 (프레임 수는 클라이언트가 정함)
+            out.serveSocket = argv[++i];
+            out.headless = true;
+        }
+        else
+        {
+            std::cerr << "[Benchmark] Unknown argument: " << arg << "\n";
+            printUsage();
+            return false;
+        }
+    }
+
+    if (out.frames <= 0 || out.fixedDtSec <= 0.0f)
+    {
+        std::cerr << "[Benchmark] --frames and --dt must be positive\n";
+        return false;
+    }
+    if (out.warmupFrames < 0) out.warmupFrames = 0;
+
+    return true;
+}
+
+// -------------------------------------------------------------
+// 스크립트 카메라
+//  - 전체 진행률 t(0~1)에 따라 태양 주위를 한 바퀴 돌면서
+//    중간에 내행성 영역까지 접근했다가 다시 멀어진다.
+// -------------------------------------------------------------
+void applyScriptedCamera(Camera& cam, int frame, int totalFrames)
+{
+    float t = (totalFrames > 1) ? (float)frame / (float)(totalFrames - 1) : 0.0f;
+
+    float angle = glm::two_pi<float>() * t + glm::half_pi<float>();
+    float radius = 230.0f - 170.0f * sin(glm::pi<float>() * t); // 230 → 60 → 230
+    float height = 80.0f - 50.0f * sin(glm::pi<float>() * t);   // 80 → 30 → 80
+
+    glm::vec3 pos(radius * cos(angle), height, radius * sin(angle));
+    cam.setPose(pos, glm::vec3(0.0f));
+}
+
+// -------------------------------------------------------------
+// 합성 소천체
+//  - 궤도 반지름 55~88 (화성과 목성 사이), 경사 ±6도, 반지름 0.15~0.4
+//  - 주기는 케플러 제3법칙 비율(a^1.5)로 맞춤 (화성 궤도 48 = 1.88년 기준)
+// -------------------------------------------------------------
+void buildExtraBodies(int count, float simYears, std::vector<glm::mat4>& outModels)
+{
+    outModels.resize(count);
+
+    unsigned int seed = 12345u;
+    auto next = [&seed]() {
+        seed = seed * 1664525u + 1013904223u;   // LCG
+        return (float)(seed >> 8) / 16777216.0f;
+    };
+
+    for (int i = 0; i < count; i++)
+    {
+        float a = 55.0f + 33.0f * next();
+        float incl = glm::radians(-6.0f + 12.0f * next());
+        float node = glm::two_pi<float>() * next();
+        float phase = glm::two_pi<float>() * next();
+        float radius = 0.15f + 0.25f * next();
+
+        float periodYears = 1.88f * pow(a / 48.0f, 1.5f);
+        float angle = phase + glm::two_pi<float>() * simYears / periodYears;
+
+        glm::vec3 p(a * cos(angle), 0.0f, a * sin(angle));
+        glm::mat4 m = glm::rotate(glm::mat4(1.0f), node, glm::vec3(0, 1, 0));
+        m = glm::rotate(m, incl, glm::vec3(1, 0, 0));
+        m = glm::translate(m, p);
+        m = glm::scale(m, glm::vec3(radius));
+        outModels[i] = m;
+    }
+}
+
+// =====================================================
+// FrameStats
+// =====================================================
+FrameStats::FrameStats()
+    : frameIndex(0), cpuStart(0.0)
+{
+    for (int i = 0; i < QUERY_RING; i++)
+    {
+        queries[i] = 0;
+        queryFrame[i] = -1;
+    }
+}
+
+FrameStats::~FrameStats()
+{
+}
+
+void FrameStats::init()
+{
+    glGenQueries(QUERY_RING, queries);
+}
+
+void FrameStats::collect(int slot)
+{
+    if (queryFrame[slot] < 0) return;
+
+    GLuint64 ns = 0;
+    glGetQueryObjectui64v(queries[slot], GL_QUERY_RESULT, &ns);
+    gpuMs[queryFrame[slot] % SAMPLE_RING] = (double)ns / 1.0e6;
+    queryFrame[slot] = -1;
+}
+
+void FrameStats::beginFrame()
+{
+    int slot = frameIndex % QUERY_RING;
+
+    // 같은 슬롯의 이전 결과는 QUERY_RING 프레임 전 것이므로 보통 이미 준비됨
+    collect(slot);
+
+    int sample = frameIndex % SAMPLE_RING;
+    if ((int)cpuMs.size() < SAMPLE_RING)
+    {
+        cpuMs.push_back(0.0);
+        gpuMs.push_back(0.0);
+    }
+    cpuMs[sample] = 0.0;
+    gpuMs[sample] = 0.0;
+
+    cpuStart = nowMs();
+    glBeginQuery(GL_TIME_ELAPSED, queries[slot]);
+    queryFrame[slot] = frameIndex;
+}
+
+void FrameStats::endFrame()
+{
+    glEndQuery(GL_TIME_ELAPSED);
+    cpuMs[frameIndex % SAMPLE_RING] = nowMs() - cpuStart;
+    frameIndex++;
+}
+
+void FrameStats::finish()
+{
+    for (int i = 0; i < QUERY_RING; i++)
+        collect(i);
+
+    glDeleteQueries(QUERY_RING, queries);
+    for (int i = 0; i < QUERY_RING; i++)
+        queries[i] = 0;
+}
+
+// 정렬된 샘플에서 백분위 값 추출
+static double percentile(const std::vector<double>& sorted, double p)
+{
+    if (sorted.empty()) return 0.0;
+    size_t idx = (size_t)(p * (double)(sorted.size() - 1) + 0.5);
+    return sorted[std::min(idx, sorted.size() - 1)];
+}
+
+static void printRow(std::ostream& os, const char* label, std::vector<double> samples)
+{
+    if (samples.empty()) return;
+
+    std::sort(samples.begin(), samples.end());
+
+    double sum = 0.0;
+    for (double s : samples) sum += s;
+
+    os << "  " << std::left << std::setw(6) << label << std::right
+        << std::setw(9) << sum / samples.size()
+        << std::setw(9) << samples.front()
+        << std::setw(9) << percentile(samples, 0.50)
+        << std::setw(9) << percentile(samples, 0.95)
+        << std::setw(9) << percentile(samples, 0.99)
+        << std::setw(9) << samples.back() << "\n";
+}
+
+void FrameStats::report(std::ostream& os, int warmupFrames) const
+{
+    int total = frameIndex;
+    int skip = std::min(warmupFrames, total);
+
+    // 링에 남은 프레임 중 워밍업 이후만 (오래된 순서로)
+    int first = std::max(skip, total - (int)cpuMs.size());
+    std::vector<double> cpu, gpu;
+    for (int f = first; f < total; f++)
+    {
+        cpu.push_back(cpuMs[f % SAMPLE_RING]);
+        gpu.push_back(gpuMs[f % SAMPLE_RING]);
+    }
+
+    double cpuSum = 0.0;
+    for (double s : cpu) cpuSum += s;
+
+    os << std::fixed << std::setprecision(3);
+    os << "[Benchmark] " << total << " frames (" << skip << " warmup excluded";
+    if (first > skip)
+        os << ", stats over last " << total - first;
+    os << ")\n";
+    os << "  (ms)  " << std::setw(9) << "avg" << std::setw(9) << "min"
+        << std::setw(9) << "p50" << std::setw(9) << "p95"
+        << std::setw(9) << "p99" << std::setw(9) << "max" << "\n";
+    printRow(os, "CPU", cpu);
+    printRow(os, "GPU", gpu);
+
+    if (!cpu.empty() && cpuSum > 0.0)
+        os << "  avg FPS (CPU): " << std::setprecision(1) << 1000.0 * cpu.size() / cpuSum << "\n";
+}
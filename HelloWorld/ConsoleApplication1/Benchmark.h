@@ -0,0 +1,109 @@
+﻿#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <string>
+#include <vector>
+#include <ostream>
+#include <glm/glm.hpp>
+
+#include "FrameCapture.h"
+
+class Camera;
+
+// =====================================================
+// 헤드리스 벤치마크 실행 옵션
+//  --headless            창 없이 오프스크린 컨텍스트로 실행
+//  --frames N            렌더링할 프레임 수
+//  --dt SEC              고정 시뮬레이션 스텝 (초)
+//  --speed X             시뮬레이션 배속
+//  --size WxH            오프스크린 해상도
+//  --context egl|osmesa  오프스크린 컨텍스트 종류
+//  --warmup N            통계에서 제외할 초기 프레임 수
+//  --capture DIR         시작부터 PNG 시퀀스로 녹화
+//  --capture-raw DIR     시작부터 RGBA8 원시 파일로 녹화
+//  --capture-pipe CMD    시작부터 외부 인코더로 원시 프레임 전달
+//  --no-shader-cache     프로그램 바이너리 캐시 사용 안 함
+//  --vram-budget MB      GPU 메모리 예산 (초과 시 텍스처 해상도 축소)
+//  --bodies N            합성 소천체 N 개 추가 (제출 부하 측정용)
+//  --fps N               창 모드 목표 프레임률 (기본: 모니터 주사율 + 수직 동기)
+//  --no-pacing           프레임 페이싱 / 늦은 입력 읽기 사용 안 함
+//  --render-scale S      HDR 장면 내부 해상도 배율 (0.25~1, 1 미만이면 시간 누적 업스케일)
+//  --sync-textures       텍스처를 첫 프레임 전에 모두 디코딩 / 업로드 (비동기 로딩 끔)
+//  --no-cooked-textures  쿠킹된 .ctex 를 무시하고 원본 JPG / PNG 를 디코딩
+//  --no-virtual-textures .vtex 가상 텍스처를 무시하고 일반 텍스처로 그림
+//  --catalog FILE        천체 카탈로그 (텍스트 또는 컴파일된 .bcat, 기본 catalogs/solar_system.txt)
+//  --belt-density F      소행성대 / 카이퍼 벨트 중 그릴 비율 (0 ~ 1, 기본 1)
+//  --serve SOCKET        프레임 서버 모드 (헤드리스, 소켓 명령 → 공유 메모리 프레임, POSIX 전용)
+// =====================================================
+struct BenchmarkOptions
+{
+    bool headless = false;            // 헤드리스 모드 여부
+    int frames = 600;                 // 렌더링할 프레임 수
+    float fixedDtSec = 1.0f / 60.0f;  // 고정 시뮬레이션 스텝 (초)
+    float simSpeed = 1.0f;            // 시뮬레이션 배속
+    unsigned int width = 1280;        // 오프스크린 가로 해상도
+    unsigned int height = 720;        // 오프스크린 세로 해상도
+    std::string contextApi = "egl";   // "egl" 또는 "osmesa"
+    int warmupFrames = 10;            // 통계에서 제외할 초기 프레임 수
+
+    CaptureOptions capture;           // 프레임 녹화 옵션 (F9 로 켜고 끄기)
+    bool shaderCache = true;          // 프로그램 바이너리 캐시 사용 여부
+    unsigned int vramBudgetMB = 0;    // GPU 메모리 예산 (MiB, 0 = 제한 없음)
+    int extraBodies = 0;              // 합성 소천체 수
+    int targetFps = 0;                // 창 모드 목표 프레임률 (0 = 모니터 주사율)
+    bool framePacing = true;          // 프레임 페이싱 사용 여부 (창 모드)
+    float renderScale = 1.0f;         // HDR 장면 내부 해상도 배율 (1 = 업스케일 없음)
+    bool asyncTextures = true;        // 텍스처 비동기 로딩 (자리 표시 후 업로드)
+    bool cookedTextures = true;       // .ctex (블록 압축 + 밉맵) 사용 여부
+    bool virtualTextures = true;      // .vtex (타일 스트리밍 가상 텍스처) 사용 여부
+    std::string catalogPath = "catalogs/solar_system.txt"; // 천체 카탈로그 경로
+    float beltDensity = 1.0f;         // 소천체 벨트 그리기 비율
+    std::string serveSocket;          // 프레임 서버 소켓 경로 (비어 있으면 끔)
+};
+
+// 명령행 인자 파싱 (실패 시 false + 사용법 출력)
+bool parseBenchmarkArgs(int argc, char** argv, BenchmarkOptions& out);
+
+// 스크립트 카메라: 프레임 번호만으로 결정되는 비행 경로 (재현 가능한 측정용)
+void applyScriptedCamera(Camera& cam, int frame, int totalFrames);
+
+// 합성 소천체: 화성~목성 사이 원궤도에 흩어진 작은 구 (시드 고정, 재현 가능)
+//  - CPU 제출 부하 측정용 (모델 행렬만 생성)
+void buildExtraBodies(int count, float simYears, std::vector<glm::mat4>& outModels);
+
+// =====================================================
+// FrameStats
+//  - 프레임별 CPU 시간(벽시계)과 GPU 시간(GL_TIME_ELAPSED) 수집
+//  - GPU 쿼리는 링 버퍼로 돌려서 결과를 기다리며 멈추지 않음
+//  - 표본도 링 버퍼 (--serve 처럼 끝없이 도는 실행에서 메모리가 늘지 않게, 통계는 최근 SAMPLE_RING 프레임)
+// =====================================================
+class FrameStats
+{
+public:
+    FrameStats();
+    ~FrameStats();
+
+    void init();        // GL 쿼리 생성 (컨텍스트 생성 후 호출)
+    void beginFrame();
+    void endFrame();
+    void finish();      // 아직 수거하지 않은 GPU 쿼리 결과 수집
+
+    void report(std::ostream& os, int warmupFrames) const;
+
+private:
+    static const int QUERY_RING = 4;
+    static const int SAMPLE_RING = 16384;     // 백분위 계산용 최근 표본 수
+
+    unsigned int queries[QUERY_RING]; // GL_TIME_ELAPSED 쿼리 링
+    int queryFrame[QUERY_RING];       // 각 쿼리가 측정한 프레임 번호 (-1 = 비어 있음)
+
+    int frameIndex;
+    double cpuStart;
+
+    std::vector<double> cpuMs;        // 프레임별 CPU 시간 (ms), 프레임 f 는 f % SAMPLE_RING 칸
+    std::vector<double> gpuMs;        // 프레임별 GPU 시간 (ms)
+
+    void collect(int slot);
+};
+
+#endif
@@ -0,0 +1,617 @@
+﻿#ifdef _WIN32
+#define _CRT_SECURE_NO_WARNINGS // fopen 경고 억제
+#endif
+
+#include "BodyCatalog.h"
+#include "Planet.h"     // 고리 / 대기 / 지형 기본값
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <sys/stat.h>
+
+// =====================================================
+// 텍스트 카탈로그 형식 (한 줄에 한 항목, # 뒤는 주석)
+//
+//  천체 시작:  star|barycenter|planet|satellite 이름 [부모 이름]
+//    부모를 생략하면 planet 은 마지막 star / barycenter, satellite 는 마지막 planet
+//    부모는 항상 먼저 나와야 함 (BodyStore 와 같은 규칙)
+//  천체 속성 (다음 천체 시작 전까지 적용):
+//    mass M / radius R / tilt DEG / spin DEG_PER_DAY / spin-period-days D (음수 = 역자전)
+//    axis-precession-years Y           (자전축 세차 주기, 없으면 세차 없음)
+//    orbit A E INC NODE PERI M0        (거리는 장면 단위, 각도는 도)
+//    period-years Y / period-days D / precession PERI_DEG_PER_YEAR NODE_DEG_PER_YEAR
+//    texture PATH / trail N
+//    ring INNER OUTER ALPHA PATH
+//    atmosphere                         (기본값으로 켜기)
+//    atmosphere.thickness|rayleigh-height|mie-height|mie|mie-g|sun-intensity V
+//    atmosphere.rayleigh R G B / atmosphere.night PATH / atmosphere.clouds PATH OPACITY
+//    terrain HEIGHT_SCALE [TILE_DIR]
+//  소천체:
+//    au-scale AU UNITS [AU UNITS]...    (AU → 장면 단위 구간 선형 대응, 없으면 그대로)
+//    small A_AU E INC NODE PERI M0 [H]  (주기는 케플러 제3법칙 A^1.5 년)
+//    mpc PATH [LIMIT]                   (MPCORB.DAT 형식 고정 열 파일, 카탈로그 기준 상대 경로)
+//    belt COUNT A_MIN A_MAX E_MAX INC_MAX [H_MIN H_MAX]
+//                                       (고정 시드로 만든 합성 소천체 COUNT 개, 거리는 AU)
+//    소천체는 고정 시드로 섞어서 저장 → 앞쪽 일부만 그려도 모든 벨트가 고르게 줄어듦
+// =====================================================
+
+namespace
+{
+    struct CatalogBuilder
+    {
+        std::vector<bcat::BodyRecord> bodies;
+        std::vector<std::string> names;
+        std::vector<bcat::SmallBody> small;
+        std::string strings;
+        std::map<std::string, uint32_t> stringIndex;
+        std::vector<std::pair<float, float>> auScale;   // (AU, 장면 단위), AU 오름차순
+        uint32_t rng = 0x2545F491u;                      // belt / 섞기 난수 상태
+
+        uint32_t addString(const std::string& s)
+        {
+            auto it = stringIndex.find(s);
+            if (it != stringIndex.end()) return it->second;
+            uint32_t offset = (uint32_t)strings.size();
+            strings.append(s);
+            strings.push_back('\0');
+            stringIndex[s] = offset;
+            return offset;
+        }
+
+        int find(const std::string& name) const
+        {
+            for (int i = (int)names.size() - 1; i >= 0; i--)
+                if (names[i] == name) return i;
+            return -1;
+        }
+
+        int lastOfKind(bcat::Kind a, bcat::Kind b) const
+        {
+            for (int i = (int)bodies.size() - 1; i >= 0; i--)
+                if (bodies[i].kind == (uint32_t)a || bodies[i].kind == (uint32_t)b) return i;
+            return -1;
+        }
+
+        // AU → 장면 단위 (구간 선형, 양 끝은 마지막 구간 기울기로 연장)
+        float sceneDistance(float au) const
+        {
+            if (auScale.empty()) return au;
+            if (auScale.size() == 1) return au * auScale[0].second / auScale[0].first;
+
+            size_t hi = 1;
+            while (hi + 1 < auScale.size() && au > auScale[hi].first) hi++;
+            const auto& k0 = auScale[hi - 1];
+            const auto& k1 = auScale[hi];
+            float t = (au - k0.first) / (k1.first - k0.first);
+            return k0.second + (k1.second - k0.second) * t;
+        }
+
+        void addSmall(float aAU, float e, float inc, float node, float peri, float m0, float h)
+        {
+            bcat::SmallBody b;
+            b.semiMajorAxis = sceneDistance(aAU);
+            b.eccentricity = e;
+            b.inclinationDeg = inc;
+            b.ascNodeDeg = node;
+            b.argPeriDeg = peri;
+            b.meanAnomalyAtEpochDeg = m0;
+            b.periodYears = std::pow(aAU, 1.5f);
+            b.absMagnitude = h;
+            small.push_back(b);
+        }
+
+        // 합성 벨트 (선형 합동 난수, 시드 고정 → 같은 텍스트는 항상 같은 결과)
+        //  - 경사각은 u² 로 얇은 원반 쪽에 몰리게, H 는 √u 로 어두운(작은) 쪽에 몰리게
+        void addBelt(long count, float aMin, float aMax, float eMax, float incMax, float hMin, float hMax)
+        {
+            auto next = [this]()
+            {
+                rng = rng * 1664525u + 1013904223u;
+                return (float)(rng >> 8) / 16777216.0f;   // [0, 1)
+            };
+
+            small.reserve(small.size() + (size_t)count);
+            for (long i = 0; i < count; i++)
+            {
+                float a = aMin + (aMax - aMin) * next();
+                float e = eMax * next();
+                float u = next();
+                float inc = incMax * u * u;
+                float node = 360.0f * next();
+                float peri = 360.0f * next();
+                float m0 = 360.0f * next();
+                float h = hMin + (hMax - hMin) * std::sqrt(next());
+                addSmall(a, e, inc, node, peri, m0, h);
+            }
+        }
+
+        // Fisher-Yates (같은 난수열)
+        void shuffleSmall()
+        {
+            for (size_t i = small.size(); i > 1; i--)
+            {
+                rng = rng * 1664525u + 1013904223u;
+                std::swap(small[i - 1], small[(size_t)((uint64_t)(rng >> 8) * i >> 24)]);
+            }
+        }
+
+        bcat::BodyRecord newBody(bcat::Kind kind, const std::string& name, int parent)
+        {
+            RingParams ring;
+            AtmosphereParams atm;
+            TerrainParams terrain;
+
+            bcat::BodyRecord r;
+            memset(&r, 0, sizeof(r));
+            r.name = addString(name);
+            r.parent = parent;
+            r.kind = (uint32_t)kind;
+            r.orbit.periodYears = 1.0f;
+            r.mass = 1.0f;
+            r.texture = bcat::NO_STRING;
+            r.trailPoints = 200;
+
+            r.ringInner = ring.innerRadius;
+            r.ringOuter = ring.outerRadius;
+            r.ringAlpha = ring.alpha;
+            r.ringTexture = bcat::NO_STRING;
+
+            r.atmThickness = atm.thickness;
+            r.atmRayleighScaleHeight = atm.rayleighScaleHeight;
+            r.atmMieScaleHeight = atm.mieScaleHeight;
+            r.atmRayleighScattering[0] = atm.rayleighScattering.r;
+            r.atmRayleighScattering[1] = atm.rayleighScattering.g;
+            r.atmRayleighScattering[2] = atm.rayleighScattering.b;
+            r.atmMieScattering = atm.mieScattering;
+            r.atmMieG = atm.mieG;
+            r.atmSunIntensity = atm.sunIntensity;
+            r.atmNightTexture = bcat::NO_STRING;
+            r.atmCloudTexture = bcat::NO_STRING;
+            r.atmCloudOpacity = atm.cloudOpacity;
+
+            r.terrainHeightScale = terrain.heightScale;
+            r.terrainTileDir = bcat::NO_STRING;
+            return r;
+        }
+
+        void writeImage(std::vector<unsigned char>& image) const
+        {
+            auto align16 = [](uint64_t v) { return (v + 15) & ~(uint64_t)15; };
+
+            bcat::FileHeader h;
+            memset(&h, 0, sizeof(h));
+            h.magic = bcat::MAGIC;
+            h.version = bcat::VERSION;
+            h.bodyCount = (uint32_t)bodies.size();
+            h.smallBodyCount = (uint32_t)small.size();
+            h.bodyOffset = align16(sizeof(h));
+            h.smallBodyOffset = align16(h.bodyOffset + sizeof(bcat::BodyRecord) * bodies.size());
+            h.stringOffset = align16(h.smallBodyOffset + sizeof(bcat::SmallBody) * small.size());
+            h.stringBytes = strings.size();
+
+            image.assign((size_t)(h.stringOffset + h.stringBytes), 0);
+            memcpy(image.data(), &h, sizeof(h));
+            if (!bodies.empty())
+                memcpy(image.data() + h.bodyOffset, bodies.data(), sizeof(bcat::BodyRecord) * bodies.size());
+            if (!small.empty())
+                memcpy(image.data() + h.smallBodyOffset, small.data(), sizeof(bcat::SmallBody) * small.size());
+            if (!strings.empty())
+                memcpy(image.data() + h.stringOffset, strings.data(), strings.size());
+        }
+    };
+
+    bool readFile(const std::string& path, std::string& out)
+    {
+        FILE* fp = fopen(path.c_str(), "rb");
+        if (!fp) return false;
+        fseek(fp, 0, SEEK_END);
+        long size = ftell(fp);
+        fseek(fp, 0, SEEK_SET);
+        out.resize(size > 0 ? (size_t)size : 0);
+        bool ok = out.empty() || fread(&out[0], 1, out.size(), fp) == out.size();
+        fclose(fp);
+        return ok;
+    }
+
+    bool parseFloat(const std::string& token, float& out)
+    {
+        char* end = nullptr;
+        out = strtof(token.c_str(), &end);
+        return end != token.c_str() && *end == '\0';
+    }
+
+    // 고정 열 숫자 (열 번호는 1 부터, 공백 허용, 비어 있으면 false)
+    bool columnFloat(const std::string& line, size_t firstCol, size_t lastCol, float& out)
+    {
+        if (line.size() < lastCol) return false;
+        char field[32];
+        size_t len = std::min(lastCol - firstCol + 1, sizeof(field) - 1);
+        memcpy(field, line.data() + firstCol - 1, len);
+        field[len] = '\0';
+
+        char* end = nullptr;
+        out = strtof(field, &end);
+        if (end == field) return false;
+        while (*end == ' ') end++;
+        return *end == '\0';
+    }
+
+    // MPCORB.DAT: 머리말 / 빈 줄 / 숫자가 아닌 줄은 건너뜀
+    //  H 9-13, M 27-35, 근일점 인수 38-46, 승교점 49-57, 경사각 60-68, 이심률 71-79, 긴반지름(AU) 93-103
+    bool importMpc(CatalogBuilder& b, const std::string& path, long limit, std::string& error)
+    {
+        std::string text;
+        if (!readFile(path, text))
+        {
+            error = path + ": cannot read";
+            return false;
+        }
+
+        long added = 0;
+        size_t pos = 0;
+        std::string line;
+        while (pos < text.size() && (limit <= 0 || added < limit))
+        {
+            size_t eol = text.find('\n', pos);
+            if (eol == std::string::npos) eol = text.size();
+            line.assign(text, pos, eol - pos);
+            pos = eol + 1;
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+
+            float m0, peri, node, inc, e, a, h;
+            if (!columnFloat(line, 27, 35, m0) || !columnFloat(line, 38, 46, peri) ||
+                !columnFloat(line, 49, 57, node) || !columnFloat(line, 60, 68, inc) ||
+                !columnFloat(line, 71, 79, e) || !columnFloat(line, 93, 103, a))
+                continue;
+            if (!(a > 0.0f) || !(e >= 0.0f) || e >= 1.0f)
+                continue; // 쌍곡선 / 포물선 궤도는 제외
+            if (!columnFloat(line, 9, 13, h)) h = 0.0f;
+
+            b.addSmall(a, e, inc, node, peri, m0, h);
+            added++;
+        }
+        return true;
+    }
+
+    // 상대 경로는 카탈로그 파일 기준으로
+    std::string resolvePath(const std::string& catalogPath, const std::string& path)
+    {
+        bool absolute = !path.empty() && (path[0] == '/' || path[0] == '\\' ||
+            (path.size() > 1 && path[1] == ':'));
+        size_t slash = catalogPath.find_last_of("/\\");
+        if (absolute || slash == std::string::npos) return path;
+        return catalogPath.substr(0, slash + 1) + path;
+    }
+
+    // 텍스트와 그 텍스트가 읽는 mpc 파일 중 가장 늦은 수정 시각 (.bcat 가 오래됐는지 판단)
+    time_t newestSourceTime(const std::string& textPath)
+    {
+        struct stat st;
+        time_t newest = 0;
+        if (stat(textPath.c_str(), &st) == 0) newest = st.st_mtime;
+
+        std::string text;
+        if (!readFile(textPath, text)) return newest;
+        if (text.size() >= 3 && memcmp(text.data(), "\xEF\xBB\xBF", 3) == 0)
+            text.erase(0, 3);
+
+        std::istringstream lines(text);
+        std::string line;
+        while (std::getline(lines, line))
+        {
+            size_t hash = line.find('#');
+            if (hash != std::string::npos) line.erase(hash);
+
+            std::istringstream ls(line);
+            std::string key, file;
+            if (!(ls >> key >> file) || key != "mpc") continue;
+            if (stat(resolvePath(textPath, file).c_str(), &st) == 0 && st.st_mtime > newest)
+                newest = st.st_mtime;
+        }
+        return newest;
+    }
+}
+
+bool compileBodyCatalog(const std::string& textPath, std::vector<unsigned char>& image, std::string& error)
+{
+    std::string text;
+    if (!readFile(textPath, text))
+    {
+        error = textPath + ": cannot read";
+        return false;
+    }
+    if (text.size() >= 3 && memcmp(text.data(), "\xEF\xBB\xBF", 3) == 0)
+        text.erase(0, 3);
+
+    CatalogBuilder b;
+    bcat::BodyRecord* cur = nullptr;
+
+    std::istringstream lines(text);
+    std::string line;
+    int lineNo = 0;
+    auto fail = [&](const std::string& msg)
+    {
+        error = textPath + ":" + std::to_string(lineNo) + ": " + msg;
+        return false;
+    };
+
+    while (std::getline(lines, line))
+    {
+        lineNo++;
+        size_t hash = line.find('#');
+        if (hash != std::string::npos) line.erase(hash);
+
+        std::istringstream ls(line);
+        std::vector<std::string> tok;
+        std::string t;
+        while (ls >> t) tok.push_back(t);
+        if (tok.empty()) continue;
+
+        const std::string& key = tok[0];
+        const size_t argc = tok.size() - 1;
+
+        // 숫자 인자 n 개 (1 번 토큰부터)
+        float v[6] = {};
+        auto numbers = [&](size_t n, size_t first = 1)
+        {
+            if (tok.size() < first + n) return false;
+            for (size_t i = 0; i < n; i++)
+                if (!parseFloat(tok[first + i], v[i])) return false;
+            return true;
+        };
+
+        // ---- 천체 시작 ----
+        bcat::Kind kind;
+        bool isBody = true;
+        if (key == "star") kind = bcat::Kind::Star;
+        else if (key == "barycenter") kind = bcat::Kind::Barycenter;
+        else if (key == "planet") kind = bcat::Kind::Planet;
+        else if (key == "satellite") kind = bcat::Kind::Satellite;
+        else isBody = false;
+
+        if (isBody)
+        {
+            if (argc < 1 || argc > 2) return fail(key + " NAME [PARENT]");
+            if (b.find(tok[1]) >= 0) return fail("duplicate body '" + tok[1] + "'");
+
+            int parent = -1;
+            if (argc == 2)
+            {
+                parent = b.find(tok[2]);
+                if (parent < 0) return fail("unknown parent '" + tok[2] + "' (parents must come first)");
+            }
+            else if (kind == bcat::Kind::Planet)
+                parent = b.lastOfKind(bcat::Kind::Star, bcat::Kind::Barycenter);
+            else if (kind == bcat::Kind::Satellite)
+            {
+                parent = b.lastOfKind(bcat::Kind::Planet, bcat::Kind::Planet);
+                if (parent < 0) return fail("satellite without a planet");
+            }
+
+            b.bodies.push_back(b.newBody(kind, tok[1], parent));
+            b.names.push_back(tok[1]);
+            cur = &b.bodies.back();
+            continue;
+        }
+
+        // ---- 소천체 ----
+        if (key == "au-scale")
+        {
+            if (argc == 0 || argc % 2 != 0) return fail("au-scale AU UNITS [AU UNITS]...");
+            for (size_t i = 1; i < tok.size(); i += 2)
+            {
+                float au, units;
+                if (!parseFloat(tok[i], au) || !parseFloat(tok[i + 1], units) || au <= 0.0f)
+                    return fail("bad au-scale pair");
+                b.auScale.push_back({ au, units });
+            }
+            std::sort(b.auScale.begin(), b.auScale.end());
+            continue;
+        }
+        if (key == "small")
+        {
+            if ((argc != 6 && argc != 7) || !numbers(6)) return fail("small A_AU E INC NODE PERI M0 [H]");
+            float h = 0.0f;
+            if (argc == 7 && !parseFloat(tok[7], h)) return fail("bad H");
+            if (!(v[0] > 0.0f) || v[1] < 0.0f || v[1] >= 1.0f) return fail("small body needs A > 0 and 0 <= E < 1");
+            b.addSmall(v[0], v[1], v[2], v[3], v[4], v[5], h);
+            continue;
+        }
+        if (key == "mpc")
+        {
+            if (argc < 1 || argc > 2) return fail("mpc PATH [LIMIT]");
+            long limit = argc == 2 ? atol(tok[2].c_str()) : 0;
+            std::string mpcError;
+            if (!importMpc(b, resolvePath(textPath, tok[1]), limit, mpcError))
+                return fail(mpcError);
+            continue;
+        }
+        if (key == "belt")
+        {
+            if ((argc != 5 && argc != 7) || !numbers(4, 2)) return fail("belt COUNT A_MIN A_MAX E_MAX INC_MAX [H_MIN H_MAX]");
+            long count = atol(tok[1].c_str());
+            float aMin = v[0], aMax = v[1], eMax = v[2], incMax = v[3];
+            float hMin = 12.0f, hMax = 18.0f;
+            if (argc == 7 && (!parseFloat(tok[6], hMin) || !parseFloat(tok[7], hMax))) return fail("bad H range");
+            if (count <= 0 || !(aMin > 0.0f) || aMax < aMin || eMax < 0.0f || eMax >= 1.0f)
+                return fail("belt needs COUNT > 0, 0 < A_MIN <= A_MAX and 0 <= E_MAX < 1");
+            b.addBelt(count, aMin, aMax, eMax, incMax, hMin, hMax);
+            continue;
+        }
+
+        // ---- 천체 속성 ----
+        if (!cur) return fail("'" + key + "' before any body");
+        bcat::BodyRecord& r = *cur;
+
+        if (key == "mass" && argc == 1 && numbers(1)) r.mass = v[0];
+        else if (key == "radius" && argc == 1 && numbers(1)) r.radius = v[0];
+        else if (key == "tilt" && argc == 1 && numbers(1)) r.axialTiltDeg = v[0];
+        else if (key == "spin" && argc == 1 && numbers(1)) r.spinDegPerDay = v[0];
+        else if (key == "spin-period-days" && argc == 1 && numbers(1) && v[0] != 0.0f)
+            r.spinDegPerDay = 360.0f / v[0];
+        else if (key == "axis-precession-years" && argc == 1 && numbers(1) && v[0] != 0.0f)
+            r.axisPrecessionDegPerYear = 360.0f / v[0];
+        else if (key == "orbit" && argc == 6 && numbers(6))
+        {
+            r.orbit.semiMajorAxis = v[0];
+            r.orbit.eccentricity = v[1];
+            r.orbit.inclinationDeg = v[2];
+            r.orbit.ascNodeDeg = v[3];
+            r.orbit.argPeriDeg = v[4];
+            r.orbit.meanAnomalyAtEpochDeg = v[5];
+        }
+        else if (key == "period-years" && argc == 1 && numbers(1) && v[0] > 0.0f)
+            r.orbit.periodYears = v[0];
+        else if (key == "period-days" && argc == 1 && numbers(1) && v[0] > 0.0f)
+            r.orbit.periodYears = v[0] / 365.25f;
+        else if (key == "precession" && argc == 2 && numbers(2))
+        {
+            r.orbit.perihelionPrecessionDegPerYear = v[0];
+            r.orbit.ascNodePrecessionDegPerYear = v[1];
+        }
+        else if (key == "texture" && argc == 1) r.texture = b.addString(tok[1]);
+        else if (key == "trail" && argc == 1 && numbers(1)) r.trailPoints = (int32_t)v[0];
+        else if (key == "ring" && argc == 4 && numbers(3))
+        {
+            r.flags |= bcat::HAS_RING;
+            r.ringInner = v[0];
+            r.ringOuter = v[1];
+            r.ringAlpha = v[2];
+            r.ringTexture = b.addString(tok[4]);
+        }
+        else if (key == "terrain" && (argc == 1 || argc == 2) && numbers(1))
+        {
+            r.flags |= bcat::HAS_TERRAIN;
+            r.terrainHeightScale = v[0];
+            if (argc == 2) r.terrainTileDir = b.addString(tok[2]);
+        }
+        else if (key.compare(0, 10, "atmosphere") == 0)
+        {
+            r.flags |= bcat::HAS_ATMOSPHERE;
+            std::string sub = key.size() > 11 && key[10] == '.' ? key.substr(11) : std::string();
+
+            if (key == "atmosphere" && argc == 0) {}
+            else if (sub == "thickness" && argc == 1 && numbers(1)) r.atmThickness = v[0];
+            else if (sub == "rayleigh-height" && argc == 1 && numbers(1)) r.atmRayleighScaleHeight = v[0];
+            else if (sub == "mie-height" && argc == 1 && numbers(1)) r.atmMieScaleHeight = v[0];
+            else if (sub == "mie" && argc == 1 && numbers(1)) r.atmMieScattering = v[0];
+            else if (sub == "mie-g" && argc == 1 && numbers(1)) r.atmMieG = v[0];
+            else if (sub == "sun-intensity" && argc == 1 && numbers(1)) r.atmSunIntensity = v[0];
+            else if (sub == "rayleigh" && argc == 3 && numbers(3))
+            {
+                r.atmRayleighScattering[0] = v[0];
+                r.atmRayleighScattering[1] = v[1];
+                r.atmRayleighScattering[2] = v[2];
+            }
+            else if (sub == "night" && argc == 1) r.atmNightTexture = b.addString(tok[1]);
+            else if (sub == "clouds" && argc == 2 && numbers(1, 2))
+            {
+                r.atmCloudTexture = b.addString(tok[1]);
+                r.atmCloudOpacity = v[0];
+            }
+            else return fail("bad atmosphere entry '" + key + "'");
+        }
+        else return fail("unknown or malformed entry '" + key + "'");
+    }
+
+    b.shuffleSmall();
+    b.writeImage(image);
+    return true;
+}
+
+// =====================================================
+// BodyCatalog
+// =====================================================
+std::unique_ptr<BodyCatalog> BodyCatalog::open(const std::string& path)
+{
+    std::unique_ptr<BodyCatalog> catalog(new BodyCatalog());
+
+    bool binary = path.size() >= 5 && path.compare(path.size() - 5, 5, ".bcat") == 0;
+    std::string binaryPath = binary ? path : bcat::pathFor(path);
+
+    // 텍스트와 그 mpc 파일들보다 새로운 .bcat 가 있으면 맵핑
+    struct stat binaryStat;
+    bool useBinary = binary;
+    if (!binary && stat(binaryPath.c_str(), &binaryStat) == 0)
+    {
+        if (newestSourceTime(path) > binaryStat.st_mtime)
+            std::cerr << "[Catalog] " << binaryPath << " is older than its source, ignored\n";
+        else
+            useBinary = true;
+    }
+
+    if (useBinary)
+    {
+        if (!catalog->map(binaryPath))
+        {
+            std::cerr << "[Catalog] Failed to map " << binaryPath << "\n";
+            return nullptr;
+        }
+    }
+    else
+    {
+        std::string error;
+        if (!compileBodyCatalog(path, catalog->owned, error))
+        {
+            std::cerr << "[Catalog] " << error << "\n";
+            return nullptr;
+        }
+        catalog->base = catalog->owned.data();
+        catalog->fileSize = catalog->owned.size();
+    }
+
+    if (!catalog->validate())
+    {
+        std::cerr << "[Catalog] Invalid catalog: " << (useBinary ? binaryPath : path) << "\n";
+        return nullptr;
+    }
+    return catalog;
+}
+
+bool BodyCatalog::validate()
+{
+    if (fileSize < sizeof(bcat::FileHeader)) return false;
+    header = (const bcat::FileHeader*)base;
+    if (header->magic != bcat::MAGIC || header->version != bcat::VERSION) return false;
+
+    // 구간이 파일 안에 있고 정렬돼 있는지 (개수는 32 비트라 곱해도 넘치지 않음)
+    const uint64_t size = fileSize;
+    if (header->bodyOffset % 16 || header->smallBodyOffset % 16) return false;
+    if (header->bodyOffset + (uint64_t)header->bodyCount * sizeof(bcat::BodyRecord) > size) return false;
+    if (header->smallBodyOffset + (uint64_t)header->smallBodyCount * sizeof(bcat::SmallBody) > size) return false;
+    if (header->stringOffset > size || header->stringBytes > size - header->stringOffset) return false;
+    if (header->stringBytes > 0 && base[header->stringOffset + header->stringBytes - 1] != '\0') return false;
+
+    bodies = (const bcat::BodyRecord*)(base + header->bodyOffset);
+    small = (const bcat::SmallBody*)(base + header->smallBodyOffset);
+    strings = (const char*)(base + header->stringOffset);
+
+    // 주요 천체는 몇 개 안 되므로 레코드까지 확인 (소천체는 숫자뿐이라 검사 없음)
+    auto validString = [&](uint32_t s) { return s == bcat::NO_STRING || s < header->stringBytes; };
+    for (uint32_t i = 0; i < header->bodyCount; i++)
+    {
+        const bcat::BodyRecord& r = bodies[i];
+        if (r.parent < -1 || r.parent >= (int32_t)i) return false;
+        if (r.kind > (uint32_t)bcat::Kind::Barycenter) return false;
+        if (r.name == bcat::NO_STRING || !validString(r.name) || !validString(r.texture) ||
+            !validString(r.ringTexture) || !validString(r.atmNightTexture) ||
+            !validString(r.atmCloudTexture) || !validString(r.terrainTileDir))
+            return false;
+    }
+    return true;
+}
+
+bool BodyCatalog::map(const std::string& path)
+{
+    if (!file.open(path)) return false;
+    base = file.getData();
+    fileSize = file.getSize();
+    return true;
+}
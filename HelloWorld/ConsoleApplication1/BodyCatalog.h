@@ -0,0 +1,187 @@
+﻿#ifndef BODY_CATALOG_H
+#define BODY_CATALOG_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "MappedFile.h"
+
+// =====================================================
+// 천체 카탈로그 바이너리 형식 (.bcat)
+//  - 텍스트 카탈로그(작성용)를 CatalogCompiler 가 옆에 변환: catalogs/solar_system.txt -> catalogs/solar_system.bcat
+//  - [FileHeader][BodyRecord x bodyCount][SmallBody x smallBodyCount][문자열 표]
+//    각 구간은 16 바이트 정렬, 레코드는 고정 크기 POD 라 맵핑한 메모리를 그대로 씀
+//  - 문자열(이름 / 텍스처 경로)은 문자열 표 안의 오프셋 (NUL 종료, NO_STRING = 없음)
+//  - 정수 / 실수는 모두 little endian
+// =====================================================
+namespace bcat
+{
+    const uint32_t MAGIC = 0x54414342u;   // "BCAT"
+    const uint32_t VERSION = 1;
+    const uint32_t NO_STRING = 0xFFFFFFFFu;
+
+    // BodyKind 와 같은 순서
+    enum class Kind : uint32_t
+    {
+        Star = 0,
+        Planet = 1,
+        Satellite = 2,
+        Barycenter = 3
+    };
+
+    enum Flags : uint32_t
+    {
+        HAS_RING = 1u << 0,
+        HAS_ATMOSPHERE = 1u << 1,
+        HAS_TERRAIN = 1u << 2
+    };
+
+    struct FileHeader
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t bodyCount;
+        uint32_t smallBodyCount;
+        uint64_t bodyOffset;        // 파일 처음부터
+        uint64_t smallBodyOffset;
+        uint64_t stringOffset;
+        uint64_t stringBytes;
+    };
+
+    // OrbitalElements 와 같은 순서 (부모 중심, 거리는 장면 단위)
+    struct Orbit
+    {
+        float semiMajorAxis;
+        float eccentricity;
+        float inclinationDeg;
+        float ascNodeDeg;
+        float argPeriDeg;
+        float periodYears;
+        float meanAnomalyAtEpochDeg;
+        float perihelionPrecessionDegPerYear;
+        float ascNodePrecessionDegPerYear;
+    };
+
+    // 주요 천체 (항성 / 행성 / 위성 / 질량중심): 이름, 텍스처, 고리, 대기, 지형까지
+    struct BodyRecord
+    {
+        uint32_t name;              // 문자열 오프셋
+        int32_t parent;             // 부모 레코드 번호 (-1 = 루트, 항상 자기보다 앞)
+        uint32_t kind;              // Kind
+        uint32_t flags;             // Flags
+        Orbit orbit;
+        float mass;
+        float radius;               // 렌더링 반지름
+        float spinDegPerDay;        // 자전 속도 (시뮬레이션 일 기준)
+        float axialTiltDeg;
+        uint32_t texture;           // 표면 텍스처 경로
+        int32_t trailPoints;        // 궤적 점 개수 (위성)
+
+        float ringInner;
+        float ringOuter;
+        float ringAlpha;
+        uint32_t ringTexture;
+
+        float atmThickness;
+        float atmRayleighScaleHeight;
+        float atmMieScaleHeight;
+        float atmRayleighScattering[3];
+        float atmMieScattering;
+        float atmMieG;
+        float atmSunIntensity;
+        uint32_t atmNightTexture;
+        uint32_t atmCloudTexture;
+        float atmCloudOpacity;
+
+        float terrainHeightScale;
+        uint32_t terrainTileDir;
+
+        float axisPrecessionDegPerYear; // 자전축 세차 (0 = 없음)
+        uint32_t reserved[2];       // 0 (레코드 크기를 16 바이트 배수로)
+    };
+
+    // 소천체 (소행성 등): 궤도 요소만, 태양 중심 / 거리는 장면 단위 / 세차 없음
+    struct SmallBody
+    {
+        float semiMajorAxis;
+        float eccentricity;
+        float inclinationDeg;
+        float ascNodeDeg;
+        float argPeriDeg;
+        float meanAnomalyAtEpochDeg;
+        float periodYears;
+        float absMagnitude;         // 절대등급 H (밝기 / 크기 추정용, 모르면 0)
+    };
+
+    static_assert(sizeof(FileHeader) == 48, "bcat::FileHeader layout");
+    static_assert(sizeof(BodyRecord) == 160, "bcat::BodyRecord layout");
+    static_assert(sizeof(SmallBody) == 32, "bcat::SmallBody layout");
+
+    // 텍스트 카탈로그 경로의 확장자를 .bcat 로 바꾼 경로
+    inline std::string pathFor(const std::string& textPath)
+    {
+        size_t dot = textPath.find_last_of('.');
+        size_t slash = textPath.find_last_of("/\\");
+        if (dot == std::string::npos || (slash != std::string::npos && dot < slash))
+            return textPath + ".bcat";
+        return textPath.substr(0, dot) + ".bcat";
+    }
+}
+
+// =====================================================
+// BodyCatalog
+//  - .bcat 를 읽기 전용으로 맵핑하고 레코드를 복사 / 천체별 할당 없이 그대로 노출
+//    (10 만 개 단위 소천체도 맵핑 + 헤더 검사만 하므로 수 ms 안에 끝남)
+//  - 텍스트 카탈로그를 열면 옆의 .bcat 가 텍스트와 그 mpc 파일들보다 새로울 때 그것을 맵핑하고,
+//    없거나 오래됐으면 메모리에서 같은 이미지로 컴파일 (느리지만 다시 빌드할 필요 없음)
+// =====================================================
+class BodyCatalog
+{
+public:
+    // .bcat 또는 텍스트 카탈로그 열기 (실패 시 nullptr + 오류 출력)
+    static std::unique_ptr<BodyCatalog> open(const std::string& path);
+
+    int bodyCount() const { return (int)header->bodyCount; }
+    const bcat::BodyRecord& body(int index) const { return bodies[index]; }
+
+    int smallBodyCount() const { return (int)header->smallBodyCount; }
+    const bcat::SmallBody* smallBodies() const { return small; }
+
+    // 문자열 표 조회 (NO_STRING 이면 빈 문자열)
+    const char* string(uint32_t offset) const
+    {
+        return offset == bcat::NO_STRING ? "" : strings + offset;
+    }
+
+    bool isMapped() const { return owned.empty(); }
+    size_t sizeBytes() const { return fileSize; }
+
+private:
+    BodyCatalog() {}
+    BodyCatalog(const BodyCatalog&) = delete;
+    BodyCatalog& operator=(const BodyCatalog&) = delete;
+
+    MappedFile file;                    // 맵핑한 .bcat (텍스트에서 컴파일했으면 비어 있음)
+    std::vector<unsigned char> owned;   // 텍스트에서 컴파일한 이미지 (맵핑이면 비어 있음)
+    const unsigned char* base = nullptr;// file 또는 owned
+    size_t fileSize = 0;
+    const bcat::FileHeader* header = nullptr;
+    const bcat::BodyRecord* bodies = nullptr;
+    const bcat::SmallBody* small = nullptr;
+    const char* strings = nullptr;
+
+    bool map(const std::string& path);
+    bool validate();
+};
+
+// =====================================================
+// 텍스트 카탈로그 → .bcat 이미지
+//  - CatalogCompiler 와 BodyCatalog::open(텍스트) 이 같이 씀 (GL 호출 없음)
+//  - 실패하면 false + error 에 "파일:줄: 내용"
+// =====================================================
+bool compileBodyCatalog(const std::string& textPath, std::vector<unsigned char>& image, std::string& error);
+
+#endif
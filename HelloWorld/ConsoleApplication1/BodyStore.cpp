@@ -0,0 +1,158 @@
+﻿#include "BodyStore.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+// 궤도 기준면 XY → 렌더링 XZ
+static const glm::mat4 orbitToXZ =
+    glm::rotate(glm::mat4(1.0f), glm::radians(-90.0f), glm::vec3(1.0f, 0.0f, 0.0f));
+
+BodyStore::BodyStore()
+    : hasPrevious(false), scale(1.0f), sunIndex(-1)
+{
+}
+
+int BodyStore::add(const BodyDesc& d)
+{
+    if (d.parent >= size()) return -1; // 부모가 먼저 있어야 한 번의 순회로 전파 가능
+
+    parents.push_back(d.parent);
+    kinds.push_back(d.kind);
+
+    semiMajorAxes.push_back(d.orbit.semiMajorAxis);
+    eccentricities.push_back(d.orbit.eccentricity);
+    inclinationsDeg.push_back(d.orbit.inclinationDeg);
+    ascNodesDeg.push_back(d.orbit.ascNodeDeg);
+    argPerisDeg.push_back(d.orbit.argPeriDeg);
+    periodsYears.push_back(d.orbit.periodYears);
+    meanAnomaliesDeg.push_back(d.orbit.meanAnomalyAtEpochDeg);
+    periPrecessionsDegPerYear.push_back(d.orbit.perihelionPrecessionDegPerYear);
+    nodePrecessionsDegPerYear.push_back(d.orbit.ascNodePrecessionDegPerYear);
+
+    spinRatesDeg.push_back(d.spinDegPerSec);
+    spinAnglesDeg.push_back(0.0f);
+    axialTiltsDeg.push_back(d.axialTiltDeg);
+    axisPrecessionsDeg.push_back(d.axisPrecessionDegPerYear);
+
+    masses.push_back(d.mass);
+    radii.push_back(d.radius);
+    materials.push_back(d.material);
+
+    localPositions.push_back(glm::vec3(0.0f));
+    childMasses.push_back(0.0f);
+    baryOffsets.push_back(glm::vec3(0.0f));
+    worldPositions.push_back(glm::vec3(0.0f));
+    models.push_back(glm::mat4(1.0f));
+    prevModels.push_back(glm::mat4(1.0f));
+    hasPrevious = false; // 새 천체는 지난 프레임 행렬이 없음
+
+    return size() - 1;
+}
+
+bool BodyStore::build(const std::vector<BodyDesc>& records)
+{
+    if (size() != 0) return false;
+
+    for (const BodyDesc& d : records)
+        if (add(d) < 0) return false;
+
+    // 항성 → 행성 → 위성 조회용 번호 (레코드에서 찾아 저장)
+    sunIndex = -1;
+    planetBodies.clear();
+    satelliteBodies.clear();
+    otherBodyList.clear();
+    std::vector<int> planetOf(records.size(), -1);
+    for (int i = 0; i < (int)records.size(); i++)
+    {
+        int p = parents[i];
+        if (kinds[i] == BodyKind::Star && sunIndex < 0)
+        {
+            sunIndex = i;
+        }
+        else if (kinds[i] == BodyKind::Planet && p >= 0 && p == sunIndex)
+        {
+            planetOf[i] = (int)planetBodies.size();
+            planetBodies.push_back(i);
+            satelliteBodies.emplace_back();
+        }
+        else if (kinds[i] == BodyKind::Satellite && p >= 0 && planetOf[p] >= 0)
+        {
+            satelliteBodies[planetOf[p]].push_back(i);
+        }
+        else
+        {
+            otherBodyList.push_back(i);
+        }
+    }
+    return true;
+}
+
+void BodyStore::advanceSpin(float dtSimDays)
+{
+    const int n = size();
+    for (int i = 0; i < n; i++)
+        spinAnglesDeg[i] += spinRatesDeg[i] * dtSimDays;
+}
+
+void BodyStore::update(float simYears, float worldScale)
+{
+    const int n = size();
+    scale = worldScale;
+
+    // 1) 부모 중심 궤도 위치 (천체마다 독립)
+    for (int i = 0; i < n; i++)
+    {
+        childMasses[i] = 0.0f;
+        baryOffsets[i] = glm::vec3(0.0f);
+        if (parents[i] < 0)
+        {
+            localPositions[i] = glm::vec3(0.0f);
+            continue;
+        }
+        localPositions[i] = keplerPosition(semiMajorAxes[i], eccentricities[i], inclinationsDeg[i],
+            ascNodesDeg[i], argPerisDeg[i], periodsYears[i], meanAnomaliesDeg[i],
+            periPrecessionsDegPerYear[i], nodePrecessionsDegPerYear[i], simYears);
+    }
+
+    // 2) 질량중심 보정: 부모는 자식들 반대쪽으로 (M + Σm) 대비 자식 질량만큼 밀림
+    //    루트는 원점에 고정 (태양은 보정하지 않음)
+    for (int i = 0; i < n; i++)
+        if (parents[i] >= 0)
+            childMasses[parents[i]] += masses[i];
+    for (int i = 0; i < n; i++)
+    {
+        int p = parents[i];
+        if (p >= 0 && parents[p] >= 0)
+            baryOffsets[p] += -(masses[i] / (masses[p] + childMasses[p])) * localPositions[i];
+    }
+
+    // 3) 월드 위치 + 모델 행렬 (부모가 앞 번호 → 한 번의 순회로 전파)
+    if (hasPrevious)
+        prevModels.swap(models);
+
+    for (int i = 0; i < n; i++)
+    {
+        int p = parents[i];
+        glm::vec3 world(0.0f);
+        if (p >= 0)
+        {
+            glm::vec3 offset = glm::vec3(orbitToXZ * glm::vec4(localPositions[i], 1.0f)) +
+                glm::vec3(orbitToXZ * glm::vec4(baryOffsets[i], 1.0f));
+            world = worldPositions[p] + offset * scale;
+        }
+        worldPositions[i] = world;
+
+        // 세차 → 자전축 기울기 → 자전 → 크기
+        glm::mat4 m = glm::translate(glm::mat4(1.0f), world);
+        if (axisPrecessionsDeg[i] != 0.0f)
+            m = glm::rotate(m, glm::radians(axisPrecessionsDeg[i]) * simYears, glm::vec3(0, 1, 0));
+        m = glm::rotate(m, glm::radians(axialTiltsDeg[i]), glm::vec3(0, 0, 1));
+        m = glm::rotate(m, glm::radians(spinAnglesDeg[i]), glm::vec3(0, 1, 0));
+        models[i] = glm::scale(m, glm::vec3(radii[i] * scale));
+    }
+
+    if (!hasPrevious)
+    {
+        prevModels = models; // 첫 프레임: 움직임 없음
+        hasPrevious = true;
+    }
+}
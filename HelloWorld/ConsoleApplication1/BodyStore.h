@@ -0,0 +1,129 @@
+﻿#ifndef BODY_STORE_H
+#define BODY_STORE_H
+
+#include <vector>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+#include "Orbit.h"
+
+// =====================================================
+// 천체 종류 (그리는 방식 / 텍스처 선택 외에는 모두 같은 경로로 처리)
+// =====================================================
+enum class BodyKind : uint8_t
+{
+    Star,
+    Planet,
+    Satellite,
+    Barycenter     // 그리지 않는 질량중심 (쌍성 등의 부모)
+};
+
+// 천체 하나 추가용 설명 (BodyStore::add)
+struct BodyDesc
+{
+    int parent = -1;                    // 부모 천체 번호 (-1 = 루트, 원점에 고정)
+    BodyKind kind = BodyKind::Planet;
+    OrbitalElements orbit = {};         // 부모 중심 궤도 (루트는 무시)
+    float mass = 0.0f;
+    float radius = 0.0f;                // 렌더링 반지름
+    float spinDegPerSec = 0.0f;         // 자전 속도 (도/초, advanceSpin 의 dt 기준)
+    float axialTiltDeg = 0.0f;          // 자전축 기울기 (Z 축 기준)
+    float axisPrecessionDegPerYear = 0.0f; // 자전축 세차 (Y 축 기준)
+    unsigned int material = 0;          // 표면 텍스처 (GL 텍스처 이름)
+};
+
+// =====================================================
+// BodyStore
+//  - 모든 천체의 매 프레임 상태를 종류별 배열(SoA)로 보관
+//    궤도 요소 / 자전 / 반지름 / 질량 / 재질 / 계산된 월드 위치 / 모델 행렬
+//  - 계층: 천체마다 부모 번호 하나 (깊이 제한 없음: 위성의 위성, 쌍성의 질량중심)
+//    부모는 항상 자식보다 앞 번호 → 앞에서부터 한 번 훑으면 부모가 먼저 계산됨
+//  - update(): 케플러 위치 → 자식 질량중심 보정 → 월드 위치 → 모델 행렬을 배열 순서대로 처리
+//  - 이름 / 텍스처 경로 / 고리 / 대기 같은 드문 데이터는 Sun / Planet / Satellite 에 그대로 둠
+// =====================================================
+class BodyStore
+{
+public:
+    BodyStore();
+
+    // 천체 추가 → 번호 (부모는 이미 추가된 천체여야 함, 아니면 -1)
+    int add(const BodyDesc& desc);
+
+    // 평면 레코드 목록으로 등록 (빈 저장소에서, parent = 레코드 번호 → 레코드 번호 = 천체 번호)
+    //  - 깊이 / 순서 제한 없음 (부모만 앞에 있으면 됨): 위성의 위성, 쌍성 질량중심, 두 번째 항성
+    //  - 첫 번째 항성이 sunBody, 그 자식 행성 / 행성의 자식 위성은 planetBody / satelliteBody 로도 찾음
+    //  - 부모가 뒤에 있는 레코드가 있으면 false
+    bool build(const std::vector<BodyDesc>& records);
+
+    void setMaterial(int body, unsigned int material) { materials[body] = material; }
+
+    // 모든 천체 자전 (시뮬레이션 일 단위 dt)
+    void advanceSpin(float dtSimDays);
+
+    // 월드 위치 + 모델 행렬 계산 (지난 결과는 prevModel 로 보관 → 움직임 벡터)
+    void update(float simYears, float worldScale);
+
+    int size() const { return (int)parents.size(); }
+
+    // 계층 / 재질
+    int parent(int body) const { return parents[body]; }
+    BodyKind kind(int body) const { return kinds[body]; }
+    unsigned int material(int body) const { return materials[body]; }
+
+    // update() 결과
+    const glm::vec3& worldPosition(int body) const { return worldPositions[body]; }
+    const glm::mat4& model(int body) const { return models[body]; }
+    const glm::mat4& prevModel(int body) const { return prevModels[body]; }
+    float worldRadius(int body) const { return radii[body] * scale; }
+
+    // build() 로 등록한 천체 번호 (등록할 때 저장한 번호, 배치 순서와 무관)
+    int sunBody() const { return sunIndex; }
+    int planetBody(int planetIndex) const { return planetBodies[planetIndex]; }
+    int satelliteBody(int planetIndex, int satIndex) const { return satelliteBodies[planetIndex][satIndex]; }
+    // 위 세 가지로 찾을 수 없는 천체 (질량중심, 두 번째 항성, 위성의 위성 ...)
+    const std::vector<int>& otherBodies() const { return otherBodyList; }
+
+private:
+    // 계층
+    std::vector<int> parents;
+    std::vector<BodyKind> kinds;
+
+    // 궤도 요소 (부모 중심)
+    std::vector<float> semiMajorAxes;
+    std::vector<float> eccentricities;
+    std::vector<float> inclinationsDeg;
+    std::vector<float> ascNodesDeg;
+    std::vector<float> argPerisDeg;
+    std::vector<float> periodsYears;
+    std::vector<float> meanAnomaliesDeg;
+    std::vector<float> periPrecessionsDegPerYear;
+    std::vector<float> nodePrecessionsDegPerYear;
+
+    // 자전
+    std::vector<float> spinRatesDeg;
+    std::vector<float> spinAnglesDeg;
+    std::vector<float> axialTiltsDeg;
+    std::vector<float> axisPrecessionsDeg;
+
+    // 물리 / 재질
+    std::vector<float> masses;
+    std::vector<float> radii;
+    std::vector<unsigned int> materials;
+
+    // update() 작업 배열 + 결과
+    std::vector<glm::vec3> localPositions;  // 부모 중심 궤도 위치 (XY 기준면)
+    std::vector<float> childMasses;         // 자식 질량 합
+    std::vector<glm::vec3> baryOffsets;     // 자식 때문에 밀려난 양 (XY 기준면)
+    std::vector<glm::vec3> worldPositions;
+    std::vector<glm::mat4> models;
+    std::vector<glm::mat4> prevModels;
+    bool hasPrevious;
+    float scale;
+
+    int sunIndex;
+    std::vector<int> planetBodies;                  // 태양의 자식 행성 (등록 순서)
+    std::vector<std::vector<int>> satelliteBodies;  // 행성별 자식 위성 (등록 순서)
+    std::vector<int> otherBodyList;
+};
+
+#endif
@@ -73,8 +73,10 @@ void Camera::processMouseScroll(float yoffset)
     if (isTracking)
     {
         //  : Ÿ  (Zoom In/Out)
-        trackDistance -= yoffset * 2.0f; //  
-        if (trackDistance < 2.0f) trackDistance = 2.0f; // ּ Ÿ
+        // 2  ( )  Ÿ ؼ ݾ
+        float step = (trackDistance > 2.0f) ? 2.0f : (trackDistance - minTrackDistance) * 0.5f + 0.01f;
+        trackDistance -= yoffset * step; //  
+        if (trackDistance < minTrackDistance) trackDistance = minTrackDistance; // ּ Ÿ
         if (trackDistance > 100.0f) trackDistance = 100.0f; // ִ Ÿ
 
         // Ÿ ٲ ġ  
@@ -114,6 +116,14 @@ void Camera::startTracking(glm::vec3 target)
     if (trackDistance < 5.0f) trackDistance = 10.0f;
 }
 
+//  ּ Ÿ (  ִ ༺ ǥ ̱)
+void Camera::setMinTrackDistance(float d)
+{
+    minTrackDistance = d;
+    if (isTracking && trackDistance < d)
+        trackDistance = d;
+}
+
 // [߰]   (  )
 void Camera::stopTracking()
 {
@@ -132,3 +142,20 @@ void Camera::updateTargetPosition(glm::vec3 newPos)
     // , (target) ߽ ϴ ġ 
     position = targetPos - (front * trackDistance);
 }
+
+// ġ ٶ    (帮 ġũ ũƮ ī޶)
+void Camera::setPose(const glm::vec3& pos, const glm::vec3& target)
+{
+    position = pos;
+
+    glm::vec3 dir = glm::normalize(target - pos);
+    pitch = glm::degrees(asin(dir.y));
+    yaw = glm::degrees(atan2(dir.z, dir.x));
+
+    if (pitch > 89.0f)
+        pitch = 89.0f;
+    if (pitch < -89.0f)
+        pitch = -89.0f;
+
+    updateVectors();
+}
@@ -26,10 +26,14 @@ public:
     // ------- [ADD] 카메라 추적 ----------
     void startTracking(glm::vec3 target); // 추적 시작
     void stopTracking();    // 추적 종료
+    void setMinTrackDistance(float d); // 줌 최소 거리 (기본 2)
 
     void updateTargetPosition(glm::vec3 newPos); // 매 프레임 대상의 새로운 위치를 업데이트
     bool getIsTracking() const { return isTracking; } // 추적 상태 확인
 
+    // 위치와 바라볼 지점을 직접 지정 (스크립트 카메라용)
+    void setPose(const glm::vec3& pos, const glm::vec3& target);
+
 private:
     glm::vec3 position;
     glm::vec3 front;
@@ -53,6 +57,7 @@ private:
     bool isTracking = false;    // 현재 추적 중인가?
     glm::vec3 targetPos;        // 추적 대상의 위치
     float trackDistance = 15.0f; // 대상과의 거리 (줌으로 조절 가능하게 할 예정)
+    float minTrackDistance = 2.0f; // 줌 최소 거리
 
     void updateVectors();
 };
@@ -0,0 +1,258 @@
+﻿#include "CommandList.h"
+
+#include <algorithm>
+#include <cstring>
+
+// =====================================================
+// CommandList
+// =====================================================
+void CommandList::reset()
+{
+    commands.clear();
+    uniformData.clear();
+    vertices.clear();
+    names.clear();
+}
+
+int CommandList::internName(const char* name)
+{
+    // 목록당 uniform 이름은 몇 개뿐이므로 선형 검색
+    for (int i = 0; i < (int)names.size(); i++)
+    {
+        if (names[i] == name)
+            return i;
+    }
+    names.push_back(name);
+    return (int)names.size() - 1;
+}
+
+void CommandList::beginPass(unsigned int fbo, int x, int y, int w, int h,
+    bool clearColor, bool clearDepth, const glm::vec4& color)
+{
+    Command c;
+    c.type = Type::BeginPass;
+    c.pass.fbo = fbo;
+    c.pass.x = x;
+    c.pass.y = y;
+    c.pass.w = w;
+    c.pass.h = h;
+    c.pass.clearColor = clearColor;
+    c.pass.clearDepth = clearDepth;
+    c.pass.color[0] = color.r;
+    c.pass.color[1] = color.g;
+    c.pass.color[2] = color.b;
+    c.pass.color[3] = color.a;
+    commands.push_back(c);
+}
+
+void CommandList::setPipeline(const PipelineState& state)
+{
+    Command c;
+    c.type = Type::SetPipeline;
+    c.pipeline = state;
+    commands.push_back(c);
+}
+
+void CommandList::bindTexture(int unit, TextureTarget target, unsigned int texture)
+{
+    Command c;
+    c.type = Type::BindTexture;
+    c.texture.unit = unit;
+    c.texture.target = target;
+    c.texture.texture = texture;
+    commands.push_back(c);
+}
+
+void CommandList::pushUniform(const char* name, UniformType type,
+    const float* data, int floats, int count)
+{
+    Command c;
+    c.type = Type::SetUniform;
+    c.uniform.name = internName(name);
+    c.uniform.type = type;
+    c.uniform.count = count;
+    c.uniform.offset = (unsigned int)uniformData.size();
+    uniformData.insert(uniformData.end(), data, data + floats);
+    commands.push_back(c);
+}
+
+void CommandList::setInt(const char* name, int v)
+{
+    // int 도 float 배열에 비트 그대로 보관
+    float f;
+    memcpy(&f, &v, sizeof(float));
+    pushUniform(name, UniformType::Int, &f, 1, 1);
+}
+
+void CommandList::setFloat(const char* name, float v)
+{
+    pushUniform(name, UniformType::Float, &v, 1, 1);
+}
+
+void CommandList::setVec3(const char* name, const glm::vec3& v)
+{
+    pushUniform(name, UniformType::Vec3, &v[0], 3, 1);
+}
+
+void CommandList::setVec4(const char* name, const glm::vec4& v)
+{
+    pushUniform(name, UniformType::Vec4, &v[0], 4, 1);
+}
+
+void CommandList::setVec4Array(const char* name, const glm::vec4* v, int count)
+{
+    if (count <= 0) return;
+    pushUniform(name, UniformType::Vec4, &v[0][0], 4 * count, count);
+}
+
+void CommandList::setMat4(const char* name, const glm::mat4& m)
+{
+    pushUniform(name, UniformType::Mat4, &m[0][0], 16, 1);
+}
+
+void CommandList::draw(Primitive primitive, unsigned int vao, int first, int count)
+{
+    if (count <= 0) return;
+
+    Command c;
+    c.type = Type::Draw;
+    c.draw.primitive = primitive;
+    c.draw.vao = vao;
+    c.draw.first = first;
+    c.draw.count = count;
+    commands.push_back(c);
+}
+
+void CommandList::drawIndexed(Primitive primitive, unsigned int vao, int indexCount)
+{
+    if (indexCount <= 0) return;
+
+    Command c;
+    c.type = Type::DrawIndexed;
+    c.draw.primitive = primitive;
+    c.draw.vao = vao;
+    c.draw.first = 0;
+    c.draw.count = indexCount;
+    commands.push_back(c);
+}
+
+void CommandList::drawTransient(Primitive primitive, const glm::vec3* points, int count)
+{
+    if (count <= 0) return;
+
+    Command c;
+    c.type = Type::DrawTransient;
+    c.draw.primitive = primitive;
+    c.draw.vao = 0;
+    c.draw.first = (int)vertices.size();
+    c.draw.count = count;
+    vertices.insert(vertices.end(), points, points + count);
+    commands.push_back(c);
+}
+
+// =====================================================
+// CommandRecorder
+// =====================================================
+CommandRecorder::CommandRecorder()
+    : jobFn(nullptr), jobCount(0), nextIndex(0), remaining(0),
+    generation(0), quit(false)
+{
+}
+
+CommandRecorder::~CommandRecorder()
+{
+    stop();
+}
+
+void CommandRecorder::start(int threadCount)
+{
+    if (!workers.empty()) return;
+
+    if (threadCount <= 0)
+        threadCount = std::max(1, (int)std::thread::hardware_concurrency() - 1);
+
+    quit = false;
+    for (int i = 0; i < threadCount; i++)
+        workers.emplace_back(&CommandRecorder::workerLoop, this);
+}
+
+void CommandRecorder::stop()
+{
+    if (workers.empty()) return;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        quit = true;
+    }
+    workCond.notify_all();
+    for (auto& w : workers)
+        w.join();
+    workers.clear();
+}
+
+// 남은 작업 하나 실행 (lock 은 실행하는 동안 풀었다가 다시 잡음)
+bool CommandRecorder::runOne(std::unique_lock<std::mutex>& lock)
+{
+    if (!jobFn || nextIndex >= jobCount)
+        return false;
+
+    int index = nextIndex++;
+    const std::function<void(int)>& fn = *jobFn;
+
+    lock.unlock();
+    fn(index);
+    lock.lock();
+
+    if (--remaining == 0)
+        doneCond.notify_all();
+    return true;
+}
+
+void CommandRecorder::record(std::vector<CommandList>& lists,
+    const std::function<void(int, CommandList&)>& fn)
+{
+    run((int)lists.size(), [&](int i) { fn(i, lists[i]); });
+}
+
+void CommandRecorder::run(int count, const std::function<void(int)>& fn)
+{
+    if (count <= 0) return;
+
+    // 스레드가 없으면 그 자리에서 순서대로 실행
+    if (workers.empty())
+    {
+        for (int i = 0; i < count; i++)
+            fn(i);
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex);
+    jobFn = &fn;
+    jobCount = count;
+    nextIndex = 0;
+    remaining = count;
+    generation++;
+    workCond.notify_all();
+
+    // 호출 스레드도 함께 작업
+    while (runOne(lock)) {}
+
+    doneCond.wait(lock, [this] { return remaining == 0; });
+    jobFn = nullptr;
+    jobCount = 0;
+}
+
+void CommandRecorder::workerLoop()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    unsigned int seen = generation;
+
+    for (;;)
+    {
+        workCond.wait(lock, [&] { return quit || generation != seen; });
+        if (quit) return;
+
+        seen = generation;
+        while (runOne(lock)) {}
+    }
+}
@@ -0,0 +1,226 @@
+﻿#ifndef COMMAND_LIST_H
+#define COMMAND_LIST_H
+
+#include <string>
+#include <vector>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <glm/glm.hpp>
+
+// =====================================================
+// 렌더링 인터페이스 공용 타입 (GL 헤더 없이 사용)
+// =====================================================
+enum class Primitive
+{
+    Triangles,
+    TriangleStrip,
+    Lines,
+    LineStrip,
+    Points
+};
+
+enum class BlendMode
+{
+    Opaque,         // 블렌딩 없음
+    Alpha,          // SRC_ALPHA, ONE_MINUS_SRC_ALPHA
+    Premultiplied,  // ONE, ONE_MINUS_SRC_ALPHA
+    Additive        // ONE, ONE
+};
+
+enum class CullMode
+{
+    None,
+    Back,
+    Front
+};
+
+enum class TextureTarget
+{
+    Texture2D,
+    Texture2DArray
+};
+
+// 파이프라인 = 프로그램 + 고정 기능 상태 묶음
+struct PipelineState
+{
+    unsigned int program;
+    BlendMode blend;
+    CullMode cull;
+    bool depthTest;
+    bool depthWrite;
+};
+
+inline PipelineState makePipeline(unsigned int program,
+    BlendMode blend = BlendMode::Opaque,
+    bool depthTest = true,
+    bool depthWrite = true,
+    CullMode cull = CullMode::None)
+{
+    PipelineState p;
+    p.program = program;
+    p.blend = blend;
+    p.cull = cull;
+    p.depthTest = depthTest;
+    p.depthWrite = depthWrite;
+    return p;
+}
+
+// =====================================================
+// CommandList
+//  - 그리기 작업을 GL 호출 없이 기록만 함 → 작업 스레드에서 병렬로 작성 가능
+//  - GL 스레드의 RenderDevice::submit() 이 순서대로 재생
+//  - uniform 값, 임시 정점(선 궤적 등)은 목록 안의 배열에 복사해 둠
+//  - 목록 하나는 한 스레드만 기록 (서로 다른 목록은 동시에 기록해도 됨)
+// =====================================================
+class CommandList
+{
+public:
+    enum class Type
+    {
+        BeginPass,
+        SetPipeline,
+        BindTexture,
+        SetUniform,
+        Draw,
+        DrawIndexed,
+        DrawTransient
+    };
+
+    enum class UniformType
+    {
+        Int,
+        Float,
+        Vec3,
+        Vec4,
+        Mat4
+    };
+
+    struct PassArgs
+    {
+        unsigned int fbo;
+        int x, y, w, h;
+        bool clearColor, clearDepth;
+        float color[4];
+    };
+
+    struct TextureArgs
+    {
+        int unit;
+        TextureTarget target;
+        unsigned int texture;
+    };
+
+    struct UniformArgs
+    {
+        int name;               // names[] 인덱스
+        UniformType type;
+        int count;              // 배열 원소 수
+        unsigned int offset;    // uniformData[] 시작 위치
+    };
+
+    struct DrawArgs
+    {
+        Primitive primitive;
+        unsigned int vao;       // DrawTransient 는 사용 안 함
+        int first;              // Draw: 첫 정점 / DrawTransient: vertices[] 시작 위치
+        int count;
+    };
+
+    struct Command
+    {
+        Type type;
+        union
+        {
+            PassArgs pass;
+            PipelineState pipeline;
+            TextureArgs texture;
+            UniformArgs uniform;
+            DrawArgs draw;
+        };
+    };
+
+    void reset();   // 다음 프레임 재사용 (메모리는 유지)
+
+    // 패스 시작: 프레임버퍼 + 뷰포트 (+ 선택적 지우기)
+    void beginPass(unsigned int fbo, int x, int y, int w, int h,
+        bool clearColor = false, bool clearDepth = false,
+        const glm::vec4& color = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f));
+
+    void setPipeline(const PipelineState& state);
+    void bindTexture(int unit, TextureTarget target, unsigned int texture);
+
+    // uniform 은 이름으로 기록하고 재생 시 위치를 찾음 (프로그램별 캐시)
+    void setInt(const char* name, int v);
+    void setFloat(const char* name, float v);
+    void setVec3(const char* name, const glm::vec3& v);
+    void setVec4(const char* name, const glm::vec4& v);
+    void setVec4Array(const char* name, const glm::vec4* v, int count);
+    void setMat4(const char* name, const glm::mat4& m);
+
+    void draw(Primitive primitive, unsigned int vao, int first, int count);
+    void drawIndexed(Primitive primitive, unsigned int vao, int indexCount);
+
+    // 위치(vec3)만 있는 임시 정점을 목록에 복사해서 그림
+    //  - 재생 시 모든 목록의 임시 정점을 스트리밍 버퍼 하나로 한 번에 업로드
+    void drawTransient(Primitive primitive, const glm::vec3* points, int count);
+
+    const std::vector<Command>& getCommands() const { return commands; }
+    const std::vector<float>& getUniformData() const { return uniformData; }
+    const std::vector<glm::vec3>& getTransientVertices() const { return vertices; }
+    const std::string& getName(int index) const { return names[index]; }
+
+    bool empty() const { return commands.empty(); }
+
+private:
+    std::vector<Command> commands;
+    std::vector<float> uniformData;
+    std::vector<glm::vec3> vertices;
+    std::vector<std::string> names;
+
+    int internName(const char* name);
+    void pushUniform(const char* name, UniformType type, const float* data, int floats, int count);
+};
+
+// =====================================================
+// CommandRecorder
+//  - 상주 작업 스레드 풀: record(lists, fn) 이 fn(i, lists[i]) 를 나눠 실행하고
+//    모두 끝날 때까지 대기 (GL 호출은 하지 않음)
+//  - run(n, fn) 은 목록 없이 작업 번호만 나눠 줌
+// =====================================================
+class CommandRecorder
+{
+public:
+    CommandRecorder();
+    ~CommandRecorder();
+
+    void start(int threadCount = 0);   // 0 = 하드웨어 스레드 수 - 1
+    void stop();
+
+    void record(std::vector<CommandList>& lists,
+        const std::function<void(int, CommandList&)>& fn);
+
+    // 일반 작업: fn(0) ... fn(count - 1) 을 나눠 실행하고 대기
+    void run(int count, const std::function<void(int)>& fn);
+
+    int getThreadCount() const { return (int)workers.size(); }
+
+private:
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable workCond;
+    std::condition_variable doneCond;
+
+    const std::function<void(int)>* jobFn;
+    int jobCount;
+    int nextIndex;
+    int remaining;
+    unsigned int generation;
+    bool quit;
+
+    void workerLoop();
+    bool runOne(std::unique_lock<std::mutex>& lock);
+};
+
+#endif
@@ -0,0 +1,95 @@
+﻿#include "CookedTexture.h"
+
+#include <GL/glew.h>
+#include <iostream>
+#include <sys/stat.h>
+
+bool CookedTexture::enabled = false;
+
+void CookedTexture::setEnabled(bool on)
+{
+    // BC1 / BC3 는 코어 GL 이 아니라 EXT_texture_compression_s3tc (BC4 = RGTC 는 GL 3.0 코어)
+    enabled = on && GLEW_EXT_texture_compression_s3tc;
+    if (on && !enabled)
+        std::cerr << "[Texture] S3TC not supported: cooked textures disabled\n";
+}
+
+std::shared_ptr<CookedTexture> CookedTexture::openFor(const std::string& sourcePath)
+{
+    if (!enabled) return nullptr;
+
+    std::string path = ctex::pathFor(sourcePath);
+    struct stat cookedStat, sourceStat;
+    if (stat(path.c_str(), &cookedStat) != 0)
+        return nullptr;
+    if (stat(sourcePath.c_str(), &sourceStat) == 0 && sourceStat.st_mtime > cookedStat.st_mtime)
+    {
+        std::cerr << "[Texture] " << path << " is older than its source, ignored\n";
+        return nullptr;
+    }
+
+    std::shared_ptr<CookedTexture> tex(new CookedTexture());
+    if (!tex->map(path))
+        return nullptr;
+    if (!tex->validate())
+    {
+        std::cerr << "[Texture] Invalid cooked texture: " << path << "\n";
+        return nullptr;
+    }
+
+    // 업로드하는 GL 스레드가 페이지 폴트로 멈추지 않게 미리 한 번씩 읽어 둠
+    volatile unsigned char sink = 0;
+    for (size_t i = 0; i < tex->fileSize; i += 4096)
+        sink += tex->base[i];
+    (void)sink;
+
+    return tex;
+}
+
+bool CookedTexture::validate() const
+{
+    if (fileSize < sizeof(ctex::FileHeader)) return false;
+    if (header->magic != ctex::MAGIC || header->version != ctex::VERSION) return false;
+
+    ctex::Format f = (ctex::Format)header->format;
+    if (f != ctex::Format::BC1 && f != ctex::Format::BC3 && f != ctex::Format::BC4) return false;
+    if (header->levels < 1 || header->levels > (uint32_t)ctex::MAX_LEVELS) return false;
+    if (sizeof(ctex::FileHeader) + sizeof(ctex::LevelEntry) * header->levels > fileSize) return false;
+
+    for (uint32_t i = 0; i < header->levels; i++)
+    {
+        const ctex::LevelEntry& e = levelTable[i];
+        if (e.size != ctex::levelBytes(f, e.width, e.height)) return false;
+        if (e.offset + e.size > fileSize) return false;
+    }
+    return true;
+}
+
+bool CookedTexture::sameLayout(const CookedTexture& other) const
+{
+    return header->format == other.header->format
+        && header->width == other.header->width
+        && header->height == other.header->height
+        && header->levels == other.header->levels;
+}
+
+unsigned int CookedTexture::getGLFormat() const
+{
+    switch (getFormat())
+    {
+    case ctex::Format::BC1: return GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+    case ctex::Format::BC3: return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+    case ctex::Format::BC4: return GL_COMPRESSED_RED_RGTC1;
+    }
+    return 0;
+}
+
+bool CookedTexture::map(const std::string& path)
+{
+    if (!file.open(path)) return false;
+    base = file.getData();
+    fileSize = file.getSize();
+    header = (const ctex::FileHeader*)base;
+    levelTable = (const ctex::LevelEntry*)(base + sizeof(ctex::FileHeader));
+    return true;
+}
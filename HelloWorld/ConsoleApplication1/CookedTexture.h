@@ -0,0 +1,117 @@
+﻿#ifndef COOKED_TEXTURE_H
+#define COOKED_TEXTURE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "MappedFile.h"
+
+// =====================================================
+// 쿠킹된 텍스처 컨테이너 (.ctex)
+//  - TextureCooker 가 원본 옆에 만듦: textures/2k_mars.jpg -> textures/2k_mars.ctex
+//  - 블록 압축(BC1 / BC3 / BC4) + 1x1 까지의 모든 밉 레벨
+//  - [FileHeader][LevelEntry x levels][레벨 0 블록][레벨 1 블록]...
+//    레벨 데이터는 16 바이트 정렬, 위 -> 아래 행 순서 (원본 이미지와 같음)
+//  - 정수는 모두 little endian
+// =====================================================
+namespace ctex
+{
+    const uint32_t MAGIC = 0x58455443u;   // "CTEX"
+    const uint32_t VERSION = 1;
+    const int MAX_LEVELS = 16;
+
+    enum class Format : uint32_t
+    {
+        BC1 = 1,    // RGB (DXT1), 블록당 8 바이트
+        BC3 = 3,    // RGBA (DXT5), 블록당 16 바이트
+        BC4 = 4     // 단일 채널 (RGTC1, 셰이더에서는 .r), 블록당 8 바이트
+    };
+
+    struct FileHeader
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t format;    // Format
+        uint32_t width;
+        uint32_t height;
+        uint32_t levels;
+        uint32_t reserved[2];
+    };
+
+    struct LevelEntry
+    {
+        uint32_t width;
+        uint32_t height;
+        uint64_t offset;    // 파일 처음부터
+        uint64_t size;
+    };
+
+    inline size_t blockBytes(Format f) { return f == Format::BC3 ? 16 : 8; }
+
+    inline size_t levelBytes(Format f, uint32_t w, uint32_t h)
+    {
+        return (size_t)((w + 3) / 4) * (size_t)((h + 3) / 4) * blockBytes(f);
+    }
+
+    // 원본 경로의 확장자를 .ctex 로 바꾼 경로
+    inline std::string pathFor(const std::string& sourcePath)
+    {
+        size_t dot = sourcePath.find_last_of('.');
+        size_t slash = sourcePath.find_last_of("/\\");
+        if (dot == std::string::npos || (slash != std::string::npos && dot < slash))
+            return sourcePath + ".ctex";
+        return sourcePath.substr(0, dot) + ".ctex";
+    }
+}
+
+// =====================================================
+// CookedTexture
+//  - .ctex 파일을 읽기 전용으로 맵핑 (mmap / MapViewOfFile)
+//    레벨 데이터는 복사 없이 맵핑된 메모리에서 바로 glCompressedTexSubImage 로 올림
+//  - open() 은 GL 호출이 없어 작업 스레드에서 불러도 됨 (페이지도 미리 읽어 둠)
+//  - 원본 이미지가 .ctex 보다 새로우면 쓰지 않음 (다시 쿠킹 필요)
+// =====================================================
+class CookedTexture
+{
+public:
+    // 원본 경로에 대응하는 .ctex 를 열기 (없거나 오래됐거나 잘못된 파일이면 nullptr)
+    static std::shared_ptr<CookedTexture> openFor(const std::string& sourcePath);
+
+    // GL 스레드에서 한 번: S3TC 지원 여부 확인 후 사용 여부 결정 (끄면 openFor 가 항상 nullptr)
+    static void setEnabled(bool enabled);
+    static bool isEnabled() { return enabled; }
+
+    ctex::Format getFormat() const { return (ctex::Format)header->format; }
+    unsigned int getGLFormat() const;   // GL_COMPRESSED_* 내부 형식
+    int getWidth() const { return (int)header->width; }
+    int getHeight() const { return (int)header->height; }
+    int getLevels() const { return (int)header->levels; }
+
+    int levelWidth(int level) const { return (int)levelTable[level].width; }
+    int levelHeight(int level) const { return (int)levelTable[level].height; }
+    size_t levelSize(int level) const { return (size_t)levelTable[level].size; }
+    const unsigned char* levelData(int level) const { return base + levelTable[level].offset; }
+
+    // 두 파일이 같은 배열 텍스처의 레이어가 될 수 있는지 (형식 / 크기 / 레벨 수)
+    bool sameLayout(const CookedTexture& other) const;
+
+private:
+    CookedTexture() {}
+    CookedTexture(const CookedTexture&) = delete;
+    CookedTexture& operator=(const CookedTexture&) = delete;
+
+    MappedFile file;
+    const unsigned char* base = nullptr;
+    size_t fileSize = 0;
+    const ctex::FileHeader* header = nullptr;
+    const ctex::LevelEntry* levelTable = nullptr;
+
+    bool map(const std::string& path);
+    bool validate() const;
+
+    static bool enabled;
+};
+
+#endif
@@ -0,0 +1,55 @@
+﻿#include "EclipseShadows.h"
+#include "Shader.h"
+
+ShadowCasters::ShadowCasters()
+    : sphereCount(0), ringCount(0)
+{
+}
+
+void ShadowCasters::clear()
+{
+    sphereCount = 0;
+    ringCount = 0;
+}
+
+void ShadowCasters::addSphere(const glm::vec3& center, float radius)
+{
+    if (sphereCount >= MAX_SPHERES) return;
+    spheres[sphereCount++] = glm::vec4(center, radius);
+}
+
+void ShadowCasters::addRing(const glm::mat4& planetModel,
+    float innerR,
+    float outerR,
+    float alpha,
+    int layer)
+{
+    if (ringCount >= MAX_RINGS || layer < 0) return;
+
+    // 고리는 모델 공간 XZ 평면 → 법선은 모델의 Y 축
+    glm::vec3 center = glm::vec3(planetModel[3]);
+    glm::vec3 normal = glm::normalize(glm::vec3(planetModel[1]));
+    float scale = glm::length(glm::vec3(planetModel[0]));
+
+    ringCenter[ringCount] = glm::vec4(center, innerR * scale);
+    ringNormal[ringCount] = glm::vec4(normal, outerR * scale);
+    ringInfo[ringCount] = glm::vec4(alpha, (float)layer, 0.0f, 0.0f);
+    ringCount++;
+}
+
+void ShadowCasters::apply(const Shader& shader) const
+{
+    shader.setInt("occluderCount", sphereCount);
+    shader.setVec4Array("occluders", spheres, sphereCount);
+
+    shader.setInt("ringCount", ringCount);
+    shader.setVec4Array("ringCenter", ringCenter, ringCount);
+    shader.setVec4Array("ringNormal", ringNormal, ringCount);
+    shader.setVec4Array("ringInfo", ringInfo, ringCount);
+}
+
+void ShadowCasters::applyEmpty(const Shader& shader)
+{
+    shader.setInt("occluderCount", 0);
+    shader.setInt("ringCount", 0);
+}
@@ -0,0 +1,107 @@
+﻿#ifndef ECLIPSE_SHADOWS_H
+#define ECLIPSE_SHADOWS_H
+
+#include <glm/glm.hpp>
+
+class Shader;
+
+// -----------------------------------------------------
+// 프래그먼트 셰이더에 붙여 쓰는 GLSL 조각
+//  float eclipseVisibility(vec3 P, vec3 lightPos) : 0(완전히 가림) ~ 1(보임)
+//  - 구: 태양 원반과 가림체 원반의 겹침 비율 (작은 각 근사)
+//  - 고리: 태양 방향 광선과 고리 평면의 교점에서 고리 텍스처 알파 사용
+//          (반영 폭만큼 밉 레벨을 올려 경계를 흐림)
+// -----------------------------------------------------
+#define ECLIPSE_SHADOW_GLSL \
+    "uniform vec4 occluders[8];\n" \
+    "uniform int occluderCount;\n" \
+    "uniform vec4 ringCenter[2];\n" \
+    "uniform vec4 ringNormal[2];\n" \
+    "uniform vec4 ringInfo[2];\n" \
+    "uniform int ringCount;\n" \
+    "uniform sampler2DArray ringShadowTex;\n" \
+    "uniform float sunRadius;\n" \
+    "float eclipseVisibility(vec3 P, vec3 L){\n" \
+    "  vec3 toL = L - P;\n" \
+    "  float dL = length(toL);\n" \
+    "  vec3 l = toL / dL;\n" \
+    "  float rs = sunRadius / dL;\n" \
+    "  float vis = 1.0;\n" \
+    "  for(int i = 0; i < occluderCount; i++){\n" \
+    "    vec3 toC = occluders[i].xyz - P;\n" \
+    "    float R = occluders[i].w;\n" \
+    "    float dC = length(toC);\n" \
+    "    if(dC < R * 1.01 || dC > dL || dot(toC, l) <= 0.0) continue;\n" \
+    "    float th = length(cross(toC, l)) / dC;\n" \
+    "    float ro = R / dC;\n" \
+    "    float f = clamp((rs + ro - th) / (2.0 * min(rs, ro)), 0.0, 1.0);\n" \
+    "    vis *= 1.0 - smoothstep(0.0, 1.0, f) * min(1.0, (ro * ro) / (rs * rs));\n" \
+    "  }\n" \
+    "  for(int i = 0; i < ringCount; i++){\n" \
+    "    vec3 N = ringNormal[i].xyz;\n" \
+    "    float denom = dot(l, N);\n" \
+    "    if(abs(denom) < 1e-4) continue;\n" \
+    "    float t = dot(ringCenter[i].xyz - P, N) / denom;\n" \
+    "    if(t <= 0.0 || t >= dL) continue;\n" \
+    "    float r = length(P + l * t - ringCenter[i].xyz);\n" \
+    "    float inner = ringCenter[i].w;\n" \
+    "    float width = ringNormal[i].w - inner;\n" \
+    "    if(r < inner || r > inner + width) continue;\n" \
+    "    float blur = 2.0 * t * rs / width * float(textureSize(ringShadowTex, 0).x);\n" \
+    "    float a = textureLod(ringShadowTex, vec3((r - inner) / width, 0.5, ringInfo[i].y),\n" \
+    "                         log2(max(blur, 1.0))).a;\n" \
+    "    vis *= 1.0 - a * ringInfo[i].x;\n" \
+    "  }\n" \
+    "  return vis;\n" \
+    "}\n"
+
+// =====================================================
+// ShadowCasters
+//  - 일식 / 고리 그림자를 해석적으로 계산하기 위한 가림체 목록
+//  - 구(행성, 위성)와 고리(annulus)를 uniform 배열로 셰이더에 전달
+//  - 프래그먼트는 태양 방향으로의 광선이 가림체에 얼마나 가려지는지
+//    태양의 겉보기 크기(반영)를 고려해 계산 (반영 = penumbra)
+//  - 섀도우 맵 / 추가 렌더 패스 없음
+// =====================================================
+class ShadowCasters
+{
+public:
+    static const int MAX_SPHERES = 8;   // ECLIPSE_SHADOW_GLSL 배열 크기와 동일
+    static const int MAX_RINGS = 2;
+
+    ShadowCasters();
+
+    void clear();
+
+    // 구 가림체 (월드 좌표 중심, 월드 반지름)
+    void addSphere(const glm::vec3& center, float radius);
+
+    // 고리 가림체: 행성 모델 행렬 기준 내경/외경 (RingRenderer 와 같은 값)
+    void addRing(const glm::mat4& planetModel,
+        float innerR,
+        float outerR,
+        float alpha,
+        int layer);
+
+    int getSphereCount() const { return sphereCount; }
+    int getRingCount() const { return ringCount; }
+
+    // uniform 업로드
+    //  - occluders[], occluderCount
+    //  - ringCenter[], ringNormal[], ringInfo[], ringCount
+    void apply(const Shader& shader) const;
+
+    // 가림체가 하나도 없다고 알림 (태양 등)
+    static void applyEmpty(const Shader& shader);
+
+private:
+    glm::vec4 spheres[MAX_SPHERES];     // xyz = 중심, w = 반지름
+    int sphereCount;
+
+    glm::vec4 ringCenter[MAX_RINGS];    // xyz = 중심, w = 내경
+    glm::vec4 ringNormal[MAX_RINGS];    // xyz = 법선, w = 외경
+    glm::vec4 ringInfo[MAX_RINGS];      // x = 투명도, y = 텍스처 레이어
+    int ringCount;
+};
+
+#endif
@@ -0,0 +1,286 @@
+﻿#ifdef _WIN32
+#define _CRT_SECURE_NO_WARNINGS // fopen 경고 억제 (stb_image_write 와 동일)
+#endif
+
+#include "FrameCapture.h"
+
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include "stb_image_write.h"
+
+#include <GL/glew.h>
+#include <iostream>
+#include <cstring>
+
+#ifdef _WIN32
+#include <direct.h>
+#define CAPTURE_MKDIR(path) _mkdir(path)
+#define CAPTURE_POPEN(cmd) _popen(cmd, "wb")
+#define CAPTURE_PCLOSE(fp) _pclose(fp)
+#else
+#include <sys/stat.h>
+#define CAPTURE_MKDIR(path) mkdir(path, 0755)
+#define CAPTURE_POPEN(cmd) popen(cmd, "w")
+#define CAPTURE_PCLOSE(fp) pclose(fp)
+#endif
+
+FrameCapture::FrameCapture()
+    : recording(false), width(0), height(0), frameBytes(0),
+    nextSlot(0), frameCounter(0), quit(false), pipe(nullptr),
+    framesWritten(0), framesDropped(0)
+{
+}
+
+FrameCapture::~FrameCapture()
+{
+    // GL 자원 정리는 컨텍스트가 살아 있을 때 stop()으로 해야 함
+    if (writer.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            quit = true;
+        }
+        queueCond.notify_all();
+        writer.join();
+    }
+}
+
+bool FrameCapture::start(const CaptureOptions& opts, int w, int h)
+{
+    if (recording) return true;
+
+    options = opts;
+    width = w;
+    height = h;
+    frameBytes = (size_t)w * (size_t)h * 4;
+
+    if (options.format == CaptureFormat::Pipe)
+    {
+        pipe = CAPTURE_POPEN(options.pipeCommand.c_str());
+        if (!pipe)
+        {
+            std::cerr << "[Capture] Failed to start encoder: " << options.pipeCommand << "\n";
+            return false;
+        }
+    }
+    else
+    {
+        CAPTURE_MKDIR(options.outputDir.c_str()); // 이미 있으면 실패해도 무관
+    }
+
+    if (options.pboRingSize < 2) options.pboRingSize = 2;
+    if (options.maxQueuedFrames < 1) options.maxQueuedFrames = 1;
+
+    // 리드백용 PBO 링
+    slots.clear();
+    slots.resize(options.pboRingSize);
+    for (auto& s : slots)
+    {
+        s.pbo = GpuBuffer("capture PBO");
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, s.pbo.get());
+        glBufferData(GL_PIXEL_PACK_BUFFER, frameBytes, nullptr, GL_STREAM_READ);
+        s.pbo.setBytes(frameBytes);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    nextSlot = 0;
+    frameCounter = 0;
+    framesWritten = 0;
+    framesDropped = 0;
+    quit = false;
+
+    writer = std::thread(&FrameCapture::writerLoop, this);
+    recording = true;
+
+    std::cout << "[Capture] Recording " << width << "x" << height << " → "
+        << (options.format == CaptureFormat::Pipe ? options.pipeCommand : options.outputDir)
+        << "\n";
+    return true;
+}
+
+void FrameCapture::stop()
+{
+    if (!recording) return;
+
+    // 남은 PBO 를 오래된 순서대로 회수
+    for (int i = 0; i < (int)slots.size(); i++)
+    {
+        Slot& s = slots[(nextSlot + i) % slots.size()];
+        if (s.frameNumber >= 0)
+            retire(s, true);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        quit = true;
+    }
+    queueCond.notify_all();
+    writer.join();
+
+    slots.clear(); // PBO 삭제
+
+    if (pipe)
+    {
+        CAPTURE_PCLOSE(pipe);
+        pipe = nullptr;
+    }
+
+    freeBuffers.clear();
+    recording = false;
+
+    std::cout << "[Capture] Stopped: " << framesWritten.load() << " frames written, "
+        << framesDropped.load() << " dropped\n";
+}
+
+void FrameCapture::captureFrame(unsigned int fbo)
+{
+    if (!recording) return;
+
+    // 1) 이미 완료된 이전 리드백을 오래된 순서대로 회수 (대기 없음)
+    for (int i = 0; i < (int)slots.size(); i++)
+    {
+        Slot& s = slots[(nextSlot + i) % slots.size()];
+        if (s.frameNumber < 0) continue;
+
+        GLenum r = glClientWaitSync((GLsync)s.fence, 0, 0);
+        if (r != GL_ALREADY_SIGNALED && r != GL_CONDITION_SATISFIED)
+            break;
+        retire(s, false);
+    }
+
+    // 2) 이번에 쓸 슬롯이 아직 사용 중이면 (N 프레임 전 것) 완료될 때까지 회수
+    Slot& slot = slots[nextSlot];
+    if (slot.frameNumber >= 0)
+        retire(slot, true);
+
+    // 3) 비동기 리드백: 데이터는 PBO 로 복사되고 glReadPixels 는 바로 반환
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, fbo);
+    glReadBuffer(fbo == 0 ? GL_BACK : GL_COLOR_ATTACHMENT0);
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.pbo.get());
+    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    slot.frameNumber = frameCounter++;
+
+    nextSlot = (nextSlot + 1) % (int)slots.size();
+}
+
+void FrameCapture::retire(Slot& slot, bool wait)
+{
+    GLsync fence = (GLsync)slot.fence;
+
+    if (wait)
+    {
+        // 1초 제한으로 대기 (정상이라면 N 프레임 전에 이미 끝난 상태)
+        glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000ull);
+    }
+    glDeleteSync(fence);
+    slot.fence = nullptr;
+
+    int frameNumber = slot.frameNumber;
+    slot.frameNumber = -1;
+
+    // 기록 스레드가 밀려 있으면 이번 프레임은 버림 (렌더링은 절대 기다리지 않음)
+    std::vector<unsigned char> buffer;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        if ((int)queue.size() >= options.maxQueuedFrames)
+        {
+            framesDropped++;
+            return;
+        }
+        if (!freeBuffers.empty())
+        {
+            buffer.swap(freeBuffers.back());
+            freeBuffers.pop_back();
+        }
+    }
+    buffer.resize(frameBytes);
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.pbo.get());
+    const unsigned char* src = (const unsigned char*)glMapBufferRange(
+        GL_PIXEL_PACK_BUFFER, 0, frameBytes, GL_MAP_READ_BIT);
+
+    if (src)
+    {
+        // GL 은 아래→위 순서이므로 행을 뒤집어 위→아래로 복사
+        size_t rowBytes = (size_t)width * 4;
+        for (int y = 0; y < height; y++)
+        {
+            memcpy(buffer.data() + (size_t)(height - 1 - y) * rowBytes,
+                src + (size_t)y * rowBytes, rowBytes);
+        }
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    if (!src)
+    {
+        std::cerr << "[Capture] Failed to map PBO for frame " << frameNumber << "\n";
+        framesDropped++;
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        Frame f;
+        f.frameNumber = frameNumber;
+        f.pixels.swap(buffer);
+        queue.push_back(std::move(f));
+    }
+    queueCond.notify_one();
+}
+
+void FrameCapture::writerLoop()
+{
+    for (;;)
+    {
+        Frame f;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            queueCond.wait(lock, [this] { return quit || !queue.empty(); });
+
+            if (queue.empty())
+                return; // quit + 대기열 비었음
+
+            f = std::move(queue.front());
+            queue.pop_front();
+        }
+
+        if (writeFrame(f))
+            framesWritten++;
+        else
+            framesDropped++;
+
+        // 버퍼 재사용
+        std::lock_guard<std::mutex> lock(queueMutex);
+        freeBuffers.push_back(std::move(f.pixels));
+    }
+}
+
+bool FrameCapture::writeFrame(const Frame& f)
+{
+    if (options.format == CaptureFormat::Pipe)
+    {
+        return fwrite(f.pixels.data(), 1, f.pixels.size(), pipe) == f.pixels.size();
+    }
+
+    char name[64];
+    snprintf(name, sizeof(name), "/frame_%06d.%s", f.frameNumber,
+        options.format == CaptureFormat::Png ? "png" : "rgba");
+    std::string path = options.outputDir + name;
+
+    if (options.format == CaptureFormat::Png)
+    {
+        return stbi_write_png(path.c_str(), width, height, 4,
+            f.pixels.data(), width * 4) != 0;
+    }
+
+    FILE* fp = fopen(path.c_str(), "wb");
+    if (!fp) return false;
+    bool ok = fwrite(f.pixels.data(), 1, f.pixels.size(), fp) == f.pixels.size();
+    fclose(fp);
+    return ok;
+}
@@ -0,0 +1,102 @@
+﻿#ifndef FRAME_CAPTURE_H
+#define FRAME_CAPTURE_H
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <cstdio>
+
+#include "GpuResource.h"
+
+// =====================================================
+// 캡처 출력 방식
+//  - Png  : <dir>/frame_000000.png  (stb_image_write)
+//  - Raw  : <dir>/frame_000000.rgba (RGBA8, 위→아래 순서)
+//  - Pipe : 외부 인코더 표준입력으로 RGBA8 원시 프레임 전달
+//           예) ffmpeg -f rawvideo -pix_fmt rgba -s 1280x720 -r 60 -i - out.mp4
+// =====================================================
+enum class CaptureFormat
+{
+    Png,
+    Raw,
+    Pipe
+};
+
+struct CaptureOptions
+{
+    bool enabled = false;              // 시작과 동시에 녹화
+    CaptureFormat format = CaptureFormat::Png;
+    std::string outputDir = "capture"; // Png / Raw 저장 폴더
+    std::string pipeCommand;           // Pipe 모드에서 실행할 명령
+    int pboRingSize = 3;               // 리드백 PBO 개수 (= 맵핑 지연 프레임 수)
+    int maxQueuedFrames = 8;           // 기록 스레드 대기열 최대 길이 (초과 시 프레임 드롭)
+};
+
+// =====================================================
+// FrameCapture
+//  - glReadPixels 를 PBO 링으로 비동기 수행하고 fence 로 완료 확인
+//  - N 프레임 뒤에 맵핑해서 복사한 뒤 기록 스레드로 넘김
+//  - 렌더링 스레드는 디스크 I/O 나 GPU 완료를 기다리지 않음
+// =====================================================
+class FrameCapture
+{
+public:
+    FrameCapture();
+    ~FrameCapture();
+
+    bool start(const CaptureOptions& opts, int width, int height);
+    void stop(); // 남은 PBO 를 모두 회수하고 기록 스레드 종료
+
+    bool isRecording() const { return recording; }
+
+    // 합성이 끝난 프레임을 fbo(0 = 기본 프레임버퍼)에서 읽어 들임
+    void captureFrame(unsigned int fbo);
+
+    int getFramesWritten() const { return framesWritten.load(); }
+    int getFramesDropped() const { return framesDropped.load(); }
+
+private:
+    struct Slot
+    {
+        GpuBuffer pbo;
+        void* fence = nullptr;  // GLsync
+        int frameNumber = -1;   // -1 = 비어 있음
+    };
+
+    struct Frame
+    {
+        int frameNumber;
+        std::vector<unsigned char> pixels;
+    };
+
+    CaptureOptions options;
+    bool recording;
+    int width, height;
+    size_t frameBytes;
+
+    std::vector<Slot> slots;
+    int nextSlot;
+    int frameCounter;
+
+    // 기록 스레드
+    std::thread writer;
+    std::mutex queueMutex;
+    std::condition_variable queueCond;
+    std::deque<Frame> queue;
+    std::vector<std::vector<unsigned char>> freeBuffers; // 재사용 버퍼 풀
+    bool quit;
+    FILE* pipe;
+
+    std::atomic<int> framesWritten;
+    std::atomic<int> framesDropped;
+
+    void retire(Slot& slot, bool wait); // fence 확인 → 맵핑 → 대기열로 전달
+    void writerLoop();
+    bool writeFrame(const Frame& f);
+};
+
+#endif
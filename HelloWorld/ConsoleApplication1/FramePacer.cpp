@@ -0,0 +1,134 @@
+﻿#include "FramePacer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <thread>
+
+static double nowMs()
+{
+    using namespace std::chrono;
+    return duration<double, std::milli>(steady_clock::now().time_since_epoch()).count();
+}
+
+FramePacer::FramePacer()
+    : periodMs(0.0), lastPresentMs(0.0), inputMs(0.0), workEstimateMs(0.0), synced(false),
+    latencyNext(0), intervalNext(0), frames(0), intervals(0), missed(0),
+    intervalSum(0.0), intervalSqSum(0.0), latencySum(0.0)
+{
+}
+
+void FramePacer::setTargetHz(double hz)
+{
+    periodMs = (hz > 0.0) ? 1000.0 / hz : 0.0;
+    synced = false;
+}
+
+void FramePacer::waitForInputSlot()
+{
+    if (!isEnabled() || !synced)
+        return;
+
+    double deadline = lastPresentMs + periodMs - (workEstimateMs + MARGIN_MS);
+
+    for (;;)
+    {
+        double remaining = deadline - nowMs();
+        if (remaining <= 0.0)
+            break;
+        if (remaining > SPIN_MS)
+            std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(remaining - SPIN_MS));
+        else
+            std::this_thread::yield();
+    }
+}
+
+void FramePacer::markInputSampled()
+{
+    inputMs = nowMs();
+}
+
+void FramePacer::markRenderDone()
+{
+    if (!isEnabled())
+        return;
+
+    double work = nowMs() - inputMs;
+
+    // 예측은 느려질 때 바로 따라가고 빨라질 때는 천천히 (마감을 놓치지 않는 쪽으로)
+    if (workEstimateMs <= 0.0 || work > workEstimateMs)
+        workEstimateMs = work;
+    else
+        workEstimateMs += 0.05 * (work - workEstimateMs);
+    workEstimateMs = std::min(workEstimateMs, periodMs);
+}
+
+void FramePacer::markPresented()
+{
+    if (!isEnabled())
+        return;
+
+    double now = nowMs();
+    double latency = now - inputMs;   // 수직 동기 대기 포함
+
+    push(latencyMs, latencyNext, latency);
+    latencySum += latency;
+    frames++;
+
+    if (synced)
+    {
+        double interval = now - lastPresentMs;
+        push(intervalMs, intervalNext, interval);
+        intervalSum += interval;
+        intervalSqSum += interval * interval;
+        intervals++;
+        if (interval > 1.5 * periodMs)
+            missed++;
+    }
+
+    lastPresentMs = now;
+    synced = true;
+}
+
+void FramePacer::push(std::vector<double>& ring, int& next, double v)
+{
+    if ((int)ring.size() < SAMPLE_RING)
+    {
+        ring.push_back(v);
+        return;
+    }
+    ring[next] = v;
+    next = (next + 1) % SAMPLE_RING;
+}
+
+// 정렬된 표본에서 백분위 값 추출
+static double percentile(std::vector<double> samples, double p)
+{
+    if (samples.empty()) return 0.0;
+    std::sort(samples.begin(), samples.end());
+    size_t idx = (size_t)(p * (double)(samples.size() - 1) + 0.5);
+    return samples[std::min(idx, samples.size() - 1)];
+}
+
+void FramePacer::report(std::ostream& os) const
+{
+    if (!isEnabled() || frames == 0)
+        return;
+
+    size_t n = intervalMs.size();
+    double mean = intervals > 0 ? intervalSum / intervals : 0.0;
+    double var = intervals > 0 ? intervalSqSum / intervals - mean * mean : 0.0;
+
+    std::vector<double> deviation(n);
+    for (size_t i = 0; i < n; i++)
+        deviation[i] = std::fabs(intervalMs[i] - periodMs);
+
+    os << std::fixed << std::setprecision(2);
+    os << "[Pacing] target " << getTargetHz() << " Hz (" << periodMs << " ms), "
+        << frames << " frames, " << missed << " missed\n";
+    os << "  frame interval avg " << mean << " ms, jitter sd " << std::sqrt(std::max(var, 0.0))
+        << " ms, p99 |error| " << percentile(deviation, 0.99) << " ms\n";
+    os << "  input -> present avg " << latencySum / frames << " ms, p50 "
+        << percentile(latencyMs, 0.50) << " ms, p95 " << percentile(latencyMs, 0.95) << " ms\n";
+}
@@ -0,0 +1,59 @@
+﻿#ifndef FRAME_PACER_H
+#define FRAME_PACER_H
+
+#include <vector>
+#include <ostream>
+
+// =====================================================
+// FramePacer
+//  - 목표 주사율(--fps 또는 모니터 주사율)에 맞춰 프레임 간격을 고르게 유지
+//  - 다음 표시 시점에서 "예상 작업 시간 + 여유"만큼 앞당긴 시점까지 잠든 뒤
+//    입력을 읽게 해서, 입력 → 표시 지연을 한 프레임 미만으로 줄임
+//    (프레임 시작에 입력을 읽고 드라이버 큐에 여러 프레임이 쌓이던 방식 대체)
+//  - 대기: 남은 시간이 길면 sleep, 마지막 SPIN_MS 는 yield 로 정밀하게
+//  - 통계: 입력 → 표시 지연, 표시 간격 흔들림(표준편차 / 목표 대비 p99 오차)
+//  - GL 호출 없음: 렌더 완료 / 표시 완료 시점(glFinish 이후)은 호출하는 쪽이 알려 줌
+//    작업 시간 예측은 렌더 완료까지만 씀 (수직 동기 대기가 섞이면 예측이 주기까지 올라가
+//    대기 없이 바로 입력을 읽게 됨)
+// =====================================================
+class FramePacer
+{
+public:
+    FramePacer();
+
+    void setTargetHz(double hz);            // <= 0 이면 끔
+    bool isEnabled() const { return periodMs > 0.0; }
+    double getTargetHz() const { return periodMs > 0.0 ? 1000.0 / periodMs : 0.0; }
+
+    // 입력을 읽기 직전에 호출: 표시 예정 시점 - 예상 작업 시간까지 대기
+    void waitForInputSlot();
+    void markInputSampled();                // 입력을 읽은 시점
+    void markRenderDone();                  // 렌더 완료 시점 (스왑 전 glFinish 직후)
+    void markPresented();                   // 표시 완료 시점 (스왑 + glFinish 직후)
+
+    // 프레임을 건너뛰었거나 오래 기다린 뒤: 다음 프레임을 지금 기준으로 다시 맞춤
+    void resync() { synced = false; }
+
+    void report(std::ostream& os) const;
+
+private:
+    static const int SAMPLE_RING = 4096;    // 백분위 계산용 최근 표본 수
+    static constexpr double SPIN_MS = 2.0;  // 마지막 구간은 잠들지 않고 yield
+    static constexpr double MARGIN_MS = 1.5;// 작업 시간 예측 오차 여유
+
+    double periodMs;
+    double lastPresentMs;
+    double inputMs;
+    double workEstimateMs;                  // 입력 → 렌더 완료 시간 예측 (늘 때는 빠르게, 줄 때는 천천히)
+    bool synced;
+
+    std::vector<double> latencyMs;          // 입력 → 표시
+    std::vector<double> intervalMs;         // 표시 → 표시
+    int latencyNext, intervalNext;
+    long long frames, intervals, missed;    // intervals: 재동기 뒤 첫 프레임은 빠짐
+    double intervalSum, intervalSqSum, latencySum;
+
+    static void push(std::vector<double>& ring, int& next, double v);
+};
+
+#endif
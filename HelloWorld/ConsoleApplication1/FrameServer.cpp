@@ -0,0 +1,517 @@
+﻿#include "FrameServer.h"
+#include "FrameServerProtocol.h"
+
+#include <GL/glew.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <sstream>
+
+#ifndef _WIN32
+#include <cerrno>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+using frameserver::RingHeader;
+using frameserver::SlotHeader;
+
+static double nowMs()
+{
+    using namespace std::chrono;
+    return duration<double, std::milli>(steady_clock::now().time_since_epoch()).count();
+}
+
+FrameServer::FrameServer()
+    : running(false), width(0), height(0), frameBytes(0),
+    listenFd(-1), clientFd(-1), ring(nullptr), ringBytes(0), nextShmSlot(0),
+    nextReadback(0), nextSeq(1), currentTag(0), streamRemaining(0),
+    framesPublished(0), renderRequests(0), streamFrames(0),
+    commands(0), badCommands(0), clientsServed(0), readerSkips(0),
+    readbackWaitMs(0.0)
+{
+}
+
+FrameServer::~FrameServer()
+{
+    // GL 자원 정리는 컨텍스트가 살아 있을 때 stop()으로 해야 함
+}
+
+void FrameServer::report(std::ostream& os) const
+{
+    os << std::fixed << std::setprecision(3);
+    os << "[FrameServer] " << framesPublished << " frames published ("
+        << renderRequests << " render, " << streamFrames << " stream), "
+        << commands << " commands (" << badCommands << " rejected), "
+        << clientsServed << " clients, " << readerSkips << " slots skipped while read, "
+        << "readback wait avg " << (framesPublished > 0 ? readbackWaitMs / framesPublished : 0.0)
+        << " ms\n";
+}
+
+#ifndef _WIN32
+
+static uint64_t monotonicNs()
+{
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+bool FrameServer::start(const std::string& path, int w, int h)
+{
+    if (running) return true;
+
+    width = w;
+    height = h;
+    frameBytes = (size_t)w * (size_t)h * 4;
+
+    // 1) 명령 소켓
+    sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (path.empty() || path.size() >= sizeof(addr.sun_path))
+    {
+        std::cerr << "[FrameServer] Invalid socket path: " << path << "\n";
+        return false;
+    }
+    memcpy(addr.sun_path, path.c_str(), path.size());
+
+    listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listenFd < 0)
+    {
+        std::cerr << "[FrameServer] socket() failed: " << strerror(errno) << "\n";
+        return false;
+    }
+    unlink(path.c_str()); // 지난 실행이 남긴 소켓 파일
+    if (bind(listenFd, (sockaddr*)&addr, sizeof(addr)) != 0 || listen(listenFd, 1) != 0)
+    {
+        std::cerr << "[FrameServer] Failed to listen on " << path << ": " << strerror(errno) << "\n";
+        close(listenFd);
+        listenFd = -1;
+        return false;
+    }
+    socketPath = path;
+
+    // 2) 프레임 슬롯 링 (공유 메모리)
+    shmName = "/solarsys_frames_" + std::to_string((long long)getpid());
+    ringBytes = (size_t)frameserver::ringDataOffset() + frameBytes * SHM_SLOTS;
+
+    int fd = shm_open(shmName.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    void* mem = MAP_FAILED;
+    if (fd >= 0)
+    {
+        if (ftruncate(fd, (off_t)ringBytes) == 0)
+            mem = mmap(nullptr, ringBytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+    }
+    if (mem == MAP_FAILED)
+    {
+        std::cerr << "[FrameServer] Failed to create shared memory " << shmName
+            << ": " << strerror(errno) << "\n";
+        if (fd >= 0) shm_unlink(shmName.c_str());
+        close(listenFd);
+        listenFd = -1;
+        unlink(socketPath.c_str());
+        return false;
+    }
+
+    ring = new (mem) RingHeader();
+    ring->magic = frameserver::MAGIC;
+    ring->version = frameserver::VERSION;
+    ring->width = (uint32_t)w;
+    ring->height = (uint32_t)h;
+    ring->slotCount = SHM_SLOTS;
+    ring->slotBytes = frameBytes;
+    ring->dataOffset = frameserver::ringDataOffset();
+    ring->latestSeq.store(0);
+    ring->latestSlot.store(-1);
+    ring->readingSlot.store(-1);
+    for (int i = 0; i < SHM_SLOTS; i++)
+        ring->slots[i].seq.store(0);
+
+    // 3) 리드백 PBO
+    for (auto& rb : readbacks)
+    {
+        rb.pbo = GpuBuffer("frame server PBO");
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, rb.pbo.get());
+        glBufferData(GL_PIXEL_PACK_BUFFER, frameBytes, nullptr, GL_STREAM_READ);
+        rb.pbo.setBytes(frameBytes);
+        rb.seq = 0;
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    nextShmSlot = 0;
+    nextReadback = 0;
+    nextSeq = 1;
+    streamRemaining = 0;
+    running = true;
+
+    std::cout << "[FrameServer] Listening on " << socketPath << ", frames in shm " << shmName
+        << " (" << width << "x" << height << " RGBA8, " << SHM_SLOTS << " slots)\n";
+    return true;
+}
+
+void FrameServer::stop()
+{
+    if (listenFd < 0) return;
+
+    flush();
+    for (auto& rb : readbacks)
+        rb.pbo.reset();
+
+    closeClient();
+    close(listenFd);
+    listenFd = -1;
+    unlink(socketPath.c_str());
+
+    munmap(ring, ringBytes);
+    ring = nullptr;
+    shm_unlink(shmName.c_str());
+
+    running = false;
+}
+
+// -------------------------------------------------------------
+// 명령 채널
+// -------------------------------------------------------------
+void FrameServer::pumpSocket(int timeoutMs)
+{
+    pollfd p;
+    p.fd = (clientFd >= 0) ? clientFd : listenFd;
+    p.events = POLLIN;
+    p.revents = 0;
+    if (poll(&p, 1, timeoutMs) <= 0)
+        return; // 시간 초과 또는 시그널
+
+    if (clientFd < 0)
+    {
+        // 한 번에 클라이언트 하나 (다음 접속은 listen 대기열에서 기다림)
+        clientFd = accept(listenFd, nullptr, nullptr);
+        if (clientFd < 0) return;
+
+        clientsServed++;
+        inBuf.clear();
+        std::cout << "[FrameServer] Client connected\n";
+
+        std::ostringstream hello;
+        hello << "hello " << width << " " << height << " " << SHM_SLOTS << " " << shmName;
+        sendLine(hello.str());
+        return;
+    }
+
+    char buf[4096];
+    ssize_t n = recv(clientFd, buf, sizeof(buf), 0);
+    if (n <= 0)
+    {
+        std::cout << "[FrameServer] Client disconnected\n";
+        closeClient();
+        return;
+    }
+    inBuf.append(buf, (size_t)n);
+}
+
+void FrameServer::closeClient()
+{
+    if (clientFd >= 0)
+    {
+        close(clientFd);
+        clientFd = -1;
+    }
+    inBuf.clear();
+    streamRemaining = 0;
+    if (ring) ring->readingSlot.store(-1); // 읽던 도중 끊긴 소비자의 표시 해제
+}
+
+void FrameServer::sendLine(const std::string& line)
+{
+    if (clientFd < 0) return;
+
+    std::string msg = line + "\n";
+    // 끊긴 소켓에 써도 SIGPIPE 로 죽지 않게 MSG_NOSIGNAL
+    if (send(clientFd, msg.data(), msg.size(), MSG_NOSIGNAL) != (ssize_t)msg.size())
+        closeClient();
+}
+
+bool FrameServer::nextLine(std::string& line)
+{
+    size_t eol = inBuf.find('\n');
+    if (eol == std::string::npos) return false;
+
+    line.assign(inBuf, 0, eol);
+    inBuf.erase(0, eol + 1);
+    if (!line.empty() && line.back() == '\r') line.pop_back();
+    return true;
+}
+
+FrameServer::Command FrameServer::handleCommand(const std::string& line, FrameRequest& out)
+{
+    std::istringstream in(line);
+    std::string cmd;
+    if (!(in >> cmd)) return Command::Continue;
+
+    commands++;
+    bool ok = true;
+
+    if (cmd == "camera")
+    {
+        glm::vec3 p, t;
+        ok = (bool)(in >> p.x >> p.y >> p.z >> t.x >> t.y >> t.z);
+        if (ok)
+        {
+            out.hasPose = true;
+            out.position = p;
+            out.target = t;
+            out.hasTracking = true; // 자유 카메라로 전환
+            out.trackingIndex = -1;
+        }
+    }
+    else if (cmd == "track")
+    {
+        int index = -1;
+        ok = (bool)(in >> index);
+        if (ok)
+        {
+            out.hasTracking = true;
+            out.trackingIndex = index;
+            out.hasPose = false;
+        }
+    }
+    else if (cmd == "zoom")
+    {
+        float steps = 0.0f;
+        ok = (bool)(in >> steps);
+        if (ok) out.zoomSteps += steps;
+    }
+    else if (cmd == "time")
+    {
+        ok = (bool)(in >> out.simYears);
+        out.hasTime = ok;
+    }
+    else if (cmd == "speed")
+    {
+        ok = (bool)(in >> out.simSpeed) && out.simSpeed >= 0.0f;
+        out.hasSpeed = ok;
+    }
+    else if (cmd == "render")
+    {
+        unsigned long long tag = 0;
+        in >> tag; // TAG 는 생략 가능
+        currentTag = tag;
+        renderRequests++;
+        return Command::Render;
+    }
+    else if (cmd == "stream")
+    {
+        int n = 0;
+        ok = (bool)(in >> n) && n >= 0;
+        if (ok) streamRemaining = n;
+    }
+    else if (cmd == "quit")
+    {
+        return Command::Quit;
+    }
+    else
+    {
+        ok = false;
+    }
+
+    if (!ok)
+    {
+        badCommands++;
+        sendLine("error " + line);
+    }
+    return Command::Continue;
+}
+
+bool FrameServer::waitForFrame(FrameRequest& out)
+{
+    if (!running) return false;
+
+    out = FrameRequest();
+    for (;;)
+    {
+        // stream 중에는 기다리지 않고 이미 도착한 명령만 읽음
+        if (streamRemaining > 0)
+            pumpSocket(0);
+
+        std::string line;
+        while (nextLine(line))
+        {
+            Command c = handleCommand(line, out);
+            if (c == Command::Quit)
+            {
+                sendLine("bye");
+                std::cout << "[FrameServer] Quit requested\n";
+                return false;
+            }
+            if (c == Command::Render)
+                return true;
+        }
+
+        if (streamRemaining > 0)
+        {
+            streamRemaining--;
+            streamFrames++;
+            currentTag = 0;
+            return true;
+        }
+
+        // 할 일 없음: 명령이 올 때까지 잠듦 (렌더링하지 않음)
+        pumpSocket(-1);
+    }
+}
+
+// -------------------------------------------------------------
+// 프레임 채널
+// -------------------------------------------------------------
+void FrameServer::publishFrame(unsigned int fbo, float simYears)
+{
+    if (!running) return;
+
+    // 이번에 쓸 PBO 가 아직 공개 전이면 (PBO_RING 프레임 전 것) 먼저 공개
+    Readback& rb = readbacks[nextReadback];
+    if (rb.seq != 0)
+        retire(rb, true);
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, fbo);
+    glReadBuffer(fbo == 0 ? GL_BACK : GL_COLOR_ATTACHMENT0);
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, rb.pbo.get());
+    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    rb.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    rb.seq = nextSeq++;
+    rb.tag = currentTag;
+    rb.simYears = simYears;
+    nextReadback = (nextReadback + 1) % PBO_RING;
+
+    if (streamRemaining == 0)
+    {
+        // 뒤따르는 프레임이 없음 (render 요청 / stream 마지막): 바로 공개
+        flush();
+        return;
+    }
+
+    // stream 중: 이미 끝난 이전 리드백만 오래된 순서대로 공개 (대기 없음)
+    for (int i = 0; i < PBO_RING; i++)
+    {
+        Readback& o = readbacks[(nextReadback + i) % PBO_RING];
+        if (o.seq == 0 || &o == &rb) continue;
+
+        GLenum r = glClientWaitSync((GLsync)o.fence, 0, 0);
+        if (r != GL_ALREADY_SIGNALED && r != GL_CONDITION_SATISFIED)
+            break;
+        retire(o, false);
+    }
+}
+
+void FrameServer::flush()
+{
+    for (int i = 0; i < PBO_RING; i++)
+    {
+        Readback& rb = readbacks[(nextReadback + i) % PBO_RING];
+        if (rb.seq != 0)
+            retire(rb, true);
+    }
+}
+
+int FrameServer::acquireShmSlot()
+{
+    for (int tries = 0; tries < 2 * SHM_SLOTS; tries++)
+    {
+        int s = nextShmSlot;
+        nextShmSlot = (nextShmSlot + 1) % SHM_SLOTS;
+
+        // 먼저 "쓰는 중" 표시 후 소비자 확인 (순서가 바뀌면 읽는 중인 슬롯을 덮어쓸 수 있음)
+        SlotHeader& slot = ring->slots[s];
+        uint64_t old = slot.seq.load();
+        slot.seq.store(0);
+        if (ring->readingSlot.load() != s)
+            return s;
+
+        slot.seq.store(old); // 소비자가 읽는 중: 되돌리고 다음 슬롯
+        readerSkips++;
+    }
+    return -1;
+}
+
+void FrameServer::retire(Readback& rb, bool wait)
+{
+    GLsync fence = (GLsync)rb.fence;
+    if (wait)
+    {
+        double t0 = nowMs();
+        glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000ull);
+        readbackWaitMs += nowMs() - t0;
+    }
+    glDeleteSync(fence);
+    rb.fence = nullptr;
+
+    unsigned long long seq = rb.seq;
+    rb.seq = 0;
+
+    int s = acquireShmSlot();
+    if (s < 0) return; // 슬롯이 1 개뿐인 경우만 (SHM_SLOTS >= 2 이면 생기지 않음)
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, rb.pbo.get());
+    const unsigned char* src = (const unsigned char*)glMapBufferRange(
+        GL_PIXEL_PACK_BUFFER, 0, frameBytes, GL_MAP_READ_BIT);
+    if (src)
+    {
+        // GL 은 아래 -> 위 순서이므로 행을 뒤집어 위 -> 아래로 복사
+        unsigned char* dst = (unsigned char*)ring + ring->dataOffset + (size_t)s * frameBytes;
+        size_t rowBytes = (size_t)width * 4;
+        for (int y = 0; y < height; y++)
+        {
+            memcpy(dst + (size_t)(height - 1 - y) * rowBytes,
+                src + (size_t)y * rowBytes, rowBytes);
+        }
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    if (!src)
+    {
+        std::cerr << "[FrameServer] Failed to map PBO for frame " << seq << "\n";
+        return; // 슬롯은 seq = 0 (비어 있음) 으로 남음
+    }
+
+    SlotHeader& slot = ring->slots[s];
+    slot.tag = rb.tag;
+    slot.simYears = rb.simYears;
+    slot.publishNs = monotonicNs();
+    slot.seq.store(seq, std::memory_order_release);
+    ring->latestSlot.store(s);
+    ring->latestSeq.store(seq);
+    framesPublished++;
+
+    std::ostringstream msg;
+    msg << "frame " << seq << " " << s << " " << rb.tag;
+    sendLine(msg.str());
+}
+
+#else // _WIN32
+
+// Unix 도메인 소켓 / POSIX 공유 메모리가 필요한 기능: Windows 에서는 지원하지 않음
+bool FrameServer::start(const std::string&, int, int)
+{
+    std::cerr << "[FrameServer] --serve is only supported on POSIX systems\n";
+    return false;
+}
+
+void FrameServer::stop() {}
+bool FrameServer::waitForFrame(FrameRequest&) { return false; }
+void FrameServer::publishFrame(unsigned int, float) {}
+
+#endif
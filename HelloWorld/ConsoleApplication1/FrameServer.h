@@ -0,0 +1,114 @@
+﻿#ifndef FRAME_SERVER_H
+#define FRAME_SERVER_H
+
+#include <string>
+#include <ostream>
+#include <glm/glm.hpp>
+
+#include "GpuResource.h"
+
+namespace frameserver { struct RingHeader; }
+
+// =====================================================
+// 서버 명령으로 바뀐 장면 상태 (다음 프레임 전에 main 이 적용)
+// =====================================================
+struct FrameRequest
+{
+    bool hasPose = false;          // camera 명령
+    glm::vec3 position = glm::vec3(0.0f);
+    glm::vec3 target = glm::vec3(0.0f);
+
+    bool hasTracking = false;      // track 명령
+    int trackingIndex = -1;
+    float zoomSteps = 0.0f;        // zoom 명령 누적 (마우스 휠 칸 수)
+
+    bool hasTime = false;          // time 명령
+    float simYears = 0.0f;
+
+    bool hasSpeed = false;         // speed 명령
+    float simSpeed = 1.0f;
+};
+
+// =====================================================
+// FrameServer (--serve SOCKET)
+//  - 다른 로컬 프로세스에 렌더러를 붙이는 서버 모드 (헤드리스 전용, POSIX)
+//  - Unix 도메인 소켓으로 카메라 / 시각 명령을 받고,
+//    완성된 프레임은 공유 메모리 슬롯 링에 공개 (프로토콜: FrameServerProtocol.h)
+//  - 리드백은 FrameCapture 와 같은 PBO + fence 방식
+//    render 요청은 바로 완료까지 기다려 공개하고,
+//    stream 중에는 PBO 링으로 겹쳐서 한 프레임 뒤에 공개
+//  - 명령이 없으면 소켓에서 잠들어 렌더링하지 않음
+//  - 클라이언트가 끊기면 다음 접속을 기다림 (quit 명령으로만 종료)
+//  - Windows 빌드에서는 start() 가 실패만 보고함
+// =====================================================
+class FrameServer
+{
+public:
+    static const int SHM_SLOTS = 4;    // 공유 메모리 이미지 슬롯 수
+    static const int PBO_RING = 2;     // stream 중 겹쳐 둘 리드백 수
+
+    FrameServer();
+    ~FrameServer();
+
+    bool start(const std::string& socketPath, int width, int height);
+    void stop();   // 남은 리드백 공개 후 소켓 / 공유 메모리 정리 (컨텍스트가 살아 있을 때)
+
+    bool isRunning() const { return running; }
+
+    // 다음 프레임을 그려야 할 때까지 명령을 처리하며 대기 (quit 이면 false)
+    bool waitForFrame(FrameRequest& out);
+
+    // 합성이 끝난 프레임을 fbo 에서 읽어 공유 메모리에 공개
+    void publishFrame(unsigned int fbo, float simYears);
+
+    void report(std::ostream& os) const;
+
+private:
+    struct Readback
+    {
+        GpuBuffer pbo;
+        void* fence = nullptr;         // GLsync
+        unsigned long long seq = 0;    // 0 = 비어 있음
+        unsigned long long tag = 0;
+        double simYears = 0.0;
+    };
+
+    bool running;
+    int width, height;
+    size_t frameBytes;
+
+    std::string socketPath;
+    int listenFd, clientFd;
+    std::string inBuf;                 // 아직 줄 단위로 자르지 못한 입력
+
+    std::string shmName;
+    frameserver::RingHeader* ring;
+    size_t ringBytes;
+    int nextShmSlot;
+
+    Readback readbacks[PBO_RING];
+    int nextReadback;
+
+    unsigned long long nextSeq;        // 다음 프레임 번호 (1 부터)
+    unsigned long long currentTag;     // 지금 그리는 프레임의 TAG
+    int streamRemaining;               // stream 명령으로 남은 프레임 수
+
+    // 통계
+    long long framesPublished, renderRequests, streamFrames;
+    long long commands, badCommands, clientsServed, readerSkips;
+    double readbackWaitMs;
+
+    void pumpSocket(int timeoutMs);    // 접속 수락 / 입력 읽기 (timeoutMs < 0 = 무한 대기)
+    void closeClient();
+    void sendLine(const std::string& line);
+    bool nextLine(std::string& line);
+
+    enum class Command { Continue, Render, Quit };
+    Command handleCommand(const std::string& line, FrameRequest& out);
+
+    void retire(Readback& rb, bool wait);  // fence 확인 -> 맵핑 -> 공유 메모리 슬롯에 복사
+    void flush();                          // 남은 리드백을 모두 공개
+    int acquireShmSlot();                  // 소비자가 읽는 중이 아닌 슬롯을 골라 seq = 0 으로 표시
+};
+
+#endif
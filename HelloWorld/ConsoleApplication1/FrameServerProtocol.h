@@ -0,0 +1,74 @@
+﻿#ifndef FRAME_SERVER_PROTOCOL_H
+#define FRAME_SERVER_PROTOCOL_H
+
+#include <atomic>
+#include <cstdint>
+
+// =====================================================
+// 프레임 서버 프로토콜 (렌더러 <-> 같은 머신의 소비 프로세스)
+//  - 서버 프로그램(--serve)과 시험 클라이언트(FrameClient)가 함께 씀
+//
+// 명령 채널: Unix 도메인 소켓, 한 줄에 명령 하나 (ASCII, '\n' 으로 끝)
+//  camera PX PY PZ TX TY TZ   자유 카메라 위치 / 바라보는 점 (추적 해제)
+//  track I                    I 번 행성 추적 (-1 = 해제)
+//  zoom N                     추적 거리 조절 (마우스 휠 N 칸, 양수 = 가까이)
+//  time YEARS                 시뮬레이션 시각 지정
+//  speed X                    프레임당 시간 진행 배속 (--dt 기준)
+//  render TAG                 한 프레임 렌더링 → "frame SEQ SLOT TAG" 응답
+//  stream N                   N 프레임 연속 렌더링 (프레임마다 "frame ..." 응답, TAG = 0)
+//  quit                       서버 종료
+//  접속 직후 서버가 "hello W H SLOTS SHM_NAME" 를 보냄
+//
+// 프레임 채널: POSIX 공유 메모리 (shm_open) 에 이미지 슬롯 링
+//  - [FrameRingHeader][슬롯 0 픽셀][슬롯 1 픽셀]...
+//  - 픽셀은 RGBA8, 위 -> 아래 순서, 행 간격 = width * 4
+//  - 슬롯 seq: 0 = 쓰는 중 / 비어 있음, 그 외 = 들어 있는 프레임 번호
+//  - 소비자는 latestSlot 의 픽셀을 복사 없이 그대로 읽음
+//    1) readingSlot 에 슬롯 번호 기록 (서버는 이 슬롯을 덮어쓰지 않음)
+//    2) 슬롯 seq 가 기대한 프레임 번호인지 다시 확인 (아니면 이미 덮어쓰인 것)
+//    3) 다 쓰면 readingSlot = -1
+//    서버는 슬롯 seq = 0 을 먼저 쓰고 readingSlot 을 확인하므로 (seq_cst)
+//    두 쪽 중 적어도 하나는 상대를 보게 되어 읽는 중인 슬롯이 찢어지지 않음
+// =====================================================
+namespace frameserver
+{
+    const uint32_t MAGIC = 0x53524D46u;  // "FMRS"
+    const uint32_t VERSION = 1;
+    const int MAX_SLOTS = 8;
+
+    struct SlotHeader
+    {
+        std::atomic<uint64_t> seq;       // 들어 있는 프레임 번호 (0 = 쓰는 중 / 비어 있음)
+        uint64_t tag;                    // render 명령의 TAG (stream 은 0)
+        double simYears;                 // 이 프레임의 시뮬레이션 시각
+        uint64_t publishNs;              // 공개 시점 (CLOCK_MONOTONIC, ns)
+    };
+
+    struct RingHeader
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t width, height;
+        uint32_t slotCount;
+        uint32_t reserved;
+        uint64_t slotBytes;              // 슬롯 하나의 픽셀 크기
+        uint64_t dataOffset;             // 첫 슬롯 픽셀 위치 (페이지 정렬)
+
+        std::atomic<uint64_t> latestSeq; // 마지막으로 공개한 프레임 번호
+        std::atomic<int32_t> latestSlot; // 그 프레임이 들어 있는 슬롯
+        std::atomic<int32_t> readingSlot;// 소비자가 읽는 중인 슬롯 (-1 = 없음)
+
+        SlotHeader slots[MAX_SLOTS];
+    };
+
+    // 프로세스 사이에서 쓰려면 원자 변수가 잠금 없이 동작해야 함
+    static_assert(ATOMIC_LLONG_LOCK_FREE == 2 && ATOMIC_INT_LOCK_FREE == 2,
+        "frame ring needs lock-free 64-bit atomics");
+
+    inline uint64_t ringDataOffset()
+    {
+        return (sizeof(RingHeader) + 4095) & ~(uint64_t)4095;
+    }
+}
+
+#endif
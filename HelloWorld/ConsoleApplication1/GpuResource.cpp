@@ -0,0 +1,258 @@
+﻿#include "GpuResource.h"
+
+#include <GL/glew.h>
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+
+std::vector<GpuRegistry::Entry> GpuRegistry::entries;
+std::vector<int> GpuRegistry::freeSlots;
+
+size_t GpuRegistry::live[(int)GpuClass::Count] = {};
+size_t GpuRegistry::peak[(int)GpuClass::Count] = {};
+int GpuRegistry::count[(int)GpuClass::Count] = {};
+size_t GpuRegistry::peakTotal = 0;
+size_t GpuRegistry::budget = 0;
+bool GpuRegistry::budgetWarned = false;
+bool GpuRegistry::closed = false;
+
+static const char* className(GpuClass cls)
+{
+    switch (cls)
+    {
+    case GpuClass::Texture:      return "textures";
+    case GpuClass::Buffer:       return "buffers";
+    case GpuClass::RenderTarget: return "render targets";
+    default:                     return "?";
+    }
+}
+
+static unsigned int genObject(GpuKind kind)
+{
+    GLuint name = 0;
+    switch (kind)
+    {
+    case GpuKind::Texture:      glGenTextures(1, &name); break;
+    case GpuKind::Buffer:       glGenBuffers(1, &name); break;
+    case GpuKind::VertexArray:  glGenVertexArrays(1, &name); break;
+    case GpuKind::Framebuffer:  glGenFramebuffers(1, &name); break;
+    case GpuKind::Renderbuffer: glGenRenderbuffers(1, &name); break;
+    }
+    return name;
+}
+
+static void deleteObject(GpuKind kind, unsigned int name)
+{
+    GLuint n = name;
+    switch (kind)
+    {
+    case GpuKind::Texture:      glDeleteTextures(1, &n); break;
+    case GpuKind::Buffer:       glDeleteBuffers(1, &n); break;
+    case GpuKind::VertexArray:  glDeleteVertexArrays(1, &n); break;
+    case GpuKind::Framebuffer:  glDeleteFramebuffers(1, &n); break;
+    case GpuKind::Renderbuffer: glDeleteRenderbuffers(1, &n); break;
+    }
+}
+
+static double toMiB(size_t bytes)
+{
+    return (double)bytes / (1024.0 * 1024.0);
+}
+
+int GpuRegistry::create(GpuKind kind, GpuClass cls, const std::string& label)
+{
+    if (closed) return -1;
+
+    Entry e;
+    e.kind = kind;
+    e.cls = cls;
+    e.name = genObject(kind);
+    e.bytes = 0;
+    e.label = label;
+
+    count[(int)cls]++;
+
+    if (!freeSlots.empty())
+    {
+        int slot = freeSlots.back();
+        freeSlots.pop_back();
+        entries[slot] = e;
+        return slot;
+    }
+
+    entries.push_back(e);
+    return (int)entries.size() - 1;
+}
+
+void GpuRegistry::destroy(int slot)
+{
+    // shutdown() 이후에는 이미 모두 삭제된 상태
+    if (closed || slot < 0 || slot >= (int)entries.size()) return;
+
+    Entry& e = entries[slot];
+    if (e.name == 0) return;
+
+    deleteObject(e.kind, e.name);
+
+    live[(int)e.cls] -= e.bytes;
+    count[(int)e.cls]--;
+
+    e.name = 0;
+    e.bytes = 0;
+    e.label.clear();
+    freeSlots.push_back(slot);
+}
+
+unsigned int GpuRegistry::createOwned(GpuKind kind, GpuClass cls, const std::string& label,
+    size_t bytes)
+{
+    int slot = create(kind, cls, label);
+    setBytes(slot, bytes);
+    return name(slot);
+}
+
+unsigned int GpuRegistry::name(int slot)
+{
+    if (slot < 0 || slot >= (int)entries.size()) return 0;
+    return entries[slot].name;
+}
+
+bool GpuRegistry::setBytes(int slot, size_t bytes)
+{
+    if (slot < 0 || slot >= (int)entries.size()) return true;
+
+    Entry& e = entries[slot];
+    if (e.name == 0) return true;
+
+    int c = (int)e.cls;
+    live[c] = live[c] - e.bytes + bytes;
+    e.bytes = bytes;
+
+    peak[c] = std::max(peak[c], live[c]);
+    peakTotal = std::max(peakTotal, liveBytes());
+
+    if (budget > 0 && liveBytes() > budget)
+    {
+        if (!budgetWarned)
+        {
+            std::cerr << "[GPU] VRAM budget exceeded by '" << e.label << "': "
+                << std::fixed << std::setprecision(1) << toMiB(liveBytes()) << " / "
+                << toMiB(budget) << " MiB\n";
+            budgetWarned = true;
+        }
+        return false;
+    }
+    return true;
+}
+
+void GpuRegistry::setBudget(size_t bytes)
+{
+    budget = bytes;
+    budgetWarned = false;
+}
+
+bool GpuRegistry::fits(size_t additionalBytes)
+{
+    return budget == 0 || liveBytes() + additionalBytes <= budget;
+}
+
+size_t GpuRegistry::liveBytes(GpuClass cls)
+{
+    return live[(int)cls];
+}
+
+size_t GpuRegistry::peakBytes(GpuClass cls)
+{
+    return peak[(int)cls];
+}
+
+size_t GpuRegistry::liveBytes()
+{
+    size_t sum = 0;
+    for (int i = 0; i < (int)GpuClass::Count; i++)
+        sum += live[i];
+    return sum;
+}
+
+size_t GpuRegistry::peakBytes()
+{
+    return peakTotal;
+}
+
+int GpuRegistry::liveCount(GpuClass cls)
+{
+    return count[(int)cls];
+}
+
+size_t GpuRegistry::imageBytes(int width, int height, int layers, int bytesPerPixel, bool mipmapped)
+{
+    size_t total = 0;
+    int w = std::max(width, 1);
+    int h = std::max(height, 1);
+
+    for (;;)
+    {
+        total += (size_t)w * (size_t)h * (size_t)bytesPerPixel;
+        if (!mipmapped || (w == 1 && h == 1)) break;
+        w = std::max(w / 2, 1);
+        h = std::max(h / 2, 1);
+    }
+    return total * (size_t)std::max(layers, 1);
+}
+
+void GpuRegistry::report(std::ostream& os)
+{
+    os << std::fixed << std::setprecision(1);
+    os << "[GPU] Memory (MiB)  " << std::setw(9) << "live" << std::setw(9) << "peak"
+        << std::setw(8) << "count" << "\n";
+
+    for (int i = 0; i < (int)GpuClass::Count; i++)
+    {
+        os << "  " << std::left << std::setw(17) << className((GpuClass)i) << std::right
+            << std::setw(9) << toMiB(live[i])
+            << std::setw(9) << toMiB(peak[i])
+            << std::setw(8) << count[i] << "\n";
+    }
+    os << "  " << std::left << std::setw(17) << "total" << std::right
+        << std::setw(9) << toMiB(liveBytes())
+        << std::setw(9) << toMiB(peakTotal) << "\n";
+
+    if (budget > 0)
+        os << "  budget " << toMiB(budget) << " MiB\n";
+
+    // 가장 큰 자원 몇 개
+    std::vector<const Entry*> largest;
+    for (const Entry& e : entries)
+    {
+        if (e.name != 0 && e.bytes > 0)
+            largest.push_back(&e);
+    }
+    std::sort(largest.begin(), largest.end(),
+        [](const Entry* a, const Entry* b) { return a->bytes > b->bytes; });
+
+    int shown = std::min((int)largest.size(), 5);
+    for (int i = 0; i < shown; i++)
+    {
+        os << "    " << std::setw(7) << toMiB(largest[i]->bytes) << "  "
+            << largest[i]->label << "\n";
+    }
+}
+
+void GpuRegistry::shutdown()
+{
+    for (Entry& e : entries)
+    {
+        if (e.name != 0)
+            deleteObject(e.kind, e.name);
+    }
+
+    entries.clear();
+    freeSlots.clear();
+
+    for (int i = 0; i < (int)GpuClass::Count; i++)
+    {
+        live[i] = 0;
+        count[i] = 0;
+    }
+    closed = true;
+}
@@ -0,0 +1,147 @@
+﻿#ifndef GPU_RESOURCE_H
+#define GPU_RESOURCE_H
+
+#include <string>
+#include <vector>
+#include <ostream>
+#include <cstddef>
+
+// =====================================================
+// GPU 자원 종류
+//  - GpuKind  : 어떤 GL 오브젝트인지 (생성/삭제 함수 결정)
+//  - GpuClass : 메모리 집계 분류 (텍스처 / 버퍼 / 렌더 타깃)
+// =====================================================
+enum class GpuKind
+{
+    Texture,
+    Buffer,
+    VertexArray,
+    Framebuffer,
+    Renderbuffer
+};
+
+enum class GpuClass
+{
+    Texture,
+    Buffer,
+    RenderTarget,
+    Count
+};
+
+// =====================================================
+// GpuRegistry
+//  - 모든 GL 오브젝트를 한 곳에서 생성/삭제하고 크기(byte)를 집계
+//  - 분류별 현재 사용량과 최고 사용량(high-water mark) 보고
+//  - VRAM 예산을 넘는 할당은 fits()로 미리 확인해서 줄이거나 포기
+//  - shutdown() 은 컨텍스트가 살아 있을 때 남은 오브젝트를 모두 삭제
+//    (이후 핸들 소멸자는 아무 GL 호출도 하지 않음)
+// =====================================================
+class GpuRegistry
+{
+public:
+    // 오브젝트 생성 → 슬롯 번호 반환 (핸들이 슬롯을 소유)
+    static int create(GpuKind kind, GpuClass cls, const std::string& label);
+    static void destroy(int slot);
+
+    // 레지스트리가 소유하는 오브젝트 생성 (shutdown 때 삭제) → GL 이름 반환
+    //  - 프로그램 전체에서 공유하는 텍스처/메쉬처럼 주인이 따로 없는 자원용
+    static unsigned int createOwned(GpuKind kind, GpuClass cls, const std::string& label,
+        size_t bytes);
+
+    static unsigned int name(int slot);
+
+    // 오브젝트 크기 갱신 (예산 초과 시 false, 집계는 그대로 반영)
+    static bool setBytes(int slot, size_t bytes);
+
+    // VRAM 예산 (0 = 제한 없음)
+    static void setBudget(size_t bytes);
+    static size_t getBudget() { return budget; }
+    static bool fits(size_t additionalBytes);
+
+    static size_t liveBytes(GpuClass cls);
+    static size_t peakBytes(GpuClass cls);
+    static size_t liveBytes();
+    static size_t peakBytes();
+    static int liveCount(GpuClass cls);
+
+    // 밉맵 포함 이미지 크기 계산 헬퍼
+    static size_t imageBytes(int width, int height, int layers, int bytesPerPixel, bool mipmapped);
+
+    static void report(std::ostream& os);
+    static void shutdown();
+
+private:
+    struct Entry
+    {
+        GpuKind kind;
+        GpuClass cls;
+        unsigned int name;   // 0 = 빈 슬롯
+        size_t bytes;
+        std::string label;
+    };
+
+    static std::vector<Entry> entries;
+    static std::vector<int> freeSlots;
+
+    static size_t live[(int)GpuClass::Count];
+    static size_t peak[(int)GpuClass::Count];
+    static int count[(int)GpuClass::Count];
+    static size_t peakTotal;
+    static size_t budget;
+    static bool budgetWarned;
+    static bool closed;
+};
+
+// =====================================================
+// GpuHandle — 레지스트리 슬롯을 소유하는 이동 전용 RAII 핸들
+// =====================================================
+template <GpuKind Kind, GpuClass Class>
+class GpuHandle
+{
+public:
+    GpuHandle() : slot(-1) {}
+    explicit GpuHandle(const std::string& label)
+        : slot(GpuRegistry::create(Kind, Class, label)) {}
+    ~GpuHandle() { reset(); }
+
+    GpuHandle(GpuHandle&& other) : slot(other.slot) { other.slot = -1; }
+    GpuHandle& operator=(GpuHandle&& other)
+    {
+        if (this != &other)
+        {
+            reset();
+            slot = other.slot;
+            other.slot = -1;
+        }
+        return *this;
+    }
+
+    GpuHandle(const GpuHandle&) = delete;
+    GpuHandle& operator=(const GpuHandle&) = delete;
+
+    unsigned int get() const { return GpuRegistry::name(slot); }
+    bool valid() const { return slot >= 0; }
+
+    bool setBytes(size_t bytes) { return GpuRegistry::setBytes(slot, bytes); }
+
+    void reset()
+    {
+        if (slot >= 0)
+        {
+            GpuRegistry::destroy(slot);
+            slot = -1;
+        }
+    }
+
+private:
+    int slot;
+};
+
+typedef GpuHandle<GpuKind::Texture, GpuClass::Texture> GpuTexture;
+typedef GpuHandle<GpuKind::Buffer, GpuClass::Buffer> GpuBuffer;
+typedef GpuHandle<GpuKind::VertexArray, GpuClass::Buffer> GpuVertexArray;
+typedef GpuHandle<GpuKind::Texture, GpuClass::RenderTarget> GpuRenderTexture;
+typedef GpuHandle<GpuKind::Renderbuffer, GpuClass::RenderTarget> GpuRenderbuffer;
+typedef GpuHandle<GpuKind::Framebuffer, GpuClass::RenderTarget> GpuFramebuffer;
+
+#endif
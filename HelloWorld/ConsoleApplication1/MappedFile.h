@@ -0,0 +1,38 @@
+﻿#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+
+// =====================================================
+// MappedFile
+//  - 파일 하나를 읽기 전용으로 맵핑 (mmap / MapViewOfFile), 소멸할 때 해제
+//  - BodyCatalog(.bcat) / CookedTexture(.ctex) 공용
+// =====================================================
+class MappedFile
+{
+public:
+    MappedFile() {}
+    ~MappedFile() { close(); }
+
+    // 맵핑 (없거나 빈 파일이면 false, 이미 맵핑돼 있으면 먼저 해제)
+    bool open(const std::string& path);
+    void close();
+
+    bool isOpen() const { return data != nullptr; }
+    const unsigned char* getData() const { return data; }
+    size_t getSize() const { return size; }
+
+private:
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const unsigned char* data = nullptr;
+    size_t size = 0;
+#ifdef _WIN32
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#endif
+};
+
+#endif
@@ -0,0 +1,235 @@
+﻿#include "PictureInPicture.h"
+#include "Shader.h"
+#include "CommandList.h"
+
+#include <GL/glew.h>
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+static const float INSET_FOV_DEG = 45.0f;
+static const float INSET_MIN_RANGE = 20.0f;   // 내행성 추적 시에도 태양 주변이 보이도록
+
+PictureInPicture::PictureInPicture()
+    : width(0), height(0),
+    sceneShader(nullptr), lineShader(nullptr), compositeShader(nullptr),
+    drawnBodies(0), culledBodies(0)
+{
+}
+
+void PictureInPicture::init(int mainWidth, int mainHeight)
+{
+    width = std::max(1, mainWidth / DOWNSCALE);
+    height = std::max(1, mainHeight / DOWNSCALE);
+
+    fbo = GpuFramebuffer("inset FBO");
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo.get());
+
+    colorTex = GpuRenderTexture("inset color");
+    glBindTexture(GL_TEXTURE_2D, colorTex.get());
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, width, height, 0, GL_RGBA, GL_FLOAT, nullptr);
+    colorTex.setBytes(GpuRegistry::imageBytes(width, height, 1, 8, false));
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+        GL_TEXTURE_2D, colorTex.get(), 0);
+
+    depthBuffer = GpuRenderbuffer("inset depth");
+    glBindRenderbuffer(GL_RENDERBUFFER, depthBuffer.get());
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height);
+    depthBuffer.setBytes(GpuRegistry::imageBytes(width, height, 1, 4, false));
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT,
+        GL_RENDERBUFFER, depthBuffer.get());
+
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+        std::cerr << "Inset framebuffer not complete!\n";
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+void PictureInPicture::setShaders(Shader* scene, Shader* line, Shader* composite)
+{
+    sceneShader = scene;
+    lineShader = line;
+    compositeShader = composite;
+}
+
+void PictureInPicture::begin()
+{
+    bodies.clear();
+    orbits.clear();
+}
+
+void PictureInPicture::addBody(const glm::mat4& model, const glm::vec3& center, float radius,
+    unsigned int texture, float emission, float minPixels)
+{
+    Body b;
+    b.model = model;
+    b.center = center;
+    b.radius = radius;
+    b.texture = texture;
+    b.emission = emission;
+    b.minPixels = minPixels;
+    bodies.push_back(b);
+}
+
+void PictureInPicture::addOrbit(const std::vector<glm::vec3>* path, bool highlight)
+{
+    if (!path || path->size() < 2) return;
+    Orbit o;
+    o.path = path;
+    o.highlight = highlight;
+    orbits.push_back(o);
+}
+
+void PictureInPicture::record(CommandList& cmd, const glm::vec3& focus,
+    unsigned int sphereVAO, unsigned int sphereIndexCount,
+    unsigned int ringShadowArray)
+{
+    cmd.reset();
+    drawnBodies = 0;
+    culledBodies = 0;
+    if (!sceneShader || !lineShader || !fbo.valid()) return;
+
+    // 보조 카메라: 태양을 중심으로 추적 대상의 궤도까지 들어오는 조감 시점
+    float range = std::max(glm::length(focus) * 1.3f, INSET_MIN_RANGE);
+    glm::vec3 eye(0.0f, range * 1.4f, range * 1.8f);
+    float eyeDist = glm::length(eye);
+
+    glm::mat4 view = glm::lookAt(eye, glm::vec3(0.0f), glm::vec3(0, 1, 0));
+    glm::mat4 proj = glm::perspective(glm::radians(INSET_FOV_DEG),
+        (float)width / (float)height, eyeDist * 0.02f, eyeDist + range * 2.0f);
+
+    // 절두체 평면 (Gribb-Hartmann: 클립 행렬의 행 조합)
+    glm::mat4 clip = proj * view;
+    glm::vec4 planes[6];
+    for (int i = 0; i < 3; i++)
+    {
+        glm::vec4 row(clip[0][i], clip[1][i], clip[2][i], clip[3][i]);
+        glm::vec4 w(clip[0][3], clip[1][3], clip[2][3], clip[3][3]);
+        planes[i * 2 + 0] = w + row;
+        planes[i * 2 + 1] = w - row;
+    }
+    for (glm::vec4& p : planes)
+        p /= glm::length(glm::vec3(p));
+
+    // 거리 1 에서 반지름 1 인 구의 화면 반지름 (픽셀)
+    float pixelsPerUnit = (float)height * 0.5f / tanf(glm::radians(INSET_FOV_DEG) * 0.5f);
+
+    cmd.beginPass(fbo.get(), 0, 0, width, height, true, true);
+
+    // 1) 천체 ----------------------------------------------------
+    cmd.setPipeline(makePipeline(sceneShader->ID));
+    cmd.setMat4("view", view);
+    cmd.setMat4("proj", proj);
+    cmd.setVec3("viewPos", eye);
+    cmd.setVec3("lightPos", glm::vec3(0.0f));
+    cmd.setVec3("lightColor", glm::vec3(1.0f, 1.0f, 0.9f));
+    cmd.bindTexture(1, TextureTarget::Texture2DArray, ringShadowArray);
+    cmd.setInt("ringShadowTex", 1);
+    cmd.setInt("diffuseMap", 0);
+
+    for (const Body& b : bodies)
+    {
+        float dist = std::max(glm::length(b.center - eye), 1e-3f);
+        float pixels = b.radius * pixelsPerUnit / dist;
+
+        glm::mat4 model = b.model;
+        float radius = b.radius;
+        if (b.minPixels > 0.0f && pixels < b.minPixels)
+        {
+            // 조감 시점에서는 행성이 점보다 작으므로 최소 크기까지 키움
+            float s = b.minPixels / std::max(pixels, 1e-4f);
+            model = glm::translate(glm::mat4(1.0f), b.center)
+                * glm::scale(glm::mat4(1.0f), glm::vec3(s))
+                * glm::translate(glm::mat4(1.0f), -b.center) * model;
+            radius *= s;
+        }
+        else if (b.minPixels <= 0.0f && pixels < 0.5f)
+        {
+            culledBodies++;
+            continue;
+        }
+
+        bool inside = true;
+        for (const glm::vec4& p : planes)
+        {
+            if (glm::dot(glm::vec3(p), b.center) + p.w < -radius)
+            {
+                inside = false;
+                break;
+            }
+        }
+        if (!inside)
+        {
+            culledBodies++;
+            continue;
+        }
+
+        cmd.bindTexture(0, TextureTarget::Texture2D, b.texture);
+        cmd.setInt("isSun", b.emission > 0.0f ? 1 : 0);
+        cmd.setFloat("emissionStrength", b.emission > 0.0f ? b.emission : 1.0f);
+        cmd.setMat4("model", model);
+        cmd.drawIndexed(Primitive::Triangles, sphereVAO, sphereIndexCount);
+        drawnBodies++;
+    }
+
+    // 2) 궤도선 (깊이 비교만, 태양 뒤쪽은 가려짐) --------------------
+    cmd.setPipeline(makePipeline(lineShader->ID, BlendMode::Opaque, true, false));
+    cmd.setMat4("view", view);
+    cmd.setMat4("proj", proj);
+    cmd.setMat4("model", glm::mat4(1.0f));
+    for (const Orbit& o : orbits)
+    {
+        cmd.setVec3("color", o.highlight ? glm::vec3(0.0f, 1.0f, 0.0f) : glm::vec3(0.35f));
+        cmd.drawTransient(Primitive::LineStrip, o.path->data(), (int)o.path->size());
+    }
+
+    // 3) 추적 대상 십자 표시 (항상 위에) ---------------------------
+    float arm = range * 0.05f;
+    const glm::vec3 axes[3] = { glm::vec3(arm, 0, 0), glm::vec3(0, arm, 0), glm::vec3(0, 0, arm) };
+    for (int i = 0; i < 3; i++)
+    {
+        marker[i * 2 + 0] = focus - axes[i];
+        marker[i * 2 + 1] = focus + axes[i];
+    }
+    cmd.setPipeline(makePipeline(lineShader->ID, BlendMode::Opaque, false, false));
+    cmd.setVec3("color", glm::vec3(1.0f, 0.8f, 0.2f));
+    cmd.drawTransient(Primitive::Lines, marker, 6);
+}
+
+void PictureInPicture::composite(unsigned int targetFBO, int screenWidth, int screenHeight,
+    unsigned int quadVAO, unsigned int exposureTex, bool autoExposure, float exposure)
+{
+    if (!compositeShader || !colorTex.valid()) return;
+
+    int x = screenWidth - width - MARGIN_PX;
+    int y = MARGIN_PX;
+    if (x < 0) return; // 창이 너무 작으면 생략
+
+    glBindFramebuffer(GL_FRAMEBUFFER, targetFBO);
+    glViewport(x, y, width, height);
+    glDisable(GL_DEPTH_TEST);
+    glDisable(GL_BLEND);
+
+    compositeShader->use();
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, colorTex.get());
+    compositeShader->setInt("insetTex", 0);
+    glActiveTexture(GL_TEXTURE2);
+    glBindTexture(GL_TEXTURE_2D, exposureTex);
+    compositeShader->setInt("exposureTex", 2);
+    compositeShader->setInt("autoExposure", autoExposure ? 1 : 0);
+    compositeShader->setFloat("exposure", exposure);
+    compositeShader->setFloat("borderPx", (float)BORDER_PX);
+    glActiveTexture(GL_TEXTURE0);
+
+    glBindVertexArray(quadVAO);
+    glDrawArrays(GL_TRIANGLES, 0, 6);
+
+    glViewport(0, 0, screenWidth, screenHeight);
+}
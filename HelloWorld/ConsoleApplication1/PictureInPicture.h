@@ -0,0 +1,94 @@
+﻿#ifndef PICTURE_IN_PICTURE_H
+#define PICTURE_IN_PICTURE_H
+
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "GpuResource.h"
+
+class Shader;
+class CommandList;
+
+// =====================================================
+// PictureInPicture
+//  - 행성 추적 중에도 태양계 전체 모습을 보여 주는 보조 화면
+//  - 두 번째 카메라(태양 위 비스듬한 조감 시점)로 1/DOWNSCALE 해상도
+//    오프스크린 HDR 타깃에 그린 뒤, 최종 출력의 오른쪽 아래에 톤매핑하며 합성
+//  - 물리 계산은 다시 하지 않음: 주 패스가 이미 계산한 모델 행렬 / 위치를
+//    addBody() 로 받아 두고, 보조 카메라 절두체 + 화면 크기로만 걸러서 그림
+//  - 장면이 바뀌지 않은 프레임(합성만 다시 하는 경우)은 타깃을 그대로 재사용
+// =====================================================
+class PictureInPicture
+{
+public:
+    static const int DOWNSCALE = 4;       // 주 화면 대비 축소 비율
+    static const int MARGIN_PX = 16;      // 화면 가장자리와의 간격
+    static const int BORDER_PX = 2;       // 테두리 두께
+
+    PictureInPicture();
+
+    // 렌더 타깃 생성 (주 화면 해상도 기준)
+    void init(int mainWidth, int mainHeight);
+
+    // scene: 천체 / line: 궤도선 / composite: 합성 (quadVert 사용)
+    void setShaders(Shader* scene, Shader* line, Shader* composite);
+
+    // 이번 프레임 목록 비우기 (주 패스 시작 시)
+    void begin();
+
+    // 주 패스에서 계산한 천체 (minPixels > 0 이면 작아도 그 크기까지 키워서 보이게,
+    // 0 이면 반 픽셀보다 작을 때 생략)
+    void addBody(const glm::mat4& model, const glm::vec3& center, float radius,
+        unsigned int texture, float emission, float minPixels);
+
+    // 궤도선 (주 패스와 같은 정점 배열을 가리키기만 함, 프레임 끝까지 유효해야 함)
+    void addOrbit(const std::vector<glm::vec3>* path, bool highlight);
+
+    // 보조 카메라를 focus(추적 대상) 기준으로 맞추고 그리기 명령 기록
+    void record(CommandList& cmd, const glm::vec3& focus,
+        unsigned int sphereVAO, unsigned int sphereIndexCount,
+        unsigned int ringShadowArray);
+
+    // 결과를 targetFBO 의 오른쪽 아래에 합성 (viewport 는 호출 측에서 복원)
+    void composite(unsigned int targetFBO, int screenWidth, int screenHeight,
+        unsigned int quadVAO, unsigned int exposureTex, bool autoExposure, float exposure);
+
+    int getDrawnBodies() const { return drawnBodies; }
+    int getCulledBodies() const { return culledBodies; }
+
+private:
+    struct Body
+    {
+        glm::mat4 model;
+        glm::vec3 center;
+        float radius;
+        unsigned int texture;
+        float emission;
+        float minPixels;
+    };
+
+    struct Orbit
+    {
+        const std::vector<glm::vec3>* path;
+        bool highlight;
+    };
+
+    int width, height;
+
+    GpuRenderTexture colorTex;
+    GpuRenderbuffer depthBuffer;
+    GpuFramebuffer fbo;
+
+    Shader* sceneShader;
+    Shader* lineShader;
+    Shader* compositeShader;
+
+    std::vector<Body> bodies;
+    std::vector<Orbit> orbits;
+    glm::vec3 marker[6];              // 추적 대상 십자 표시
+
+    int drawnBodies;
+    int culledBodies;
+};
+
+#endif
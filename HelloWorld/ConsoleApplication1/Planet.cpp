@@ -1,6 +1,6 @@
 ﻿#include "Planet.h"
 #include "Shader.h"
-#include "Texture.h"
+#include "CommandList.h"
 
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/constants.hpp>
@@ -9,31 +9,9 @@
 
 Planet::Planet(const PlanetParams& p)
 	: params(p),         // 행성 파라미터 복사
-	spinAngleDeg(0.0f),  // 자전 각도 초기화
     generatedOrbit(false) 
 {
-    if (params.ring.enabled)
-    {
-        unsigned int texID = 0;
-
-        if (!params.ring.texturePath.empty())
-        {
-            texID = loadTexture(params.ring.texturePath);
-            params.ring.textureID = texID;   // 나중에 필요하면 참조
-        }
-        else
-        {
-            texID = params.ring.textureID;   // fallback (이미 ID가 세팅된 경우)
-        }
-
-		// 고리 객체 생성 및 초기화
-        ring = new PlanetRing();
-		// 외부에서 텍스처 ID를 전달받아 초기화
-        ring->init(texID,
-            params.ring.innerRadius,
-            params.ring.outerRadius,
-            params.ring.alpha);
-    }
+	// 고리 메쉬/텍스처는 RingRenderer 가 모든 행성에 대해 공유
 }
 
 void Planet::addSatellite(const Satellite& s)
@@ -47,31 +25,11 @@ glm::vec3 Planet::positionAroundSun(float tYears) const
 	return params.orbit.positionAtTime(tYears); // 궤도 요소로부터 위치 계산
 }
 
-// 궤도 경로를 그리는 헬퍼 함수
-static void drawLineStrip(const std::vector<glm::vec3>& pts)
+// 궤도 경로를 그리는 헬퍼 함수 (정점은 명령 목록에 복사되어 한 번에 업로드)
+static void drawLineStrip(CommandList& cmd, const std::vector<glm::vec3>& pts)
 {
     if (pts.size() < 2) return;
-
-    unsigned int vao, vbo;
-
-    glGenVertexArrays(1, &vao);
-    glGenBuffers(1, &vbo);
-
-    glBindVertexArray(vao);
-    glBindBuffer(GL_ARRAY_BUFFER, vbo);
-    glBufferData(GL_ARRAY_BUFFER,
-        pts.size() * sizeof(glm::vec3),
-        pts.data(),
-        GL_DYNAMIC_DRAW);
-
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE,
-        sizeof(glm::vec3), (void*)0);
-    glEnableVertexAttribArray(0);
-
-    glDrawArrays(GL_LINE_STRIP, 0, (GLsizei)pts.size());
-
-    glDeleteVertexArrays(1, &vao);
-    glDeleteBuffers(1, &vbo);
+    cmd.drawTransient(Primitive::LineStrip, pts.data(), (int)pts.size());
 }
 
 // 주어진 위치에 가장 가까운 궤도 점의 인덱스 찾기
@@ -95,42 +53,39 @@ static int findClosestPointIndex(const std::vector<glm::vec3>& path,
 	return idx; // 가장 가까운 점의 인덱스 반환
 }
 
-void Planet::drawTrail(const Shader& shader,
+void Planet::drawTrail(CommandList& cmd,
+	const Shader& shader,
 	const glm::mat4& view, // 뷰 매트릭스
 	const glm::mat4& proj, // 투영 매트릭스
 	float tYears) const    // 경과 시간 (년 단위)
 {
-    shader.use();
-    shader.setMat4("view", view);
-    shader.setMat4("proj", proj);
+	// 궤도선은 깊이 테스트 없이 그림
+    cmd.setPipeline(makePipeline(shader.ID, BlendMode::Opaque, false));
+    cmd.setMat4("view", view);
+    cmd.setMat4("proj", proj);
 
     glm::mat4 model(1.0f);
-	shader.setMat4("model", model); // 단위 행렬
-
-	// 궤도 경로 생성
-    if (!generatedOrbit)
-    {
-		// 기본 궤도 경로 (XY 평면)
-        std::vector<glm::vec3> basePath = buildOrbitPath(params.orbit);
+	cmd.setMat4("model", model); // 단위 행렬
 
-		// XY 평면에서 XZ 평면으로 변환 매트릭스
-        glm::mat4 orbitToXZ =
-            glm::rotate(glm::mat4(1.0f),
-                -glm::half_pi<float>(),
-                glm::vec3(1, 0, 0));
+    std::vector<glm::vec3> part;
+    const std::vector<glm::vec3>& path = trailGeometry(tYears, part);
 
-        orbitPath.clear();
-        orbitPath.reserve(basePath.size());
-
-		// 변환 적용
-        for (auto& p : basePath)
-        {
-			glm::vec4 v = orbitToXZ * glm::vec4(p, 1.0f); // XZ 평면으로 변환
-			orbitPath.push_back(glm::vec3(v));            // vec3로 변환하여 저장
-        }
+    cmd.setVec3("color", glm::vec3(1, 1, 1));
+    drawLineStrip(cmd, path);
 
-        generatedOrbit = true;
+    if (!part.empty())
+    {
+        cmd.setVec3("color", glm::vec3(0, 1, 0));
+        drawLineStrip(cmd, part);
     }
+}
+
+// 궤도선 정점 계산
+const std::vector<glm::vec3>& Planet::trailGeometry(float tYears,
+    std::vector<glm::vec3>& progress) const
+{
+    progress.clear();
+    orbitGeometry();
 
 	// 현재 위치에 가장 가까운 궤도 점 찾기
     glm::mat4 orbitToXZ =
@@ -145,56 +100,44 @@ void Planet::drawTrail(const Shader& shader,
 	// 가장 가까운 궤도 점 인덱스 찾기
     int idx = findClosestPointIndex(orbitPath, currPos);
 
-    glDisable(GL_DEPTH_TEST);
-
-    shader.setVec3("color", glm::vec3(1, 1, 1));
-    drawLineStrip(orbitPath);
-
 	if (idx > 1) // 유효한 인덱스인 경우
     {
-        std::vector<glm::vec3> part;
-        part.reserve(idx);
+        progress.reserve(idx + 1);
 
         for (int i = 0; i < idx; i++)
-            part.push_back(orbitPath[i]);
+            progress.push_back(orbitPath[i]);
 
-        part.push_back(currPos);
-
-        shader.setVec3("color", glm::vec3(0, 1, 0));
-        drawLineStrip(part);
+        progress.push_back(currPos);
     }
-
-    glEnable(GL_DEPTH_TEST);
+    return orbitPath;
 }
 
-// 자전 업데이트
-void Planet::advanceSpin(float dtSec) const
+// 전체 궤도선 정점 (처음 호출 시 생성)
+const std::vector<glm::vec3>& Planet::orbitGeometry() const
 {
-    spinAngleDeg += params.spinDegPerSec * dtSec;
-}
-
-// 행성 모델 매트릭스 생성
-glm::mat4 Planet::buildModelMatrix(float scale, const glm::vec3& worldPos) const
-{
-    glm::mat4 m(1.0f);
-	m = glm::translate(m, worldPos); // 위치 변환
-
-    float precessionSpeed = glm::radians(360.0f / 25772.0f);  // 라디안/년
+	// 궤도 경로 생성
+    if (!generatedOrbit)
+    {
+		// 기본 궤도 경로 (XY 평면)
+        std::vector<glm::vec3> basePath = buildOrbitPath(params.orbit);
 
-	extern float gTimeYears; // 전역 시뮬레이션 시간 (년 단위)
-	float precessionAngle = precessionSpeed * gTimeYears; // 세차 각도 계산
+		// XY 평면에서 XZ 평면으로 변환 매트릭스
+        glm::mat4 orbitToXZ =
+            glm::rotate(glm::mat4(1.0f),
+                -glm::half_pi<float>(),
+                glm::vec3(1, 0, 0));
 
-	// 세차, 자전축 기울기, 자전 변환 적용
-    m = glm::rotate(m, precessionAngle, glm::vec3(0, 1, 0));
-    m = glm::rotate(m,
-        glm::radians(params.axialTiltDeg),
-        glm::vec3(0, 0, 1));
-    m = glm::rotate(m,
-        glm::radians(spinAngleDeg),
-        glm::vec3(0, 1, 0));
+        orbitPath.clear();
+        orbitPath.reserve(basePath.size());
 
-	// 스케일 변환 적용
-    m = glm::scale(m, glm::vec3(params.radiusRender * scale));
+		// 변환 적용
+        for (auto& p : basePath)
+        {
+			glm::vec4 v = orbitToXZ * glm::vec4(p, 1.0f); // XZ 평면으로 변환
+			orbitPath.push_back(glm::vec3(v));            // vec3로 변환하여 저장
+        }
 
-    return m;
+        generatedOrbit = true;
+    }
+    return orbitPath;
 }
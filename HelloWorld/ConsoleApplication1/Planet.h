@@ -7,9 +7,9 @@
 
 #include "Orbit.h"
 #include "Satellite.h"
-#include "planetRing.h"
 
 class Shader;
+class CommandList;
 
 // =====================================================
 // ⭐ RingParams — PlanetParams보다 먼저 선언
@@ -20,8 +20,41 @@ struct RingParams {
 	float outerRadius = 1.5f;// 고리 외경
 	float alpha = 1.0f;      // 고리 투명도
 
-    unsigned int textureID = 0;   // 실제 OpenGL 텍스처 ID
     std::string texturePath;      // main.cpp에서 경로만 세팅
+    int textureLayer = -1;        // RingRenderer 텍스처 배열 레이어 (-1 = 미등록)
+};
+
+// =====================================================
+// ⭐ AtmosphereParams — 대기 산란 파라미터
+//  - 길이는 모두 행성 반지름 = 1 기준 (렌더링 크기와 무관)
+//  - 산란 계수는 "행성 반지름당" 값 (두께를 과장하면 계수를 같은 비율로 줄임)
+// =====================================================
+struct AtmosphereParams {
+    bool enabled = false;                   // 대기 활성화 여부
+    float thickness = 0.06f;                // 대기 두께 (반지름 대비)
+    float rayleighScaleHeight = 0.008f;     // 레일리 밀도 척도 높이
+    float mieScaleHeight = 0.0012f;         // 미 산란 밀도 척도 높이
+    glm::vec3 rayleighScattering = glm::vec3(5.86f, 13.6f, 33.4f); // 레일리 산란 계수 (RGB)
+    float mieScattering = 21.2f;            // 미 산란 계수
+    float mieG = 0.76f;                     // 미 산란 비대칭 계수
+    float sunIntensity = 20.0f;             // 대기에 들어오는 햇빛 세기
+
+    std::string nightTexturePath;           // 밤 쪽 도시 불빛 (비어 있으면 없음)
+    std::string cloudTexturePath;           // 구름/대기층 텍스처 (비어 있으면 없음)
+    float cloudOpacity = 0.0f;              // 구름 텍스처를 지표 위에 섞는 비율
+
+    int lutLayer = -1;                      // AtmosphereRenderer LUT 레이어 (-1 = 미등록)
+};
+
+// =====================================================
+// ⭐ TerrainParams — 근접 지형 (PlanetTerrain)
+//  - 높이는 행성 반지름 = 1 기준
+//  - tileDir 에 없는 타일은 기본 텍스처 + 펄린 노이즈로 생성
+// =====================================================
+struct TerrainParams {
+    bool enabled = false;                   // 근접 지형 사용 여부
+    float heightScale = 0.004f;             // 최대 높이 (반지름 대비)
+    std::string tileDir;                    // 타일 폴더 (비어 있으면 항상 생성)
 };
 
 // =====================================================
@@ -39,6 +72,8 @@ struct PlanetParams
 	float axialTiltDeg = 0.0f; // 자전축 기울기 (도)
 
     RingParams ring;           // 고리 정보
+    AtmosphereParams atmosphere; // 대기 정보
+    TerrainParams terrain;       // 근접 지형 정보
 };
 
 class Planet
@@ -60,27 +95,30 @@ public:
 	// 행성의 자전축 방향 계산
     float orbitProgress(float tYears) const;
 
-	// 행성 궤도 그리기
-    void drawTrail(const Shader& shader,
+	// 행성 궤도 그리기 (명령 목록에 기록, 작업 스레드에서 호출 가능)
+    void drawTrail(CommandList& cmd,
+        const Shader& shader,
         const glm::mat4& view,
         const glm::mat4& proj,
         float tYears) const;
 
-	// 자전 업데이트
-    void advanceSpin(float dtSec) const;
+	// 궤도선 정점 (XZ 평면): 전체 궤도를 반환하고 현재 위치까지의 진행 구간을 progress 에 채움
+    const std::vector<glm::vec3>& trailGeometry(float tYears,
+        std::vector<glm::vec3>& progress) const;
+
+	// 전체 궤도선 정점만 (XZ 평면, 처음 한 번 생성 후 캐시)
+    const std::vector<glm::vec3>& orbitGeometry() const;
 
-	// 행성 모델 매트릭스 생성
-    glm::mat4 buildModelMatrix(float scale,
-        const glm::vec3& worldPos) const;
+    // 고리 텍스처 레이어 지정 (RingRenderer::addLayer 결과)
+    void setRingTextureLayer(int layer) { params.ring.textureLayer = layer; }
 
-    // 고리 객체 포인터 (main에서 바로 접근 가능하도록)
-    PlanetRing* ring = nullptr;
+    // 대기 LUT 레이어 지정 (AtmosphereRenderer::addAtmosphere 결과)
+    void setAtmosphereLayer(int layer) { params.atmosphere.lutLayer = layer; }
 
 private:
     PlanetParams params;
     std::vector<Satellite> sats;
 
-	mutable float spinAngleDeg;               // 자전 각도 (도)
 	mutable bool generatedOrbit = false;      // 궤도 경로 생성 여부
 	mutable std::vector<glm::vec3> orbitPath; // 궤도 경로 점들
 };
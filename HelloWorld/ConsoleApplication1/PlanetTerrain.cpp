@@ -0,0 +1,669 @@
+﻿#include "PlanetTerrain.h"
+#include "Planet.h"
+#include "Shader.h"
+
+#include "stb_image.h"
+
+#define STB_PERLIN_IMPLEMENTATION
+#include "stb_perlin.h"
+
+#include <GL/glew.h>
+#include <glm/gtc/constants.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <iostream>
+
+// =====================================================
+// 정육면체 구 좌표
+//  - 면 번호: +X, -X, +Y, -Y, +Z, -Z
+//  - 면 안의 좌표 (u, v) 0~1, cross(U, V) = N (바깥에서 보면 반시계)
+//  - 셰이더의 FACE_N / FACE_U / FACE_V 와 같은 순서
+// =====================================================
+static const glm::vec3 FACE_N[6] = {
+    { 1, 0, 0 }, { -1, 0, 0 }, { 0, 1, 0 }, { 0, -1, 0 }, { 0, 0, 1 }, { 0, 0, -1 } };
+static const glm::vec3 FACE_U[6] = {
+    { 0, 0, -1 }, { 0, 0, 1 }, { 1, 0, 0 }, { 1, 0, 0 }, { 1, 0, 0 }, { -1, 0, 0 } };
+static const glm::vec3 FACE_V[6] = {
+    { 0, 1, 0 }, { 0, 1, 0 }, { 0, 0, -1 }, { 0, 0, 1 }, { 0, 1, 0 }, { 0, 1, 0 } };
+
+static glm::vec3 cubeDir(int face, float u, float v)
+{
+    return glm::normalize(FACE_N[face] + (2.0f * u - 1.0f) * FACE_U[face]
+        + (2.0f * v - 1.0f) * FACE_V[face]);
+}
+
+// 키: 면(3비트) | 레벨(5비트) | x(28비트) | y(28비트)
+static uint64_t tileKey(int face, int level, int x, int y)
+{
+    return ((uint64_t)face << 61) | ((uint64_t)level << 56) | ((uint64_t)x << 28) | (uint64_t)y;
+}
+
+static int keyFace(uint64_t key) { return (int)(key >> 61); }
+static int keyLevel(uint64_t key) { return (int)((key >> 56) & 31); }
+static int keyX(uint64_t key) { return (int)((key >> 28) & 0xFFFFFFF); }
+static int keyY(uint64_t key) { return (int)(key & 0xFFFFFFF); }
+
+// 높이 함수: 방향만으로 결정 → 레벨 / 면이 달라도 같은 지점은 같은 높이 (틈 없음)
+static float terrainHeight(const glm::vec3& d)
+{
+    float n = stb_perlin_fbm_noise3(d.x * 4.0f, d.y * 4.0f, d.z * 4.0f, 2.0f, 0.5f, 12);
+    return glm::clamp(0.5f + 0.6f * n, 0.0f, 1.0f);
+}
+
+// 128 → 1 밉맵 개수
+static int albedoLevels()
+{
+    int levels = 1;
+    for (int s = PlanetTerrain::ALBEDO_SIZE; s > 1; s /= 2) levels++;
+    return levels;
+}
+
+// =====================================================
+// TerrainTileLoader
+// =====================================================
+TerrainTileLoader::TerrainTileLoader()
+    : quit(false), tilesBuilt(0), tilesFromDisk(0)
+{
+}
+
+TerrainTileLoader::~TerrainTileLoader()
+{
+    stop();
+}
+
+void TerrainTileLoader::start(int threadCount)
+{
+    quit = false;
+    for (int i = 0; i < threadCount; i++)
+        workers.emplace_back(&TerrainTileLoader::workerLoop, this);
+}
+
+void TerrainTileLoader::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        quit = true;
+        queue.clear();
+    }
+    cond.notify_all();
+    for (auto& t : workers)
+        t.join();
+    workers.clear();
+}
+
+void TerrainTileLoader::setSource(const std::string& baseTexturePath, const std::string& tileDir)
+{
+    // 기본 텍스처 디코딩은 작업 스레드가 첫 타일에서 기다림 (메인 스레드는 멈추지 않음)
+    auto decode = [baseTexturePath]() {
+        auto img = std::make_shared<BaseImage>();
+        int channels = 0;
+        unsigned char* data = stbi_load(baseTexturePath.c_str(), &img->width, &img->height, &channels, 3);
+        if (data)
+        {
+            img->rgb.assign(data, data + (size_t)img->width * img->height * 3);
+            stbi_image_free(data);
+        }
+        else
+        {
+            std::cerr << "[Terrain] Failed to load base texture: " << baseTexturePath << "\n";
+            img->width = img->height = 0;
+        }
+        return std::shared_ptr<const BaseImage>(img);
+    };
+
+    auto src = std::make_shared<Source>();
+    src->tileDir = tileDir;
+    src->base = std::async(std::launch::async, decode).share();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    source = src;
+    queue.clear();
+    busy.clear();
+    done.clear();
+}
+
+void TerrainTileLoader::setWanted(const std::vector<uint64_t>& keys)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        queue.clear();
+        for (uint64_t k : keys)
+            if (!busy.count(k))
+                queue.push_back(k);
+    }
+    cond.notify_all();
+}
+
+void TerrainTileLoader::poll(std::vector<TerrainTile>& out, int maxTiles)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    int n = std::min(maxTiles, (int)done.size());
+    for (int i = 0; i < n; i++)
+    {
+        busy.erase(done[i].key);
+        out.push_back(std::move(done[i]));
+    }
+    done.erase(done.begin(), done.begin() + n);
+}
+
+void TerrainTileLoader::workerLoop()
+{
+    for (;;)
+    {
+        uint64_t key;
+        std::shared_ptr<const Source> src;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            cond.wait(lock, [this] { return quit || (!queue.empty() && source); });
+            if (quit) return;
+
+            key = queue.front();
+            queue.pop_front();
+            busy.insert(key);
+            src = source;
+        }
+
+        TerrainTile tile = build(*src, key);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (src != source)
+            continue; // 그사이 행성이 바뀜 (busy 는 setSource 가 이미 비움)
+        tilesBuilt++;
+        if (tile.fromDisk) tilesFromDisk++;
+        done.push_back(std::move(tile));
+    }
+}
+
+TerrainTile TerrainTileLoader::build(const Source& src, uint64_t key)
+{
+    const int HS = PlanetTerrain::HEIGHT_SIZE;
+    const int AS = PlanetTerrain::ALBEDO_SIZE;
+
+    int face = keyFace(key), level = keyLevel(key), x = keyX(key), y = keyY(key);
+    float size = 1.0f / (float)(1 << level);
+    float u0 = x * size, v0 = y * size;
+
+    TerrainTile tile;
+    tile.key = key;
+
+    // 1) 디스크 타일: <tileDir>/<면>/<레벨>/<x>_<y>.png (16비트 회색 높이) / .jpg (색)
+    //    첫 행 = 패치 v = 0, 크기가 맞지 않으면 무시하고 생성
+    std::vector<unsigned char> albedo0;
+    if (!src.tileDir.empty())
+    {
+        char name[256];
+        snprintf(name, sizeof(name), "%s/%d/%d/%d_%d", src.tileDir.c_str(), face, level, x, y);
+
+        int w, h, c;
+        stbi_us* hd = stbi_load_16((std::string(name) + ".png").c_str(), &w, &h, &c, 1);
+        if (hd && w == HS && h == HS)
+        {
+            tile.height.resize((size_t)HS * HS);
+            for (size_t i = 0; i < tile.height.size(); i++)
+                tile.height[i] = hd[i] / 65535.0f;
+        }
+        if (hd) stbi_image_free(hd);
+
+        unsigned char* ad = stbi_load((std::string(name) + ".jpg").c_str(), &w, &h, &c, 4);
+        if (ad && w == AS && h == AS)
+            albedo0.assign(ad, ad + (size_t)AS * AS * 4);
+        if (ad) stbi_image_free(ad);
+
+        tile.fromDisk = !tile.height.empty() && !albedo0.empty();
+    }
+
+    // 2) 생성: 높이 = 방향의 fbm 노이즈 (가장자리 텍셀 = 패치 가장자리 정점)
+    if (tile.height.empty())
+    {
+        tile.height.resize((size_t)HS * HS);
+        for (int j = 0; j < HS; j++)
+            for (int i = 0; i < HS; i++)
+            {
+                glm::vec3 d = cubeDir(face, u0 + size * i / (HS - 1), v0 + size * j / (HS - 1));
+                tile.height[(size_t)j * HS + i] = terrainHeight(d);
+            }
+    }
+
+    // 색 = 기본 텍스처(등장방형, createSphere 와 같은 UV) 쌍선형 + 잔 노이즈
+    if (albedo0.empty())
+    {
+        std::shared_ptr<const BaseImage> base = src.base.get();
+        albedo0.resize((size_t)AS * AS * 4);
+
+        for (int j = 0; j < AS; j++)
+            for (int i = 0; i < AS; i++)
+            {
+                glm::vec3 d = cubeDir(face, u0 + size * (i + 0.5f) / AS, v0 + size * (j + 0.5f) / AS);
+                glm::vec3 color(0.5f);
+
+                if (base->width > 0)
+                {
+                    float u = atan2f(d.z, d.x) / glm::two_pi<float>();
+                    u -= floorf(u);
+                    float v = acosf(glm::clamp(d.y, -1.0f, 1.0f)) / glm::pi<float>();
+
+                    float fx = u * base->width - 0.5f;
+                    float fy = glm::clamp(v * base->height - 0.5f, 0.0f, (float)(base->height - 1));
+                    int x0 = (int)floorf(fx), y0 = (int)fy;
+                    float tx = fx - x0, ty = fy - y0;
+                    int y1 = std::min(y0 + 1, base->height - 1);
+                    int xa = (x0 % base->width + base->width) % base->width;
+                    int xb = (xa + 1) % base->width;
+
+                    auto texel = [&](int px, int py) {
+                        const unsigned char* p = &base->rgb[((size_t)py * base->width + px) * 3];
+                        return glm::vec3(p[0], p[1], p[2]) / 255.0f;
+                    };
+                    color = glm::mix(glm::mix(texel(xa, y0), texel(xb, y0), tx),
+                        glm::mix(texel(xa, y1), texel(xb, y1), tx), ty);
+                }
+
+                float detail = stb_perlin_fbm_noise3(d.x * 256.0f, d.y * 256.0f, d.z * 256.0f, 2.0f, 0.5f, 6);
+                color *= 0.9f + 0.2f * detail;
+
+                unsigned char* out = &albedo0[((size_t)j * AS + i) * 4];
+                out[0] = (unsigned char)(glm::clamp(color.r, 0.0f, 1.0f) * 255.0f + 0.5f);
+                out[1] = (unsigned char)(glm::clamp(color.g, 0.0f, 1.0f) * 255.0f + 0.5f);
+                out[2] = (unsigned char)(glm::clamp(color.b, 0.0f, 1.0f) * 255.0f + 0.5f);
+                out[3] = 255;
+            }
+    }
+
+    // 3) 밉맵 (2x2 평균, 큰 것부터 이어 붙임)
+    tile.albedo = albedo0;
+    size_t prev = 0;
+    for (int s = AS / 2; s >= 1; s /= 2)
+    {
+        size_t cur = tile.albedo.size();
+        tile.albedo.resize(cur + (size_t)s * s * 4);
+        const unsigned char* src0 = &tile.albedo[prev];
+        unsigned char* dst = &tile.albedo[cur];
+        int ps = s * 2;
+        for (int j = 0; j < s; j++)
+            for (int i = 0; i < s; i++)
+                for (int ch = 0; ch < 4; ch++)
+                {
+                    int sum = src0[((2 * j) * ps + 2 * i) * 4 + ch] + src0[((2 * j) * ps + 2 * i + 1) * 4 + ch]
+                        + src0[((2 * j + 1) * ps + 2 * i) * 4 + ch] + src0[((2 * j + 1) * ps + 2 * i + 1) * 4 + ch];
+                    dst[(j * s + i) * 4 + ch] = (unsigned char)((sum + 2) / 4);
+                }
+        prev = cur;
+    }
+
+    return tile;
+}
+
+// =====================================================
+// PlanetTerrain
+// =====================================================
+PlanetTerrain::PlanetTerrain()
+    : shader(nullptr), planet(nullptr), heightScale(0.0f), targeted(false), streaming(false),
+    view(1.0f), proj(1.0f), cameraPos(0.0f), pixelsPerUnit(0.0f), frame(0),
+    instanceCapacity(0), indexCount(0), camLocal(0.0f),
+    lastPatches(0), peakResident(0), tilesUploaded(0), tilesEvicted(0)
+{
+}
+
+PlanetTerrain::~PlanetTerrain()
+{
+    loader.stop();
+}
+
+void PlanetTerrain::init(int workerThreads)
+{
+    // 타일 텍스처 배열 (고정 용량 → 메모리 상한)
+    heightArray = GpuTexture("terrain height tiles");
+    glBindTexture(GL_TEXTURE_2D_ARRAY, heightArray.get());
+    glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_R16F, HEIGHT_SIZE, HEIGHT_SIZE, CAPACITY,
+        0, GL_RED, GL_FLOAT, nullptr);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, 0);
+    heightArray.setBytes(GpuRegistry::imageBytes(HEIGHT_SIZE, HEIGHT_SIZE, CAPACITY, 2, false));
+
+    albedoArray = GpuTexture("terrain albedo tiles");
+    glBindTexture(GL_TEXTURE_2D_ARRAY, albedoArray.get());
+    int levels = albedoLevels();
+    for (int l = 0, s = ALBEDO_SIZE; l < levels; l++, s = std::max(1, s / 2))
+        glTexImage3D(GL_TEXTURE_2D_ARRAY, l, GL_RGBA8, s, s, CAPACITY,
+            0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, levels - 1);
+    albedoArray.setBytes(GpuRegistry::imageBytes(ALBEDO_SIZE, ALBEDO_SIZE, CAPACITY, 4, true));
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+    slots.assign(CAPACITY, Slot());
+
+    // 패치 격자 (0~1, GRID x GRID 사각형, 대각선 방향 통일 → morph 하면 거친 격자와 일치)
+    std::vector<glm::vec2> verts;
+    for (int j = 0; j <= GRID; j++)
+        for (int i = 0; i <= GRID; i++)
+            verts.push_back(glm::vec2((float)i / GRID, (float)j / GRID));
+
+    std::vector<unsigned int> indices;
+    for (int j = 0; j < GRID; j++)
+        for (int i = 0; i < GRID; i++)
+        {
+            unsigned int a = j * (GRID + 1) + i, b = a + 1, c = a + GRID + 1, d = c + 1;
+            indices.insert(indices.end(), { a, b, d, a, d, c });
+        }
+    indexCount = (int)indices.size();
+
+    vao = GpuVertexArray("terrain VAO");
+    gridVBO = GpuBuffer("terrain grid");
+    gridEBO = GpuBuffer("terrain grid indices");
+    instanceVBO = GpuBuffer("terrain patches");
+
+    glBindVertexArray(vao.get());
+
+    glBindBuffer(GL_ARRAY_BUFFER, gridVBO.get());
+    glBufferData(GL_ARRAY_BUFFER, verts.size() * sizeof(glm::vec2), verts.data(), GL_STATIC_DRAW);
+    gridVBO.setBytes(verts.size() * sizeof(glm::vec2));
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(glm::vec2), (void*)0);
+    glEnableVertexAttribArray(0);
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, gridEBO.get());
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
+    gridEBO.setBytes(indices.size() * sizeof(unsigned int));
+
+    // location 1 = 패치 원점 / 크기 / 레이어, 2 = 면 / morph 범위 (인스턴스마다)
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVBO.get());
+    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(PatchInstance),
+        (void*)offsetof(PatchInstance, node));
+    glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, sizeof(PatchInstance),
+        (void*)offsetof(PatchInstance, info));
+    glEnableVertexAttribArray(1);
+    glEnableVertexAttribArray(2);
+    glVertexAttribDivisor(1, 1);
+    glVertexAttribDivisor(2, 1);
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    loader.start(workerThreads);
+}
+
+void PlanetTerrain::shutdown()
+{
+    loader.stop();
+}
+
+void PlanetTerrain::clearTiles()
+{
+    resident.clear();
+    slots.assign(CAPACITY, Slot());
+    arrived.clear();
+}
+
+void PlanetTerrain::beginFrame(const Planet* target,
+    const glm::mat4& viewMatrix, const glm::mat4& projMatrix,
+    const glm::vec3& camPos, float fovDeg, int viewportHeight)
+{
+    frame++;
+    view = viewMatrix;
+    proj = projMatrix;
+    cameraPos = camPos;
+    pixelsPerUnit = (float)viewportHeight * 0.5f / tanf(glm::radians(fovDeg) * 0.5f);
+
+    targeted = (target != nullptr && target->getParams().terrain.enabled);
+    streaming = false;
+    if (!targeted)
+    {
+        // 추적을 풀어도 올려 둔 타일은 유지 (같은 행성으로 돌아오면 그대로 사용)
+        loader.setWanted(std::vector<uint64_t>());
+        return;
+    }
+
+    if (target != planet)
+    {
+        planet = target;
+        heightScale = planet->getParams().terrain.heightScale;
+        clearTiles();
+        loader.setSource(planet->getParams().texturePath, planet->getParams().terrain.tileDir);
+    }
+
+    // 완성 타일 업로드 (프레임당 예산)
+    arrived.clear();
+    loader.poll(arrived, UPLOADS_PER_FRAME);
+    for (const TerrainTile& t : arrived)
+        upload(t);
+    streaming = !arrived.empty();
+
+    // 루트 타일이 다 오기 전까지는 루트만 요청 (그동안 구 메쉬로 그림)
+    if (!rootsReady())
+    {
+        std::vector<uint64_t> roots;
+        for (int face = 0; face < 6; face++)
+            if (!resident.count(tileKey(face, 0, 0, 0)))
+                roots.push_back(tileKey(face, 0, 0, 0));
+        loader.setWanted(roots);
+        streaming = true;
+    }
+}
+
+bool PlanetTerrain::rootsReady() const
+{
+    for (int face = 0; face < 6; face++)
+        if (!resident.count(tileKey(face, 0, 0, 0)))
+            return false;
+    return true;
+}
+
+bool PlanetTerrain::covers(const Planet* p, const glm::vec3& worldCenter, float worldRadius) const
+{
+    if (!targeted || p != planet || !rootsReady())
+        return false;
+    return glm::distance(cameraPos, worldCenter) < ACTIVE_DISTANCE * worldRadius;
+}
+
+// 레벨 L 이 쓰이는 최대 거리 (객체 공간): 한 단계 거친 레벨의 정점 간격이 TARGET_PIXELS 가 되는 거리
+float PlanetTerrain::levelRange(int level) const
+{
+    float spacing = glm::half_pi<float>() / (float)(1 << level) / (float)GRID;
+    return 2.0f * spacing * pixelsPerUnit / TARGET_PIXELS;
+}
+
+int PlanetTerrain::acquireSlot()
+{
+    int best = -1;
+    for (int i = 0; i < (int)slots.size(); i++)
+    {
+        const Slot& s = slots[i];
+        if (!s.used) return i;
+        // 이번 프레임에 쓴 타일 / 루트 타일은 교체하지 않음
+        if (s.lastUsed < frame && keyLevel(s.key) > 0 &&
+            (best < 0 || s.lastUsed < slots[best].lastUsed))
+            best = i;
+    }
+    if (best >= 0)
+    {
+        resident.erase(slots[best].key);
+        slots[best].used = false;
+        tilesEvicted++;
+    }
+    return best;
+}
+
+void PlanetTerrain::upload(const TerrainTile& tile)
+{
+    if (resident.count(tile.key)) return;
+
+    int layer = acquireSlot();
+    if (layer < 0) return; // 캐시가 이번 프레임 타일로 가득 참 → 버림 (필요하면 다시 요청됨)
+
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+    glBindTexture(GL_TEXTURE_2D_ARRAY, heightArray.get());
+    glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, layer, HEIGHT_SIZE, HEIGHT_SIZE, 1,
+        GL_RED, GL_FLOAT, tile.height.data());
+
+    glBindTexture(GL_TEXTURE_2D_ARRAY, albedoArray.get());
+    size_t offset = 0;
+    for (int l = 0, s = ALBEDO_SIZE; s >= 1; l++, s /= 2)
+    {
+        glTexSubImage3D(GL_TEXTURE_2D_ARRAY, l, 0, 0, layer, s, s, 1,
+            GL_RGBA, GL_UNSIGNED_BYTE, tile.albedo.data() + offset);
+        offset += (size_t)s * s * 4;
+    }
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+    Slot& slot = slots[layer];
+    slot.key = tile.key;
+    slot.lastUsed = frame;
+    slot.used = true;
+    resident[tile.key] = layer;
+
+    tilesUploaded++;
+    peakResident = std::max(peakResident, (int)resident.size());
+}
+
+void PlanetTerrain::select(int face, int level, int x, int y)
+{
+    float size = 1.0f / (float)(1 << level);
+    float u0 = x * size, v0 = y * size;
+
+    // 경계 구: 중심 방향 (높이 중간) + 네 모서리 (높이 0 / 최대)
+    glm::vec3 centerDir = cubeDir(face, u0 + 0.5f * size, v0 + 0.5f * size);
+    glm::vec3 center = centerDir * (1.0f + 0.5f * heightScale);
+    float radius = 0.5f * heightScale;
+    float capCos = 1.0f;
+    for (int c = 0; c < 4; c++)
+    {
+        glm::vec3 d = cubeDir(face, u0 + (c & 1) * size, v0 + (c >> 1) * size);
+        radius = std::max(radius, glm::length(d - center));
+        radius = std::max(radius, glm::length(d * (1.0f + heightScale) - center));
+        capCos = std::min(capCos, glm::dot(d, centerDir));
+    }
+
+    // 절두체
+    for (const glm::vec4& p : frustum)
+        if (glm::dot(glm::vec3(p), center) + p.w < -radius)
+            return;
+
+    // 지평선: 패치가 차지하는 각 + 카메라 지평선 각 + 최대 높이만큼 넘어간 각보다 멀면 가려짐
+    float camDist = glm::length(camLocal);
+    if (camDist > 1.0f)
+    {
+        float theta = acosf(glm::clamp(glm::dot(camLocal / camDist, centerDir), -1.0f, 1.0f));
+        float limit = acosf(capCos) + acosf(1.0f / camDist) + acosf(1.0f / (1.0f + heightScale));
+        if (theta > limit)
+            return;
+    }
+
+    uint64_t key = tileKey(face, level, x, y);
+    slots[resident[key]].lastUsed = frame;
+
+    float dist = std::max(0.0f, glm::length(camLocal - center) - radius);
+
+    if (level < MAX_LEVEL && dist < levelRange(level + 1))
+    {
+        bool ready = true;
+        for (int c = 0; c < 4; c++)
+        {
+            uint64_t child = tileKey(face, level + 1, 2 * x + (c & 1), 2 * y + (c >> 1));
+            if (!resident.count(child))
+            {
+                ready = false;
+                wanted.push_back({ child, level + 1, dist });
+            }
+        }
+
+        if (ready)
+        {
+            for (int c = 0; c < 4; c++)
+                select(face, level + 1, 2 * x + (c & 1), 2 * y + (c >> 1));
+            return;
+        }
+    }
+
+    float range = levelRange(level);
+    PatchInstance inst;
+    inst.node = glm::vec4(u0, v0, size, (float)resident[key]);
+    inst.info = glm::vec4((float)face, range * MORPH_START, range, 0.0f);
+    patches.push_back(inst);
+}
+
+void PlanetTerrain::render(const glm::mat4& model, const glm::mat4& prevModel)
+{
+    if (!shader) return;
+
+    // 객체 공간(반지름 1)에서 선택: 카메라 위치 + 절두체 평면 (Gribb-Hartmann)
+    camLocal = glm::vec3(glm::inverse(model) * glm::vec4(cameraPos, 1.0f));
+
+    glm::mat4 m = proj * view * model;
+    glm::vec4 row[4];
+    for (int i = 0; i < 4; i++)
+        row[i] = glm::vec4(m[0][i], m[1][i], m[2][i], m[3][i]);
+    for (int i = 0; i < 3; i++)
+    {
+        frustum[i * 2 + 0] = row[3] + row[i];
+        frustum[i * 2 + 1] = row[3] - row[i];
+    }
+    for (glm::vec4& p : frustum)
+        p /= glm::length(glm::vec3(p));
+
+    patches.clear();
+    wanted.clear();
+    for (int face = 0; face < 6; face++)
+        select(face, 0, 0, 0);
+
+    // 요청: 거친 레벨 → 가까운 것 순
+    std::sort(wanted.begin(), wanted.end(), [](const Wanted& a, const Wanted& b) {
+        return a.level != b.level ? a.level < b.level : a.distance < b.distance;
+    });
+    std::vector<uint64_t> keys;
+    for (int i = 0; i < (int)wanted.size() && i < MAX_WANTED; i++)
+        keys.push_back(wanted[i].key);
+    loader.setWanted(keys);
+    if (!keys.empty()) streaming = true;
+
+    lastPatches = (int)patches.size();
+    if (patches.empty()) return;
+
+    // 인스턴스 업로드 (버퍼 재할당으로 이전 프레임과 동기화 피함)
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVBO.get());
+    if (patches.size() > instanceCapacity)
+    {
+        instanceCapacity = patches.size() * 2;
+        instanceVBO.setBytes(instanceCapacity * sizeof(PatchInstance));
+    }
+    glBufferData(GL_ARRAY_BUFFER, instanceCapacity * sizeof(PatchInstance), nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, patches.size() * sizeof(PatchInstance), patches.data());
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    shader->use();
+    shader->setMat4("view", view);
+    shader->setMat4("proj", proj);
+    shader->setMat4("model", model);
+    shader->setMat4("prevModel", prevModel);
+    shader->setVec3("camLocal", camLocal);
+    shader->setFloat("heightScale", heightScale);
+
+    // 텍스처 배열: 고리 그림자(1) / 대기 LUT(4) 와 겹치지 않는 5, 6번 유닛
+    glActiveTexture(GL_TEXTURE5);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, albedoArray.get());
+    shader->setInt("albedoTiles", 5);
+    glActiveTexture(GL_TEXTURE6);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, heightArray.get());
+    shader->setInt("heightTiles", 6);
+    glActiveTexture(GL_TEXTURE0);
+
+    glBindVertexArray(vao.get());
+    glDrawElementsInstanced(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, 0, (GLsizei)patches.size());
+    glBindVertexArray(0);
+}
+
+void PlanetTerrain::report(std::ostream& os) const
+{
+    if (tilesUploaded == 0) return;
+    os << "[Terrain] " << loader.getTilesBuilt() << " tiles built (" << loader.getTilesFromDisk()
+        << " from disk), " << tilesUploaded << " uploaded, " << tilesEvicted << " evicted, peak "
+        << peakResident << "/" << CAPACITY << " resident, last frame " << lastPatches << " patches\n";
+}
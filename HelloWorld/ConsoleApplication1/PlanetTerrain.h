@@ -0,0 +1,218 @@
+﻿#ifndef PLANET_TERRAIN_H
+#define PLANET_TERRAIN_H
+
+#include <vector>
+#include <deque>
+#include <string>
+#include <memory>
+#include <future>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <unordered_map>
+#include <unordered_set>
+#include <cstdint>
+#include <ostream>
+#include <glm/glm.hpp>
+
+#include "GpuResource.h"
+
+class Shader;
+class Planet;
+
+// =====================================================
+// 지형 타일 (작업 스레드 → 메인 스레드)
+//  - 키: 정육면체 면 / 쿼드트리 레벨 / 면 안의 x, y
+//  - 높이: HEIGHT_SIZE^2 (0~1, 패치 정점과 가장자리 텍셀이 일치)
+//  - 색: ALBEDO_SIZE^2 RGBA8 + 밉맵 (큰 것부터 이어 붙임)
+// =====================================================
+struct TerrainTile
+{
+    uint64_t key = 0;
+    std::vector<float> height;
+    std::vector<unsigned char> albedo;
+    bool fromDisk = false;
+};
+
+// =====================================================
+// TerrainTileLoader
+//  - 작업 스레드가 타일을 디스크(tileDir/<면>/<레벨>/<x>_<y>.png / .jpg)에서 읽고,
+//    없으면 행성 기본 텍스처 + stb_perlin 노이즈로 생성
+//  - 메인 스레드는 매 프레임 원하는 타일 목록(우선순위 순)으로 대기열을 통째로 바꿈
+//    → 카메라가 지나간 뒤 필요 없어진 요청은 시작하지 않고 버림
+//  - 완성 타일은 poll()로 정해진 개수만 가져감 (업로드 예산은 호출 측)
+// =====================================================
+class TerrainTileLoader
+{
+public:
+    TerrainTileLoader();
+    ~TerrainTileLoader();
+
+    void start(int threadCount);
+    void stop();
+
+    // 행성 전환: 대기 / 완성 타일을 모두 버리고 기본 텍스처 디코딩 시작
+    void setSource(const std::string& baseTexturePath, const std::string& tileDir);
+
+    // 원하는 타일 (앞쪽이 먼저) — 이미 만드는 중이거나 완성된 키는 건너뜀
+    void setWanted(const std::vector<uint64_t>& keys);
+
+    // 완성 타일을 최대 maxTiles 개 꺼냄
+    void poll(std::vector<TerrainTile>& out, int maxTiles);
+
+    int getTilesBuilt() const { return tilesBuilt.load(); }
+    int getTilesFromDisk() const { return tilesFromDisk.load(); }
+
+private:
+    struct BaseImage
+    {
+        int width = 0, height = 0;
+        std::vector<unsigned char> rgb;
+    };
+
+    struct Source
+    {
+        std::string tileDir;
+        std::shared_future<std::shared_ptr<const BaseImage>> base;
+    };
+
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable cond;
+    std::deque<uint64_t> queue;            // 아직 시작하지 않은 요청
+    std::unordered_set<uint64_t> busy;     // 만드는 중 + 완성 후 미수거
+    std::vector<TerrainTile> done;
+    std::shared_ptr<const Source> source;
+    bool quit;
+
+    std::atomic<int> tilesBuilt;
+    std::atomic<int> tilesFromDisk;
+
+    void workerLoop();
+    static TerrainTile build(const Source& src, uint64_t key);
+};
+
+// =====================================================
+// PlanetTerrain
+//  - 추적 중인 행성에 가까이 다가가면 구 메쉬 대신 정육면체 구(면 6개) 쿼드트리 지형을 그림
+//  - CDLOD: 모든 패치는 같은 (GRID+1)^2 격자, 레벨마다 거리 범위가 절반
+//    정점 셰이더가 범위 끝으로 갈수록 홀수 정점을 짝수 정점으로 모아(morph)
+//    한 단계 거친 이웃과 틈 없이 이어짐
+//  - 절두체 + 지평선 너머 패치는 CPU 에서 제외, 남은 패치는 인스턴싱 드로우 한 번
+//  - 타일은 고정 용량 텍스처 배열(CAPACITY 레이어)에 올리고 오래 안 쓴 것부터 교체
+//    자식 타일 4개가 모두 올라와야 세분 (그 전에는 부모 레벨로 그림)
+//  - 면 6개 루트 타일이 준비되기 전에는 covers() = false → 기존 구 메쉬로 그림
+// =====================================================
+class PlanetTerrain
+{
+public:
+    static const int GRID = 32;                  // 패치 한 변의 사각형 수 (셰이더와 같은 값)
+    static const int HEIGHT_SIZE = 2 * GRID + 1; // 높이 타일 크기 (정점 사이 텍셀 하나 더)
+    static const int ALBEDO_SIZE = 128;          // 색 타일 크기
+    static const int MAX_LEVEL = 10;             // 가장 세밀한 레벨
+    static const int CAPACITY = 384;             // 올려 둘 수 있는 타일 수
+    static const int UPLOADS_PER_FRAME = 8;      // 프레임당 업로드 타일 수
+    static const int MAX_WANTED = 32;            // 대기열에 넣는 요청 수
+    static constexpr float ACTIVE_DISTANCE = 4.0f;   // 이 거리(반지름 배수) 안에서 지형 사용
+    static constexpr float TARGET_PIXELS = 4.0f;     // 정점 간격 목표 (픽셀)
+    static constexpr float MORPH_START = 0.7f;       // 범위의 이 비율부터 morph 시작
+
+    PlanetTerrain();
+    ~PlanetTerrain();
+
+    void init(int workerThreads);
+    void shutdown();                             // 작업 스레드 정리 (컨텍스트 살아 있을 때)
+    void setShader(Shader* shaderPtr) { shader = shaderPtr; }
+    Shader* getShader() const { return shader; }
+
+    // 장면 프레임마다 (행성 루프 전): 대상 행성 지정(nullptr = 없음) + 완성 타일 업로드
+    void beginFrame(const Planet* planet,
+        const glm::mat4& view, const glm::mat4& proj,
+        const glm::vec3& camPos, float fovDeg, int viewportHeight);
+
+    // 이 행성을 지형으로 그려야 하는지 (대상 + 루트 준비 + 가까움)
+    bool covers(const Planet* planet, const glm::vec3& worldCenter, float worldRadius) const;
+
+    // 패치 선택 → 부족한 타일 요청 → 인스턴싱 드로우
+    //  - 조명 / 대기 / 그림자 / 움직임 벡터 uniform 은 호출 측에서 설정 (sceneShader 와 같은 이름)
+    void render(const glm::mat4& model, const glm::mat4& prevModel);
+
+    // 타일을 기다리거나 받는 중인지 (렌더 온 디맨드에서도 계속 그려야 함)
+    bool isStreaming() const { return streaming; }
+
+    int getLastPatches() const { return lastPatches; }
+    int getResidentTiles() const { return (int)resident.size(); }
+
+    void report(std::ostream& os) const;
+
+private:
+    struct Slot
+    {
+        uint64_t key = 0;
+        int lastUsed = -1;       // 마지막으로 쓴 프레임
+        bool used = false;
+    };
+
+    struct PatchInstance         // 셰이더 인스턴스 속성 (location 1, 2)
+    {
+        glm::vec4 node;          // 면 안의 원점 u, v / 크기 / 높이·색 타일 레이어
+        glm::vec4 info;          // 면 번호 / morph 시작 / morph 끝 / 0
+    };
+
+    struct Wanted
+    {
+        uint64_t key;
+        int level;
+        float distance;
+    };
+
+    Shader* shader;
+    TerrainTileLoader loader;
+
+    const Planet* planet;        // 타일 캐시가 속한 행성
+    float heightScale;
+    bool targeted;               // 이번 프레임에 지형 대상이 있는지
+    bool streaming;
+
+    glm::mat4 view, proj;
+    glm::vec3 cameraPos;
+    float pixelsPerUnit;
+    int frame;
+
+    // 타일 캐시
+    GpuTexture heightArray;
+    GpuTexture albedoArray;
+    std::vector<Slot> slots;
+    std::unordered_map<uint64_t, int> resident;  // 키 → 레이어
+    std::vector<TerrainTile> arrived;
+
+    // 패치 격자 + 인스턴스
+    GpuVertexArray vao;
+    GpuBuffer gridVBO;
+    GpuBuffer gridEBO;
+    GpuBuffer instanceVBO;
+    size_t instanceCapacity;
+    int indexCount;
+
+    std::vector<PatchInstance> patches;
+    std::vector<Wanted> wanted;
+
+    // 선택 중 사용 (객체 공간 = 반지름 1)
+    glm::vec3 camLocal;
+    glm::vec4 frustum[6];
+
+    int lastPatches;
+    int peakResident;
+    int tilesUploaded;
+    int tilesEvicted;
+
+    bool rootsReady() const;
+    float levelRange(int level) const;
+    void select(int face, int level, int x, int y);
+    int acquireSlot();
+    void upload(const TerrainTile& tile);
+    void clearTiles();
+};
+
+#endif
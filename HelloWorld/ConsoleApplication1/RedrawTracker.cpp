@@ -0,0 +1,64 @@
+﻿#include "RedrawTracker.h"
+
+RedrawTracker::RedrawTracker()
+    : enabled(true), hasLast(false), sceneDirty(true), compositeDirty(false),
+    exposureSettleSec(0.0f), sceneSettleFrames(0), sceneFrames(0), compositeFrames(0), idleFrames(0)
+{
+}
+
+void RedrawTracker::setEnabled(bool on)
+{
+    enabled = on;
+    sceneDirty = true;
+}
+
+// 부동소수 값도 그대로 비교: 입력이 멈추면 같은 계산에서 같은 비트가 나옴
+bool RedrawTracker::sameScene(const RedrawState& a, const RedrawState& b)
+{
+    return a.simYears == b.simYears &&
+        a.view == b.view &&
+        a.fov == b.fov &&
+        a.width == b.width &&
+        a.height == b.height &&
+        a.trackingIndex == b.trackingIndex;
+}
+
+RedrawLevel RedrawTracker::update(const RedrawState& state, float dtSec)
+{
+    RedrawLevel level = RedrawLevel::None;
+
+    if (!enabled || sceneDirty || !hasLast || !sameScene(state, last))
+    {
+        level = RedrawLevel::Scene;
+        exposureSettleSec = state.autoExposure ? EXPOSURE_SETTLE_SEC : 0.0f;
+        sceneSettleFrames = state.settleSceneFrames;
+    }
+    else if (sceneSettleFrames > 0)
+    {
+        level = RedrawLevel::Scene;
+        sceneSettleFrames--;
+    }
+    else if (compositeDirty || state.autoExposure != last.autoExposure)
+    {
+        // 노출 모드만 바뀜: 새로 켜졌다면 처음부터 다시 수렴
+        level = RedrawLevel::Composite;
+        if (state.autoExposure && !last.autoExposure)
+            exposureSettleSec = EXPOSURE_SETTLE_SEC;
+    }
+    else if (state.autoExposure && exposureSettleSec > 0.0f)
+    {
+        level = RedrawLevel::Composite;
+        exposureSettleSec -= dtSec;
+    }
+
+    last = state;
+    hasLast = true;
+    sceneDirty = false;
+    compositeDirty = false;
+
+    if (level == RedrawLevel::Scene) sceneFrames++;
+    else if (level == RedrawLevel::Composite) compositeFrames++;
+    else idleFrames++;
+
+    return level;
+}
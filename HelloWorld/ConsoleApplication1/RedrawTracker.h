@@ -0,0 +1,75 @@
+﻿#ifndef REDRAW_TRACKER_H
+#define REDRAW_TRACKER_H
+
+#include <glm/glm.hpp>
+
+// 이번 프레임에 다시 그릴 범위
+enum class RedrawLevel
+{
+    None,       // 그리지 않음 (화면에 남은 마지막 프레임 유지, 이벤트 대기)
+    Composite,  // HDR / 블룸 결과는 그대로 두고 스카이박스 + 합성 + 궤도선만
+    Scene       // 천체 + 블룸 + 합성 전부
+};
+
+// 장면 결과를 결정하는 입력 (이 값이 같으면 HDR 버퍼도 같음)
+struct RedrawState
+{
+    float simYears = 0.0f;
+    glm::mat4 view = glm::mat4(1.0f);
+    float fov = 0.0f;
+    unsigned int width = 0;
+    unsigned int height = 0;
+    int trackingIndex = -1;
+
+    bool autoExposure = false;   // 합성에만 영향
+    int settleSceneFrames = 0;   // 장면이 멈춘 뒤에도 더 그릴 프레임 수 (시간 누적 업스케일 수렴)
+};
+
+// =====================================================
+// RedrawTracker
+//  - 일시 정지 + 카메라 정지 상태에서 매 프레임 전체를 다시 그리지 않도록
+//    지난 프레임의 입력과 비교해서 다시 그릴 범위를 정함
+//  - 자동 노출이 켜져 있으면 장면이 멈춘 뒤에도 노출이 수렴할 때까지
+//    (EXPOSURE_SETTLE_SEC) 합성만 계속 실행
+//  - 시간 누적 업스케일이 켜져 있으면 멈춘 뒤에도 지터 한 주기
+//    (settleSceneFrames) 만큼 장면을 더 그려서 히스토리를 채움
+//  - 창 다시 그리기 요청 같은 외부 변경은 invalidate*() 로 알림
+// =====================================================
+class RedrawTracker
+{
+public:
+    static constexpr float EXPOSURE_SETTLE_SEC = 5.0f;  // 느린 쪽 적응 속도(1/초) 기준 약 1% 이내
+
+    RedrawTracker();
+
+    void setEnabled(bool on);
+    bool isEnabled() const { return enabled; }
+
+    void invalidateScene() { sceneDirty = true; }
+    void invalidateComposite() { compositeDirty = true; }
+
+    // 이번 프레임 입력으로 다시 그릴 범위 결정 (꺼져 있으면 항상 Scene)
+    RedrawLevel update(const RedrawState& state, float dtSec);
+
+    int getSceneFrames() const { return sceneFrames; }
+    int getCompositeFrames() const { return compositeFrames; }
+    int getIdleFrames() const { return idleFrames; }
+
+private:
+    bool enabled;
+    bool hasLast;
+    bool sceneDirty;
+    bool compositeDirty;
+    float exposureSettleSec;    // 남은 노출 수렴 시간
+    int sceneSettleFrames;      // 남은 장면 수렴 프레임
+
+    RedrawState last;
+
+    int sceneFrames;
+    int compositeFrames;
+    int idleFrames;
+
+    static bool sameScene(const RedrawState& a, const RedrawState& b);
+};
+
+#endif
@@ -0,0 +1,460 @@
+﻿#include "RenderDevice.h"
+
+#include <GL/glew.h>
+#include <cstring>
+#include <iostream>
+
+static GLenum toGL(Primitive p)
+{
+    switch (p)
+    {
+    case Primitive::Triangles:     return GL_TRIANGLES;
+    case Primitive::TriangleStrip: return GL_TRIANGLE_STRIP;
+    case Primitive::Lines:         return GL_LINES;
+    case Primitive::LineStrip:     return GL_LINE_STRIP;
+    case Primitive::Points:        return GL_POINTS;
+    }
+    return GL_TRIANGLES;
+}
+
+static GLenum toGL(TextureTarget t)
+{
+    return (t == TextureTarget::Texture2DArray) ? GL_TEXTURE_2D_ARRAY : GL_TEXTURE_2D;
+}
+
+// =====================================================
+// RenderDevice (공용: 상태 캐시 + 재생 루프)
+// =====================================================
+RenderDevice::RenderDevice()
+    : streamCapacity(0), streamReady(false)
+{
+    invalidate();
+}
+
+void RenderDevice::invalidate()
+{
+    cache.program = 0xFFFFFFFFu;
+    cache.vao = 0xFFFFFFFFu;
+    cache.fbo = 0xFFFFFFFFu;
+    for (int i = 0; i < 4; i++) cache.viewport[i] = -1;
+    cache.blend = -1;
+    cache.cull = -1;
+    cache.depthTest = -1;
+    cache.depthWrite = -1;
+    for (int u = 0; u < MAX_UNITS; u++)
+        cache.textures[u][0] = cache.textures[u][1] = 0xFFFFFFFFu;
+
+    // uniform 값은 직접 GL 을 호출하는 코드가 바꿨을 수 있으므로 잊음 (위치는 유지)
+    for (auto& program : uniforms)
+        for (auto& slot : program.second)
+            slot.second.last.clear();
+}
+
+void RenderDevice::restoreDefaults()
+{
+    glEnable(GL_DEPTH_TEST);
+    glDepthMask(GL_TRUE);
+    glDisable(GL_BLEND);
+    glDisable(GL_CULL_FACE);
+    glUseProgram(0);
+    glBindVertexArray(0);
+    glActiveTexture(GL_TEXTURE0);
+}
+
+void RenderDevice::useProgram(unsigned int program)
+{
+    if (changed(cache.program, program))
+        glUseProgram(program);
+}
+
+void RenderDevice::bindVertexArray(unsigned int vao)
+{
+    if (changed(cache.vao, vao))
+        glBindVertexArray(vao);
+}
+
+void RenderDevice::applyPipeline(const PipelineState& p)
+{
+    useProgram(p.program);
+
+    if (changed(cache.depthTest, p.depthTest ? 1 : 0))
+    {
+        if (p.depthTest) glEnable(GL_DEPTH_TEST);
+        else glDisable(GL_DEPTH_TEST);
+    }
+    if (changed(cache.depthWrite, p.depthWrite ? 1 : 0))
+        glDepthMask(p.depthWrite ? GL_TRUE : GL_FALSE);
+
+    if (changed(cache.blend, (int)p.blend))
+    {
+        switch (p.blend)
+        {
+        case BlendMode::Opaque:
+            glDisable(GL_BLEND);
+            break;
+        case BlendMode::Alpha:
+            glEnable(GL_BLEND);
+            glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+            break;
+        case BlendMode::Premultiplied:
+            glEnable(GL_BLEND);
+            glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+            break;
+        case BlendMode::Additive:
+            glEnable(GL_BLEND);
+            glBlendFunc(GL_ONE, GL_ONE);
+            break;
+        }
+    }
+
+    if (changed(cache.cull, (int)p.cull))
+    {
+        if (p.cull == CullMode::None)
+        {
+            glDisable(GL_CULL_FACE);
+        }
+        else
+        {
+            glEnable(GL_CULL_FACE);
+            glCullFace(p.cull == CullMode::Back ? GL_BACK : GL_FRONT);
+        }
+    }
+}
+
+RenderDevice::UniformSlot& RenderDevice::uniformSlot(unsigned int program, const std::string& name)
+{
+    auto& table = uniforms[program];
+    auto it = table.find(name);
+    if (it != table.end())
+        return it->second;
+
+    UniformSlot slot;
+    slot.location = glGetUniformLocation(program, name.c_str());
+    return table.emplace(name, slot).first->second;
+}
+
+void RenderDevice::submit(const CommandList* lists, int count)
+{
+    if (!streamReady)
+    {
+        initStream();
+        streamReady = true;
+    }
+
+    invalidate();
+
+    // 1) 모든 목록의 임시 정점을 한 번에 업로드 ----------------------
+    std::vector<int> vertexBase(count);
+    size_t totalVertices = 0;
+    for (int i = 0; i < count; i++)
+    {
+        vertexBase[i] = (int)totalVertices;
+        totalVertices += lists[i].getTransientVertices().size();
+    }
+
+    if (totalVertices > 0)
+    {
+        std::vector<glm::vec3> merged;
+        merged.reserve(totalVertices);
+        for (int i = 0; i < count; i++)
+        {
+            const auto& v = lists[i].getTransientVertices();
+            merged.insert(merged.end(), v.begin(), v.end());
+        }
+        uploadStream(merged.data(), merged.size() * sizeof(glm::vec3));
+    }
+
+    // 2) 명령 재생 -------------------------------------------------
+    for (int li = 0; li < count; li++)
+    {
+        const CommandList& list = lists[li];
+        const std::vector<float>& data = list.getUniformData();
+
+        for (const CommandList::Command& c : list.getCommands())
+        {
+            stats.commands++;
+
+            switch (c.type)
+            {
+            case CommandList::Type::BeginPass:
+            {
+                if (changed(cache.fbo, c.pass.fbo))
+                    bindFramebuffer(c.pass.fbo);
+
+                const int vp[4] = { c.pass.x, c.pass.y, c.pass.w, c.pass.h };
+                if (memcmp(vp, cache.viewport, sizeof(vp)) != 0)
+                {
+                    memcpy(cache.viewport, vp, sizeof(vp));
+                    glViewport(vp[0], vp[1], vp[2], vp[3]);
+                    stats.stateChanges++;
+                }
+                else
+                {
+                    stats.stateSkipped++;
+                }
+
+                if (c.pass.clearDepth && cache.depthWrite != 1)
+                {
+                    // 깊이 쓰기가 꺼져 있으면 지워지지 않음
+                    glDepthMask(GL_TRUE);
+                    cache.depthWrite = 1;
+                }
+                if (c.pass.clearColor || c.pass.clearDepth)
+                    clear(c.pass.fbo, c.pass.clearColor, c.pass.clearDepth, c.pass.color);
+                break;
+            }
+
+            case CommandList::Type::SetPipeline:
+                applyPipeline(c.pipeline);
+                break;
+
+            case CommandList::Type::BindTexture:
+            {
+                int unit = c.texture.unit;
+                int t = (c.texture.target == TextureTarget::Texture2DArray) ? 1 : 0;
+                if (unit < 0 || unit >= MAX_UNITS || changed(cache.textures[unit][t], c.texture.texture))
+                    bindTextureUnit(unit, c.texture.target, c.texture.texture);
+                break;
+            }
+
+            case CommandList::Type::SetUniform:
+            {
+                if (cache.program == 0 || cache.program == 0xFFFFFFFFu) break; // 파이프라인 없음
+
+                UniformSlot& slot = uniformSlot(cache.program, list.getName(c.uniform.name));
+                if (slot.location < 0) break;
+
+                int floats = c.uniform.count;
+                switch (c.uniform.type)
+                {
+                case CommandList::UniformType::Int:
+                case CommandList::UniformType::Float: break;
+                case CommandList::UniformType::Vec3:  floats *= 3; break;
+                case CommandList::UniformType::Vec4:  floats *= 4; break;
+                case CommandList::UniformType::Mat4:  floats *= 16; break;
+                }
+
+                const float* v = data.data() + c.uniform.offset;
+                if ((int)slot.last.size() == floats &&
+                    memcmp(slot.last.data(), v, floats * sizeof(float)) == 0)
+                {
+                    stats.stateSkipped++;
+                    break;
+                }
+                slot.last.assign(v, v + floats);
+                stats.stateChanges++;
+
+                setUniform(cache.program, slot.location, c.uniform.type, c.uniform.count, v);
+                break;
+            }
+
+            case CommandList::Type::Draw:
+                bindVertexArray(c.draw.vao);
+                glDrawArrays(toGL(c.draw.primitive), c.draw.first, c.draw.count);
+                stats.draws++;
+                break;
+
+            case CommandList::Type::DrawIndexed:
+                bindVertexArray(c.draw.vao);
+                glDrawElements(toGL(c.draw.primitive), c.draw.count, GL_UNSIGNED_INT, 0);
+                stats.draws++;
+                break;
+
+            case CommandList::Type::DrawTransient:
+                bindVertexArray(streamVAO());
+                glDrawArrays(toGL(c.draw.primitive), vertexBase[li] + c.draw.first, c.draw.count);
+                stats.draws++;
+                break;
+            }
+        }
+    }
+
+    restoreDefaults();
+}
+
+// =====================================================
+// GL 3.3 백엔드 (바인딩 후 수정)
+// =====================================================
+class RenderDeviceGL33 : public RenderDevice
+{
+public:
+    const char* getName() const override { return "GL33"; }
+
+protected:
+    void initStream() override
+    {
+        streamArray = GpuVertexArray("command stream VAO");
+        streamBuffer = GpuBuffer("command stream vertices");
+
+        glBindVertexArray(streamArray.get());
+        glBindBuffer(GL_ARRAY_BUFFER, streamBuffer.get());
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3), (void*)0);
+        glEnableVertexAttribArray(0);
+        glBindVertexArray(0);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    void uploadStream(const void* data, size_t bytes) override
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, streamBuffer.get());
+        if (bytes > streamCapacity)
+        {
+            streamCapacity = bytes * 2;
+            streamBuffer.setBytes(streamCapacity);
+        }
+        glBufferData(GL_ARRAY_BUFFER, streamCapacity, nullptr, GL_STREAM_DRAW); // orphan
+        glBufferSubData(GL_ARRAY_BUFFER, 0, bytes, data);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    unsigned int streamVAO() const override { return streamArray.get(); }
+
+    void bindFramebuffer(unsigned int fbo) override
+    {
+        glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    }
+
+    void clear(unsigned int, bool color, bool depth, const float* rgba) override
+    {
+        if (color) glClearColor(rgba[0], rgba[1], rgba[2], rgba[3]);
+        glClear((color ? GL_COLOR_BUFFER_BIT : 0) | (depth ? GL_DEPTH_BUFFER_BIT : 0));
+        if (color) glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+    }
+
+    void bindTextureUnit(int unit, TextureTarget target, unsigned int texture) override
+    {
+        glActiveTexture(GL_TEXTURE0 + unit);
+        glBindTexture(toGL(target), texture);
+    }
+
+    void setUniform(unsigned int, int loc, CommandList::UniformType type,
+        int count, const float* v) override
+    {
+        // 재생 루프가 이미 glUseProgram 을 걸어 둔 상태
+        switch (type)
+        {
+        case CommandList::UniformType::Int:
+        {
+            int i;
+            memcpy(&i, v, sizeof(int));
+            glUniform1i(loc, i);
+            break;
+        }
+        case CommandList::UniformType::Float: glUniform1fv(loc, count, v); break;
+        case CommandList::UniformType::Vec3:  glUniform3fv(loc, count, v); break;
+        case CommandList::UniformType::Vec4:  glUniform4fv(loc, count, v); break;
+        case CommandList::UniformType::Mat4:  glUniformMatrix4fv(loc, count, GL_FALSE, v); break;
+        }
+    }
+};
+
+// =====================================================
+// GL 4.5 DSA 백엔드
+//  - 레지스트리가 glGen* 으로 만든 이름은 한 번 바인딩해야 오브젝트가 생기므로
+//    스트림 버퍼/VAO 는 생성 직후 한 번 바인딩해서 초기화
+// =====================================================
+class RenderDeviceGL45 : public RenderDevice
+{
+public:
+    const char* getName() const override { return "GL45 (DSA)"; }
+
+protected:
+    void initStream() override
+    {
+        streamArray = GpuVertexArray("command stream VAO");
+        streamBuffer = GpuBuffer("command stream vertices");
+
+        glBindVertexArray(streamArray.get());
+        glBindVertexArray(0);
+        glBindBuffer(GL_ARRAY_BUFFER, streamBuffer.get());
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+        GLuint vao = streamArray.get();
+        glVertexArrayVertexBuffer(vao, 0, streamBuffer.get(), 0, sizeof(glm::vec3));
+        glVertexArrayAttribFormat(vao, 0, 3, GL_FLOAT, GL_FALSE, 0);
+        glVertexArrayAttribBinding(vao, 0, 0);
+        glEnableVertexArrayAttrib(vao, 0);
+    }
+
+    void uploadStream(const void* data, size_t bytes) override
+    {
+        if (bytes > streamCapacity)
+        {
+            streamCapacity = bytes * 2;
+            streamBuffer.setBytes(streamCapacity);
+        }
+        glNamedBufferData(streamBuffer.get(), streamCapacity, nullptr, GL_STREAM_DRAW); // orphan
+        glNamedBufferSubData(streamBuffer.get(), 0, bytes, data);
+    }
+
+    unsigned int streamVAO() const override { return streamArray.get(); }
+
+    void bindFramebuffer(unsigned int fbo) override
+    {
+        glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    }
+
+    void clear(unsigned int fbo, bool color, bool depth, const float* rgba) override
+    {
+        // GLEW 의 선언이 const 가 아니라서 지역 복사본을 넘김
+        float value[4] = { rgba[0], rgba[1], rgba[2], rgba[3] };
+        if (color)
+        {
+            // glClear 처럼 켜진 그리기 버퍼를 모두 지움 (장면 / 블룸 FBO 는 색 첨부가 여러 개)
+            //  fbo 는 호출 측에서 이미 바인딩 → GL_DRAW_BUFFERi 가 그 FBO 의 설정
+            if (maxDrawBuffers == 0)
+                glGetIntegerv(GL_MAX_DRAW_BUFFERS, &maxDrawBuffers);
+            for (int i = 0; i < maxDrawBuffers; i++)
+            {
+                GLint buffer = GL_NONE;
+                glGetIntegerv(GL_DRAW_BUFFER0 + i, &buffer);
+                if (buffer != GL_NONE)
+                    glClearNamedFramebufferfv(fbo, GL_COLOR, i, value);
+            }
+        }
+        if (depth)
+        {
+            float one = 1.0f;
+            glClearNamedFramebufferfv(fbo, GL_DEPTH, 0, &one);
+        }
+    }
+
+    void bindTextureUnit(int unit, TextureTarget, unsigned int texture) override
+    {
+        glBindTextureUnit(unit, texture);
+    }
+
+    void setUniform(unsigned int program, int loc, CommandList::UniformType type,
+        int count, const float* v) override
+    {
+        switch (type)
+        {
+        case CommandList::UniformType::Int:
+        {
+            int i;
+            memcpy(&i, v, sizeof(int));
+            glProgramUniform1i(program, loc, i);
+            break;
+        }
+        case CommandList::UniformType::Float: glProgramUniform1fv(program, loc, count, v); break;
+        case CommandList::UniformType::Vec3:  glProgramUniform3fv(program, loc, count, v); break;
+        case CommandList::UniformType::Vec4:  glProgramUniform4fv(program, loc, count, v); break;
+        case CommandList::UniformType::Mat4:  glProgramUniformMatrix4fv(program, loc, count, GL_FALSE, v); break;
+        }
+    }
+
+private:
+    GLint maxDrawBuffers = 0;   // 처음 clear 할 때 조회
+};
+
+std::unique_ptr<RenderDevice> RenderDevice::create(bool preferDSA)
+{
+    std::unique_ptr<RenderDevice> device;
+    if (preferDSA && (GLEW_VERSION_4_5 || GLEW_ARB_direct_state_access))
+        device.reset(new RenderDeviceGL45());
+    else
+        device.reset(new RenderDeviceGL33());
+
+    std::cout << "[RenderDevice] Backend: " << device->getName() << "\n";
+    return device;
+}
@@ -0,0 +1,115 @@
+﻿#ifndef RENDER_DEVICE_H
+#define RENDER_DEVICE_H
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "CommandList.h"
+#include "GpuResource.h"
+
+// =====================================================
+// RenderDevice
+//  - CommandList 를 GL 스레드에서 재생하는 백엔드
+//  - 중복 상태 걸러내기: 프로그램 / VAO / 텍스처 / 블렌드 / 깊이 / 컬링 /
+//    프레임버퍼 / 뷰포트 / uniform 값이 이전과 같으면 GL 호출 생략
+//  - 백엔드
+//      GL33 : glActiveTexture + glBindTexture, glUniform (바인딩 후 수정)
+//      GL45 : DSA (glBindTextureUnit, glProgramUniform, glNamedBufferData ...)
+//  - submit() 전후로 직접 GL 을 호출하는 코드와 섞여 쓰이므로
+//    submit() 시작 시 상태 캐시를 비우고, 끝나면 기본 상태로 되돌림
+//    (깊이 테스트/쓰기 켜짐, 블렌드/컬링 꺼짐, 프로그램/VAO 0, 텍스처 유닛 0)
+// =====================================================
+class RenderDevice
+{
+public:
+    struct Stats
+    {
+        long long commands = 0;         // 재생한 명령 수
+        long long draws = 0;            // 그리기 호출 수
+        long long stateChanges = 0;     // 실제로 수행한 상태 변경
+        long long stateSkipped = 0;     // 중복이라 생략한 상태 변경
+    };
+
+    // DSA(GL 4.5 / ARB_direct_state_access)를 쓸 수 있고 preferDSA 이면 GL45 백엔드
+    static std::unique_ptr<RenderDevice> create(bool preferDSA = true);
+
+    virtual ~RenderDevice() {}
+
+    virtual const char* getName() const = 0;
+
+    void submit(const CommandList& list) { submit(&list, 1); }
+    void submit(const CommandList* lists, int count);
+    void submit(const std::vector<CommandList>& lists)
+    {
+        if (!lists.empty()) submit(lists.data(), (int)lists.size());
+    }
+
+    const Stats& getStats() const { return stats; }
+
+protected:
+    RenderDevice();
+
+    // 백엔드별 GL 호출 -----------------------------------------------
+    virtual void initStream() = 0;
+    virtual void uploadStream(const void* data, size_t bytes) = 0;
+    virtual unsigned int streamVAO() const = 0;
+
+    virtual void bindFramebuffer(unsigned int fbo) = 0;
+    virtual void clear(unsigned int fbo, bool color, bool depth, const float* rgba) = 0;
+    virtual void bindTextureUnit(int unit, TextureTarget target, unsigned int texture) = 0;
+    virtual void setUniform(unsigned int program, int location,
+        CommandList::UniformType type, int count, const float* data) = 0;
+
+    GpuBuffer streamBuffer;           // 임시 정점 스트리밍 버퍼
+    GpuVertexArray streamArray;       // 위치(vec3) 하나짜리 VAO
+    size_t streamCapacity;
+
+private:
+    static const int MAX_UNITS = 16;
+
+    // 현재 GL 상태 캐시 (-1 / 0xFFFFFFFF = 모름)
+    struct StateCache
+    {
+        unsigned int program;
+        unsigned int vao;
+        unsigned int fbo;
+        int viewport[4];
+        int blend;                    // BlendMode, -1 = 모름
+        int cull;                     // CullMode, -1 = 모름
+        int depthTest;
+        int depthWrite;
+        unsigned int textures[MAX_UNITS][2];
+    } cache;
+
+    // 프로그램별 uniform 위치 + 마지막 값
+    struct UniformSlot
+    {
+        int location;
+        std::vector<float> last;
+    };
+    std::unordered_map<unsigned int, std::unordered_map<std::string, UniformSlot>> uniforms;
+
+    Stats stats;
+    bool streamReady;
+
+    void invalidate();
+    void restoreDefaults();
+
+    void applyPipeline(const PipelineState& p);
+    void useProgram(unsigned int program);
+    void bindVertexArray(unsigned int vao);
+    UniformSlot& uniformSlot(unsigned int program, const std::string& name);
+
+    template<typename T>
+    bool changed(T& cached, T value)
+    {
+        if (cached == value) { stats.stateSkipped++; return false; }
+        cached = value;
+        stats.stateChanges++;
+        return true;
+    }
+};
+
+#endif
@@ -1,5 +1,6 @@
 ﻿#include "Satellite.h"
 #include "Shader.h"
+#include "CommandList.h"
 
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/constants.hpp>
@@ -8,7 +9,6 @@
 
 Satellite::Satellite(const SatelliteParams& p)
     : params(p),
-    spinAngleDeg(0.0f),
     generatedOrbit(false)
 {
 }
@@ -20,31 +20,11 @@ glm::vec3 Satellite::positionRelativeToPlanet(float tYears) const
     return params.orbit.positionAtTime(tYears);
 }
 
-// 위성의 궤도 진행도 계산 (0.0 ~ 1.0)
-static void drawLineStrip(const std::vector<glm::vec3>& pts)
+// 궤도 경로를 그리는 헬퍼 함수 (정점은 명령 목록에 복사되어 한 번에 업로드)
+static void drawLineStrip(CommandList& cmd, const std::vector<glm::vec3>& pts)
 {
     if (pts.size() < 2) return;
-
-    unsigned int vao, vbo;
-
-    glGenVertexArrays(1, &vao);
-    glGenBuffers(1, &vbo);
-
-    glBindVertexArray(vao);
-    glBindBuffer(GL_ARRAY_BUFFER, vbo);
-    glBufferData(GL_ARRAY_BUFFER,
-        pts.size() * sizeof(glm::vec3),
-        pts.data(),
-        GL_DYNAMIC_DRAW);
-
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE,
-        sizeof(glm::vec3), (void*)0);
-    glEnableVertexAttribArray(0);
-
-    glDrawArrays(GL_LINE_STRIP, 0, (GLsizei)pts.size());
-
-    glDeleteBuffers(1, &vbo);
-    glDeleteVertexArrays(1, &vao);
+    cmd.drawTransient(Primitive::LineStrip, pts.data(), (int)pts.size());
 }
 
 // 주어진 위치에 가장 가까운 궤도 점의 인덱스 찾기
@@ -67,15 +47,17 @@ static int findClosestPointIndex(const std::vector<glm::vec3>& path,
 }
 
 // 위성의 궤도 궤적 그리기
-void Satellite::drawTrail(const Shader& shader,
+void Satellite::drawTrail(CommandList& cmd,
+	const Shader& shader,
 	const glm::mat4& view, // 뷰 매트릭스
 	const glm::mat4& proj,  // 투영 매트릭스
 	const glm::mat4& planetModel, // 행성 모델 매트릭스
     float tYears) const 
 {
-    shader.use();
-    shader.setMat4("view", view);
-    shader.setMat4("proj", proj);
+	// 궤도선은 깊이 테스트 없이 그림
+    cmd.setPipeline(makePipeline(shader.ID, BlendMode::Opaque, false));
+    cmd.setMat4("view", view);
+    cmd.setMat4("proj", proj);
 
 	// 행성 위치 추출
     glm::vec3 parentPos = glm::vec3(planetModel[3]);
@@ -83,7 +65,28 @@ void Satellite::drawTrail(const Shader& shader,
 	// 행성 위치로 이동
     glm::mat4 model(1.0f);
     model = glm::translate(model, parentPos);
-    shader.setMat4("model", model);
+    cmd.setMat4("model", model);
+
+    std::vector<glm::vec3> part;
+    const std::vector<glm::vec3>& path = trailGeometry(tYears, part);
+
+    // 전체 궤도 = 흰색
+    cmd.setVec3("color", glm::vec3(1, 1, 1));
+	drawLineStrip(cmd, path); // 전체 궤도 그리기
+
+    // 진행 구간 = 초록색
+    if (!part.empty())
+    {
+        cmd.setVec3("color", glm::vec3(0, 1, 0));
+        drawLineStrip(cmd, part);
+    }
+}
+
+// 궤도선 정점 계산
+const std::vector<glm::vec3>& Satellite::trailGeometry(float tYears,
+    std::vector<glm::vec3>& progress) const
+{
+    progress.clear();
 
     // 1) orbitPath 캐싱
     if (!generatedOrbit)
@@ -123,68 +126,15 @@ void Satellite::drawTrail(const Shader& shader,
 	// 가장 가까운 궤도 점 인덱스 찾기
     int idx = findClosestPointIndex(orbitPath, relPos);
 
-    glDisable(GL_DEPTH_TEST);
-
-    // 전체 궤도 = 흰색
-    shader.setVec3("color", glm::vec3(1, 1, 1));
-	drawLineStrip(orbitPath); // 전체 궤도 그리기
-
     // gap 제거 초록색 trail
     if (idx > 1)
     {
-        std::vector<glm::vec3> part;
-        part.reserve(idx);
+        progress.reserve(idx + 1);
 
         for (int i = 0; i < idx; i++)
-            part.push_back(orbitPath[i]);
+            progress.push_back(orbitPath[i]);
 
-        part.push_back(relPos);   // ★ gap 완전 제거 핵심
-
-        shader.setVec3("color", glm::vec3(0, 1, 0));
-        drawLineStrip(part);
+        progress.push_back(relPos);   // ★ gap 완전 제거 핵심
     }
-
-    glEnable(GL_DEPTH_TEST);
-}
-
-// 위성을 월드 위치에 그리기
-void Satellite::drawAtWorld(const Shader& shader,
-	float dtSec,   // 시뮬레이션 시간 델타 (초 단위, 자전용)
-	float scale,   // 세계 스케일링 팩터
-	const glm::vec3& worldPos, // 이미 스케일링 및 행성 위치가 적용된 월드 위치
-	unsigned int sphereVAO, // 구 메쉬 VAO
-    unsigned int indexCount) const 
-{
-    // 자전 업데이트
-    const_cast<Satellite*>(this)->spinAngleDeg +=
-        params.spinDegPerSec * dtSec;
-
-    shader.use();
-
-    glm::mat4 m(1.0f);
-
-    // 1) 월드 위치 이동
-    m = glm::translate(m, worldPos);
-
-    // 2) 자전축 기울기 적용 (행성과 동일) 보통 Z축 기준으로 기울인다 (지구/위성 모두 동일)
-    m = glm::rotate(m,
-        glm::radians(params.axialTiltDeg),
-        glm::vec3(0, 0, 1));
-
-    // 3) 자전 적용
-    m = glm::rotate(m,
-        glm::radians(spinAngleDeg),
-        glm::vec3(0, 1, 0));
-
-    // 4) 스케일 적용
-    m = glm::scale(m,
-        glm::vec3(params.radiusRender * scale));
-
-    shader.setMat4("model", m);
-    shader.setVec3("objectColor", params.color);
-
-    glBindVertexArray(sphereVAO);
-    glDrawElements(GL_TRIANGLES, indexCount,
-        GL_UNSIGNED_INT, 0);
-    glBindVertexArray(0);
+    return orbitPath;
 }
@@ -8,6 +8,7 @@
 #include "Orbit.h"
 
 class Shader;
+class CommandList;
 
 struct SatelliteParams
 {
@@ -37,24 +38,22 @@ public:
 
     float orbitProgress(float tYears) const;
 
-    void drawTrail(const Shader& shader,
+    // 위성 궤도 그리기 (명령 목록에 기록, 작업 스레드에서 호출 가능)
+    void drawTrail(CommandList& cmd,
+        const Shader& shader,
         const glm::mat4& view,
         const glm::mat4& proj,
         const glm::mat4& planetModel,
         float tYears) const;
 
-    void drawAtWorld(const Shader& shader,
-		float dtSec,    // 시뮬레이션 시간 델타 (초 단위, 자전용)
-		float scale,    // 세계 스케일링 팩터
-		const glm::vec3& worldPos, // 이미 스케일링 및 행성 위치가 적용된 월드 위치
-		unsigned int sphereVAO, // 구 메쉬 VAO
-		unsigned int indexCount) const; // 구 메쉬 인덱스 개수
+    // 궤도선 정점 (행성 기준 XZ 평면): 전체 궤도를 반환하고 진행 구간을 progress 에 채움
+    const std::vector<glm::vec3>& trailGeometry(float tYears,
+        std::vector<glm::vec3>& progress) const;
 
     float getMass() const { return params.mass; }
 
 private:
 	SatelliteParams params; // 위성 파라미터
-	mutable float spinAngleDeg; // 자전 각도
 
 	mutable bool generatedOrbit = false; // 궤도 경로 생성 플래그
 	mutable std::vector<glm::vec3> orbitPath; // 궤도 경로 점들
@@ -4,37 +4,240 @@
 #include <iostream>
 #include <sstream>
 #include <fstream>
+#include <vector>
+#include <cstdio>
 
+#ifdef _WIN32
+#include <direct.h>
+#define SHADER_MKDIR(path) _mkdir(path)
+#else
+#include <sys/stat.h>
+#define SHADER_MKDIR(path) mkdir(path, 0755)
+#endif
 
-Shader::Shader(const char* vertexSrc, const char* fragmentSrc)
+bool Shader::cacheEnabled = true;
+std::string Shader::cacheDir = "shader_cache";
+int Shader::cacheHits = 0;
+int Shader::cacheMisses = 0;
+bool Shader::parallelCompile = false;
+
+// 캐시 파일 헤더
+static const unsigned int BINARY_MAGIC = 0x42504C47; // "GLPB"
+static const unsigned int BINARY_VERSION = 1;
+
+// FNV-1a 64비트 해시
+static unsigned long long hashString(unsigned long long h, const char* s)
+{
+    if (!s) s = "";
+    for (; *s; ++s)
+    {
+        h ^= (unsigned char)*s;
+        h *= 1099511628211ull;
+    }
+    // 구분자 (소스 경계가 섞여도 같은 해시가 나오지 않도록)
+    h ^= 0xFF;
+    h *= 1099511628211ull;
+    return h;
+}
+
+// 프로그램 바이너리를 쓸 수 있는 드라이버인지 확인 (한 번만 조회)
+static bool binarySupported()
 {
+    static int supported = -1;
+    if (supported < 0)
+    {
+        GLint formats = 0;
+        if (GLEW_VERSION_4_1 || GLEW_ARB_get_program_binary)
+            glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+        supported = (formats > 0) ? 1 : 0;
+    }
+    return supported == 1;
+}
+
+void Shader::setBinaryCache(bool enabled, const std::string& dir)
+{
+    cacheEnabled = enabled;
+    cacheDir = dir;
+}
+
+void Shader::enableParallelCompile()
+{
+    // 0xFFFFFFFF = 드라이버가 정한 최대 스레드 수 사용
+    if (GLEW_KHR_parallel_shader_compile)
+    {
+        glMaxShaderCompilerThreadsKHR(0xFFFFFFFF);
+        parallelCompile = true;
+    }
+    else if (GLEW_ARB_parallel_shader_compile)
+    {
+        glMaxShaderCompilerThreadsARB(0xFFFFFFFF);
+        parallelCompile = true;
+    }
+}
+
+Shader::Shader(const char* vertexSrc, const char* fragmentSrc, bool deferStatus)
+    : ID(0)
+{
+    // ===============================
+    // Program Binary Cache
+    // ===============================
+    bool useCache = cacheEnabled && binarySupported();
+
+    if (useCache)
+    {
+        unsigned long long key = 14695981039346656037ull;
+        key = hashString(key, vertexSrc);
+        key = hashString(key, fragmentSrc);
+        key = hashString(key, (const char*)glGetString(GL_VENDOR));
+        key = hashString(key, (const char*)glGetString(GL_RENDERER));
+        key = hashString(key, (const char*)glGetString(GL_VERSION));
+
+        char name[32];
+        snprintf(name, sizeof(name), "/%016llx.bin", key);
+
+        if (loadBinary(cacheDir + name, key))
+        {
+            cacheHits++;
+            linked = true;
+            return;
+        }
+        cacheMisses++;
+
+        cacheKey = key;
+        cachePath = cacheDir + name;
+    }
+
     // ===============================
-    // Vertex Shader
+    // Vertex Shader (제출만, 상태 확인은 finish)
     // ===============================
-    unsigned int vertex = glCreateShader(GL_VERTEX_SHADER);
-    glShaderSource(vertex, 1, &vertexSrc, nullptr);
-    glCompileShader(vertex);
-    checkCompileErrors(vertex, "VERTEX");
+    vertexShader = glCreateShader(GL_VERTEX_SHADER);
+    glShaderSource(vertexShader, 1, &vertexSrc, nullptr);
+    glCompileShader(vertexShader);
 
     // ===============================
     // Fragment Shader
     // ===============================
-    unsigned int fragment = glCreateShader(GL_FRAGMENT_SHADER);
-    glShaderSource(fragment, 1, &fragmentSrc, nullptr);
-    glCompileShader(fragment);
-    checkCompileErrors(fragment, "FRAGMENT");
+    fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
+    glShaderSource(fragmentShader, 1, &fragmentSrc, nullptr);
+    glCompileShader(fragmentShader);
 
     // ===============================
     // Shader Program
     // ===============================
     ID = glCreateProgram();
-    glAttachShader(ID, vertex);
-    glAttachShader(ID, fragment);
+    glAttachShader(ID, vertexShader);
+    glAttachShader(ID, fragmentShader);
+    if (useCache)
+        glProgramParameteri(ID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
     glLinkProgram(ID);
-    checkCompileErrors(ID, "PROGRAM");
 
-    glDeleteShader(vertex);
-    glDeleteShader(fragment);
+    pending = true;
+    if (!deferStatus)
+        finish();
+}
+
+bool Shader::isReady() const
+{
+    if (!pending) return true;
+
+    // 병렬 컴파일을 지원하지 않으면 조회 자체가 대기를 유발하므로 준비된 것으로 취급
+    if (!parallelCompile) return true;
+
+    GLint done = 0;
+    glGetProgramiv(ID, GL_COMPLETION_STATUS_KHR, &done);
+    return done != 0;
+}
+
+bool Shader::finish()
+{
+    if (!pending) return linked;
+    pending = false;
+
+    // 여기서 처음으로 상태를 조회 (아직 진행 중이면 이 시점에만 대기)
+    checkCompileErrors(vertexShader, "VERTEX");
+    checkCompileErrors(fragmentShader, "FRAGMENT");
+    linked = checkCompileErrors(ID, "PROGRAM");
+
+    glDetachShader(ID, vertexShader);
+    glDetachShader(ID, fragmentShader);
+    glDeleteShader(vertexShader);
+    glDeleteShader(fragmentShader);
+    vertexShader = 0;
+    fragmentShader = 0;
+
+    if (linked && !cachePath.empty())
+        saveBinary(cachePath, cacheKey);
+
+    return linked;
+}
+
+// 캐시 파일에서 프로그램 바이너리 로드 (실패하면 false → 소스 컴파일)
+bool Shader::loadBinary(const std::string& path, unsigned long long key)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return false;
+
+    unsigned int magic = 0, version = 0, format = 0, length = 0;
+    unsigned long long storedKey = 0;
+    in.read((char*)&magic, sizeof(magic));
+    in.read((char*)&version, sizeof(version));
+    in.read((char*)&storedKey, sizeof(storedKey));
+    in.read((char*)&format, sizeof(format));
+    in.read((char*)&length, sizeof(length));
+
+    if (!in || magic != BINARY_MAGIC || version != BINARY_VERSION ||
+        storedKey != key || length == 0)
+        return false;
+
+    std::vector<char> binary(length);
+    in.read(binary.data(), length);
+    if (!in) return false;
+
+    ID = glCreateProgram();
+    glProgramBinary(ID, (GLenum)format, binary.data(), (GLsizei)length);
+
+    // 드라이버 업데이트 등으로 거부되면 조용히 소스 컴파일로 대체
+    GLint success = 0;
+    glGetProgramiv(ID, GL_LINK_STATUS, &success);
+    if (!success)
+    {
+        glDeleteProgram(ID);
+        ID = 0;
+        return false;
+    }
+    return true;
+}
+
+// 링크된 프로그램을 캐시 파일로 저장
+void Shader::saveBinary(const std::string& path, unsigned long long key) const
+{
+    GLint length = 0;
+    glGetProgramiv(ID, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) return;
+
+    std::vector<char> binary(length);
+    GLenum format = 0;
+    GLsizei written = 0;
+    glGetProgramBinary(ID, length, &written, &format, binary.data());
+    if (written <= 0) return;
+
+    SHADER_MKDIR(cacheDir.c_str()); // 이미 있으면 실패해도 무관
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out)
+    {
+        std::cerr << "[Shader] Cannot write program cache: " << path << "\n";
+        return;
+    }
+
+    unsigned int magic = BINARY_MAGIC, version = BINARY_VERSION;
+    unsigned int fmt = format, len = (unsigned int)written;
+    out.write((const char*)&magic, sizeof(magic));
+    out.write((const char*)&version, sizeof(version));
+    out.write((const char*)&key, sizeof(key));
+    out.write((const char*)&fmt, sizeof(fmt));
+    out.write((const char*)&len, sizeof(len));
+    out.write(binary.data(), written);
 }
 
 void Shader::use() const
@@ -57,6 +260,11 @@ void Shader::setFloat(const std::string& name, float value) const
     glUniform1f(glGetUniformLocation(ID, name.c_str()), value);
 }
 
+void Shader::setVec2(const std::string& name, const glm::vec2& v) const
+{
+    glUniform2f(glGetUniformLocation(ID, name.c_str()), v.x, v.y);
+}
+
 void Shader::setVec3(const std::string& name, const glm::vec3& v) const
 {
     glUniform3f(glGetUniformLocation(ID, name.c_str()), v.x, v.y, v.z);
@@ -67,6 +275,17 @@ void Shader::setVec3(const std::string& name, float x, float y, float z) const
     glUniform3f(glGetUniformLocation(ID, name.c_str()), x, y, z);
 }
 
+void Shader::setVec4(const std::string& name, const glm::vec4& v) const
+{
+    glUniform4f(glGetUniformLocation(ID, name.c_str()), v.x, v.y, v.z, v.w);
+}
+
+void Shader::setVec4Array(const std::string& name, const glm::vec4* v, int count) const
+{
+    if (count <= 0) return;
+    glUniform4fv(glGetUniformLocation(ID, name.c_str()), count, &v[0][0]);
+}
+
 void Shader::setMat4(const std::string& name, const glm::mat4& mat) const
 {
     glUniformMatrix4fv(glGetUniformLocation(ID, name.c_str()),
@@ -74,7 +293,7 @@ void Shader::setMat4(const std::string& name, const glm::mat4& mat) const
 }
 
 
-void Shader::checkCompileErrors(unsigned int shader, const std::string& type)
+bool Shader::checkCompileErrors(unsigned int shader, const std::string& type)
 {
     int success;
     char infoLog[1024];
@@ -98,4 +317,5 @@ void Shader::checkCompileErrors(unsigned int shader, const std::string& type)
                 << infoLog << "\n";
         }
     }
+    return success != 0;
 }
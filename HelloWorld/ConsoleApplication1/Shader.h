@@ -9,7 +9,15 @@ class Shader
 public:
     unsigned int ID;
 
-    Shader(const char* vertexSrc, const char* fragmentSrc);
+    // deferStatus = true 이면 컴파일/링크만 제출하고 상태 확인은 finish()에서 수행
+    //  → 여러 프로그램을 먼저 제출해 두고 다른 초기화 작업과 겹쳐서 컴파일
+    Shader(const char* vertexSrc, const char* fragmentSrc, bool deferStatus = false);
+
+    // 드라이버 병렬 컴파일 활성화 (KHR/ARB_parallel_shader_compile, 첫 셰이더 전에 호출)
+    static void enableParallelCompile();
+
+    bool isReady() const;   // 컴파일/링크 완료 여부 (병렬 컴파일 지원 시 대기 없이 조회)
+    bool finish();          // 상태 확인 + 에러 출력 + 캐시 저장 (링크 성공 여부 반환)
 
     void use() const;
 
@@ -18,13 +26,43 @@ public:
     void setInt(const std::string& name, int value) const;
     void setFloat(const std::string& name, float value) const;
 
+    void setVec2(const std::string& name, const glm::vec2& v) const;
+
     void setVec3(const std::string& name, const glm::vec3& v) const;
     void setVec3(const std::string& name, float x, float y, float z) const;
 
+    void setVec4(const std::string& name, const glm::vec4& v) const;
+    void setVec4Array(const std::string& name, const glm::vec4* v, int count) const;
+
     void setMat4(const std::string& name, const glm::mat4& mat) const;
 
+    // 프로그램 바이너리 캐시 (glGetProgramBinary / glProgramBinary)
+    //  - 키: 소스 해시 + 드라이버(vendor/renderer/version) 문자열
+    //  - 드라이버가 바이너리를 거부하면 소스 컴파일로 대체
+    static void setBinaryCache(bool enabled, const std::string& dir = "shader_cache");
+    static int getCacheHits() { return cacheHits; }
+    static int getCacheMisses() { return cacheMisses; }
+
 private:
-    void checkCompileErrors(unsigned int shader, const std::string& type);
+    bool checkCompileErrors(unsigned int shader, const std::string& type);
+
+    bool loadBinary(const std::string& path, unsigned long long key);
+    void saveBinary(const std::string& path, unsigned long long key) const;
+
+    // finish() 전까지 유지되는 제출 상태
+    bool pending = false;
+    bool linked = false;
+    unsigned int vertexShader = 0;
+    unsigned int fragmentShader = 0;
+    unsigned long long cacheKey = 0;
+    std::string cachePath;
+
+    static bool parallelCompile;
+
+    static bool cacheEnabled;
+    static std::string cacheDir;
+    static int cacheHits;
+    static int cacheMisses;
 };
 
 #endif
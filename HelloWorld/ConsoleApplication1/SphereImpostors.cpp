@@ -0,0 +1,141 @@
+﻿#include "SphereImpostors.h"
+#include "Shader.h"
+
+#include <GL/glew.h>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+SphereImpostors::SphereImpostors()
+    : shader(nullptr), cameraPos(0.0f), pixelsPerUnit(0.0f),
+    instanceCapacity(0), lastCount(0), lastDraws(0)
+{
+}
+
+void SphereImpostors::init()
+{
+    // 사각형 모서리 (-1~1), 삼각형 띠 순서
+    const float corners[8] = { -1.0f, -1.0f,  1.0f, -1.0f,  -1.0f, 1.0f,  1.0f, 1.0f };
+
+    vao = GpuVertexArray("impostor VAO");
+    cornerVBO = GpuBuffer("impostor corners");
+    instanceVBO = GpuBuffer("impostor instances");
+
+    glBindVertexArray(vao.get());
+
+    glBindBuffer(GL_ARRAY_BUFFER, cornerVBO.get());
+    glBufferData(GL_ARRAY_BUFFER, sizeof(corners), corners, GL_STATIC_DRAW);
+    cornerVBO.setBytes(sizeof(corners));
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+
+    // location 1~4 = model, 5~8 = prevModel (인스턴스마다)
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVBO.get());
+    for (int i = 0; i < 8; i++)
+    {
+        glEnableVertexAttribArray(1 + i);
+        glVertexAttribDivisor(1 + i, 1);
+    }
+    bindInstanceAttributes(0);
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+// 인스턴스 속성이 firstInstance 번째부터 읽도록 지정 (텍스처 묶음마다)
+void SphereImpostors::bindInstanceAttributes(size_t firstInstance)
+{
+    size_t base = firstInstance * sizeof(GpuInstance);
+    for (int i = 0; i < 4; i++)
+    {
+        glVertexAttribPointer(1 + i, 4, GL_FLOAT, GL_FALSE, sizeof(GpuInstance),
+            (void*)(base + offsetof(GpuInstance, model) + i * sizeof(glm::vec4)));
+        glVertexAttribPointer(5 + i, 4, GL_FLOAT, GL_FALSE, sizeof(GpuInstance),
+            (void*)(base + offsetof(GpuInstance, prevModel) + i * sizeof(glm::vec4)));
+    }
+}
+
+void SphereImpostors::setView(const glm::vec3& camPos, float fovDeg, int viewportHeight)
+{
+    cameraPos = camPos;
+    pixelsPerUnit = (float)viewportHeight * 0.5f / tanf(glm::radians(fovDeg) * 0.5f);
+}
+
+bool SphereImpostors::shouldUse(const glm::vec3& center, float radius) const
+{
+    float dist = glm::length(center - cameraPos);
+    if (dist <= radius * 2.0f) return false; // 가까우면 항상 메쉬
+    return radius * pixelsPerUnit / dist < MAX_PIXELS;
+}
+
+void SphereImpostors::begin()
+{
+    instances.clear();
+}
+
+void SphereImpostors::add(const glm::mat4& model, const glm::mat4& prevModel, unsigned int texture)
+{
+    Instance inst;
+    inst.model = model;
+    inst.prevModel = prevModel;
+    inst.texture = texture;
+    instances.push_back(inst);
+}
+
+void SphereImpostors::render(const glm::mat4& view, const glm::mat4& proj)
+{
+    lastCount = (int)instances.size();
+    lastDraws = 0;
+    if (instances.empty() || !shader || !vao.valid()) return;
+
+    // 텍스처별로 묶기 (같은 텍스처 안에서는 추가 순서 유지)
+    std::stable_sort(instances.begin(), instances.end(),
+        [](const Instance& a, const Instance& b) { return a.texture < b.texture; });
+
+    upload.resize(instances.size());
+    for (size_t i = 0; i < instances.size(); i++)
+    {
+        upload[i].model = instances[i].model;
+        upload[i].prevModel = instances[i].prevModel;
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVBO.get());
+    if (instances.size() > instanceCapacity)
+    {
+        instanceCapacity = std::max(instances.size(), instanceCapacity * 2);
+        glBufferData(GL_ARRAY_BUFFER, instanceCapacity * sizeof(GpuInstance), nullptr, GL_STREAM_DRAW);
+        instanceVBO.setBytes(instanceCapacity * sizeof(GpuInstance));
+    }
+    else
+    {
+        // 이전 프레임 드로우와 겹치지 않게 고아화
+        glBufferData(GL_ARRAY_BUFFER, instanceCapacity * sizeof(GpuInstance), nullptr, GL_STREAM_DRAW);
+    }
+    glBufferSubData(GL_ARRAY_BUFFER, 0, upload.size() * sizeof(GpuInstance), upload.data());
+
+    shader->use();
+    shader->setMat4("view", view);
+    shader->setMat4("proj", proj);
+    shader->setInt("diffuseMap", 0);
+
+    glBindVertexArray(vao.get());
+    glActiveTexture(GL_TEXTURE0);
+
+    size_t first = 0;
+    while (first < instances.size())
+    {
+        size_t last = first + 1;
+        while (last < instances.size() && instances[last].texture == instances[first].texture)
+            last++;
+
+        glBindTexture(GL_TEXTURE_2D, instances[first].texture);
+        bindInstanceAttributes(first);
+        glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, (GLsizei)(last - first));
+        lastDraws++;
+
+        first = last;
+    }
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
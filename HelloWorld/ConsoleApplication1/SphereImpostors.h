@@ -0,0 +1,80 @@
+﻿#ifndef SPHERE_IMPOSTORS_H
+#define SPHERE_IMPOSTORS_H
+
+#include <vector>
+#include <glm/glm.hpp>
+
+#include "GpuResource.h"
+
+class Shader;
+
+// =====================================================
+// SphereImpostors
+//  - 화면에서 작게 보이는 천체(반지름 MAX_PIXELS 미만)를 구 메쉬 대신
+//    카메라를 향한 사각형(정점 4개) 하나로 그림
+//  - 프래그먼트 셰이더가 모델 행렬 역행렬로 광선을 객체 공간 단위 구와 교차시켜
+//    교점의 깊이(gl_FragDepth) / 법선 / 등장방형 UV(createSphere 와 같은 배치)를 계산
+//  - 사각형은 원근 투영에서도 실루엣을 모두 덮도록 접선 원뿔 크기로 키움
+//  - 인스턴스(모델 + 지난 프레임 모델 행렬)를 텍스처별로 묶어 한 번씩 인스턴싱 드로우
+//  - 일식 그림자 / 대기 / 구름 / 야간 조명은 생략 (몇 픽셀 크기에서는 보이지 않음)
+// =====================================================
+class SphereImpostors
+{
+public:
+    static constexpr float MAX_PIXELS = 16.0f;   // 화면 반지름(픽셀) 기준
+
+    SphereImpostors();
+
+    void init();
+    void setShader(Shader* shaderPtr) { shader = shaderPtr; }
+
+    // 화면 크기 판정 기준 (장면 프레임마다)
+    void setView(const glm::vec3& camPos, float fovDeg, int viewportHeight);
+
+    // 중심 / 반지름(월드)인 구가 임포스터로 그릴 만큼 작은지
+    bool shouldUse(const glm::vec3& center, float radius) const;
+
+    // 매 프레임: begin() -> add() * N -> render()
+    void begin();
+    void add(const glm::mat4& model, const glm::mat4& prevModel, unsigned int texture);
+
+    // 조명 / 움직임 벡터 uniform 은 호출 측에서 설정 (sceneShader 와 같은 이름)
+    void render(const glm::mat4& view, const glm::mat4& proj);
+
+    int getLastCount() const { return lastCount; }
+    int getLastDraws() const { return lastDraws; }
+
+private:
+    struct Instance
+    {
+        glm::mat4 model;
+        glm::mat4 prevModel;
+        unsigned int texture;
+    };
+
+    struct GpuInstance
+    {
+        glm::mat4 model;
+        glm::mat4 prevModel;
+    };
+
+    Shader* shader;
+
+    glm::vec3 cameraPos;
+    float pixelsPerUnit;              // 거리 1 에서 길이 1 의 화면 크기 (픽셀)
+
+    std::vector<Instance> instances;
+    std::vector<GpuInstance> upload;
+
+    GpuVertexArray vao;
+    GpuBuffer cornerVBO;
+    GpuBuffer instanceVBO;
+    size_t instanceCapacity;          // instanceVBO 크기 (인스턴스 수)
+
+    int lastCount;
+    int lastDraws;
+
+    void bindInstanceAttributes(size_t firstInstance);
+};
+
+#endif
@@ -3,7 +3,6 @@
 
 #include <vector>
 #include <glm/glm.hpp>
-#include <glm/gtc/matrix_transform.hpp>
 
 #include "Planet.h"
 
@@ -18,21 +17,16 @@ public:
     const std::vector<Planet>& getPlanets() const { return planets; }
 
     float getMass() const { return mass; }
+    void setMass(float m) { mass = m; }
 
-    // ⭐ 자전 업데이트
-    void advanceSpin(float dtSec) const;
-
-    // ⭐ 태양 렌더링용 model matrix 생성
-    glm::mat4 buildModelMatrix(float scale) const;
-
-    // ⭐ 태양 자전 속도 설정
+    // ⭐ 태양 자전 속도 (자전 각도 / 모델 행렬은 BodyStore 가 계산)
     void setSpinSpeed(float degPerSec) { spinDegPerSec = degPerSec; }
+    float getSpinSpeed() const { return spinDegPerSec; }
 
 private:
     float mass;                    // 태양 질량
     std::vector<Planet> planets;
 
-    mutable float spinAngleDeg;    // ⭐ 누적 자전 각도
     float spinDegPerSec;           // ⭐ 초당 회전 속도 (deg/sec)
 };
 
@@ -0,0 +1,180 @@
+﻿#include "TemporalUpscaler.h"
+#include "Shader.h"
+
+#include <GL/glew.h>
+#include <glm/gtc/matrix_inverse.hpp>
+#include <algorithm>
+#include <iostream>
+
+// 움직임 벡터 "기록 안 됨" 표시 (resolve 셰이더에서 -100 미만으로 판별)
+static const float VELOCITY_UNWRITTEN = -1000.0f;
+static const float HISTORY_WEIGHT = 0.9f;
+
+// =====================================================
+// TemporalUpscaler
+// =====================================================
+
+// Halton 수열 (밑 base, 1 부터)
+static float halton(int index, int base)
+{
+    float f = 1.0f, r = 0.0f;
+    while (index > 0)
+    {
+        f /= (float)base;
+        r += f * (float)(index % base);
+        index /= base;
+    }
+    return r;
+}
+
+// 색 / 벡터 타깃 하나 생성
+static void createTexture(GpuRenderTexture& tex, const char* label,
+    int w, int h, GLenum internalFormat, GLenum format, GLenum type, size_t bpp, GLenum filter)
+{
+    tex = GpuRenderTexture(label);
+    glBindTexture(GL_TEXTURE_2D, tex.get());
+    glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, w, h, 0, format, type, nullptr);
+    tex.setBytes(GpuRegistry::imageBytes(w, h, 1, bpp, false));
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filter);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filter);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+}
+
+TemporalUpscaler::TemporalUpscaler()
+    : enabled(false), historyValid(false),
+    outputWidth(0), outputHeight(0), renderWidth(0), renderHeight(0),
+    frameIndex(0), current(0), jitterUV(0.0f),
+    viewProj(1.0f), prevViewProj(1.0f), hasPrevViewProj(false),
+    resolveShader(nullptr)
+{
+}
+
+void TemporalUpscaler::init(int outW, int outH, float renderScale)
+{
+    renderScale = std::min(std::max(renderScale, 0.25f), 1.0f);
+
+    outputWidth = outW;
+    outputHeight = outH;
+    renderWidth = std::max(1, (int)(outW * renderScale + 0.5f));
+    renderHeight = std::max(1, (int)(outH * renderScale + 0.5f));
+
+    // 저해상도 장면 타깃 ---------------------------------------------
+    createTexture(colorTex, "upscale scene color", renderWidth, renderHeight,
+        GL_RGBA16F, GL_RGBA, GL_FLOAT, 8, GL_LINEAR);
+    createTexture(brightTex, "upscale scene bright", renderWidth, renderHeight,
+        GL_RGBA16F, GL_RGBA, GL_FLOAT, 8, GL_LINEAR);
+    createTexture(velocityTex, "upscale velocity", renderWidth, renderHeight,
+        GL_RG16F, GL_RG, GL_FLOAT, 4, GL_NEAREST);
+    createTexture(depthTex, "upscale depth", renderWidth, renderHeight,
+        GL_DEPTH_COMPONENT24, GL_DEPTH_COMPONENT, GL_UNSIGNED_INT, 4, GL_NEAREST);
+
+    sceneFBO = GpuFramebuffer("upscale scene FBO");
+    glBindFramebuffer(GL_FRAMEBUFFER, sceneFBO.get());
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, colorTex.get(), 0);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, GL_TEXTURE_2D, brightTex.get(), 0);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT2, GL_TEXTURE_2D, velocityTex.get(), 0);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, depthTex.get(), 0);
+
+    unsigned int attachments[3] = { GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1, GL_COLOR_ATTACHMENT2 };
+    glDrawBuffers(3, attachments);
+
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+        std::cerr << "Upscale scene framebuffer not complete!\n";
+
+    // 출력 해상도 히스토리 ---------------------------------------------
+    const char* historyLabels[2] = { "upscale history A", "upscale history B" };
+    const char* historyFboLabels[2] = { "upscale history FBO A", "upscale history FBO B" };
+    for (int i = 0; i < 2; i++)
+    {
+        createTexture(historyTex[i], historyLabels[i], outputWidth, outputHeight,
+            GL_RGBA16F, GL_RGBA, GL_FLOAT, 8, GL_LINEAR);
+
+        historyFBO[i] = GpuFramebuffer(historyFboLabels[i]);
+        glBindFramebuffer(GL_FRAMEBUFFER, historyFBO[i].get());
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+            GL_TEXTURE_2D, historyTex[i].get(), 0);
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    current = 0;
+    historyValid = false;
+}
+
+void TemporalUpscaler::setEnabled(bool on)
+{
+    if (on && !enabled)
+        historyValid = false;
+    enabled = on;
+}
+
+glm::mat4 TemporalUpscaler::beginFrame(const glm::mat4& view, const glm::mat4& proj)
+{
+    prevViewProj = hasPrevViewProj ? viewProj : proj * view;
+    viewProj = proj * view;
+    hasPrevViewProj = true;
+
+    if (!enabled)
+    {
+        jitterUV = glm::vec2(0.0f);
+        return proj;
+    }
+
+    // 내부 해상도 픽셀 기준 [-0.5, 0.5) 지터
+    int phase = frameIndex % JITTER_PHASES;
+    frameIndex++;
+    glm::vec2 jitterPx(halton(phase + 1, 2) - 0.5f, halton(phase + 1, 3) - 0.5f);
+    jitterUV = jitterPx / glm::vec2((float)renderWidth, (float)renderHeight);
+
+    // NDC 에서 +2*jitterUV 만큼 이동 (원근 투영은 w = -z 이므로 부호 반대로 더함)
+    glm::mat4 jittered = proj;
+    jittered[2][0] -= 2.0f * jitterUV.x;
+    jittered[2][1] -= 2.0f * jitterUV.y;
+    return jittered;
+}
+
+void TemporalUpscaler::clearVelocity()
+{
+    const float unwritten[4] = { VELOCITY_UNWRITTEN, VELOCITY_UNWRITTEN, 0.0f, 0.0f };
+    glClearBufferfv(GL_COLOR, 2, unwritten);
+}
+
+void TemporalUpscaler::resolve(unsigned int quadVAO)
+{
+    if (!resolveShader || !sceneFBO.valid()) return;
+
+    int previous = current;
+    current = 1 - current;
+
+    glBindFramebuffer(GL_FRAMEBUFFER, historyFBO[current].get());
+    glViewport(0, 0, outputWidth, outputHeight);
+    glDisable(GL_DEPTH_TEST);
+    glDisable(GL_BLEND);
+
+    resolveShader->use();
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, colorTex.get());
+    resolveShader->setInt("currentTex", 0);
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D, velocityTex.get());
+    resolveShader->setInt("velocityTex", 1);
+    glActiveTexture(GL_TEXTURE2);
+    glBindTexture(GL_TEXTURE_2D, depthTex.get());
+    resolveShader->setInt("depthTex", 2);
+    glActiveTexture(GL_TEXTURE3);
+    glBindTexture(GL_TEXTURE_2D, historyTex[previous].get());
+    resolveShader->setInt("historyTex", 3);
+    glActiveTexture(GL_TEXTURE0);
+
+    resolveShader->setVec2("jitterUV", jitterUV);
+    resolveShader->setMat4("reprojection", prevViewProj * glm::inverse(viewProj));
+    resolveShader->setFloat("historyWeight", historyValid ? HISTORY_WEIGHT : 0.0f);
+
+    glBindVertexArray(quadVAO);
+    glDrawArrays(GL_TRIANGLES, 0, 6);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    historyValid = true;
+}
@@ -0,0 +1,82 @@
+﻿#ifndef TEMPORAL_UPSCALER_H
+#define TEMPORAL_UPSCALER_H
+
+#include <glm/glm.hpp>
+
+#include "GpuResource.h"
+
+class Shader;
+
+// =====================================================
+// TemporalUpscaler
+//  - HDR 장면을 renderScale 배 해상도로, 프레임마다 다른 부분 픽셀 지터
+//    (Halton 2,3 / JITTER_PHASES 주기)를 투영 행렬에 더해 그림
+//  - 장면 FBO: 색 / 밝은 부분(블룸) / 움직임 벡터(RG16F) / 깊이 텍스처
+//    움직임 벡터는 sceneShader 가 모델 행렬(현재 / 지난 프레임)로 직접 기록,
+//    기록되지 않은 픽셀(고리 / 빈 공간)은 깊이 + 카메라 행렬로 재투영
+//  - 복원: 출력 해상도 히스토리(핑퐁)를 움직임 벡터로 가져와
+//    현재 저해상도 3x3 이웃의 최소/최대로 제한한 뒤 섞음
+//  - 궤도선 / 스카이박스는 합성 단계에서 출력 해상도로 그리므로 영향 없음
+// =====================================================
+class TemporalUpscaler
+{
+public:
+    static const int JITTER_PHASES = 8;
+
+    TemporalUpscaler();
+
+    // 출력 해상도 + 내부 해상도 배율 (0.25 ~ 1)
+    void init(int outputWidth, int outputHeight, float renderScale);
+    void setShader(Shader* resolve) { resolveShader = resolve; }
+
+    void setEnabled(bool on);
+    bool isEnabled() const { return enabled; }
+
+    // 히스토리 버리기 (다음 프레임은 현재 값만 사용)
+    void reset() { historyValid = false; }
+
+    int getRenderWidth() const { return renderWidth; }
+    int getRenderHeight() const { return renderHeight; }
+    unsigned int getSceneFBO() const { return sceneFBO.get(); }
+    unsigned int getBrightTexture() const { return brightTex.get(); }
+    unsigned int getOutputTexture() const { return historyTex[current].get(); }
+
+    // 장면 프레임 시작: 지터가 적용된 투영 행렬 반환 (꺼져 있으면 그대로)
+    //  - 움직임 벡터용 행렬(지터 없음)은 꺼져 있어도 갱신
+    glm::mat4 beginFrame(const glm::mat4& view, const glm::mat4& proj);
+
+    const glm::mat4& getViewProj() const { return viewProj; }
+    const glm::mat4& getPrevViewProj() const { return prevViewProj; }
+
+    // 장면 FBO 를 지운 뒤 호출: 움직임 벡터를 "기록 안 됨" 값으로 채움
+    void clearVelocity();
+
+    // 저해상도 장면 → 출력 해상도 히스토리 (viewport 는 출력 크기로 남음)
+    void resolve(unsigned int quadVAO);
+
+private:
+    bool enabled;
+    bool historyValid;
+    int outputWidth, outputHeight;
+    int renderWidth, renderHeight;
+    int frameIndex;
+    int current;                      // 최신 히스토리 핑퐁 인덱스
+
+    glm::vec2 jitterUV;               // 이번 프레임 지터 (UV 단위)
+    glm::mat4 viewProj;               // 지터 없는 현재 / 지난 프레임 행렬
+    glm::mat4 prevViewProj;
+    bool hasPrevViewProj;
+
+    GpuFramebuffer sceneFBO;
+    GpuRenderTexture colorTex;
+    GpuRenderTexture brightTex;
+    GpuRenderTexture velocityTex;
+    GpuRenderTexture depthTex;
+
+    GpuRenderTexture historyTex[2];
+    GpuFramebuffer historyFBO[2];
+
+    Shader* resolveShader;
+};
+
+#endif
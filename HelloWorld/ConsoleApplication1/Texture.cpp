@@ -1,58 +1,349 @@
 #include "Texture.h"
+#include "GpuResource.h"
+#include "TextureStreamer.h"
+#include "CookedTexture.h"
 
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
 
+#define STB_IMAGE_RESIZE_IMPLEMENTATION
+#include "stb_image_resize2.h"
+
 #include <GL/glew.h>
 #include <iostream>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
 
-unsigned int loadTexture(const std::string& path)
+static GLenum formatFor(int channels)
 {
+    if (channels == 1)
+        return GL_RED;
+    else if (channels == 3)
+        return GL_RGB;
+    else if (channels == 4)
+        return GL_RGBA;
+    else
+        return GL_RGB; // fallback
+}
+
+bool decodeImage(const std::string& path, TextureImage& out)
+{
+    // ŷ ؽó  ڵ  θ
+    out.cooked.clear();
+    out.baseLevel = 0;
+    std::shared_ptr<CookedTexture> cooked = CookedTexture::openFor(path);
+    if (cooked)
+    {
+        out.width = cooked->getWidth();
+        out.height = cooked->getHeight();
+        out.channels = (cooked->getFormat() == ctex::Format::BC4) ? 1
+            : (cooked->getFormat() == ctex::Format::BC1) ? 3 : 4;
+        out.layers = 0;
+        out.pixels.clear();
+        out.cooked.push_back(cooked);
+        return true;
+    }
+
     int width, height, channels;
     unsigned char* data = stbi_load(path.c_str(), &width, &height, &channels, 0);
 
     if (!data)
     {
         std::cerr << "[Texture] Failed to load texture: " << path << "\n";
-        return 0;
+        return false;
     }
 
-    GLenum format;
-    if (channels == 1)
-        format = GL_RED;
-    else if (channels == 3)
-        format = GL_RGB;
-    else if (channels == 4)
-        format = GL_RGBA;
+    out.width = width;
+    out.height = height;
+    out.channels = channels;
+    out.layers = 0;
+    out.pixels.assign(data, data + (size_t)width * height * channels);
+    stbi_image_free(data);
+    return true;
+}
+
+bool decodeImageArray(const std::vector<std::string>& paths, TextureImage& out)
+{
+    out.width = out.height = 0;
+    out.channels = 4;
+    out.layers = (int)paths.size();
+    out.pixels.clear();
+    out.cooked.clear();
+    out.baseLevel = 0;
+
+    //  ̾   / ũ ŷ   迭 (ϳ ٸ ڵ)
+    for (const std::string& p : paths)
+    {
+        std::shared_ptr<CookedTexture> c = CookedTexture::openFor(p);
+        if (!c || (!out.cooked.empty() && !c->sameLayout(*out.cooked[0])))
+        {
+            out.cooked.clear();
+            break;
+        }
+        out.cooked.push_back(c);
+    }
+    if (!out.cooked.empty())
+    {
+        out.width = out.cooked[0]->getWidth();
+        out.height = out.cooked[0]->getHeight();
+        return true;
+    }
+
+    for (size_t layer = 0; layer < paths.size(); layer++)
+    {
+        int w, h, channels;
+        unsigned char* data = stbi_load(paths[layer].c_str(), &w, &h, &channels, 4);
+
+        if (!data)
+        {
+            std::cerr << "[Texture] Failed to load texture layer: " << paths[layer] << "\n";
+            continue; // ش ̾  
+        }
+
+        if (out.width == 0)
+        {
+            // ù °  ̹ 迭 ũ⸦ 
+            out.width = w;
+            out.height = h;
+        }
+        out.pixels.resize((size_t)out.width * out.height * 4 * paths.size(), 0);
+
+        unsigned char* dst = out.pixels.data() + (size_t)out.width * out.height * 4 * layer;
+        if (w == out.width && h == out.height)
+        {
+            memcpy(dst, data, (size_t)out.width * out.height * 4);
+        }
+        else
+        {
+            stbir_resize_uint8_linear(data, w, h, 0, dst, out.width, out.height, 0, STBIR_RGBA);
+        }
+
+        stbi_image_free(data);
+    }
+
+    return out.width > 0;
+}
+
+size_t fitImageToBudget(TextureImage& img, const std::string& label)
+{
+    if (!img.cooked.empty())
+    {
+        //   ̹ Ƿ ø    ǳʶ
+        const CookedTexture& c = *img.cooked[0];
+        int layers = std::max(1, img.layers);
+        auto bytesFrom = [&](int first) {
+            size_t b = 0;
+            for (int l = first; l < c.getLevels(); l++)
+                b += c.levelSize(l);
+            return b * layers;
+        };
+
+        img.baseLevel = 0;
+        size_t bytes = bytesFrom(0);
+        while (!GpuRegistry::fits(bytes) && img.baseLevel + 1 < c.getLevels())
+            bytes = bytesFrom(++img.baseLevel);
+
+        if (img.baseLevel > 0)
+        {
+            std::cerr << "[Texture] " << label << " starts at mip " << img.baseLevel << " ("
+                << c.levelWidth(img.baseLevel) << "x" << c.levelHeight(img.baseLevel)
+                << ", VRAM budget)\n";
+        }
+        return bytes;
+    }
+
+    if (img.layers > 0)
+        return GpuRegistry::imageBytes(img.width, img.height, img.layers, 4, true);
+
+    // VRAM     ػ󵵸 ݾ 
+    //  (RGB  ̹  4Ʈ ϹǷ 4 )
+    int bpp = (img.channels == 3) ? 4 : img.channels;
+    size_t bytes = GpuRegistry::imageBytes(img.width, img.height, 1, bpp, true);
+
+    if (!GpuRegistry::fits(bytes))
+    {
+        int w = img.width, h = img.height;
+        while (!GpuRegistry::fits(bytes) && (w > 1 || h > 1))
+        {
+            w = (w > 1) ? w / 2 : 1;
+            h = (h > 1) ? h / 2 : 1;
+            bytes = GpuRegistry::imageBytes(w, h, 1, bpp, true);
+        }
+
+        std::vector<unsigned char> small((size_t)w * h * img.channels);
+        stbir_resize_uint8_linear(img.pixels.data(), img.width, img.height, 0,
+            small.data(), w, h, 0, (stbir_pixel_layout)img.channels);
+        img.pixels.swap(small);
+
+        std::cerr << "[Texture] " << label << " downscaled to " << w << "x" << h
+            << " (VRAM budget)\n";
+        img.width = w;
+        img.height = h;
+    }
+    return bytes;
+}
+
+// ŷ ؽó: ε   ״ ø (Ӹ  )
+static void uploadCooked(const TextureImage& img)
+{
+    const CookedTexture& c0 = *img.cooked[0];
+    GLenum format = c0.getGLFormat();
+    int first = img.baseLevel;
+    int levels = c0.getLevels() - first;
+    int w = c0.levelWidth(first);
+    int h = c0.levelHeight(first);
+    GLenum target = (img.layers > 0) ? GL_TEXTURE_2D_ARRAY : GL_TEXTURE_2D;
+
+    // Һ  (ARB_texture_storage    Ҵ)
+    bool storage = GLEW_ARB_texture_storage != 0;
+
+    if (img.layers > 0)
+    {
+        if (storage)
+            glTexStorage3D(target, levels, format, w, h, img.layers);
+
+        for (int l = 0; l < levels; l++)
+        {
+            int level = first + l;
+            int lw = c0.levelWidth(level), lh = c0.levelHeight(level);
+            if (!storage)
+            {
+                glCompressedTexImage3D(target, l, format, lw, lh, img.layers, 0,
+                    (GLsizei)(c0.levelSize(level) * img.layers), nullptr);
+            }
+            for (int layer = 0; layer < img.layers; layer++)
+            {
+                const CookedTexture& c = *img.cooked[layer];
+                glCompressedTexSubImage3D(target, l, 0, 0, layer, lw, lh, 1, format,
+                    (GLsizei)c.levelSize(level), c.levelData(level));
+            }
+        }
+    }
     else
-        format = GL_RGB; // fallback
+    {
+        if (storage)
+            glTexStorage2D(target, levels, format, w, h);
+
+        for (int l = 0; l < levels; l++)
+        {
+            int level = first + l;
+            int lw = c0.levelWidth(level), lh = c0.levelHeight(level);
+            if (storage)
+            {
+                glCompressedTexSubImage2D(target, l, 0, 0, lw, lh, format,
+                    (GLsizei)c0.levelSize(level), c0.levelData(level));
+            }
+            else
+            {
+                glCompressedTexImage2D(target, l, format, lw, lh, 0,
+                    (GLsizei)c0.levelSize(level), c0.levelData(level));
+            }
+        }
+    }
+
+    if (!storage)
+        glTexParameteri(target, GL_TEXTURE_MAX_LEVEL, levels - 1);
+}
 
-    unsigned int textureID;
-    glGenTextures(1, &textureID);
+void uploadImage(const TextureImage& img, const void* data)
+{
+    if (!img.cooked.empty())
+    {
+        uploadCooked(img);
+        return;
+    }
 
-    glBindTexture(GL_TEXTURE_2D, textureID);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1); // RGB / Ȧ  ̹ ϰ
 
+    if (img.layers > 0)
+    {
+        glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, GL_RGBA8,
+            img.width, img.height, img.layers,
+            0, GL_RGBA, GL_UNSIGNED_BYTE, data);
+        glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
+        return;
+    }
+
+    GLenum format = formatFor(img.channels);
     glTexImage2D(GL_TEXTURE_2D,
         0,
         format,
-        width,
-        height,
+        img.width,
+        img.height,
         0,
         format,
         GL_UNSIGNED_BYTE,
         data);
 
     glGenerateMipmap(GL_TEXTURE_2D);
+}
 
+void setTextureSampler(unsigned int target, TextureSampler sampler)
+{
     // Wrapping ɼ
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+    glTexParameteri(target, GL_TEXTURE_WRAP_S,
+        sampler == TextureSampler::ClampS ? GL_CLAMP_TO_EDGE : GL_REPEAT);
+    glTexParameteri(target, GL_TEXTURE_WRAP_T, GL_REPEAT);
 
     // Filtering ɼ
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(target, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+    glTexParameteri(target, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+}
 
-    stbi_image_free(data);
+TextureRef loadTexture(const std::string& path, unsigned int placeholderRGBA,
+    TextureSampler sampler)
+{
+    std::vector<std::string> paths{ path };
+    std::string key = TextureCache::makeKey(paths, false, sampler);
+    TextureRef cached = TextureCache::find(key);
+    if (cached)
+        return cached;
+
+    // 񵿱 ε ̸ ڸ ǥ ؽó  ٷ ȯ
+    if (TextureStreamer::isRunning())
+        return TextureCache::insert(key, TextureStreamer::load(paths, false, placeholderRGBA, sampler));
+
+    TextureImage img;
+    if (!decodeImage(path, img))
+        return TextureRef();
+
+    size_t bytes = fitImageToBudget(img, path);
+    int slot = GpuRegistry::create(GpuKind::Texture, GpuClass::Texture, path);
+    GpuRegistry::setBytes(slot, bytes);
+
+    glBindTexture(GL_TEXTURE_2D, GpuRegistry::name(slot));
+    uploadImage(img, img.pixels.data());
+    setTextureSampler(GL_TEXTURE_2D, sampler);
+
+    return TextureCache::insert(key, slot);
+}
+
+TextureRef loadTextureArray(const std::vector<std::string>& paths, TextureSampler sampler)
+{
+    if (paths.empty()) return TextureRef();
+
+    std::string key = TextureCache::makeKey(paths, true, sampler);
+    TextureRef cached = TextureCache::find(key);
+    if (cached)
+        return cached;
+
+    if (TextureStreamer::isRunning())
+        return TextureCache::insert(key, TextureStreamer::load(paths, true, 0x00000000u, sampler));
+
+    TextureImage img;
+    if (!decodeImageArray(paths, img))
+        return TextureRef();
+
+    std::string label = "texture array (" + std::to_string(paths.size()) + " layers)";
+    int slot = GpuRegistry::create(GpuKind::Texture, GpuClass::Texture, label);
+    GpuRegistry::setBytes(slot, fitImageToBudget(img, label));
+    glBindTexture(GL_TEXTURE_2D_ARRAY, GpuRegistry::name(slot));
+
+    uploadImage(img, img.pixels.data());
+    setTextureSampler(GL_TEXTURE_2D_ARRAY, sampler);
+
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
 
-    return textureID;
+    return TextureCache::insert(key, slot);
 }
@@ -2,10 +2,63 @@
 #define TEXTURE_H
 
 #include <string>
+#include <vector>
+#include <memory>
+
+#include "TextureCache.h"
+
+class CookedTexture;
 
 // JPG / PNG 텍스처 로더
-// 반환값: OpenGL texture ID
-unsigned int loadTexture(const std::string& path);
+//  - TextureCache 를 거치므로 같은 파일 + 샘플러는 한 번만 디코딩 / 업로드하고 참조를 공유
+//  - TextureStreamer 가 켜져 있으면 1x1 자리 표시 텍스처를 바로 만들어 반환하고
+//    실제 이미지는 나중에 같은 ID 에 올라감 (placeholderRGBA = 0xRRGGBBAA, 처음 요청한 쪽 기준)
+// 반환값: 공유 텍스처 참조 (실패하면 빈 참조)
+TextureRef loadTexture(const std::string& path, unsigned int placeholderRGBA = 0x808080FFu,
+    TextureSampler sampler = TextureSampler::Repeat);
+
+// 여러 이미지를 한 장의 GL_TEXTURE_2D_ARRAY 로 로드 (RGBA, 레이어 순서 = paths 순서)
+//  - 첫 이미지와 크기가 다르면 첫 이미지 크기로 리샘플링
+//  - 로드 실패한 레이어는 투명으로 채움
+//  - TextureStreamer 가 켜져 있으면 투명 1x1 레이어로 먼저 만들어 반환
+// 반환값: 공유 텍스처 참조 (모두 실패하면 빈 참조)
+TextureRef loadTextureArray(const std::vector<std::string>& paths,
+    TextureSampler sampler = TextureSampler::ClampS);
+
+// =====================================================
+// 로더 공용 단계 (동기 로더와 TextureStreamer 가 함께 씀)
+// =====================================================
+
+// 디코딩된 이미지 (위 -> 아래 행 순서 그대로)
+struct TextureImage
+{
+    int width = 0, height = 0;
+    int channels = 0;   // 1 / 3 / 4 (배열은 항상 4)
+    int layers = 0;     // 0 = 2D 텍스처, 1 이상 = 배열 레이어 수
+    std::vector<unsigned char> pixels;
+
+    // 쿠킹된 압축 텍스처 (.ctex, 있으면 pixels 대신 사용 / 배열은 레이어마다 하나)
+    std::vector<std::shared_ptr<CookedTexture>> cooked;
+    int baseLevel = 0;  // VRAM 예산 때문에 건너뛸 상위 밉 레벨 수
+};
+
+// 원본 옆에 .ctex 가 있으면 맵핑만 하고, 없으면 stb_image 로 디코딩
+// (GL 호출 없음 -> 작업 스레드에서 호출 가능)
+bool decodeImage(const std::string& path, TextureImage& out);
+bool decodeImageArray(const std::vector<std::string>& paths, TextureImage& out);
+
+// 이하 GL 스레드 전용
+// VRAM 예산을 넘으면 해상도를 절반씩 줄이고 필요한 바이트 수 반환
+//  (디코딩한 2D 는 리샘플링, 쿠킹된 텍스처는 상위 밉 레벨을 건너뜀)
+size_t fitImageToBudget(TextureImage& img, const std::string& label);
+
+// 바인딩된 텍스처에 이미지 전체 + 밉맵 업로드 (data = nullptr 이면 바인딩된 PBO 에서)
+//  - 쿠킹된 텍스처는 data 를 무시하고 맵핑된 파일에서 레벨별로 바로 올림
+//    (불변 저장소 glTexStorage + glCompressedTexSubImage, 밉맵 생성 없음)
+void uploadImage(const TextureImage& img, const void* data);
+
+// 바인딩된 target 에 래핑 / 필터링 설정
+void setTextureSampler(unsigned int target, TextureSampler sampler);
 
 #endif
 
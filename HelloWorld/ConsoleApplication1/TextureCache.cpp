@@ -0,0 +1,106 @@
+﻿#include "TextureCache.h"
+#include "GpuResource.h"
+#include "TextureStreamer.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+
+struct TextureRef::Entry
+{
+    std::string key;
+    int slot;           // GpuRegistry 슬롯 (엔트리가 소유)
+
+    ~Entry() { TextureCache::evict(key, slot); }
+};
+
+std::unordered_map<std::string, std::weak_ptr<TextureRef::Entry>> TextureCache::entries;
+int TextureCache::requests = 0;
+int TextureCache::hits = 0;
+int TextureCache::evictions = 0;
+
+unsigned int TextureRef::get() const
+{
+    return entry ? GpuRegistry::name(entry->slot) : 0;
+}
+
+// "textures/a.jpg", "./textures/a.jpg", "textures\\a.jpg" 가 같은 키가 되도록 정규화
+//  - 파일이 없으면 (어차피 로드 실패) 구분자만 통일
+static std::string canonicalPath(const std::string& path)
+{
+    std::string out;
+#ifdef _WIN32
+    char buf[_MAX_PATH];
+    out = _fullpath(buf, path.c_str(), _MAX_PATH) ? buf : path;
+    std::replace(out.begin(), out.end(), '\\', '/');
+    std::transform(out.begin(), out.end(), out.begin(),
+        [](unsigned char c) { return (char)std::tolower(c); }); // 대소문자 구분 없음
+#else
+    char* resolved = realpath(path.c_str(), nullptr);
+    if (resolved)
+    {
+        out = resolved;
+        free(resolved);
+    }
+    else
+    {
+        out = path;
+        std::replace(out.begin(), out.end(), '\\', '/');
+    }
+#endif
+    return out;
+}
+
+std::string TextureCache::makeKey(const std::vector<std::string>& paths, bool array,
+    TextureSampler sampler)
+{
+    std::string key = array ? "array" : "2d";
+    key += sampler == TextureSampler::Repeat ? "|repeat" : "|clamp-s";
+    for (const auto& p : paths)
+        key += "|" + canonicalPath(p);
+    return key;
+}
+
+TextureRef TextureCache::find(const std::string& key)
+{
+    requests++;
+
+    TextureRef ref;
+    auto it = entries.find(key);
+    if (it != entries.end())
+    {
+        ref.entry = it->second.lock();
+        if (ref.entry)
+            hits++;
+    }
+    return ref;
+}
+
+TextureRef TextureCache::insert(const std::string& key, int slot)
+{
+    TextureRef ref;
+    ref.entry = std::make_shared<TextureRef::Entry>();
+    ref.entry->key = key;
+    ref.entry->slot = slot;
+    entries[key] = ref.entry;
+    return ref;
+}
+
+void TextureCache::evict(const std::string& key, int slot)
+{
+    auto it = entries.find(key);
+    if (it != entries.end() && it->second.expired())
+        entries.erase(it);
+
+    // 아직 디코딩 중이면 업로드 취소 (슬롯 번호는 곧 다른 오브젝트가 재사용할 수 있음)
+    TextureStreamer::cancel(slot);
+    GpuRegistry::destroy(slot);
+    evictions++;
+}
+
+void TextureCache::report(std::ostream& os)
+{
+    os << "[TextureCache] " << requests << " requests, " << hits
+        << " shared (decode + upload skipped), " << entries.size() << " live, "
+        << evictions << " evicted\n";
+}
@@ -0,0 +1,71 @@
+﻿#ifndef TEXTURE_CACHE_H
+#define TEXTURE_CACHE_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <unordered_map>
+#include <ostream>
+
+// =====================================================
+// 샘플러 설정 (캐시 키의 일부: 같은 이미지라도 설정이 다르면 다른 텍스처)
+// =====================================================
+enum class TextureSampler
+{
+    Repeat,     // S / T 반복 + 트라이리니어 (구 표면, 배경)
+    ClampS      // S clamp / T 반복 + 트라이리니어 (고리: 반지름 방향 clamp)
+};
+
+// =====================================================
+// TextureRef — 캐시된 텍스처를 공유하는 참조 카운트 핸들
+//  - 복사하면 참조가 늘고, 마지막 참조가 사라지면 캐시에서 빠지고 GL 텍스처도 삭제
+//  - GpuRegistry::shutdown() 이후에는 소멸자가 GL 호출을 하지 않음
+// =====================================================
+class TextureRef
+{
+public:
+    TextureRef() {}
+
+    unsigned int get() const;   // GL 텍스처 이름 (없으면 0)
+    explicit operator bool() const { return get() != 0; }
+    long useCount() const { return entry.use_count(); }
+
+private:
+    friend class TextureCache;
+    struct Entry;
+    std::shared_ptr<Entry> entry;
+};
+
+// =====================================================
+// TextureCache
+//  - 정규화한 경로 + 배열 여부 + 샘플러를 키로 텍스처를 한 번만 디코딩 / 업로드
+//  - 캐시는 약한 참조만 들고 있음 (살아 있는 TextureRef 가 없으면 바로 제거)
+//  - GL 스레드 전용, 프로그램 전체에서 하나 (정적 클래스)
+// =====================================================
+class TextureCache
+{
+public:
+    // 캐시 키 (경로는 실제 파일 기준 절대 경로로 정규화)
+    static std::string makeKey(const std::vector<std::string>& paths, bool array,
+        TextureSampler sampler);
+
+    // 이미 있으면 참조를 하나 더 만들어 반환 (없으면 빈 참조)
+    static TextureRef find(const std::string& key);
+
+    // GpuRegistry 슬롯의 소유권을 넘겨받아 등록
+    static TextureRef insert(const std::string& key, int slot);
+
+    static int liveCount() { return (int)entries.size(); }
+    static void report(std::ostream& os);
+
+private:
+    static std::unordered_map<std::string, std::weak_ptr<TextureRef::Entry>> entries;
+
+    // 통계
+    static int requests, hits, evictions;
+
+    static void evict(const std::string& key, int slot);
+    friend struct TextureRef::Entry;
+};
+
+#endif
@@ -0,0 +1,276 @@
+﻿#include "TextureStreamer.h"
+
+#include <GL/glew.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+
+std::vector<TextureStreamer::Job> TextureStreamer::jobs;
+std::deque<int> TextureStreamer::queue;
+std::deque<TextureStreamer::Decoded> TextureStreamer::ready;
+std::vector<std::thread> TextureStreamer::workers;
+std::mutex TextureStreamer::mutex;
+std::condition_variable TextureStreamer::cond;
+std::condition_variable TextureStreamer::readyCond;
+bool TextureStreamer::quit = false;
+bool TextureStreamer::running = false;
+int TextureStreamer::pending = 0;
+GpuBuffer TextureStreamer::pbos[TextureStreamer::PBO_COUNT];
+int TextureStreamer::nextPbo = 0;
+int TextureStreamer::uploaded = 0;
+int TextureStreamer::failed = 0;
+int TextureStreamer::cancelled = 0;
+int TextureStreamer::cookedUploads = 0;
+size_t TextureStreamer::uploadedBytes = 0;
+double TextureStreamer::uploadMs = 0.0;
+double TextureStreamer::maxPumpMs = 0.0;
+
+static double nowMs()
+{
+    using namespace std::chrono;
+    return duration<double, std::milli>(steady_clock::now().time_since_epoch()).count();
+}
+
+void TextureStreamer::start(int workerThreads)
+{
+    if (running) return;
+
+    quit = false;
+    for (int i = 0; i < std::max(1, workerThreads); i++)
+        workers.emplace_back(&TextureStreamer::workerLoop);
+
+    for (auto& p : pbos)
+        p = GpuBuffer("texture upload PBO");
+    nextPbo = 0;
+    running = true;
+}
+
+void TextureStreamer::stop()
+{
+    if (!running) return;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        quit = true;
+        queue.clear();
+        ready.clear();
+    }
+    cond.notify_all();
+    for (auto& t : workers)
+        t.join();
+    workers.clear();
+
+    for (auto& p : pbos)
+        p.reset();
+    running = false;
+}
+
+int TextureStreamer::load(const std::vector<std::string>& paths, bool array,
+    unsigned int placeholderRGBA, TextureSampler sampler)
+{
+    std::string label = array
+        ? "texture array (" + std::to_string(paths.size()) + " layers)"
+        : paths[0];
+
+    // 1x1 자리 표시 (밉맵 레벨이 하나뿐이라 밉맵 필터링으로도 완전한 텍스처)
+    int slot = GpuRegistry::create(GpuKind::Texture, GpuClass::Texture, label);
+    unsigned int textureID = GpuRegistry::name(slot);
+    GLenum target = array ? GL_TEXTURE_2D_ARRAY : GL_TEXTURE_2D;
+    int layers = array ? (int)paths.size() : 1;
+
+    std::vector<unsigned char> texel((size_t)layers * 4);
+    for (int l = 0; l < layers; l++)
+    {
+        texel[l * 4 + 0] = (unsigned char)(placeholderRGBA >> 24);
+        texel[l * 4 + 1] = (unsigned char)(placeholderRGBA >> 16);
+        texel[l * 4 + 2] = (unsigned char)(placeholderRGBA >> 8);
+        texel[l * 4 + 3] = (unsigned char)(placeholderRGBA);
+    }
+
+    glBindTexture(target, textureID);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    if (array)
+        glTexImage3D(target, 0, GL_RGBA8, 1, 1, layers, 0, GL_RGBA, GL_UNSIGNED_BYTE, texel.data());
+    else
+        glTexImage2D(target, 0, GL_RGBA8, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, texel.data());
+    setTextureSampler(target, sampler);
+    glBindTexture(target, 0);
+    GpuRegistry::setBytes(slot, texel.size());
+
+    Job job;
+    job.slot = slot;
+    job.array = array;
+    job.paths = paths;
+    pending++;
+
+    {
+        // jobs 가 재할당될 수 있으므로 작업 스레드가 읽는 것과 같은 mutex 구간에서 추가
+        std::lock_guard<std::mutex> lock(mutex);
+        jobs.push_back(job);
+        queue.push_back((int)jobs.size() - 1);
+    }
+    cond.notify_one();
+
+    return slot;
+}
+
+void TextureStreamer::cancel(int slot)
+{
+    // 디코딩 결과는 그대로 받되 pump() 에서 업로드만 건너뜀
+    for (auto& job : jobs)
+    {
+        if (job.slot == slot)
+            job.slot = -1;
+    }
+}
+
+void TextureStreamer::workerLoop()
+{
+    for (;;)
+    {
+        Decoded d;
+        std::vector<std::string> paths;
+        bool array = false;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            cond.wait(lock, [] { return quit || !queue.empty(); });
+            if (quit) return;
+
+            d.job = queue.front();
+            queue.pop_front();
+            paths = jobs[d.job].paths;
+            array = jobs[d.job].array;
+        }
+
+        d.ok = array ? decodeImageArray(paths, d.image) : decodeImage(paths[0], d.image);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            ready.push_back(std::move(d));
+        }
+        readyCond.notify_all();
+    }
+}
+
+bool TextureStreamer::pump(double budgetMs)
+{
+    if (!running || pending == 0) return false;
+
+    double t0 = nowMs();
+    bool any = false;
+
+    for (;;)
+    {
+        Decoded d;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (ready.empty()) break;
+            d = std::move(ready.front());
+            ready.pop_front();
+        }
+
+        // jobs 는 GL 스레드(load)에서만 늘어나므로 잠금 없이 읽음
+        if (jobs[d.job].slot < 0)
+            cancelled++; // 올리기 전에 캐시에서 빠진 텍스처
+        else if (d.ok)
+            upload(jobs[d.job], d.image);
+        else
+            failed++;
+
+        pending--;
+        any = true;
+
+        // 예산을 넘었으면 나머지는 다음 프레임으로 (최소 한 장은 올림)
+        if (nowMs() - t0 >= budgetMs)
+            break;
+    }
+
+    if (any)
+        maxPumpMs = std::max(maxPumpMs, nowMs() - t0);
+    return any;
+}
+
+void TextureStreamer::upload(const Job& job, TextureImage& image)
+{
+    double t0 = nowMs();
+
+    std::string label = job.array ? "texture array" : job.paths[0];
+    size_t bytes = fitImageToBudget(image, label);
+    GLenum target = job.array ? GL_TEXTURE_2D_ARRAY : GL_TEXTURE_2D;
+
+    if (!image.cooked.empty())
+    {
+        // 쿠킹된 텍스처: 이미 맵핑된 파일에서 압축 레벨을 바로 올림 (PBO 복사 생략)
+        glBindTexture(target, GpuRegistry::name(job.slot));
+        uploadImage(image, nullptr);
+        glBindTexture(target, 0);
+
+        GpuRegistry::setBytes(job.slot, bytes);
+        uploaded++;
+        cookedUploads++;
+        uploadedBytes += bytes;
+        uploadMs += nowMs() - t0;
+        return;
+    }
+
+    // PBO 에 복사한 뒤 PBO 에서 업로드 (이전 내용은 버림: 드라이버가 새 저장소를 줌)
+    GpuBuffer& pbo = pbos[nextPbo];
+    nextPbo = (nextPbo + 1) % PBO_COUNT;
+
+    size_t size = image.pixels.size();
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pbo.get());
+    glBufferData(GL_PIXEL_UNPACK_BUFFER, size, nullptr, GL_STREAM_DRAW);
+    pbo.setBytes(size);
+    void* dst = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size,
+        GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+
+    glBindTexture(target, GpuRegistry::name(job.slot));
+    if (dst)
+    {
+        memcpy(dst, image.pixels.data(), size);
+        glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+        uploadImage(image, nullptr);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    }
+    else
+    {
+        // 맵핑 실패: 클라이언트 메모리에서 바로 업로드
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        uploadImage(image, image.pixels.data());
+    }
+    glBindTexture(target, 0);
+
+    GpuRegistry::setBytes(job.slot, bytes);
+    uploaded++;
+    uploadedBytes += size;
+    uploadMs += nowMs() - t0;
+}
+
+void TextureStreamer::finish()
+{
+    while (running && pending > 0)
+    {
+        pump(1.0e9);
+        if (pending == 0) break;
+
+        std::unique_lock<std::mutex> lock(mutex);
+        readyCond.wait(lock, [] { return !ready.empty(); });
+    }
+}
+
+void TextureStreamer::report(std::ostream& os)
+{
+    // 뒤에 출력하는 벤치마크 줄의 숫자 형식을 바꾸지 않도록 되돌려 둠
+    std::ios::fmtflags flags = os.flags();
+    std::streamsize precision = os.precision();
+
+    os << std::fixed << std::setprecision(1);
+    os << "[Texture] " << uploaded << " streamed (" << cookedUploads << " cooked, " << uploadedBytes / (1024.0 * 1024.0)
+        << " MiB), " << failed << " failed, " << cancelled << " cancelled, " << pending << " pending, upload "
+        << uploadMs << " ms total, longest pump " << maxPumpMs << " ms\n";
+
+    os.flags(flags);
+    os.precision(precision);
+}
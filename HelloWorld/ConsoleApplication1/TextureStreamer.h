@@ -0,0 +1,91 @@
+﻿#ifndef TEXTURE_STREAMER_H
+#define TEXTURE_STREAMER_H
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <ostream>
+
+#include "GpuResource.h"
+#include "Texture.h"
+
+// =====================================================
+// TextureStreamer
+//  - 켜져 있는 동안 loadTexture / loadTextureArray 는 디코딩을 기다리지 않음
+//    1) GL 스레드: 1x1 자리 표시 텍스처를 만들어 ID 를 바로 돌려줌
+//    2) 작업 스레드: stb_image 로 디코딩
+//    3) GL 스레드 pump(): PBO 에 복사 -> 같은 ID 에 이미지 + 밉맵 업로드
+//       프레임마다 시간 예산 안에서 (최소 한 장은 올림)
+//       쿠킹된 .ctex 는 작업 스레드가 맵핑만 하고 압축 레벨을 PBO 없이 바로 올림
+//  - ID 가 바뀌지 않으므로 그리는 쪽은 로딩 여부를 몰라도 됨
+//  - 디코딩에 실패한 텍스처는 자리 표시 색으로 남음
+//  - GpuRegistry 처럼 프로그램 전체에서 하나 (정적 클래스)
+// =====================================================
+class TextureStreamer
+{
+public:
+    static void start(int workerThreads);
+    static void stop();   // 작업 스레드 종료 + PBO 정리 (남은 작업은 버림)
+    static bool isRunning() { return running; }
+
+    // 자리 표시 텍스처 생성 + 디코딩 예약 (array = GL_TEXTURE_2D_ARRAY)
+    // 반환값: GpuRegistry 슬롯 (소유권은 호출한 쪽, 보통 TextureCache)
+    static int load(const std::vector<std::string>& paths, bool array,
+        unsigned int placeholderRGBA, TextureSampler sampler);
+
+    // 슬롯이 삭제되기 전에 호출: 아직 올리지 않았으면 업로드하지 않음
+    static void cancel(int slot);
+
+    // 디코딩이 끝난 이미지를 budgetMs 안에서 업로드 (하나라도 올렸으면 true)
+    static bool pump(double budgetMs);
+
+    // 남은 텍스처를 모두 올릴 때까지 대기 (헤드리스: 재현 가능한 프레임)
+    static void finish();
+
+    static int pendingCount() { return pending; }
+    static void report(std::ostream& os);
+
+private:
+    static const int PBO_COUNT = 2;     // 번갈아 쓰는 업로드 PBO
+
+    struct Job
+    {
+        int slot;                       // GpuRegistry 슬롯 (크기 갱신용, -1 = 취소됨)
+        bool array;
+        std::vector<std::string> paths;
+    };
+
+    struct Decoded
+    {
+        int job;
+        bool ok;
+        TextureImage image;
+    };
+
+    static std::vector<Job> jobs;       // GL 스레드에서만 추가 (추가 / 작업 스레드 읽기는 mutex)
+    static std::deque<int> queue;       // 디코딩 대기 (mutex)
+    static std::deque<Decoded> ready;   // 업로드 대기 (mutex)
+    static std::vector<std::thread> workers;
+    static std::mutex mutex;
+    static std::condition_variable cond;      // 작업 스레드 깨우기
+    static std::condition_variable readyCond; // finish() 깨우기
+    static bool quit;
+    static bool running;
+    static int pending;                 // 아직 올리지 못한 텍스처 수
+
+    static GpuBuffer pbos[PBO_COUNT];
+    static int nextPbo;
+
+    // 통계
+    static int uploaded, failed, cancelled, cookedUploads;
+    static size_t uploadedBytes;
+    static double uploadMs, maxPumpMs;
+
+    static void workerLoop();
+    static void upload(const Job& job, TextureImage& image);
+};
+
+#endif
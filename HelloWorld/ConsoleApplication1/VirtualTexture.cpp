@@ -0,0 +1,676 @@
+﻿#ifdef _WIN32
+#define _CRT_SECURE_NO_WARNINGS // fopen 경고 억제
+#endif
+
+#include "VirtualTexture.h"
+#include "Shader.h"
+
+#include <GL/glew.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+
+// 키: 텍스처(8비트) | 레벨(8비트) | x(16비트) | y(16비트)
+static uint64_t vtKey(int texture, int level, int x, int y)
+{
+    return ((uint64_t)texture << 40) | ((uint64_t)level << 32) | ((uint64_t)x << 16) | (uint64_t)y;
+}
+
+static int keyTexture(uint64_t key) { return (int)((key >> 40) & 0xFF); }
+static int keyLevel(uint64_t key) { return (int)((key >> 32) & 0xFF); }
+static int keyX(uint64_t key) { return (int)((key >> 16) & 0xFFFF); }
+static int keyY(uint64_t key) { return (int)(key & 0xFFFF); }
+
+// 페이지 테이블 항목 (RGBA8 메모리 순서: 슬롯 x, 슬롯 y, 레벨, 255)
+static uint32_t packEntry(int slot, int level)
+{
+    int sx = slot % VirtualTextureSystem::CACHE_SIDE;
+    int sy = slot / VirtualTextureSystem::CACHE_SIDE;
+    return (uint32_t)sx | ((uint32_t)sy << 8) | ((uint32_t)level << 16) | 0xFF000000u;
+}
+
+// =====================================================
+// VirtualTileLoader
+// =====================================================
+VirtualTileLoader::VirtualTileLoader()
+    : inFlight(0), quit(false), tilesRead(0)
+{
+}
+
+VirtualTileLoader::~VirtualTileLoader()
+{
+    stop();
+}
+
+void VirtualTileLoader::start(int threadCount)
+{
+    quit = false;
+    for (int i = 0; i < threadCount; i++)
+        workers.emplace_back(&VirtualTileLoader::workerLoop, this);
+}
+
+void VirtualTileLoader::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        quit = true;
+        queue.clear();
+    }
+    cond.notify_all();
+    idleCond.notify_all();
+    for (auto& t : workers)
+        t.join();
+    workers.clear();
+}
+
+int VirtualTileLoader::addSource(const Source& src)
+{
+    sources.push_back(src);
+    return (int)sources.size() - 1;
+}
+
+void VirtualTileLoader::setWanted(const std::vector<uint64_t>& keys)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        queue.clear();
+        for (uint64_t k : keys)
+            if (!busy.count(k))
+                queue.push_back(k);
+    }
+    cond.notify_all();
+}
+
+void VirtualTileLoader::poll(std::vector<Tile>& out, int maxTiles)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    int n = std::min(maxTiles, (int)done.size());
+    for (int i = 0; i < n; i++)
+    {
+        busy.erase(done[i].key);
+        out.push_back(std::move(done[i]));
+    }
+    done.erase(done.begin(), done.begin() + n);
+}
+
+void VirtualTileLoader::waitIdle()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    idleCond.wait(lock, [this] { return quit || workers.empty() || (queue.empty() && inFlight == 0); });
+}
+
+bool VirtualTileLoader::isBusy()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return !queue.empty() || inFlight > 0 || !done.empty();
+}
+
+bool VirtualTileLoader::readTile(FILE* fp, const Source& src, uint64_t key, Tile& out)
+{
+    int level = keyLevel(key), x = keyX(key), y = keyY(key);
+    if (level >= (int)src.levels.size()) return false;
+
+    const vtex::LevelEntry& le = src.levels[level];
+    if (x >= (int)le.pagesX || y >= (int)le.pagesY) return false;
+
+    uint64_t index = (uint64_t)le.firstTile + (uint64_t)y * le.pagesX + (uint64_t)x;
+    uint64_t offset = src.dataOffset + index * vtex::TILE_BYTES;
+
+    out.key = key;
+    out.data.resize(vtex::TILE_BYTES);
+    // 32k 텍스처도 1 GiB 미만이라 long 오프셋으로 충분
+    if (fseek(fp, (long)offset, SEEK_SET) != 0) return false;
+    return fread(out.data.data(), 1, vtex::TILE_BYTES, fp) == vtex::TILE_BYTES;
+}
+
+void VirtualTileLoader::workerLoop()
+{
+    // 스레드마다 파일 핸들을 따로 열어서 seek + read 가 서로 막지 않게 함
+    std::vector<FILE*> files(sources.size(), nullptr);
+
+    for (;;)
+    {
+        uint64_t key;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            cond.wait(lock, [this] { return quit || !queue.empty(); });
+            if (quit) break;
+
+            key = queue.front();
+            queue.pop_front();
+            busy.insert(key);
+            inFlight++;
+        }
+
+        int index = keyTexture(key);
+        Tile tile;
+        bool ok = false;
+        if (index < (int)sources.size())
+        {
+            if (!files[index])
+                files[index] = fopen(sources[index].path.c_str(), "rb");
+            ok = files[index] && readTile(files[index], sources[index], key, tile);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            inFlight--;
+            if (ok)
+            {
+                tilesRead++;
+                done.push_back(std::move(tile));
+            }
+            else
+            {
+                busy.erase(key);
+            }
+        }
+        idleCond.notify_all();
+    }
+
+    for (FILE* fp : files)
+        if (fp) fclose(fp);
+}
+
+// =====================================================
+// VirtualTextureSystem
+// =====================================================
+VirtualTextureSystem::VirtualTextureSystem()
+    : feedbackShader(nullptr), enabled(false), synchronous(false), streaming(false), frame(0),
+    feedbackW(0), feedbackH(0), nextReadback(0),
+    tilesUploaded(0), tilesEvicted(0), peakResident(0), feedbackReads(0)
+{
+}
+
+VirtualTextureSystem::~VirtualTextureSystem()
+{
+}
+
+bool VirtualTextureSystem::init(bool sync)
+{
+    synchronous = sync;
+    if (!GLEW_EXT_texture_compression_s3tc)
+    {
+        std::cout << "[VirtualTexture] S3TC not supported, using regular textures\n";
+        return false;
+    }
+
+    // 고정 크기 BC1 캐시 (밉맵 없음: 레벨 선택은 페이지 테이블이 함)
+    const int side = CACHE_SIDE * vtex::TILE;
+    const size_t bytes = (size_t)(side / 4) * (side / 4) * 8;
+    cache = GpuTexture("virtual texture cache");
+    glBindTexture(GL_TEXTURE_2D, cache.get());
+    glCompressedTexImage2D(GL_TEXTURE_2D, 0, GL_COMPRESSED_RGB_S3TC_DXT1_EXT, side, side, 0,
+        (GLsizei)bytes, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    cache.setBytes(bytes);
+
+    slots.assign(CACHE_SIDE * CACHE_SIDE, Slot());
+    enabled = true;
+    return true;
+}
+
+void VirtualTextureSystem::start(int workerThreads)
+{
+    if (enabled && !textures.empty())
+        loader.start(workerThreads);
+}
+
+void VirtualTextureSystem::shutdown()
+{
+    loader.stop();
+    for (auto& rb : readbacks)
+    {
+        if (rb.fence)
+        {
+            glDeleteSync((GLsync)rb.fence);
+            rb.fence = nullptr;
+        }
+        rb.pbo.reset();
+    }
+}
+
+bool VirtualTextureSystem::add(const Planet* owner, const std::string& path)
+{
+    if (!enabled || textures.size() >= 255) return false;
+
+    FILE* fp = fopen(path.c_str(), "rb");
+    if (!fp) return false; // 가상 텍스처는 선택 사항 (없으면 기존 텍스처)
+
+    vtex::FileHeader header;
+    std::vector<vtex::LevelEntry> levels;
+    bool ok = fread(&header, sizeof(header), 1, fp) == 1 &&
+        header.magic == vtex::MAGIC && header.version == vtex::VERSION &&
+        header.levels >= 1 && header.levels <= (uint32_t)vtex::MAX_LEVELS;
+    if (ok)
+    {
+        levels.resize(header.levels);
+        ok = fread(levels.data(), sizeof(vtex::LevelEntry), levels.size(), fp) == levels.size();
+    }
+    // 페이지 수는 레벨마다 절반 (올림), 가장 거친 레벨은 페이지 하나 → GL 밉 체인과 같은 모양
+    for (size_t l = 0; ok && l < levels.size(); l++)
+    {
+        uint32_t px = (header.width >> l) ? ((header.width >> l) + vtex::PAGE - 1) / vtex::PAGE : 1;
+        uint32_t py = (header.height >> l) ? ((header.height >> l) + vtex::PAGE - 1) / vtex::PAGE : 1;
+        ok = levels[l].pagesX == px && levels[l].pagesY == py && px <= (uint32_t)vtex::MAX_PAGES &&
+            py <= (uint32_t)vtex::MAX_PAGES && levels[l].firstTile + px * py <= header.tileCount;
+    }
+    ok = ok && levels.back().pagesX == 1 && levels.back().pagesY == 1;
+
+    int index = (int)textures.size();
+    VirtualTileLoader::Source src;
+    src.path = path;
+    src.dataOffset = header.dataOffset;
+    src.levels = levels;
+
+    // 가장 거친 레벨 (페이지 하나) 은 바로 읽어서 고정
+    VirtualTileLoader::Tile top;
+    ok = ok && VirtualTileLoader::readTile(fp, src, vtKey(index, (int)header.levels - 1, 0, 0), top);
+    fclose(fp);
+    if (!ok)
+    {
+        std::cerr << "[VirtualTexture] Invalid tile file: " << path << "\n";
+        return false;
+    }
+
+    loader.addSource(src);
+
+    Texture t;
+    t.owner = owner;
+    t.header = header;
+    t.levels = levels;
+    t.dirty = true;
+    t.pageTable = GpuTexture("virtual page table " + path);
+    glBindTexture(GL_TEXTURE_2D, t.pageTable.get());
+    size_t bytes = 0;
+    for (size_t l = 0; l < levels.size(); l++)
+    {
+        glTexImage2D(GL_TEXTURE_2D, (GLint)l, GL_RGBA8, levels[l].pagesX, levels[l].pagesY, 0,
+            GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        t.entries.emplace_back((size_t)levels[l].pagesX * levels[l].pagesY, 0u);
+        bytes += t.entries.back().size() * 4;
+    }
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, (GLint)levels.size() - 1);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST_MIPMAP_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    t.pageTable.setBytes(bytes);
+    textures.push_back(std::move(t));
+
+    upload(top, true);
+    rebuildPageTable(index);
+
+    std::cout << "[VirtualTexture] " << path << ": " << header.width << "x" << header.height
+        << ", " << header.levels << " levels, " << header.tileCount << " tiles\n";
+    return true;
+}
+
+void VirtualTextureSystem::beginFrame()
+{
+    if (!enabled || textures.empty()) return;
+
+    frame++;
+    draws.clear();
+
+    // 1) 끝난 피드백 리드백 회수 (오래된 것부터, 기다리지 않음)
+    bool fresh = false;
+    for (int i = 0; i < READBACK_RING; i++)
+    {
+        Readback& rb = readbacks[(nextReadback + i) % READBACK_RING];
+        if (!rb.fence) continue;
+        if (!collectFeedback(rb, synchronous)) break;
+        fresh = true;
+    }
+    if (fresh)
+        processFeedback(feedbackW, feedbackH);
+
+    // 2) 도착한 타일 업로드 (헤드리스는 요청한 타일을 모두 읽을 때까지 기다림)
+    if (synchronous)
+        loader.waitIdle();
+
+    arrived.clear();
+    loader.poll(arrived, synchronous ? (int)slots.size() : UPLOADS_PER_FRAME);
+    if (synchronous)
+    {
+        // 도착 순서와 관계없이 같은 슬롯 배치 (재현 가능한 프레임)
+        std::sort(arrived.begin(), arrived.end(),
+            [](const VirtualTileLoader::Tile& a, const VirtualTileLoader::Tile& b) { return a.key < b.key; });
+    }
+    for (const auto& tile : arrived)
+        upload(tile, false);
+
+    // 3) 바뀐 텍스처만 페이지 테이블 다시 만들기
+    for (int i = 0; i < (int)textures.size(); i++)
+        if (textures[i].dirty)
+            rebuildPageTable(i);
+
+    bool pendingReadback = false;
+    for (const auto& rb : readbacks)
+        pendingReadback = pendingReadback || rb.fence != nullptr;
+    streaming = pendingReadback || loader.isBusy();
+}
+
+bool VirtualTextureSystem::bind(Shader& shader, const Planet* planet, const glm::mat4& model)
+{
+    if (!enabled) return false;
+
+    for (int i = 0; i < (int)textures.size(); i++)
+    {
+        const Texture& t = textures[i];
+        if (t.owner != planet) continue;
+
+        glActiveTexture(GL_TEXTURE0 + PAGE_TABLE_UNIT);
+        glBindTexture(GL_TEXTURE_2D, t.pageTable.get());
+        glActiveTexture(GL_TEXTURE0 + CACHE_UNIT);
+        glBindTexture(GL_TEXTURE_2D, cache.get());
+        glActiveTexture(GL_TEXTURE0);
+
+        shader.setInt("vtEnabled", 1);
+        shader.setInt("vtPageTable", PAGE_TABLE_UNIT);
+        shader.setInt("vtCache", CACHE_UNIT);
+        shader.setVec4("vtInfo", glm::vec4((float)t.header.width, (float)t.header.height,
+            (float)(t.header.levels - 1), (float)CACHE_SIDE));
+
+        draws.push_back({ i, model });
+        return true;
+    }
+    return false;
+}
+
+void VirtualTextureSystem::unbind(Shader& shader)
+{
+    shader.setInt("vtEnabled", 0);
+}
+
+void VirtualTextureSystem::ensureFeedbackTarget(int width, int height)
+{
+    if (feedbackFBO.valid() && width == feedbackW && height == feedbackH)
+        return;
+
+    feedbackW = width;
+    feedbackH = height;
+
+    feedbackFBO = GpuFramebuffer("virtual texture feedback FBO");
+    glBindFramebuffer(GL_FRAMEBUFFER, feedbackFBO.get());
+
+    feedbackColor = GpuRenderTexture("virtual texture feedback");
+    glBindTexture(GL_TEXTURE_2D, feedbackColor.get());
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    feedbackColor.setBytes(GpuRegistry::imageBytes(width, height, 1, 4, false));
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+        GL_TEXTURE_2D, feedbackColor.get(), 0);
+
+    feedbackDepth = GpuRenderbuffer("virtual texture feedback depth");
+    glBindRenderbuffer(GL_RENDERBUFFER, feedbackDepth.get());
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height);
+    feedbackDepth.setBytes(GpuRegistry::imageBytes(width, height, 1, 4, false));
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT,
+        GL_RENDERBUFFER, feedbackDepth.get());
+
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+        std::cerr << "Virtual texture feedback framebuffer not complete!\n";
+
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    // 크기가 바뀌면 진행 중인 리드백은 버림
+    for (auto& rb : readbacks)
+    {
+        if (rb.fence)
+        {
+            glDeleteSync((GLsync)rb.fence);
+            rb.fence = nullptr;
+        }
+    }
+}
+
+void VirtualTextureSystem::renderFeedback(const glm::mat4& view, const glm::mat4& proj,
+    unsigned int sphereVAO, unsigned int sphereIndexCount, int sceneW, int sceneH)
+{
+    if (!enabled || draws.empty() || !feedbackShader) return;
+
+    int width = std::max(1, sceneW / FEEDBACK_DIVISOR);
+    int height = std::max(1, sceneH / FEEDBACK_DIVISOR);
+    ensureFeedbackTarget(width, height);
+
+    // 링이 가득 차 있으면 가장 오래된 리드백을 기다려서 비움 (보통은 이미 끝난 상태)
+    Readback& rb = readbacks[nextReadback];
+    if (rb.fence && collectFeedback(rb, true))
+        processFeedback(feedbackW, feedbackH);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, feedbackFBO.get());
+    glViewport(0, 0, width, height);
+    glClearColor(0, 0, 0, 0);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    glEnable(GL_DEPTH_TEST);
+    GLboolean blend = glIsEnabled(GL_BLEND); // 번호를 그대로 써야 하므로 섞지 않음
+    glDisable(GL_BLEND);
+
+    feedbackShader->use();
+    feedbackShader->setMat4("view", view);
+    feedbackShader->setMat4("proj", proj);
+    // 피드백은 저해상도라 미분이 크게 나옴 → 장면 해상도 기준 레벨로 보정
+    feedbackShader->setFloat("vtLodBias", std::log2((float)sceneW / (float)width));
+
+    glBindVertexArray(sphereVAO);
+    for (const Draw& d : draws)
+    {
+        const Texture& t = textures[d.texture];
+        feedbackShader->setMat4("model", d.model);
+        feedbackShader->setVec4("vtInfo", glm::vec4((float)t.header.width, (float)t.header.height,
+            (float)(t.header.levels - 1), (float)CACHE_SIDE));
+        feedbackShader->setFloat("vtIndex", (float)d.texture);
+        glDrawElements(GL_TRIANGLES, sphereIndexCount, GL_UNSIGNED_INT, 0);
+    }
+    glBindVertexArray(0);
+    if (blend) glEnable(GL_BLEND);
+
+    // 비동기 리드백 (데이터는 PBO 로 복사되고 glReadPixels 는 바로 반환)
+    size_t bytes = (size_t)width * height * 4;
+    if (!rb.pbo.valid())
+        rb.pbo = GpuBuffer("virtual texture feedback PBO");
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, rb.pbo.get());
+    if (rb.width != width || rb.height != height)
+    {
+        glBufferData(GL_PIXEL_PACK_BUFFER, bytes, nullptr, GL_STREAM_READ);
+        rb.pbo.setBytes(bytes);
+        rb.width = width;
+        rb.height = height;
+    }
+    glReadBuffer(GL_COLOR_ATTACHMENT0);
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    rb.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    nextReadback = (nextReadback + 1) % READBACK_RING;
+}
+
+bool VirtualTextureSystem::collectFeedback(Readback& rb, bool wait)
+{
+    GLsync fence = (GLsync)rb.fence;
+    GLenum r = glClientWaitSync(fence, wait ? GL_SYNC_FLUSH_COMMANDS_BIT : 0,
+        wait ? 1000000000ull : 0);
+    if (r != GL_ALREADY_SIGNALED && r != GL_CONDITION_SATISFIED)
+        return false;
+
+    glDeleteSync(fence);
+    rb.fence = nullptr;
+
+    size_t bytes = (size_t)rb.width * rb.height * 4;
+    feedbackPixels.resize(bytes);
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, rb.pbo.get());
+    const void* src = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, bytes, GL_MAP_READ_BIT);
+    if (src)
+    {
+        memcpy(feedbackPixels.data(), src, bytes);
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    feedbackReads++;
+    return src != nullptr;
+}
+
+void VirtualTextureSystem::processFeedback(int width, int height)
+{
+    // 픽셀마다 (페이지 x, y / 레벨 / 텍스처 번호 + 1), 0 = 가상 텍스처 없음
+    seen.clear();
+    size_t count = std::min((size_t)width * height, feedbackPixels.size() / 4);
+    for (size_t i = 0; i < count; i++)
+    {
+        const unsigned char* p = feedbackPixels.data() + i * 4;
+        if (p[3] == 0 || p[3] > textures.size()) continue;
+
+        int index = p[3] - 1;
+        const Texture& t = textures[index];
+        int level = std::min((int)p[2], (int)t.header.levels - 1);
+        int x = std::min((int)p[0], (int)t.levels[level].pagesX - 1);
+        int y = std::min((int)p[1], (int)t.levels[level].pagesY - 1);
+        seen.insert(vtKey(index, level, x, y));
+    }
+
+    // 상위 레벨 페이지도 함께 (없는 동안 대신 보이는 페이지 → 거친 것부터 채움)
+    wanted.assign(seen.begin(), seen.end());
+    for (uint64_t key : wanted)
+    {
+        int index = keyTexture(key), level = keyLevel(key), x = keyX(key), y = keyY(key);
+        int top = (int)textures[index].header.levels - 1;
+        while (level < top)
+        {
+            level++;
+            x /= 2;
+            y /= 2;
+            if (!seen.insert(vtKey(index, level, x, y)).second)
+                break; // 이미 넣은 조상 (그 위도 들어 있음)
+        }
+    }
+
+    wanted.clear();
+    for (uint64_t key : seen)
+    {
+        auto it = resident.find(key);
+        if (it != resident.end())
+            slots[it->second].lastUsed = frame;
+        else
+            wanted.push_back(key);
+    }
+
+    // 거친 레벨 먼저, 같은 레벨은 키 순서 (재현 가능)
+    std::sort(wanted.begin(), wanted.end(), [](uint64_t a, uint64_t b) {
+        int la = keyLevel(a), lb = keyLevel(b);
+        return la != lb ? la > lb : a < b;
+    });
+    size_t limit = synchronous ? slots.size() : (size_t)MAX_WANTED;
+    if (wanted.size() > limit)
+        wanted.resize(limit);
+    loader.setWanted(wanted);
+}
+
+int VirtualTextureSystem::acquireSlot()
+{
+    int best = -1;
+    for (int i = 0; i < (int)slots.size(); i++)
+    {
+        const Slot& s = slots[i];
+        if (!s.used) return i;
+        // 이번 프레임 피드백에 나온 타일 / 가장 거친 레벨은 교체하지 않음
+        if (!s.pinned && s.lastUsed < frame &&
+            (best < 0 || s.lastUsed < slots[best].lastUsed))
+            best = i;
+    }
+    if (best >= 0)
+    {
+        uint64_t old = slots[best].key;
+        resident.erase(old);
+        textures[keyTexture(old)].dirty = true;
+        slots[best].used = false;
+        tilesEvicted++;
+    }
+    return best;
+}
+
+void VirtualTextureSystem::upload(const VirtualTileLoader::Tile& tile, bool pinned)
+{
+    if (resident.count(tile.key)) return;
+
+    int slot = acquireSlot();
+    if (slot < 0) return; // 캐시가 이번 프레임 타일로 가득 참 → 버림 (필요하면 다시 요청됨)
+
+    glBindTexture(GL_TEXTURE_2D, cache.get());
+    glCompressedTexSubImage2D(GL_TEXTURE_2D, 0,
+        (slot % CACHE_SIDE) * vtex::TILE, (slot / CACHE_SIDE) * vtex::TILE,
+        vtex::TILE, vtex::TILE, GL_COMPRESSED_RGB_S3TC_DXT1_EXT,
+        (GLsizei)vtex::TILE_BYTES, tile.data.data());
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    Slot& s = slots[slot];
+    s.key = tile.key;
+    s.lastUsed = frame;
+    s.used = true;
+    s.pinned = pinned;
+    resident[tile.key] = slot;
+    textures[keyTexture(tile.key)].dirty = true;
+
+    tilesUploaded++;
+    peakResident = std::max(peakResident, (int)resident.size());
+}
+
+void VirtualTextureSystem::rebuildPageTable(int index)
+{
+    Texture& t = textures[index];
+    int top = (int)t.levels.size() - 1;
+
+    // 거친 레벨부터: 없는 페이지는 바로 위 레벨 항목을 그대로 물려받음
+    glBindTexture(GL_TEXTURE_2D, t.pageTable.get());
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    for (int level = top; level >= 0; level--)
+    {
+        const vtex::LevelEntry& le = t.levels[level];
+        std::vector<uint32_t>& e = t.entries[level];
+        for (int y = 0; y < (int)le.pagesY; y++)
+        {
+            for (int x = 0; x < (int)le.pagesX; x++)
+            {
+                auto it = resident.find(vtKey(index, level, x, y));
+                if (it != resident.end())
+                    e[y * le.pagesX + x] = packEntry(it->second, level);
+                else if (level < top)
+                    e[y * le.pagesX + x] = t.entries[level + 1][(y / 2) * t.levels[level + 1].pagesX + x / 2];
+            }
+        }
+        glTexSubImage2D(GL_TEXTURE_2D, level, 0, 0, le.pagesX, le.pagesY,
+            GL_RGBA, GL_UNSIGNED_BYTE, e.data());
+    }
+    glBindTexture(GL_TEXTURE_2D, 0);
+    t.dirty = false;
+}
+
+void VirtualTextureSystem::report(std::ostream& os) const
+{
+    if (textures.empty()) return;
+
+    size_t cacheBytes = (size_t)(CACHE_SIDE * vtex::TILE / 4) * (CACHE_SIDE * vtex::TILE / 4) * 8;
+    std::ios::fmtflags flags = os.flags();
+    std::streamsize precision = os.precision();
+
+    os << std::fixed << std::setprecision(1);
+    os << "[VirtualTexture] " << textures.size() << " textures, cache " << slots.size()
+        << " tiles (" << cacheBytes / (1024.0 * 1024.0) << " MiB), " << loader.getTilesRead()
+        << " read, " << tilesUploaded << " uploaded, " << tilesEvicted << " evicted, peak "
+        << peakResident << "/" << slots.size() << " resident, " << feedbackReads << " feedback readbacks\n";
+
+    os.flags(flags);
+    os.precision(precision);
+}
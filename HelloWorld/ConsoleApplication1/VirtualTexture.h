@@ -0,0 +1,248 @@
+﻿#ifndef VIRTUAL_TEXTURE_H
+#define VIRTUAL_TEXTURE_H
+
+#include <vector>
+#include <deque>
+#include <string>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <unordered_map>
+#include <unordered_set>
+#include <cstdint>
+#include <cstdio>
+#include <ostream>
+#include <glm/glm.hpp>
+
+#include "GpuResource.h"
+#include "VirtualTextureFormat.h"
+
+class Shader;
+class Planet;
+
+// -----------------------------------------------------
+// 가상 텍스처 샘플링 GLSL 조각 (sceneFrag 공용 + 피드백 셰이더)
+//  - 페이지 테이블: 레벨마다 페이지 하나당 텍셀 하나 (RGBA8 = 캐시 슬롯 x, y / 실제 레벨 / 1)
+//    아직 없는 페이지는 CPU 가 가장 가까운 상위 레벨 페이지로 채워 둠 → 항상 무언가 보임
+//  - vtInfo: 레벨 0 크기 (텍셀) / 가장 거친 레벨 / 캐시 한 변 슬롯 수
+//  - 128 / 4 / 136 은 vtex::PAGE / BORDER / TILE 과 같은 값
+//  - 밉 사이는 두 레벨을 직접 샘플링해서 섞음 (캐시 텍스처 자체는 밉맵 없음)
+// -----------------------------------------------------
+#define VIRTUAL_TEXTURE_GLSL \
+    "uniform int vtEnabled;\n" \
+    "uniform sampler2D vtPageTable;\n" \
+    "uniform sampler2D vtCache;\n" \
+    "uniform vec4 vtInfo;\n" \
+    "vec2 vtWrap(vec2 uv){ return vec2(fract(uv.x), clamp(uv.y, 0.0, 0.99999)); }\n" \
+    "float vtLod(vec2 dx, vec2 dy){\n" \
+    "  vec2 tx = dx * vtInfo.xy, ty = dy * vtInfo.xy;\n" \
+    "  return clamp(0.5 * log2(max(dot(tx, tx), dot(ty, ty))), 0.0, vtInfo.z);\n" \
+    "}\n" \
+    "vec3 vtSampleLevel(vec2 uv, float level){\n" \
+    "  vec3 e = floor(textureLod(vtPageTable, uv, level).xyz * 255.0 + 0.5);\n" \
+    "  vec2 inPage = fract(uv * vtInfo.xy / (128.0 * exp2(e.z)));\n" \
+    "  vec2 st = (e.xy * 136.0 + 4.0 + inPage * 128.0) / (136.0 * vtInfo.w);\n" \
+    "  return textureLod(vtCache, st, 0.0).rgb;\n" \
+    "}\n" \
+    "vec3 virtualTextureGrad(vec2 uv, vec2 dx, vec2 dy){\n" \
+    "  uv = vtWrap(uv);\n" \
+    "  float lod = vtLod(dx, dy);\n" \
+    "  float l0 = floor(lod);\n" \
+    "  vec3 c = vtSampleLevel(uv, l0);\n" \
+    "  if(l0 >= vtInfo.z) return c;\n" \
+    "  return mix(c, vtSampleLevel(uv, l0 + 1.0), lod - l0);\n" \
+    "}\n"
+
+// =====================================================
+// VirtualTileLoader
+//  - 작업 스레드가 .vtex 에서 BC1 타일을 읽음 (스레드마다 파일 핸들 따로)
+//  - 메인 스레드는 피드백을 읽을 때마다 원하는 타일 목록(우선순위 순)으로 대기열을 통째로 바꿈
+//  - 완성 타일은 poll()로 정해진 개수만 가져감 (업로드 예산은 호출 측)
+// =====================================================
+class VirtualTileLoader
+{
+public:
+    struct Tile
+    {
+        uint64_t key = 0;
+        std::vector<unsigned char> data;   // vtex::TILE_BYTES
+    };
+
+    struct Source
+    {
+        std::string path;
+        uint64_t dataOffset = 0;
+        std::vector<vtex::LevelEntry> levels;
+    };
+
+    VirtualTileLoader();
+    ~VirtualTileLoader();
+
+    void start(int threadCount);
+    void stop();
+
+    // 파일 등록 (start 전에만) → 텍스처 번호
+    int addSource(const Source& src);
+    const Source& getSource(int index) const { return sources[index]; }
+
+    // 원하는 타일 (앞쪽이 먼저) — 이미 읽는 중이거나 완성된 키는 건너뜀
+    void setWanted(const std::vector<uint64_t>& keys);
+
+    // 완성 타일을 최대 maxTiles 개 꺼냄
+    void poll(std::vector<Tile>& out, int maxTiles);
+
+    // 대기열 + 읽는 중인 타일이 모두 끝날 때까지 대기 (헤드리스: 재현 가능한 프레임)
+    void waitIdle();
+
+    bool isBusy();
+    int getTilesRead() const { return tilesRead.load(); }
+
+    // 타일 하나 읽기 (GL 없음, 메인 스레드에서 바로 부를 수도 있음)
+    static bool readTile(FILE* fp, const Source& src, uint64_t key, Tile& out);
+
+private:
+    std::vector<Source> sources;
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable cond;
+    std::condition_variable idleCond;
+    std::deque<uint64_t> queue;            // 아직 시작하지 않은 요청
+    std::unordered_set<uint64_t> busy;     // 읽는 중 + 완성 후 미수거
+    std::vector<Tile> done;
+    int inFlight;
+    bool quit;
+
+    std::atomic<int> tilesRead;
+
+    void workerLoop();
+};
+
+// =====================================================
+// VirtualTextureSystem
+//  - 8k~16k 행성 텍스처를 통째로 올리지 않고 보이는 타일만 고정 크기 캐시에 둠
+//    1) 장면 패스: 가상 텍스처 행성은 diffuseMap 대신 페이지 테이블 → 캐시로 샘플링
+//    2) 피드백 패스: 같은 행성을 1/FEEDBACK_DIVISOR 해상도로 다시 그려
+//       픽셀마다 (페이지 x, y / 레벨 / 텍스처 번호) 기록 → PBO 로 비동기 리드백
+//    3) 다음 프레임들: 리드백이 끝나면 필요한 타일(+ 상위 레벨)을 작업 스레드에 요청
+//       도착한 타일은 프레임마다 UPLOADS_PER_FRAME 개까지 캐시에 올리고 오래 안 쓴 것부터 교체
+//       바뀐 텍스처만 페이지 테이블을 다시 만듦
+//  - 가장 거친 레벨 타일(페이지 하나)은 등록할 때 바로 올리고 교체하지 않음
+//  - 헤드리스(synchronous): 리드백과 타일 읽기를 기다려서 프레임이 재현 가능
+//  - S3TC 를 지원하지 않으면 꺼짐 (기존 텍스처로 그림)
+// =====================================================
+class VirtualTextureSystem
+{
+public:
+    static const int CACHE_SIDE = 32;            // 캐시 한 변 슬롯 수 (32 x 32 = 1024 타일)
+    static const int FEEDBACK_DIVISOR = 8;       // 피드백 버퍼 = 장면 해상도 / 8
+    static const int READBACK_RING = 3;          // 피드백 리드백 PBO 개수
+    static const int UPLOADS_PER_FRAME = 32;     // 프레임당 업로드 타일 수
+    static const int MAX_WANTED = 96;            // 대기열에 넣는 요청 수
+    static const int PAGE_TABLE_UNIT = 7;        // 텍스처 유닛 (0~6 은 장면 셰이더가 사용)
+    static const int CACHE_UNIT = 8;
+
+    VirtualTextureSystem();
+    ~VirtualTextureSystem();
+
+    // 캐시 생성 (컨텍스트 생성 후) — S3TC 가 없으면 false
+    bool init(bool synchronous);
+    void start(int workerThreads);               // 등록이 끝난 뒤 작업 스레드 시작
+    void shutdown();                             // 작업 스레드 + PBO 정리 (컨텍스트 살아 있을 때)
+    void setFeedbackShader(Shader* shaderPtr) { feedbackShader = shaderPtr; }
+
+    // 행성에 .vtex 등록 (파일이 없거나 잘못됐으면 false)
+    bool add(const Planet* owner, const std::string& path);
+    int getTextureCount() const { return (int)textures.size(); }
+
+    // 장면 프레임마다 (행성 루프 전): 피드백 회수 → 요청 → 타일 업로드 → 페이지 테이블 갱신
+    void beginFrame();
+
+    // 이 행성에 가상 텍스처가 있으면 셰이더에 바인딩하고 피드백 목록에 추가
+    bool bind(Shader& shader, const Planet* planet, const glm::mat4& model);
+    void unbind(Shader& shader);
+
+    // 이번 프레임에 가상 텍스처로 그린 행성을 피드백 버퍼에 다시 그리고 리드백 시작
+    //  (호출 후 프레임버퍼 / 뷰포트는 호출 측에서 다시 설정)
+    void renderFeedback(const glm::mat4& view, const glm::mat4& proj,
+        unsigned int sphereVAO, unsigned int sphereIndexCount, int sceneW, int sceneH);
+
+    // 타일을 기다리거나 받는 중인지 (렌더 온 디맨드에서도 계속 그려야 함)
+    bool isStreaming() const { return streaming; }
+
+    void report(std::ostream& os) const;
+
+private:
+    struct Texture
+    {
+        const Planet* owner;
+        vtex::FileHeader header;
+        std::vector<vtex::LevelEntry> levels;
+        GpuTexture pageTable;
+        std::vector<std::vector<uint32_t>> entries;   // 레벨별 페이지 항목 (RGBA8)
+        bool dirty;
+    };
+
+    struct Slot
+    {
+        uint64_t key = 0;
+        int lastUsed = -1;       // 마지막으로 피드백에 나온 프레임
+        bool used = false;
+        bool pinned = false;     // 가장 거친 레벨 (교체하지 않음)
+    };
+
+    struct Draw
+    {
+        int texture;
+        glm::mat4 model;
+    };
+
+    struct Readback
+    {
+        GpuBuffer pbo;
+        void* fence = nullptr;   // GLsync
+        int width = 0, height = 0;
+    };
+
+    Shader* feedbackShader;
+    VirtualTileLoader loader;
+    bool enabled;
+    bool synchronous;
+    bool streaming;
+    int frame;
+
+    std::vector<Texture> textures;
+    std::vector<Draw> draws;
+
+    // 타일 캐시
+    GpuTexture cache;
+    std::vector<Slot> slots;
+    std::unordered_map<uint64_t, int> resident;  // 키 → 슬롯
+    std::vector<VirtualTileLoader::Tile> arrived;
+
+    // 피드백
+    GpuFramebuffer feedbackFBO;
+    GpuRenderTexture feedbackColor;
+    GpuRenderbuffer feedbackDepth;
+    int feedbackW, feedbackH;
+    Readback readbacks[READBACK_RING];
+    int nextReadback;
+    std::vector<unsigned char> feedbackPixels;
+    std::unordered_set<uint64_t> seen;
+    std::vector<uint64_t> wanted;
+
+    // 통계
+    int tilesUploaded;
+    int tilesEvicted;
+    int peakResident;
+    int feedbackReads;
+
+    void ensureFeedbackTarget(int width, int height);
+    bool collectFeedback(Readback& rb, bool wait);
+    void processFeedback(int width, int height);
+    int acquireSlot();
+    void upload(const VirtualTileLoader::Tile& tile, bool pinned);
+    void rebuildPageTable(int index);
+};
+
+#endif
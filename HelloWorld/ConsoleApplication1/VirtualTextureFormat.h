@@ -0,0 +1,61 @@
+﻿#ifndef VIRTUAL_TEXTURE_FORMAT_H
+#define VIRTUAL_TEXTURE_FORMAT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// =====================================================
+// 가상 텍스처 타일 파일 (.vtex)
+//  - VirtualTextureCooker 가 8k~16k 원본에서 만듦 (런타임과 도구가 함께 씀)
+//  - 레벨 L 은 원본을 2^L 로 줄인 이미지, PAGE x PAGE 페이지로 나눔
+//    가장 거친 레벨은 페이지 하나에 전부 들어감 (남는 부분은 가장자리 반복)
+//  - 타일 = 페이지 + 사방 BORDER 텍셀 (이웃 페이지 내용, 가로는 경도 방향 반복)
+//    → 캐시에서 페이지 끝을 쌍선형 필터링해도 이음새가 없음
+//  - 타일은 모두 BC1, 같은 크기 → 위치는 계산으로 구함 (색인 표 없음)
+//  - [FileHeader][LevelEntry x levels][레벨 0 타일 (행 우선)][레벨 1 타일]...
+//  - 행은 위 -> 아래 순서 (원본 이미지와 같음), 정수는 little endian
+// =====================================================
+namespace vtex
+{
+    const uint32_t MAGIC = 0x58455456u;   // "VTEX"
+    const uint32_t VERSION = 1;
+    const int PAGE = 128;                 // 페이지 한 변 (텍셀)
+    const int BORDER = 4;                 // 타일 테두리 (BC1 블록 정렬)
+    const int TILE = PAGE + 2 * BORDER;   // 타일 한 변 (텍셀)
+    const int MAX_LEVELS = 9;             // 32k 까지 (페이지 좌표는 셰이더 피드백에서 8 비트)
+    const int MAX_PAGES = 256;            // 레벨 0 의 한 변 페이지 수 상한
+
+    const size_t TILE_BYTES = (size_t)(TILE / 4) * (TILE / 4) * 8; // BC1
+
+    struct FileHeader
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t width;       // 레벨 0 크기 (2 의 거듭제곱)
+        uint32_t height;
+        uint32_t levels;
+        uint32_t tileCount;
+        uint64_t dataOffset;  // 첫 타일 위치
+    };
+
+    struct LevelEntry
+    {
+        uint32_t pagesX;
+        uint32_t pagesY;
+        uint32_t firstTile;   // 이 레벨 첫 타일 번호
+        uint32_t reserved;
+    };
+
+    // 원본 경로의 확장자를 .vtex 로 바꾼 경로
+    inline std::string pathFor(const std::string& sourcePath)
+    {
+        size_t dot = sourcePath.find_last_of('.');
+        size_t slash = sourcePath.find_last_of("/\\");
+        if (dot == std::string::npos || (slash != std::string::npos && dot < slash))
+            return sourcePath + ".vtex";
+        return sourcePath.substr(0, dot) + ".vtex";
+    }
+}
+
+#endif
@@ -19,7 +19,31 @@
 #include "Planet.h"
 #include "Satellite.h"
 #include "Orbit.h"
+#include "BodyStore.h"
+#include "BodyCatalog.h"
 #include "planetRing.h"
+#include "Benchmark.h"
+#include "FrameCapture.h"
+#include "FrameServer.h"
+#include "GpuResource.h"
+#include "EclipseShadows.h"
+#include "Atmosphere.h"
+#include "AutoExposure.h"
+#include "CommandList.h"
+#include "RenderDevice.h"
+#include "RedrawTracker.h"
+#include "FramePacer.h"
+#include "PictureInPicture.h"
+#include "TemporalUpscaler.h"
+#include "SphereImpostors.h"
+#include "AsteroidBelt.h"
+#include "PlanetTerrain.h"
+#include "TextureStreamer.h"
+#include "CookedTexture.h"
+#include "VirtualTexture.h"
+
+#include <thread>
+#include <chrono>
 
 unsigned int SCR_WIDTH = 1280;
 unsigned int SCR_HEIGHT = 720;
@@ -27,6 +51,11 @@ unsigned int SCR_HEIGHT = 720;
 float simSpeedMultiplier = 1.0f;   // 시뮬레이션 배속 (0.5x ~ 10x) ?
 
 Camera* gCamera = nullptr;
+RedrawTracker* gRedraw = nullptr;   // 창 다시 그리기 요청 전달용
+BodyStore* gBodies = nullptr;       // 천체별 월드 위치 / 모델 행렬 (지난 프레임 포함)
+SphereImpostors* gImpostors = nullptr; // 작게 보이는 천체를 모아 두는 임포스터 목록
+PlanetTerrain* gTerrain = nullptr;     // 추적 중인 행성 근접 지형
+VirtualTextureSystem* gVirtualTextures = nullptr; // 8k~16k 행성 텍스처 (보이는 타일만 상주)
 const float SCALE_UNITS = 1.0f;
 
 // 현재 추적 중인 행성의 인덱스: -1 (NONE)
@@ -34,15 +63,7 @@ int trackingIndex = -1;
 // 게임 일시 정지 플래그
 bool isPaused = false;
 
-float gTimeYears = 0.0f; // 시뮬레이션 경과 시간 (년 단위)
-
-// ========================
-// XZ 평면 정렬 행렬 정의
-// ========================
-static glm::mat4 orbitToXZ =
-glm::rotate(glm::mat4(1.0f),
-	glm::radians(-90.0f),
-	glm::vec3(1.0f, 0.0f, 0.0f));
+const float SUN_RENDER_RADIUS = 7.0f; // 태양 렌더링 반지름 (일식 반영 계산에도 사용)
 
 // 콜백 -------------------------------------------------------------
 void framebuffer_size_callback(GLFWwindow* window, int w, int h)
@@ -52,6 +73,13 @@ void framebuffer_size_callback(GLFWwindow* window, int w, int h)
 	glViewport(0, 0, w, h);
 }
 
+// 창이 가려졌다 드러나는 등 내용을 다시 그려야 할 때 (장면은 그대로, 합성만)
+void window_refresh_callback(GLFWwindow*)
+{
+	if (gRedraw)
+		gRedraw->invalidateComposite();
+}
+
 // 키보드 입력 콜백
 void mouse_callback(GLFWwindow* window, double xpos, double ypos)
 {
@@ -66,12 +94,12 @@ void scroll_callback(GLFWwindow* window, double xoffset, double yoffset)
 		gCamera->processMouseScroll((float)yoffset);
 }
 
-// 구 + UV 
-void createSphere(unsigned int& vao, unsigned int& indexCount,
+// 구 + UV 정점 생성 (pos3 + normal3 + uv2)
+void buildSphereMesh(std::vector<float>& vertices, std::vector<unsigned int>& indices,
 	int stacks = 40, int slices = 40)
 {
-	std::vector<float> vertices;
-	std::vector<unsigned int> indices;
+	vertices.clear();
+	indices.clear();
 
 	for (int i = 0; i <= stacks; ++i)
 	{
@@ -117,13 +145,24 @@ void createSphere(unsigned int& vao, unsigned int& indexCount,
 			indices.push_back(row2 + j + 1);
 		}
 	}
+}
+
+// 구 + UV 
+void createSphere(unsigned int& vao, unsigned int& indexCount,
+	int stacks = 40, int slices = 40)
+{
+	std::vector<float> vertices;
+	std::vector<unsigned int> indices;
+	buildSphereMesh(vertices, indices, stacks, slices);
 
 	indexCount = (unsigned int)indices.size();
 
-	unsigned int vbo, ebo;
-	glGenVertexArrays(1, &vao);
-	glGenBuffers(1, &vbo);
-	glGenBuffers(1, &ebo);
+	// 공용 구 메쉬: 프로그램 끝까지 사용하므로 레지스트리가 소유
+	vao = GpuRegistry::createOwned(GpuKind::VertexArray, GpuClass::Buffer, "sphere VAO", 0);
+	unsigned int vbo = GpuRegistry::createOwned(GpuKind::Buffer, GpuClass::Buffer,
+		"sphere vertices", vertices.size() * sizeof(float));
+	unsigned int ebo = GpuRegistry::createOwned(GpuKind::Buffer, GpuClass::Buffer,
+		"sphere indices", indices.size() * sizeof(unsigned int));
 
 	glBindVertexArray(vao);
 
@@ -162,8 +201,9 @@ void createQuad(unsigned int& vao, unsigned int& vbo)
 		 1.0f,  1.0f,  1.0f, 1.0f
 	};
 
-	glGenVertexArrays(1, &vao);
-	glGenBuffers(1, &vbo);
+	vao = GpuRegistry::createOwned(GpuKind::VertexArray, GpuClass::Buffer, "quad VAO", 0);
+	vbo = GpuRegistry::createOwned(GpuKind::Buffer, GpuClass::Buffer,
+		"quad vertices", sizeof(quadVertices));
 
 	glBindVertexArray(vao);
 	glBindBuffer(GL_ARRAY_BUFFER, vbo);
@@ -188,87 +228,16 @@ void createQuad(unsigned int& vao, unsigned int& vbo)
 
 
 // 텍스처 로드 및 에러 체크 헬퍼 함수
-unsigned int loadTextureWithCheck(const char* path)
+TextureRef loadTextureWithCheck(const char* path)
 {
-	unsigned int textureID = loadTexture(path);
-	if (textureID == 0) // loadTexture가 실패하면 보통 0을 반환함
+	TextureRef texture = loadTexture(path);
+	if (!texture) // loadTexture가 실패하면 빈 참조를 반환함
 	{
 		std::cerr << "[ERROR] Texture load failed: " << path << std::endl;
 		// 필요하다면 여기서 프로그램을 강제 종료하거나, 
 		// 핑크색 '에러 텍스처'를 대신 반환하는 로직을 넣을 수도 있음
 	}
-	return textureID;
-}
-
-// -------------------------------------------------------------
-// [Helper] 행성 파라미터 생성기
-// 필수적인 값만 인자로 받고, 나머지는 기본값(0 등)으로 채웁니다.
-// -------------------------------------------------------------
-PlanetParams createPlanetParams(std::string name,
-	float radius,
-	float distance,   // SemiMajorAxis
-	float eccentricity,
-	float period,
-	float spinSpeed,
-	std::string texPath,
-	float ax = 0.0f)
-{
-	PlanetParams p;
-	p.name = name;
-	p.mass = 1.0f; // 필요하면 인자로 추가
-	p.radiusRender = radius;
-	p.color = glm::vec3(1.0f);
-
-	// 궤도 기본 설정
-	p.orbit.semiMajorAxis = distance;
-	p.orbit.eccentricity = eccentricity;
-	p.orbit.periodYears = period;
-
-	// 나머지 궤도 각도들은 0.0f로 초기화 (필요시 반환 후 수정)
-	p.orbit.inclinationDeg = 0.0f;
-	p.orbit.ascNodeDeg = 0.0f;
-	p.orbit.argPeriDeg = 0.0f;
-	p.orbit.meanAnomalyAtEpochDeg = 0.0f;
-
-	p.spinDegPerSec = spinSpeed;
-	p.texturePath = texPath;
-	p.axialTiltDeg = ax;
-
-	return p;
-}
-
-// -------------------------------------------------------------
-// [Helper] 위성 파라미터 생성기
-// -------------------------------------------------------------
-SatelliteParams createSatelliteParams(std::string name,
-	float radius,
-	float distance,
-	float eccentricity,
-	float period,
-	float spinSpeed,
-	std::string texPath)
-{
-	SatelliteParams p;
-	p.name = name;
-	p.mass = 0.05f; // 기본값
-	p.radiusRender = radius;
-	p.color = glm::vec3(1.0f);
-
-	p.orbit.semiMajorAxis = distance;
-	p.orbit.eccentricity = eccentricity;
-	p.orbit.periodYears = period;
-
-	// 위성은 궤도 경사각이 있는 경우가 많으므로 일단 0으로 두고 밖에서 수정 권장
-	p.orbit.inclinationDeg = 0.0f;
-	p.orbit.ascNodeDeg = 0.0f;
-	p.orbit.argPeriDeg = 0.0f;
-	p.orbit.meanAnomalyAtEpochDeg = 0.0f;
-
-	p.spinDegPerSec = spinSpeed;
-	p.trailMaxPoints = 200; // 궤적 길이 기본값
-	p.texturePath = texPath;
-
-	return p;
+	return texture;
 }
 
 // 자전축 방향 계산 함수 추가-------------------------------------------------------------
@@ -281,469 +250,182 @@ glm::vec3 computeAxisDir(float tiltDeg)
 }
 
 // 선(line) 그리는 함수 추가 -------------------------------------------------------------
-void drawAxisLine(const glm::vec3& center,
+void drawAxisLine(CommandList& cmd,
+	const glm::vec3& center,
 	const glm::vec3& axisDir,
 	const Shader& axisShader,
 	const glm::mat4& view,
 	const glm::mat4& proj)
 {
 	float length = 5.0f;
-	glm::vec3 p1 = center + axisDir * length;
-	glm::vec3 p2 = center - axisDir * length;
+	glm::vec3 verts[2] = { center + axisDir * length, center - axisDir * length };
 
-	float verts[6] = { p1.x, p1.y, p1.z, p2.x, p2.y, p2.z };
+	cmd.setPipeline(makePipeline(axisShader.ID));
+	cmd.setMat4("view", view);
+	cmd.setMat4("proj", proj);
+	cmd.drawTransient(Primitive::Lines, verts, 2);
+}
 
-	unsigned int VAO, VBO;
-	glGenVertexArrays(1, &VAO);
-	glGenBuffers(1, &VBO);
 
-	glBindVertexArray(VAO);
-	glBindBuffer(GL_ARRAY_BUFFER, VBO);
-	glBufferData(GL_ARRAY_BUFFER, sizeof(verts), verts, GL_STATIC_DRAW);
+// ================================================================
+// 태양계 Setup (BodyCatalog → BodyStore + Sun / Planet / Satellite)
+//  - 모든 레코드를 그대로 BodyStore 에 등록 (레코드 번호 = 천체 번호) → 전부 시뮬레이션 / 렌더링
+//  - 첫 번째 star 가 태양, 그 행성 / 위성은 고리 / 대기 / 궤적 같은 드문 데이터용으로
+//    Planet / Satellite 도 만듦
+//  - 그 밖의 천체 (두 번째 항성, 위성의 위성) 는 BodyStore::otherBodies → 구 하나로 그림
+// ================================================================
+static OrbitalElements catalogOrbit(const bcat::Orbit& o)
+{
+	OrbitalElements e;
+	e.semiMajorAxis = o.semiMajorAxis;
+	e.eccentricity = o.eccentricity;
+	e.inclinationDeg = o.inclinationDeg;
+	e.ascNodeDeg = o.ascNodeDeg;
+	e.argPeriDeg = o.argPeriDeg;
+	e.periodYears = o.periodYears;
+	e.meanAnomalyAtEpochDeg = o.meanAnomalyAtEpochDeg;
+	e.perihelionPrecessionDegPerYear = o.perihelionPrecessionDegPerYear;
+	e.ascNodePrecessionDegPerYear = o.ascNodePrecessionDegPerYear;
+	return e;
+}
 
-	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3), (void*)0);
-	glEnableVertexAttribArray(0);
+static BodyDesc catalogBody(const bcat::BodyRecord& r)
+{
+	BodyDesc d;
+	d.parent = r.parent;
+	d.kind = (BodyKind)r.kind; // bcat::Kind 와 같은 순서
+	d.orbit = catalogOrbit(r.orbit);
+	d.mass = r.mass;
+	d.radius = r.radius;
+	d.spinDegPerSec = r.spinDegPerDay;
+	d.axialTiltDeg = r.axialTiltDeg;
+	d.axisPrecessionDegPerYear = r.axisPrecessionDegPerYear;
+	return d;
+}
 
-	axisShader.use();
-	axisShader.setMat4("view", view);
-	axisShader.setMat4("proj", proj);
+static PlanetParams catalogPlanet(const BodyCatalog& catalog, const bcat::BodyRecord& r)
+{
+	PlanetParams p;
+	p.name = catalog.string(r.name);
+	p.mass = r.mass;
+	p.radiusRender = r.radius;
+	p.color = glm::vec3(1.0f);
+	p.orbit = catalogOrbit(r.orbit);
+	p.spinDegPerSec = r.spinDegPerDay;
+	p.texturePath = catalog.string(r.texture);
+	p.axialTiltDeg = r.axialTiltDeg;
 
-	glLineWidth(1.0f);
-	glDrawArrays(GL_LINES, 0, 2);
+	if (r.flags & bcat::HAS_RING)
+	{
+		p.ring.enabled = true;
+		p.ring.innerRadius = r.ringInner;
+		p.ring.outerRadius = r.ringOuter;
+		p.ring.alpha = r.ringAlpha;
+		p.ring.texturePath = catalog.string(r.ringTexture);
+	}
 
-	glDeleteBuffers(1, &VBO);
-	glDeleteVertexArrays(1, &VAO);
+	if (r.flags & bcat::HAS_ATMOSPHERE)
+	{
+		AtmosphereParams& a = p.atmosphere;
+		a.enabled = true;
+		a.thickness = r.atmThickness;
+		a.rayleighScaleHeight = r.atmRayleighScaleHeight;
+		a.mieScaleHeight = r.atmMieScaleHeight;
+		a.rayleighScattering = glm::vec3(r.atmRayleighScattering[0], r.atmRayleighScattering[1], r.atmRayleighScattering[2]);
+		a.mieScattering = r.atmMieScattering;
+		a.mieG = r.atmMieG;
+		a.sunIntensity = r.atmSunIntensity;
+		a.nightTexturePath = catalog.string(r.atmNightTexture);
+		a.cloudTexturePath = catalog.string(r.atmCloudTexture);
+		a.cloudOpacity = r.atmCloudOpacity;
+	}
+
+	if (r.flags & bcat::HAS_TERRAIN)
+	{
+		p.terrain.enabled = true;
+		p.terrain.heightScale = r.terrainHeightScale;
+		p.terrain.tileDir = catalog.string(r.terrainTileDir);
+	}
+	return p;
 }
 
+static SatelliteParams catalogSatellite(const BodyCatalog& catalog, const bcat::BodyRecord& r)
+{
+	SatelliteParams s;
+	s.name = catalog.string(r.name);
+	s.mass = r.mass;
+	s.radiusRender = r.radius;
+	s.color = glm::vec3(1.0f);
+	s.orbit = catalogOrbit(r.orbit);
+	s.spinDegPerSec = r.spinDegPerDay;
+	s.trailMaxPoints = r.trailPoints;
+	s.texturePath = catalog.string(r.texture);
+	s.axialTiltDeg = r.axialTiltDeg;
+	return s;
+}
 
-// ================================================================
-// 태양계 Setup
-// ================================================================
-void setupSolarSystem(Sun& sun)
+bool setupSolarSystem(Sun& sun, BodyStore& bodies, const BodyCatalog& catalog)
 {
-	// ================================================================
-	// Mercury (수성)
-	// ================================================================
-	PlanetParams mercuryP = createPlanetParams(
-		"Mercury",                  // 행성 이름
-		0.25f,                      // 렌더링 반지름
-		16.0f,                      // 시뮬레이션 스케일 거리
-		0.2056f,                    // 이심률
-		0.240846f,                  // 공전 주기(년)
-		360.0f / 58.646f,           // 자전 속도 (deg/day)
-		"textures/2k_mercury.jpg"   // 텍스처 경로
-	);
-
-	// 수성 궤도 요소 (NASA JPL Elements)
-	mercuryP.orbit.inclinationDeg = 7.005f;            // 궤도 경사각
-	mercuryP.orbit.ascNodeDeg = 48.33167f;			   // 승교점 경도
-	mercuryP.orbit.argPeriDeg = 29.124f;               // 근일점 인수
-	mercuryP.orbit.meanAnomalyAtEpochDeg = 174.796f;   // 평균근점이각
-	mercuryP.orbit.periodYears = 0.240846f;			   // 공전 주기(년)
-	mercuryP.orbit.perihelionPrecessionDegPerYear = 0.015555f;  // 근일점 세차
-	mercuryP.orbit.ascNodePrecessionDegPerYear = -0.005000f;    // 승교점 세차
-	mercuryP.axialTiltDeg = 0.034f; 					// 자전축 기울기
-
-	Planet mercury(mercuryP);      // 수성 Planet 객체 생성
-	sun.addPlanet(mercury);        // 태양에 수성 등록
-
-	// ================================================================
-	// Venus (금성)
-	// ================================================================
-	PlanetParams venusP = createPlanetParams(
-		"Venus",                    // 행성 이름
-		0.60f,                      // 렌더링 반지름
-		24.0f,                      // 시뮬레이션 스케일 거리
-		0.0067f,                    // 이심률
-		0.615197f,                  // 공전 주기(년, 224.701일)
-		-360.0f / 243.0185f,        // 자전 속도 (역자전 → 음수, deg/day)
-		"textures/2k_venus.jpg"     // 텍스처 경로
-	);
-
-	// 금성 궤도 요소 (NASA JPL Elements)
-	venusP.orbit.inclinationDeg = 3.39471f;          // 궤도 경사각
-	venusP.orbit.ascNodeDeg = 76.68069f;			 // 승교점 경도
-	venusP.orbit.argPeriDeg = 54.884f;				 // 근일점 인수
-	venusP.orbit.meanAnomalyAtEpochDeg = 50.115f;    // 평균근점이각
-	venusP.orbit.periodYears = 0.615197f;            // 공전 주기(년)
-	venusP.orbit.perihelionPrecessionDegPerYear = 0.007777f;   // 근일점 세차
-	venusP.orbit.ascNodePrecessionDegPerYear = -0.003900f;     // 승교점 세차
-	venusP.axialTiltDeg = 177.36f; 					 // 자전축 기울기
-
-	Planet venus(venusP);          // 금성 Planet 객체 생성
-	sun.addPlanet(venus);          // 태양에 금성 등록
-
-	// ================================================================
-	// Earth (지구)
-	// ================================================================
-	PlanetParams earthP = createPlanetParams(
-		"Earth",                    // 행성 이름
-		0.65f,                      // 렌더링 반지름
-		32.0f,                      // 시뮬레이션 스케일 거리
-		0.01671022f,                // 이심률
-		1.000000f,                  // 공전 주기(년)
-		360.0f / 0.99726968f,       // 자전 속도(항성일 0.99726968일)
-		"textures/2k_earth_day.jpg" // 텍스처 경로
-	);
-
-	// 지구 궤도 요소 (NASA JPL Elements)
-	earthP.mass = 5.9722e24; 						 // 질량
-	earthP.orbit.inclinationDeg = 0.00005f;          // 궤도 경사각
-	earthP.orbit.ascNodeDeg = -11.26064f;			 // 승교점 경도 
-	earthP.orbit.argPeriDeg = 114.20783f;			 // 근일점 인수 
-	earthP.orbit.meanAnomalyAtEpochDeg = 357.51716f; // 평균근점이각
-	earthP.orbit.periodYears = 1.000000f;            // 공전 주기(년)
-	earthP.orbit.ascNodePrecessionDegPerYear = -0.01397f;
-	earthP.orbit.perihelionPrecessionDegPerYear = 0.01397f;
-	earthP.axialTiltDeg = 23.439f;					 // 자전축 기울기
-
-	Planet earth(earthP);   // 지구 생성
-
-	// ================================================================
-	// + Moon (달)
-	// ================================================================
-	SatelliteParams moonP{
-		"Moon",                         // 이름
-		0.0123f,                        // 질량 (사용 안 해도 무관)
-		0.18f,                          // 렌더링 반지름
-		glm::vec3(1.0f),                // 기본 색상 (텍스처 사용)
-		{
-			3.844f,                     // 거리
-			0.0549f,                    // 이심률
-			5.145f,                     // 궤도 경사각
-			125.08f,                    // 승교점 경도
-			318.15f,                    // 근일점 인수
-			27.321661f / 365.25f,       // 공전 주기(년) — 27.321661일/365.25
-			115.3654f                   // 평균근점이각
-		},
-		360.0f / 27.321661f,            // 자전 속도 — 조석고정
-		2000,                           // trail 포인트
-		"textures/2k_moon.jpg"          // 달 텍스처
-	};
+	int star = -1;
+	std::vector<Planet> planets;
+	std::vector<int> planetOf(catalog.bodyCount(), -1); // 레코드 번호 → planets 번호
+	std::vector<BodyDesc> records;
+	records.reserve(catalog.bodyCount());
 
-	moonP.mass = 7.34767309e22; 						     // 질량
-	moonP.orbit.perihelionPrecessionDegPerYear = 0.1114f;    // 근지점 세차(약 3232.6일 주기)
-	moonP.orbit.ascNodePrecessionDegPerYear = -0.053f;       // 승교점 세차(18.6년 주기)
-	moonP.axialTiltDeg = 6.687f; 						     // 자전축 기울기
-
-	Satellite moon(moonP);        // 달 생성
-	earth.addSatellite(moon);     // 지구 위성으로 달 등록
-	sun.addPlanet(earth);		  // 태양에 지구 추가
-
-	// ================================================================
-	// Mars (화성)
-	// ================================================================
-	PlanetParams marsP = createPlanetParams(
-		"Mars",                     // 행성 이름
-		0.45f,                      // 렌더링 반지름
-		48.0f,                      // 시뮬레이션 스케일 거리
-		0.0934f,                    // 이심률
-		1.8808476f,                 // 공전 주기(년, 686.980일)
-		360.0f / 1.025957f,         // 자전 속도(화성 하루 1.025957일)
-		"textures/2k_mars.jpg"      // 텍스처 경로
-	);
-
-	// 화성 궤도 요소 (NASA JPL Elements)
-	marsP.orbit.inclinationDeg = 1.85061f;           // 궤도 경사각
-	marsP.orbit.ascNodeDeg = 49.57854f;				 // 승교점 경도 
-	marsP.orbit.argPeriDeg = 286.502f;				 // 근일점 인수 
-	marsP.orbit.meanAnomalyAtEpochDeg = 19.412f;     // 평균근점이각
-	marsP.orbit.periodYears = 1.8808476f;            // 공전 주기(년)
-	marsP.orbit.perihelionPrecessionDegPerYear = 0.004166f;  // 근일점 세차
-	marsP.orbit.ascNodePrecessionDegPerYear = -0.002000f;    // 승교점 세차
-
-	Planet mars(marsP);            // 화성 Planet 객체 생성
-	sun.addPlanet(mars);           // 태양에 화성 등록
-
-
-	// ================================================================
-	// Jupiter (목성)
-	// ================================================================
-	PlanetParams jupiterP = createPlanetParams(
-		"Jupiter",                  // 행성 이름
-		2.8f,                       // 렌더링 반지름
-		94.0f,                     // 시뮬레이션 스케일 거리
-		0.0489f,                    // 이심률
-		11.862615f,                 // 공전 주기(년)
-		360.0f / 0.41354f,          // 자전 속도 (목성 하루 0.41354일)
-		"textures/2k_jupiter.jpg"   // 텍스처 경로
-	);
-
-	// 목성 궤도 요소 (NASA JPL Elements)
-	jupiterP.mass = 1.8985e27f; 					  // 질량
-	jupiterP.orbit.inclinationDeg = 1.303f;           // 궤도 경사각
-	jupiterP.orbit.ascNodeDeg = 100.55615f;			  // 승교점 경도
-	jupiterP.orbit.argPeriDeg = 273.867f;			  // 근일점 인수 
-	jupiterP.orbit.meanAnomalyAtEpochDeg = 20.020f;   // 평균근점이각 
-	jupiterP.orbit.periodYears = 11.862615f;          // 공전 주기(년)
-	jupiterP.orbit.perihelionPrecessionDegPerYear = 0.000194f;  // 근일점 세차
-	jupiterP.orbit.ascNodePrecessionDegPerYear = -0.000150f;	// 승교점 세차
-	jupiterP.axialTiltDeg = 3.13f; 					  // 자전축 기울기
-
-	jupiterP.ring.enabled = true;
-	jupiterP.ring.innerRadius = 2.0f;   // 목성 고리 내경 
-	jupiterP.ring.outerRadius = 2.03f;  // 목성 고리 외경
-	jupiterP.ring.alpha = 0.005f;		// 목성 고리는 아주 희미함
-	jupiterP.ring.texturePath = "textures/2k_jupiter_ring_alpha.png";  // 텍스쳐 경로
-
-	Planet jupiter(jupiterP);			// 목성 생성
-
-	// ================================================================
-	// Europa (유로파)
-	// ================================================================
-	SatelliteParams europaP{
-		"Europa",                      // 위성 이름
-		0.0625f,                       // 위성 질량
-		0.20f,                         // 렌더링 반지름
-		glm::vec3(1.0f),               // 색상 (텍스처 사용하므로 의미 X)
-		{
-			7.5f,                      // 거리 스케일(목성 중심)
-			0.0094f,                   // 이심률
-			0.470f,                    // 궤도 경사각
-			219.106f,                  // 승교점 경도
-			88.970f,                   // 근지점 인수
-			3.551181f / 365.25f,       // 공전 주기(년) — 3.551181일
-			128.0f                     // 평균근점이각
-		},
-		360.0f / 3.551181f,            // 자전 속도 — 조석고정
-		2000,                          // trail 포인트 개수
-		"textures/2k_europa.jpg"       // 유로파 텍스처
-	};
+	for (int i = 0; i < catalog.bodyCount(); i++)
+	{
+		const bcat::BodyRecord& r = catalog.body(i);
+		bcat::Kind kind = (bcat::Kind)r.kind;
+		records.push_back(catalogBody(r));
 
-	europaP.mass = 4.80e22f; 		   // 질량
-	europaP.orbit.perihelionPrecessionDegPerYear = 0.0101f;   // 근지점 세차
-	europaP.orbit.ascNodePrecessionDegPerYear = -0.0111f;	  // 승교점 세차
-	europaP.axialTiltDeg = 0.1f; 							  // 자전축 기울기
-
-	Satellite europa(europaP);      // 유로파 생성
-	jupiter.addSatellite(europa);	// 목성에 유로파 위성 등록
-	sun.addPlanet(jupiter);         // 태양에 목성 등록
-
-	// ================================================================
-	// Saturn (토성)
-	// ================================================================
-	PlanetParams saturnP = createPlanetParams(
-		"Saturn",                   // 행성 이름
-		2.5f,                       // 렌더링 반지름
-		140.0f,                     // 시뮬레이션 스케일 거리
-		0.0565f,                    // 이심률
-		29.4571f,                   // 공전 주기(년, 10759일)
-		360.0f / 0.44401f,          // 자전 속도(토성 하루 0.44401일)
-		"textures/2k_saturn.jpg"    // 텍스처 경로
-	);
-
-	// 토성 궤도 요소 (NASA JPL Elements)
-	saturnP.mass = 5.683e26f; 					     // 질량
-	saturnP.orbit.inclinationDeg = 2.485f;           // 궤도 경사각
-	saturnP.orbit.ascNodeDeg = 113.662f;			 // 승교점 경도
-	saturnP.orbit.argPeriDeg = 339.392f;			 // 근일점 인수
-	saturnP.orbit.meanAnomalyAtEpochDeg = 317.020f;  // 평균근점이각
-	saturnP.orbit.periodYears = 29.4571f;			 // 공전 주기(년)
-	saturnP.orbit.perihelionPrecessionDegPerYear = 0.000100f;  // 근일점 세차
-	saturnP.orbit.ascNodePrecessionDegPerYear = -0.000070f;	   // 승교점 세차
-	saturnP.axialTiltDeg = 26.73f; 					 // 자전축 기울기
-
-	saturnP.ring.enabled = true;	// 고리 활성화
-	saturnP.ring.innerRadius = 1.2f;// 토성 고리 내경
-	saturnP.ring.outerRadius = 2.4f;// 토성 고리 외경
-	saturnP.ring.alpha = 0.9f;		// 토성 고리 투명도
-	saturnP.ring.texturePath = "textures/2k_saturn_ring_alpha.png";
-
-	Planet saturn(saturnP);         // 토성 생성
-
-	// ================================================================
-	// Titan (타이탄)
-	// ================================================================
-	SatelliteParams titanP{
-		"Titan",                        // 위성 이름
-		0.2225f,                        // 질량
-		0.1105f,                        // 렌더링 반지름
-		glm::vec3(1.0f),                // 색상 (텍스처 사용)
+		if (kind == bcat::Kind::Star && star < 0)
 		{
-			10.0f,                      // 거리 스케일(토성 중심)
-			0.0288f,                    // 이심률
-			0.34854f,                   // 궤도 경사각
-			168.77f,                    // 승교점 경도
-			186.585f,                   // 근지점 인수
-			15.945f / 365.25f,          // 공전 주기(년) — 15.945일
-			17.0f                       // 평균근점이각
-		},
-		360.0f / 15.945f,               // 자전 속도 — 조석고정
-		2000,                           // trail 포인트 개수
-		"textures/2k_titan.jpg"         // 타이탄 텍스처
-	};
-
-	titanP.mass = 1.3452e23f; 		    // 질량
-	titanP.orbit.perihelionPrecessionDegPerYear = 0.0038f;    // 근지점 세차
-	titanP.orbit.ascNodePrecessionDegPerYear = -0.0046f;	  // 승교점 세차
-	titanP.axialTiltDeg = 0.3f; 							  // 자전축 기울기
-
-	Satellite titan(titanP);         // 타이탄 생성
-	saturn.addSatellite(titan);		 // 토성에 타이탄 추가
-	sun.addPlanet(saturn);           // 태양에 토성 등록
-
-	// ================================================================
-	// Uranus (천왕성)
-	// ================================================================
-	PlanetParams uranusP = createPlanetParams(
-		"Uranus",                    // 행성 이름
-		1.80f,                       // 렌더링 반지름
-		190.0f,                      // 시뮬레이션 스케일 거리
-		0.04726f,                    // 이심률
-		84.016846f,                  // 공전 주기(년)
-		-(360.0f / 0.71833f),        // 자전 속도 (17.24h = 0.71833일, 역행 = 음수)
-		"textures/2k_uranus.jpg",    // 텍스처 경로
-		97.77f                       // 자전축 기울기
-	);
-
-	// 천왕성 궤도 요소 (NASA JPL Elements)
-	uranusP.mass = 8.6810e25f; 					      // 질량
-	uranusP.orbit.inclinationDeg = 0.773f;            // 궤도 경사각
-	uranusP.orbit.ascNodeDeg = 74.006f;               // 승교점 경도
-	uranusP.orbit.argPeriDeg = 96.998857f;            // 근일점 인수
-	uranusP.orbit.meanAnomalyAtEpochDeg = 142.2386f;  // 평균근점이각
-	uranusP.orbit.periodYears = 84.016846f;           // 공전 주기(년, 동일하게 유지)
-	uranusP.orbit.perihelionPrecessionDegPerYear = 0.000095f;   // 근일점 세차
-	uranusP.orbit.ascNodePrecessionDegPerYear = -0.000095f;		// 승교점 세차
-	uranusP.axialTiltDeg = 97.77f; 					  // 자전축 기울기
-
-	uranusP.ring.enabled = true;	 // 고리 활성화
-	uranusP.ring.innerRadius = 1.52f;// 천왕성 고리 내경
-	uranusP.ring.outerRadius = 1.55f;// 천왕성 고리 외경
-	uranusP.ring.alpha = 0.005f;	 // 천왕성 고리 투명도
-	uranusP.ring.texturePath = "textures/2k_uranus_ring_alpha.png";
-
-	Planet uranus(uranusP);        // 천왕성 객체 생성
-
-	SatelliteParams oberonP{
-		"Oberon",				   // 위성 이름
-		0.225f,					   // 질량
-		0.054f,                    // 렌더링 반지름
-		glm::vec3(1.0f),		   // 색상 (텍스처 사용)
+			star = i;
+			sun.setMass(r.mass);
+			sun.setSpinSpeed(r.spinDegPerDay);
+			records.back().radius = SUN_RENDER_RADIUS;
+		}
+		else if (kind == bcat::Kind::Planet && star >= 0 && r.parent == star)
 		{
-			8.0f,                  // 거리 스케일 (천왕성 중심)
-			0.0014f,               // 이심률
-			0.34854f,              // 궤도 경사각
-			168.77f,               // 승교점 경도
-			186.585f,              // 근지점 인수
-			13.463234f / 365.25f,  // 공전 주기(년)
-			17.0f                  // 평균근점이각
-		},
-		360.0f / 13.463234f,       // 조석 고정
-		2000,
-		"textures/2k_oberon.jpg"
-	};
-
-	oberonP.mass = 3.014e21f; 	   // 질량
-	oberonP.orbit.perihelionPrecessionDegPerYear = 0.0035f;   // 근지점 세차 (조금 작게)
-	oberonP.orbit.ascNodePrecessionDegPerYear = -0.0042f;  // 승교점 세차
-	oberonP.axialTiltDeg = 0.0f;   // 자전축 기울기
-
-	Satellite oberon(oberonP);     // 오베론 생성
-	uranus.addSatellite(oberon);   // 천왕성에 타이탄 추가
-	sun.addPlanet(uranus);         // 태양에 천왕성 등록
-
-	// ================================================================
-	// Neptune (해왕성)
-	// ================================================================
-	PlanetParams neptuneP = createPlanetParams(
-		"Neptune",                   // 행성 이름
-		1.70f,                       // 렌더링 반지름
-		230.0f,                      // 시뮬레이션 스케일 거리
-		0.008678f,                   // 이심률
-		164.8922113f,                // 공전 주기(년)
-		360.0f / 0.67125f,           // 자전 속도 (자전주기 약 16.11h = 0.67125 day)
-		"textures/2k_neptune.jpg"    // 텍스처 경로
-	);
-
-	// 해왕성 궤도 요소 (NASA JPL Elements)
-	neptuneP.mass = 1.02413e26f;
-	neptuneP.orbit.inclinationDeg = 1.769f;       // 궤도 경사각
-	neptuneP.orbit.ascNodeDeg = 131.784f;		  // 승교점 경도
-	neptuneP.orbit.argPeriDeg = 273.187f;		  // 근일점 인수
-	neptuneP.orbit.meanAnomalyAtEpochDeg = 259.908f;		   // 평균근점이각
-	neptuneP.orbit.periodYears = 164.8922113f;	  // 공전 주기(년)
-	neptuneP.orbit.perihelionPrecessionDegPerYear = 0.000032f; // 근일점 세차
-	neptuneP.orbit.ascNodePrecessionDegPerYear = -0.000032f;   // 승교점 세차
-	neptuneP.axialTiltDeg = 28.32f; 			  // 자전축 기울기
-
-	neptuneP.ring.enabled = true;	  // 고리 활성화
-	neptuneP.ring.innerRadius = 1.6f; // 해왕성 고리 내경
-	neptuneP.ring.outerRadius = 1.63f;// 해왕성 고리 외경
-	neptuneP.ring.alpha = 0.005f;	  // 해왕성 고리 투명도
-	neptuneP.ring.texturePath = "textures/2k_neptune_ring_alpha.png";
-
-	Planet neptune(neptuneP);   // 해왕성 객체 생성
-
-	// ================================================================
-	// Triton (트리톤)
-	// ================================================================
-	SatelliteParams tritonP{
-		"Triton",                       // 위성 이름
-		2.139e22f,                      // 질량
-		0.0934f,                        // 렌더링 반지름
-		glm::vec3(1.0f),                // 색상 (텍스처 사용)
+			planetOf[i] = (int)planets.size();
+			planets.emplace_back(catalogPlanet(catalog, r));
+		}
+		else if (kind == bcat::Kind::Satellite && r.parent >= 0 && planetOf[r.parent] >= 0)
 		{
-			6.0f,                       // 거리 스케일 (해왕성 중심)
-			0.000016f,                  // 이심률
-			157.0f,                     // 궤도 경사각 (역행)
-			200.0f,                     // 승교점 경도
-			39.48f,                     // 근지점 인수
-			5.876854f / 365.25f,        // 실제 공전 주기(년)
-			358.0f                      // 평균근점이각
-		},
-		360.0f / 5.876854f,             // 조석고정
-		2000,                           // trail 포인트 개수
-		"textures/2k_triton.jpg"		// 텍스처 경로
-	};
+			planets[planetOf[r.parent]].addSatellite(Satellite(catalogSatellite(catalog, r)));
+		}
+	}
+
+	if (star < 0)
+	{
+		std::cerr << "[Catalog] No star in catalog\n";
+		return false;
+	}
+	if (!bodies.build(records))
+	{
+		std::cerr << "[Catalog] Body parent must come before the body\n";
+		return false;
+	}
+
+	for (const Planet& planet : planets)
+		sun.addPlanet(planet);
 
-	tritonP.mass = 2.139e22f;								  // 질량
-	tritonP.orbit.perihelionPrecessionDegPerYear = 0.0050f;   // 근지점 세차
-	tritonP.orbit.ascNodePrecessionDegPerYear = -0.0050f; 	  // 승교점 세차
-	tritonP.axialTiltDeg = 0.3f; 							  // 자전축 기울기
-
-	Satellite triton(tritonP);           // 트리톤 생성
-	neptune.addSatellite(triton);		 // 해왕성에 트리톤 추가
-	sun.addPlanet(neptune);				 // 태양에 해왕성 등록
-
-	// ---------------------------------------------------------
-	// 9. 아스가르드 (Asgard) - 수직 궤도 행성
-	// ---------------------------------------------------------
-	PlanetParams asgardP = createPlanetParams(
-		"Asgard",
-		1.5f,   // 크기: 지구보다 좀 큼
-		45.0f,  // 거리: 목성(40)과 토성(50) 사이를 가로지름
-		0.0f,   // 이심률
-		2.0f,   // 공전 속도: 꽤 빠름
-		5.0f,   // 자전 속도
-		"textures/2k_asgard.jpg" // 텍스처 (없으면 달 텍스처 재활용)
-	);
-
-	// 궤도 경사각을 90도로 설정 (수직 공전)
-	asgardP.orbit.inclinationDeg = 90.0f;
-
-	// 궤도 교차 지점 설정 (0도면 X축에서 교차, 90도면 Z축에서 교차)
-	asgardP.orbit.ascNodeDeg = 45.0f;
-
-	Planet asgard(asgardP);
-	sun.addPlanet(asgard); // 태양계 등록
+	if (!bodies.otherBodies().empty())
+		std::cout << "[Catalog] " << bodies.otherBodies().size()
+			<< " bodies outside star -> planet -> satellite (drawn as plain spheres)\n";
+	return true;
 }
 
-// render helper: 한 행성(Planet)을 렌더링
-void renderPlanet(Planet& planet,
-	unsigned int textureID,
+// render helper: 한 행성(Planet)을 렌더링 (위치 / 행렬 / 텍스처는 BodyStore 에서)
+void renderPlanet(const Planet& planet,
+	int body,
 	Shader& shader,
 	unsigned int sphereIndexCount,
-	float dtSeconds,
-	float worldScale,
-	const glm::vec3& worldPos,
 	unsigned int sphereVAO,
 	bool isSun = false,
 	float emissionStrength = 1.0f)
 {
-	// 시뮬레이션 시간 기준 자전 업데이트 (배속 + 일시정지 반영)
-	float dtSimDays = (isPaused ? 0.0f : dtSeconds * simSpeedMultiplier);
-	planet.advanceSpin(dtSimDays);
+	unsigned int textureID = gBodies->material(body);
 
 	// 텍스처 + 쉐이더 설정
 	glActiveTexture(GL_TEXTURE0);
@@ -752,136 +434,181 @@ void renderPlanet(Planet& planet,
 	shader.setInt("isSun", isSun ? 1 : 0);
 	shader.setFloat("emissionStrength", emissionStrength);
 
-	glm::mat4 model = planet.buildModelMatrix(worldScale, worldPos);
+	const glm::mat4& model = gBodies->model(body);
+	const glm::mat4& prevModel = gBodies->prevModel(body);
+
+	// 가까이 추적 중이면 쿼드트리 지형으로 (uniform 은 호출 측에서 terrainShader 에 설정)
+	const glm::vec3& worldPos = gBodies->worldPosition(body);
+	float radius = gBodies->worldRadius(body);
+	if (!isSun && gTerrain && gTerrain->covers(&planet, worldPos, radius))
+	{
+		// 가상 텍스처가 있으면 지형 색도 타일 캐시에서 (피드백 패스에는 같은 model 의 구로 기록)
+		Shader* terrainShader = gTerrain->getShader();
+		bool virtualTexture = false;
+		if (terrainShader && gVirtualTextures)
+		{
+			terrainShader->use();
+			virtualTexture = gVirtualTextures->bind(*terrainShader, &planet, model);
+		}
+
+		gTerrain->render(model, prevModel);
+
+		if (virtualTexture)
+			gVirtualTextures->unbind(*terrainShader);
+		shader.use();
+		return;
+	}
+
+	// 화면에서 작으면 임포스터 목록으로 (나중에 한꺼번에 그림)
+	if (!isSun && gImpostors && gImpostors->shouldUse(worldPos, radius))
+	{
+		gImpostors->add(model, prevModel, textureID);
+		return;
+	}
+
 	shader.setMat4("model", model);
+	shader.setMat4("prevModel", prevModel);
+
+	// 가상 텍스처가 있으면 diffuseMap 대신 타일 캐시로 샘플링 (피드백 패스에도 등록)
+	bool virtualTexture = !isSun && gVirtualTextures && gVirtualTextures->bind(shader, &planet, model);
 
 	glBindVertexArray(sphereVAO);
 	glDrawElements(GL_TRIANGLES, sphereIndexCount, GL_UNSIGNED_INT, 0);
+
+	if (virtualTexture)
+		gVirtualTextures->unbind(shader);
 }
 
-void renderSatellites(Planet& planet,
+void renderSatellites(const Planet& planet,
+	int planetIndex,
 	Shader& shader,
-	float dt,
-	float simTime,
-	float scale,
 	unsigned int sphereVAO,
-	unsigned int indexCount,
-	glm::vec3 planetWorldPos, // 이미 회전(XZ) + 스케일 + 질량중심 보정이 적용된 행성 위치
-	unsigned int texMoon,
-	unsigned int texEuropa,
-	unsigned int texTitan)
+	unsigned int indexCount)
 {
-	// 위성이 없으면 바로 리턴
-	if (planet.satellites().empty()) return;
-
-	// 모든 위성 순회
-	for (auto& sat : planet.satellites())
+	// 모든 위성 순회 (BodyStore 가 등록할 때 저장한 위성 번호)
+	int satCount = (int)planet.satellites().size();
+	for (int s = 0; s < satCount; s++)
 	{
-		std::string sName = sat.getParams().name;
-		unsigned int currentTex = texMoon; // 기본값: 달 텍스처
-
-		// 1. 이름에 따라 텍스처 자동 선택
-		if (sName == "Moon")        currentTex = texMoon;
-		else if (sName == "Europa") currentTex = texEuropa;
-		else if (sName == "Titan")  currentTex = texTitan;
-		// else currentTex = texGenericRock; // 필요 시 일반 위성 텍스처
+		int body = gBodies->satelliteBody(planetIndex, s);
+		unsigned int currentTex = gBodies->material(body);
 
-		// 2. 텍스처 바인딩
+		// 1. 텍스처 바인딩
 		glActiveTexture(GL_TEXTURE0);
 		glBindTexture(GL_TEXTURE_2D, currentTex);
 		shader.setInt("diffuseMap", 0);
 		shader.setInt("isSun", 0);
 		shader.setFloat("emissionStrength", 1.0f);
 
-		// 3. 상대 위치 계산 (모든 궤도는 XY → XZ로 회전해서 사용)
-		glm::vec3 rel = sat.positionRelativeToPlanet(simTime);                 // XY 기준
-		glm::vec3 relXZ = glm::vec3(orbitToXZ * glm::vec4(rel, 1.0f));         // XZ 기준으로 회전
-
-		// 4. 최종 world 위치
-		// planetWorldPos는 이미 (physPos + Re) * scale 에 orbitToXZ를 적용한 값
-		// relXZ는 시뮬레이션 단위이므로 scale을 곱해서 같은 단위로 맞춘다.
-		glm::vec3 satWorldPos = planetWorldPos + relXZ * scale;
+		// 2. 렌더링 (위치 / 자전은 BodyStore::update 에서 계산됨)
+		const glm::mat4& model = gBodies->model(body);
+		const glm::mat4& prevModel = gBodies->prevModel(body);
+		if (gImpostors && gImpostors->shouldUse(gBodies->worldPosition(body), gBodies->worldRadius(body)))
+		{
+			// 화면에서 작으면 임포스터 목록으로
+			gImpostors->add(model, prevModel, currentTex);
+			continue;
+		}
 
-		// 5. 렌더링 (자전도 시뮬레이션 배속 반영)
-		float dtSimDays = (isPaused ? 0.0f : dt * simSpeedMultiplier);
-		sat.drawAtWorld(shader, dtSimDays, scale, satWorldPos, sphereVAO, indexCount);
+		shader.setMat4("model", model);
+		shader.setMat4("prevModel", prevModel);
+		glBindVertexArray(sphereVAO);
+		glDrawElements(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, 0);
+		glBindVertexArray(0);
 	}
 }
 
-// -------------------------------------------------------------
-//  행성 + 위성 질량중심(barycenter) 보정 포함 updatePlanetPhysics()
-//  - 모든 위성의 질량과 상대 위치를 합산하여 행성의 질량중심 보정 적용
-//  - 달 / 유로파 / 타이탄 모두 서로 다른 barycenter 반영
-// -------------------------------------------------------------
-void updatePlanetPhysics(
-	Planet& planet,
-	float simYears,
-	const glm::mat4& orbitToXZ,
-	float scaleUnits,
-	glm::vec3& outWorldPos)
+// ================================================================
+// 천체 표면 셰이딩 (sceneShader / 구 임포스터 공용)
+//  - shadeSurface: 텍스처 + 조명 + 일식 + 대기 투과 + 구름 / 야간 조명
+//    (텍스처 미분값을 직접 받음: 임포스터는 경도 이음새에서 미분을 보정)
+//  - writeSurface: HDR 색 / 블룸용 밝은 부분 / 움직임 벡터 출력
+// ================================================================
+#define SCENE_SURFACE_GLSL \
+	"layout(location=0) out vec4 FragColor;\n" \
+	"layout(location=1) out vec4 BrightColor;\n" \
+	"layout(location=2) out vec2 Velocity;\n" /* UV 단위 (업스케일 타깃에만 존재) */ \
+	"uniform sampler2D diffuseMap;\n" \
+	"uniform vec3 lightPos;\n" \
+	"uniform vec3 lightColor;\n" \
+	"uniform vec3 viewPos;\n" \
+	"uniform int  isSun;\n" \
+	"uniform float emissionStrength;\n" \
+	"uniform float ringAlpha;\n" \
+	"uniform float atmoLayer;\n" /* 대기 LUT 레이어 (-1 = 대기 없음) */ \
+	"uniform vec3  atmoCenter;\n" \
+	"uniform float atmoRadius;\n" \
+	"uniform float atmoTop;\n" \
+	"uniform int   hasNightMap;\n" \
+	"uniform sampler2D nightMap;\n" \
+	"uniform float cloudOpacity;\n" \
+	"uniform sampler2D cloudMap;\n" \
+	ECLIPSE_SHADOW_GLSL \
+	ATMOSPHERE_GLSL \
+	VIRTUAL_TEXTURE_GLSL \
+	"vec3 shadeSurfaceAlbedo(vec3 texColor, vec3 P, vec3 norm, vec2 uv, vec2 dx, vec2 dy){\n" \
+	"  if(isSun == 1) return texColor * emissionStrength;\n" \
+	"  if(cloudOpacity > 0.0)\n" \
+	"    texColor = mix(texColor, textureGrad(cloudMap, uv, dx, dy).rgb, cloudOpacity);\n" \
+	"  vec3 lightDir = normalize(lightPos - P);\n" \
+	"  float diff = max(dot(norm, lightDir), 0.0);\n" \
+	"  if(diff > 0.0) diff *= eclipseVisibility(P, lightPos);\n" \
+	"  vec3 sunColor = lightColor;\n" \
+	"  if(atmoLayer >= 0.0){\n" \
+	"    vec3 up = normalize(P - atmoCenter);\n" \
+	"    float mus = max(dot(up, lightDir), 0.02);\n" \
+	"    sunColor *= atmoTransmittance(1.0, mus, atmoTop, atmoLayer); // 대기 통과 햇빛 (노을)\n" \
+	"  }\n" \
+	"  vec3 diffuse = diff * sunColor * texColor;\n" \
+	"  vec3 ambient = 0.1 * texColor;\n" \
+	"  vec3 color = ambient + diffuse;\n" \
+	"  if(hasNightMap == 1){\n" \
+	"    float night = smoothstep(0.1, -0.15, dot(norm, lightDir));\n" \
+	"    color += textureGrad(nightMap, uv, dx, dy).rgb * night * 1.5;\n" \
+	"  }\n" \
+	"  return color;\n" \
+	"}\n" \
+	"vec3 shadeSurface(vec3 P, vec3 norm, vec2 uv, vec2 dx, vec2 dy){\n" \
+	"  vec3 albedo = (vtEnabled == 1) ? virtualTextureGrad(uv, dx, dy) : textureGrad(diffuseMap, uv, dx, dy).rgb;\n" \
+	"  return shadeSurfaceAlbedo(albedo, P, norm, uv, dx, dy);\n" \
+	"}\n" \
+	"void writeSurface(vec3 color, vec4 currClip, vec4 prevClip){\n" \
+	"  FragColor = vec4(color, ringAlpha);\n" \
+	"  float brightness = dot(color, vec3(0.2126,0.7152,0.0722));\n" \
+	"  if(brightness > 1.0) BrightColor = vec4(color,1.0);\n" \
+	"  else BrightColor = vec4(0.0,0.0,0.0,1.0);\n" \
+	"  Velocity = (currClip.xy / currClip.w - prevClip.xy / prevClip.w) * 0.5;\n" \
+	"}\n"
+
+// main -------------------------------------------------------------
+int main(int argc, char** argv)
 {
-	// -----------------------------
-	// 1) 행성의 원래(순수) 궤도 위치
-	// -----------------------------
-	glm::vec3 physPos = planet.positionAroundSun(simYears);
-
-	// -----------------------------
-	// 2) 위성 목록
-	// -----------------------------
-	const auto& sats = planet.satellites();
-
-	// 위성이 없다면 보정 없이 원래 위치 사용
-	if (sats.empty())
+	// 명령행 옵션 (헤드리스 벤치마크)
+	BenchmarkOptions bench;
+	if (!parseBenchmarkArgs(argc, argv, bench))
+		return -1;
+
+	// 천체 카탈로그: 컴파일된 .bcat 는 맵핑만 하고, 텍스트는 읽어서 같은 형식으로 컴파일
+	auto catalogStart = std::chrono::steady_clock::now();
+	std::unique_ptr<BodyCatalog> catalog = BodyCatalog::open(bench.catalogPath);
+	if (!catalog)
+		return -1;
 	{
-		outWorldPos = glm::vec3(
-			orbitToXZ * glm::vec4(physPos * scaleUnits, 1.0f));
-		return;
+		double catalogMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - catalogStart).count();
+		std::ostringstream msg; // 뒤의 벤치마크 출력 숫자 형식을 바꾸지 않도록 따로 서식
+		msg << std::fixed << std::setprecision(2) << catalogMs;
+		std::cout << "[Catalog] " << catalog->bodyCount() << " bodies, " << catalog->smallBodyCount()
+			<< " small bodies (" << (catalog->isMapped() ? "mapped .bcat" : "compiled from text") << ", "
+			<< catalog->sizeBytes() / 1024 << " KiB) in " << msg.str() << " ms\n";
 	}
 
-	// -----------------------------
-	// 3) 질량 정보
-	// -----------------------------
-	float Mp = planet.getParams().mass;  // 행성 질량
-
-	float sumMs = 0.0f;                  // 위성 총 질량
-	for (const auto& s : sats)
-		sumMs += s.getParams().mass;
-
-	// -----------------------------
-	// 4) 모든 위성 기반 barycenter offset 계산
-	// -----------------------------
-	glm::vec3 baryOffset(0.0f);
-
-	for (const auto& sat : sats)
+	if (bench.headless)
 	{
-		// (XY 기준) 위성의 상대 위치 (행성 중심)
-		glm::vec3 rel = sat.positionRelativeToPlanet(simYears);
-
-		// barycenter 기여량
-		baryOffset += -(sat.getParams().mass / (Mp + sumMs)) * rel;
+		// 디스플레이 없이 동작하는 null 플랫폼 + 오프스크린 컨텍스트 (EGL / OSMesa)
+		glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+		SCR_WIDTH = bench.width;
+		SCR_HEIGHT = bench.height;
 	}
 
-	// -----------------------------
-	// 5) XY → XZ 평면 회전 적용
-	// -----------------------------
-	glm::vec3 baryOffsetXZ =
-		glm::vec3(orbitToXZ * glm::vec4(baryOffset, 1.0f));
-
-	// -----------------------------
-	// 6) 최종적으로 보정된 행성의 worldPos
-	// -----------------------------
-	glm::vec3 planetWorldPos =
-		glm::vec3(orbitToXZ * glm::vec4(physPos, 1.0f)) +
-		baryOffsetXZ;
-
-	planetWorldPos *= scaleUnits;
-
-	outWorldPos = planetWorldPos;
-}
-
-// main -------------------------------------------------------------
-int main()
-{
 	if (!glfwInit())
 		return -1;
 
@@ -889,17 +616,27 @@ int main()
 	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
 	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
 
+	if (bench.headless)
+	{
+		glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+		glfwWindowHint(GLFW_CONTEXT_CREATION_API,
+			bench.contextApi == "osmesa" ? GLFW_OSMESA_CONTEXT_API : GLFW_EGL_CONTEXT_API);
+	}
+
 	GLFWwindow* window =
 		glfwCreateWindow(SCR_WIDTH, SCR_HEIGHT, "Solar System Full", nullptr, nullptr);
 	if (!window)
 	{
+		std::cerr << "Window / context creation failed\n";
 		glfwTerminate();
 		return -1;
 	}
 	glfwMakeContextCurrent(window);
 
 	glewExperimental = GL_TRUE;
-	if (glewInit() != GLEW_OK)
+	GLenum glewErr = glewInit();
+	// 헤드리스(EGL/OSMesa)에서는 GLX 디스플레이가 없어도 GL 함수 로드는 끝난 상태
+	if (glewErr != GLEW_OK && !(bench.headless && glewErr == GLEW_ERROR_NO_GLX_DISPLAY))
 	{
 		std::cerr << "GLEW init error\n";
 		return -1;
@@ -907,14 +644,34 @@ int main()
 
 	glEnable(GL_DEPTH_TEST);
 
-	glfwSetFramebufferSizeCallback(window, framebuffer_size_callback);
-	glfwSetCursorPosCallback(window, mouse_callback);
-	glfwSetScrollCallback(window, scroll_callback);
-	glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
+	if (!bench.headless)
+	{
+		glfwSetFramebufferSizeCallback(window, framebuffer_size_callback);
+		glfwSetCursorPosCallback(window, mouse_callback);
+		glfwSetScrollCallback(window, scroll_callback);
+		glfwSetWindowRefreshCallback(window, window_refresh_callback);
+		glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
+	}
+	else
+	{
+		std::cout << "[Benchmark] Renderer: " << glGetString(GL_RENDERER)
+			<< " / " << glGetString(GL_VERSION) << "\n";
+		simSpeedMultiplier = bench.simSpeed;
+	}
 
 	Camera cam(glm::vec3(0.0f, 80.0f, 230.0f));
 	gCamera = &cam;
 
+	// GPU 메모리 예산 (넘으면 텍스처 해상도를 줄여서 로드)
+	GpuRegistry::setBudget((size_t)bench.vramBudgetMB * 1024 * 1024);
+
+	// 프로그램 바이너리 캐시 (warm start 시 컴파일 생략)
+	Shader::setBinaryCache(bench.shaderCache);
+
+	// 셰이더는 컴파일/링크만 먼저 제출하고 (드라이버 병렬 컴파일),
+	// 텍스처 디코딩 / 태양계 구성 / FBO 생성이 끝난 뒤 한꺼번에 상태를 확인한다.
+	Shader::enableParallelCompile();
+
 	// Skybox shader -------------------------------------------------
 	const char* skyVert =
 		"#version 330 core\n"
@@ -937,7 +694,7 @@ int main()
 		"uniform sampler2D skyTex;\n"
 		"void main(){ FragColor = vec4(texture(skyTex, TexCoord).rgb, 1.0); }\n";
 
-	Shader skyShader(skyVert, skyFrag);
+	Shader skyShader(skyVert, skyFrag, true);
 
 	// Scene + bright pass shader -----------------------------------
 	const char* sceneVert =
@@ -948,13 +705,20 @@ int main()
 		"out vec3 FragPos;\n"
 		"out vec3 Normal;\n"
 		"out vec2 TexCoord;\n"
+		"out vec4 CurrClip;\n"               // 움직임 벡터용 (지터 없음)
+		"out vec4 PrevClip;\n"
 		"uniform mat4 model;\n"
 		"uniform mat4 view;\n"
 		"uniform mat4 proj;\n"
+		"uniform mat4 prevModel;\n"          // 지난 프레임 모델 행렬
+		"uniform mat4 currViewProj;\n"
+		"uniform mat4 prevViewProj;\n"
 		"void main(){\n"
 		"  FragPos = vec3(model * vec4(aPos,1.0));\n"
 		"  Normal  = mat3(transpose(inverse(model))) * aNormal;\n"
 		"  TexCoord= aTex;\n"
+		"  CurrClip = currViewProj * vec4(FragPos,1.0);\n"
+		"  PrevClip = prevViewProj * prevModel * vec4(aPos,1.0);\n"
 		"  gl_Position = proj * view * vec4(FragPos,1.0);\n"
 		"}\n";
 
@@ -963,46 +727,270 @@ int main()
 		"in vec3 FragPos;\n"
 		"in vec3 Normal;\n"
 		"in vec2 TexCoord;\n"
+		"in vec4 CurrClip;\n"
+		"in vec4 PrevClip;\n"
+		SCENE_SURFACE_GLSL
+		"void main(){\n"
+		"  vec3 color = shadeSurface(FragPos, normalize(Normal), TexCoord, dFdx(TexCoord), dFdy(TexCoord));\n"
+		"  writeSurface(color, CurrClip, PrevClip);\n"
+		"}\n";
+
+	Shader sceneShader(sceneVert, sceneFrag, true);
+
+	// ================================
+	// Sphere Impostor Shader (작게 보이는 천체)
+	// ================================
+	// 인스턴싱: 사각형 모서리 + (모델, 지난 프레임 모델) 행렬
+	const char* impostorVert =
+		"#version 330 core\n"
+		"layout(location=0) in vec2 aCorner;\n"
+		"layout(location=1) in mat4 aModel;\n"
+		"layout(location=5) in mat4 aPrevModel;\n"
+		"out vec3 RayDir;\n"                 // 카메라 → 사각형 위 점 (월드)
+		"flat out mat4 InvModel;\n"
+		"flat out mat4 PrevModel;\n"
+		"flat out vec4 Sphere;\n"            // 중심, 반지름 (월드)
+		"uniform mat4 view;\n"
+		"uniform mat4 proj;\n"
+		"uniform vec3 viewPos;\n"
+		"void main(){\n"
+		"  vec3 c = aModel[3].xyz;\n"
+		"  float r = length(aModel[0].xyz);\n"
+		"  vec3 toEye = viewPos - c;\n"
+		"  float d = length(toEye);\n"
+		"  vec3 f = toEye / d;\n"
+		"  vec3 up0 = abs(f.y) > 0.99 ? vec3(1.0, 0.0, 0.0) : vec3(0.0, 1.0, 0.0);\n"
+		"  vec3 right = normalize(cross(up0, f));\n"
+		"  vec3 up = cross(f, right);\n"
+		// 중심을 지나는 평면에서 실루엣(접선 원뿔)을 덮는 크기
+		"  float s = r * d / sqrt(max(d * d - r * r, 1e-6)) * 1.01;\n"
+		"  vec3 corner = c + (right * aCorner.x + up * aCorner.y) * s;\n"
+		"  RayDir = corner - viewPos;\n"
+		"  InvModel = inverse(aModel);\n"
+		"  PrevModel = aPrevModel;\n"
+		"  Sphere = vec4(c, r);\n"
+		"  gl_Position = proj * view * vec4(corner, 1.0);\n"
+		"}\n";
+
+	const char* impostorFrag =
+		"#version 330 core\n"
+		"in vec3 RayDir;\n"
+		"flat in mat4 InvModel;\n"
+		"flat in mat4 PrevModel;\n"
+		"flat in vec4 Sphere;\n"
+		"uniform mat4 view;\n"
+		"uniform mat4 proj;\n"
+		"uniform mat4 currViewProj;\n"
+		"uniform mat4 prevViewProj;\n"
+		SCENE_SURFACE_GLSL
+		"void main(){\n"
+		// 객체 공간에서 단위 구와 교차 (t 는 월드 광선과 같은 값)
+		"  vec3 ro = (InvModel * vec4(viewPos, 1.0)).xyz;\n"
+		"  vec3 rd = (InvModel * vec4(RayDir, 0.0)).xyz;\n"
+		"  float a = dot(rd, rd);\n"
+		"  float b = dot(ro, rd);\n"
+		"  float disc = b * b - a * (dot(ro, ro) - 1.0);\n"
+		"  bool miss = disc < 0.0;\n"
+		"  float t = (-b - sqrt(max(disc, 0.0))) / a;\n"
+		"  vec3 p = normalize(ro + t * rd);\n"
+		"  vec3 P = viewPos + t * RayDir;\n"
+		// createSphere 와 같은 UV: u = atan(z, x) / 2pi, v = acos(y) / pi
+		"  vec2 uv = vec2(fract(atan(p.z, p.x) * 0.15915494), acos(clamp(p.y, -1.0, 1.0)) * 0.31830989);\n"
+		// 경도 이음새(u = 0/1)에서 미분이 튀지 않게 반 바퀴 돌린 u 와 비교
+		"  vec2 dx = dFdx(uv), dy = dFdy(uv);\n"
+		"  float u2 = fract(uv.x + 0.5);\n"
+		"  float dx2 = dFdx(u2), dy2 = dFdy(u2);\n"
+		"  if(abs(dx2) + abs(dy2) < abs(dx.x) + abs(dy.x)){ dx.x = dx2; dy.x = dy2; }\n"
+		"  if(miss) discard;\n"
+		"  vec4 clip = proj * view * vec4(P, 1.0);\n"
+		"  gl_FragDepth = clip.z / clip.w * 0.5 + 0.5;\n"
+		"  vec3 color = shadeSurface(P, normalize(P - Sphere.xyz), uv, dx, dy);\n"
+		"  writeSurface(color, currViewProj * vec4(P, 1.0), prevViewProj * PrevModel * vec4(p, 1.0));\n"
+		"}\n";
+
+	Shader impostorShader(impostorVert, impostorFrag, true);
+
+	// ================================
+	// Asteroid Belt Shader (AsteroidBelt, 점 스프라이트)
+	// ================================
+	// 정점 = 소천체 궤도 요소 (a, e, i, Ω) / (ω, M0, 주기, H), 위치는 Orbit.h keplerPosition 과 같은 식
+	const char* beltVert =
+		"#version 330 core\n"
+		"layout(location=0) in vec4 aElem0;\n"
+		"layout(location=1) in vec4 aElem1;\n"
+		"out vec3 WorldPos;\n"
+		"out float Intensity;\n"             // 1 픽셀보다 작으면 덮는 면적만큼 어둡게
+		"flat out float PointSize;\n"
+		"flat out vec3 LightDirView;\n"      // 햇빛 방향 (뷰 공간)
+		"uniform mat4 view;\n"
+		"uniform mat4 proj;\n"
+		"uniform vec3 viewPos;\n"
+		"uniform vec3 lightPos;\n"
+		"uniform float simYears;\n"
+		"uniform float worldScale;\n"
+		"uniform float pixelsPerUnit;\n"
+		"uniform float maxPointSize;\n"
+		"const float TWO_PI = 6.28318531;\n"
+		"void main(){\n"
+		"  float e = clamp(aElem0.y, 0.0, 0.99);\n"
+		"  float M = mod(radians(aElem1.y) + TWO_PI / aElem1.z * simYears, TWO_PI);\n"
+		"  float E = M;\n"
+		"  for(int k = 0; k < 6; k++) E -= (E - e * sin(E) - M) / (1.0 - e * cos(E));\n"
+		"  float r = aElem0.x * (1.0 - e * cos(E));\n"
+		"  float v = atan(sqrt(1.0 - e * e) * sin(E), cos(E) - e);\n"
+		"  float T = radians(aElem1.x) + v;\n"
+		"  float I = radians(aElem0.z), O = radians(aElem0.w);\n"
+		"  vec3 p = r * vec3(cos(O) * cos(T) - sin(O) * sin(T) * cos(I),\n"
+		"                    sin(O) * cos(T) + cos(O) * sin(T) * cos(I),\n"
+		"                    sin(T) * sin(I));\n"
+		"  WorldPos = vec3(p.x, p.z, -p.y) * worldScale;\n"   // orbitToXZ (X 축 -90도)
+		// 절대등급 H 로 반지름 추정 (H = 10 → 0.02, 5 등급마다 10 배)
+		"  float radius = 0.02 * pow(10.0, -0.2 * (aElem1.w - 10.0)) * worldScale;\n"
+		"  float pixels = 2.0 * radius * pixelsPerUnit / max(length(viewPos - WorldPos), 1e-3);\n"
+		"  PointSize = clamp(pixels, 1.0, maxPointSize);\n"
+		"  Intensity = clamp(pixels * pixels, 0.03, 1.0);\n"
+		"  LightDirView = normalize(mat3(view) * (lightPos - WorldPos));\n"
+		"  gl_PointSize = PointSize;\n"
+		"  gl_Position = proj * view * vec4(WorldPos, 1.0);\n"
+		"}\n";
+
+	const char* beltFrag =
+		"#version 330 core\n"
+		"in vec3 WorldPos;\n"
+		"in float Intensity;\n"
+		"flat in float PointSize;\n"
+		"flat in vec3 LightDirView;\n"
 		"layout(location=0) out vec4 FragColor;\n"
 		"layout(location=1) out vec4 BrightColor;\n"
-		"uniform sampler2D diffuseMap;\n"
-		"uniform vec3 lightPos;\n"
+		"layout(location=2) out vec2 Velocity;\n"
 		"uniform vec3 lightColor;\n"
-		"uniform vec3 viewPos;\n"
-		"uniform int  isSun;\n"
-		"uniform float emissionStrength;\n"
-		"uniform float ringAlpha;\n"
+		"uniform mat4 currViewProj;\n"
+		"uniform mat4 prevViewProj;\n"
 		"void main(){\n"
-		"  vec3 texColor = texture(diffuseMap, TexCoord).rgb;\n"
-		"  vec3 color;\n"
-		"  if(isSun == 1){\n"
-		"    color = texColor * emissionStrength;\n"
-		"  } else {\n"
-		"    vec3 norm = normalize(Normal);\n"
-		"    vec3 lightDir = normalize(lightPos - FragPos);\n"
-		"    float diff = max(dot(norm, lightDir), 0.0);\n"
-		"    vec3 diffuse = diff * lightColor * texColor;\n"
-		"    vec3 ambient = 0.1 * texColor;\n"
-		"    color = ambient + diffuse;\n"
+		// 몇 픽셀 이상이면 점 안을 구로 보고 음영 (작은 임포스터), 그보다 작으면 평균 밝기
+		"  float diff = 0.5;\n"
+		"  if(PointSize > 2.5){\n"
+		"    vec2 q = gl_PointCoord * 2.0 - 1.0;\n"
+		"    float rr = dot(q, q);\n"
+		"    if(rr > 1.0) discard;\n"
+		"    diff = max(dot(vec3(q.x, -q.y, sqrt(1.0 - rr)), LightDirView), 0.0);\n"
 		"  }\n"
-		"  FragColor = vec4(color, ringAlpha);\n"
-		"  float brightness = dot(color, vec3(0.2126,0.7152,0.0722));\n"
-		"  if(brightness > 1.0) BrightColor = vec4(color,1.0);\n"
-		"  else BrightColor = vec4(0.0,0.0,0.0,1.0);\n"
+		"  vec3 albedo = vec3(0.55, 0.5, 0.45);\n"
+		"  FragColor = vec4(albedo * (0.05 + diff * lightColor) * Intensity, 1.0);\n"
+		"  BrightColor = vec4(0.0, 0.0, 0.0, 1.0);\n"
+		"  vec4 currClip = currViewProj * vec4(WorldPos, 1.0);\n"
+		"  vec4 prevClip = prevViewProj * vec4(WorldPos, 1.0);\n"
+		"  Velocity = (currClip.xy / currClip.w - prevClip.xy / prevClip.w) * 0.5;\n"
 		"}\n";
 
-	Shader sceneShader(sceneVert, sceneFrag);
+	Shader beltShader(beltVert, beltFrag, true);
 
-	sceneShader.use();
-	sceneShader.setFloat("ringAlpha", 1.0f);   // 기본값: 불투명
+	// ================================
+	// Terrain Shader (근접 지형, PlanetTerrain)
+	// ================================
+	// 격자 32x32 (PlanetTerrain::GRID), 높이 타일 65x65 (정점 = 짝수 텍셀)
+	const char* terrainVert =
+		"#version 330 core\n"
+		"layout(location=0) in vec2 aGrid;\n"    // 패치 안 좌표 0~1
+		"layout(location=1) in vec4 aNode;\n"    // 면 안의 원점 u, v / 크기 / 타일 레이어
+		"layout(location=2) in vec4 aInfo;\n"    // 면 번호 / morph 시작 / morph 끝
+		"out vec3 FragPos;\n"
+		"out vec3 LocalPos;\n"
+		"out vec2 PatchUV;\n"
+		"out vec3 TanU;\n"                       // 객체 공간 dP/du, dP/dv (높이 0 기준)
+		"out vec3 TanV;\n"
+		"flat out float Layer;\n"
+		"out vec4 CurrClip;\n"
+		"out vec4 PrevClip;\n"
+		"uniform mat4 model;\n"
+		"uniform mat4 prevModel;\n"
+		"uniform mat4 view;\n"
+		"uniform mat4 proj;\n"
+		"uniform mat4 currViewProj;\n"
+		"uniform mat4 prevViewProj;\n"
+		"uniform vec3 camLocal;\n"
+		"uniform float heightScale;\n"
+		"uniform sampler2DArray heightTiles;\n"
+		// 정육면체 면 기준축: PlanetTerrain.cpp 의 FACE_N / FACE_U / FACE_V 와 같은 순서
+		"const vec3 FACE_N[6] = vec3[6](vec3(1,0,0), vec3(-1,0,0), vec3(0,1,0), vec3(0,-1,0), vec3(0,0,1), vec3(0,0,-1));\n"
+		"const vec3 FACE_U[6] = vec3[6](vec3(0,0,-1), vec3(0,0,1), vec3(1,0,0), vec3(1,0,0), vec3(1,0,0), vec3(-1,0,0));\n"
+		"const vec3 FACE_V[6] = vec3[6](vec3(0,1,0), vec3(0,1,0), vec3(0,0,-1), vec3(0,0,1), vec3(0,1,0), vec3(0,1,0));\n"
+		"vec3 cubePoint(int f, vec2 uv){ return FACE_N[f] + (2.0*uv.x-1.0)*FACE_U[f] + (2.0*uv.y-1.0)*FACE_V[f]; }\n"
+		"float heightAt(vec2 s, float layer){ return textureLod(heightTiles, vec3((s*64.0+0.5)/65.0, layer), 0.0).r; }\n"
+		"void main(){\n"
+		"  int f = int(aInfo.x + 0.5);\n"
+		"  vec3 p0 = normalize(cubePoint(f, aNode.xy + aGrid * aNode.z));\n"
+		"  float d = distance(camLocal, p0 * (1.0 + heightScale * heightAt(aGrid, aNode.w)));\n"
+		// CDLOD morph: 범위 끝에서 홀수 정점이 아래쪽 짝수 정점과 겹침 (= 한 단계 거친 격자)
+		"  float k = clamp((d - aInfo.y) / (aInfo.z - aInfo.y), 0.0, 1.0);\n"
+		"  vec2 g = aGrid * 32.0;\n"
+		"  vec2 s = (g - fract(g * 0.5) * 2.0 * k) / 32.0;\n"
+		"  vec3 q = cubePoint(f, aNode.xy + s * aNode.z);\n"
+		"  float ql = length(q);\n"
+		"  vec3 p = q / ql;\n"
+		"  float scale = 2.0 * aNode.z / ql;\n"
+		"  TanU = (FACE_U[f] - p * dot(p, FACE_U[f])) * scale;\n"
+		"  TanV = (FACE_V[f] - p * dot(p, FACE_V[f])) * scale;\n"
+		"  vec4 local = vec4(p * (1.0 + heightScale * heightAt(s, aNode.w)), 1.0);\n"
+		"  LocalPos = local.xyz;\n"
+		"  PatchUV = s;\n"
+		"  Layer = aNode.w;\n"
+		"  vec4 world = model * local;\n"
+		"  FragPos = world.xyz;\n"
+		"  CurrClip = currViewProj * world;\n"
+		"  PrevClip = prevViewProj * prevModel * local;\n"
+		"  gl_Position = proj * view * world;\n"
+		"}\n";
+
+	const char* terrainFrag =
+		"#version 330 core\n"
+		"in vec3 FragPos;\n"
+		"in vec3 LocalPos;\n"
+		"in vec2 PatchUV;\n"
+		"in vec3 TanU;\n"
+		"in vec3 TanV;\n"
+		"flat in float Layer;\n"
+		"in vec4 CurrClip;\n"
+		"in vec4 PrevClip;\n"
+		"uniform mat4 model;\n"
+		"uniform float heightScale;\n"
+		"uniform sampler2DArray albedoTiles;\n"
+		"uniform sampler2DArray heightTiles;\n"
+		SCENE_SURFACE_GLSL
+		"void main(){\n"
+		// 법선: 높이 타일 중앙 차분 (패치 좌표 기준 기울기) → 높이 반영한 접선의 외적
+		"  vec2 hc = (PatchUV * 64.0 + 0.5) / 65.0;\n"
+		"  const float e = 1.0 / 65.0;\n"
+		"  float h = texture(heightTiles, vec3(hc, Layer)).r;\n"
+		"  float hu = (texture(heightTiles, vec3(hc + vec2(e, 0.0), Layer)).r - texture(heightTiles, vec3(hc - vec2(e, 0.0), Layer)).r) * 32.0;\n"
+		"  float hv = (texture(heightTiles, vec3(hc + vec2(0.0, e), Layer)).r - texture(heightTiles, vec3(hc - vec2(0.0, e), Layer)).r) * 32.0;\n"
+		"  vec3 p = normalize(LocalPos);\n"
+		"  float r = 1.0 + heightScale * h;\n"
+		"  vec3 tu = TanU * r + p * heightScale * hu;\n"
+		"  vec3 tv = TanV * r + p * heightScale * hv;\n"
+		"  vec3 N = normalize(mat3(model) * normalize(cross(tu, tv)));\n"
+		// 가상 텍스처 / 야간 / 구름용 등장방형 UV (구 메쉬와 같은 배치, 이음새 미분 보정)
+		"  vec2 uv = vec2(fract(atan(p.z, p.x) * 0.15915494), acos(clamp(p.y, -1.0, 1.0)) * 0.31830989);\n"
+		"  vec2 dx = dFdx(uv), dy = dFdy(uv);\n"
+		"  float u2 = fract(uv.x + 0.5);\n"
+		"  float dx2 = dFdx(u2), dy2 = dFdy(u2);\n"
+		"  if(abs(dx2) + abs(dy2) < abs(dx.x) + abs(dy.x)){ dx.x = dx2; dy.x = dy2; }\n"
+		// 색: 가상 텍스처 행성은 타일 캐시 (원본 해상도), 아니면 기본 텍스처로 구운 지형 색 타일
+		"  vec3 albedo = (vtEnabled == 1) ? virtualTextureGrad(uv, dx, dy) : texture(albedoTiles, vec3(PatchUV, Layer)).rgb;\n"
+		"  vec3 color = shadeSurfaceAlbedo(albedo, FragPos, N, uv, dx, dy);\n"
+		"  writeSurface(color, CurrClip, PrevClip);\n"
+		"}\n";
+
+	Shader terrainShader(terrainVert, terrainFrag, true);
 
 	// ================================
-	// Ring Shader (고리 전용)
+	// Virtual Texture Feedback Shader (저해상도, 가상 텍스처 행성만)
 	// ================================
-	const char* ringVert =
+	// 픽셀마다 필요한 (페이지 x, y / 레벨 / 텍스처 번호 + 1) 기록
+	const char* vtFeedbackVert =
 		"#version 330 core\n"
 		"layout(location=0) in vec3 aPos;\n"
-		"layout(location=1) in vec2 aTex;\n"
+		"layout(location=2) in vec2 aTex;\n"
 		"out vec2 TexCoord;\n"
 		"uniform mat4 model;\n"
 		"uniform mat4 view;\n"
@@ -1012,22 +1000,128 @@ int main()
 		"  gl_Position = proj * view * model * vec4(aPos,1.0);\n"
 		"}\n";
 
+	const char* vtFeedbackFrag =
+		"#version 330 core\n"
+		"in vec2 TexCoord;\n"
+		"out vec4 FragColor;\n"
+		VIRTUAL_TEXTURE_GLSL
+		"uniform float vtIndex;\n"
+		"uniform float vtLodBias;\n"   // log2(장면 해상도 / 피드백 해상도)
+		"void main(){\n"
+		"  float lod = clamp(floor(vtLod(dFdx(TexCoord), dFdy(TexCoord)) - vtLodBias), 0.0, vtInfo.z);\n"
+		"  vec2 page = floor(vtWrap(TexCoord) * vtInfo.xy / (128.0 * exp2(lod)));\n"
+		"  FragColor = vec4(page, lod, vtIndex + 1.0) / 255.0;\n"
+		"}\n";
+
+	Shader vtFeedbackShader(vtFeedbackVert, vtFeedbackFrag, true);
+
+	// ================================
+	// Ring Shader (고리 전용)
+	// ================================
+	// 인스턴싱: 반지름 1 공용 고리 + 행성별 (내경, 외경, 투명도, 레이어)
+	const char* ringVert =
+		"#version 330 core\n"
+		"layout(location=0) in vec2 aDir;\n"      // (cos, sin)
+		"layout(location=1) in vec2 aTex;\n"      // u = 반지름 방향, v = 둘레
+		"layout(location=2) in vec4 aRing;\n"     // 내경, 외경, 투명도, 레이어
+		"layout(location=3) in mat4 aModel;\n"
+		"out vec2 TexCoord;\n"
+		"out vec3 WorldPos;\n"
+		"flat out float Layer;\n"
+		"flat out float Alpha;\n"
+		"uniform mat4 view;\n"
+		"uniform mat4 proj;\n"
+		"void main(){\n"
+		"  float r = mix(aRing.x, aRing.y, aTex.x);\n"
+		"  vec3 pos = vec3(aDir.x * r, 0.0, aDir.y * r);\n"
+		"  TexCoord = aTex;\n"
+		"  Alpha = aRing.z;\n"
+		"  Layer = aRing.w;\n"
+		"  WorldPos = vec3(aModel * vec4(pos,1.0));\n"
+		"  gl_Position = proj * view * vec4(WorldPos,1.0);\n"
+		"}\n";
+
 	const char* ringFrag =
 		"#version 330 core\n"
 		"in vec2 TexCoord;\n"
+		"in vec3 WorldPos;\n"
+		"flat in float Layer;\n"
+		"flat in float Alpha;\n"
 		"layout(location=0) out vec4 FragColor;\n"
 		"layout(location=1) out vec4 BrightColor;\n"
-		"uniform sampler2D ringTex;\n"
-		"uniform float alpha;\n"
+		"uniform sampler2DArray ringTex;\n"
+		"uniform vec3 lightPos;\n"
+		ECLIPSE_SHADOW_GLSL
 		"void main(){\n"
-		"  vec4 c = texture(ringTex, TexCoord);\n"
+		"  vec4 c = texture(ringTex, vec3(TexCoord, Layer));\n"
 		"  if(c.a < 0.05) discard;\n"
-		"  vec4 col = vec4(c.rgb, c.a * alpha);\n"
+		"  c.rgb *= mix(0.1, 1.0, eclipseVisibility(WorldPos, lightPos)); // 행성/위성 그림자\n"
+		"  vec4 col = vec4(c.rgb, c.a * Alpha);\n"
 		"  FragColor = col;\n"
 		"  BrightColor = vec4(0.0, 0.0, 0.0, 1.0); // ★ 고리는 항상 Bloom 0\n"
 		"}\n";
 
-	Shader ringShader(ringVert, ringFrag);
+	Shader ringShader(ringVert, ringFrag, true);
+
+	// ================================
+	// Atmosphere Shader (대기 껍질)
+	// ================================
+	// 껍질 구를 그리고 프래그먼트마다 대기 입구를 해석적으로 구해 LUT 조회
+	const char* atmosphereVert =
+		"#version 330 core\n"
+		"layout(location=0) in vec3 aPos;\n"
+		"out vec3 WorldPos;\n"
+		"uniform mat4 model;\n"
+		"uniform mat4 view;\n"
+		"uniform mat4 proj;\n"
+		"void main(){\n"
+		"  WorldPos = vec3(model * vec4(aPos,1.0));\n"
+		"  gl_Position = proj * view * vec4(WorldPos,1.0);\n"
+		"}\n";
+
+	const char* atmosphereFrag =
+		"#version 330 core\n"
+		"in vec3 WorldPos;\n"
+		"layout(location=0) out vec4 FragColor;\n"
+		"layout(location=1) out vec4 BrightColor;\n"
+		"uniform vec3 camPos;\n"
+		"uniform vec3 lightPos;\n"
+		"uniform vec3 atmoCenter;\n"
+		"uniform float atmoRadius;\n"
+		"uniform float atmoTop;\n"
+		"uniform float atmoLayer;\n"
+		"uniform vec3 betaR;\n"
+		"uniform float mieG;\n"
+		"uniform float sunIntensity;\n"
+		"uniform sampler2DArray inscatterLUT;\n"
+		ATMOSPHERE_GLSL
+		"const float PI = 3.14159265;\n"
+		"void main(){\n"
+		"  vec3 o = (camPos - atmoCenter) / atmoRadius;\n"   // 행성 반지름 = 1 단위
+		"  vec3 d = normalize(WorldPos - camPos);\n"
+		"  float b = dot(o, d);\n"
+		"  float disc = b * b - dot(o, o) + atmoTop * atmoTop;\n"
+		"  if(disc < 0.0) discard;\n"
+		"  vec3 x = o + d * max(-b - sqrt(disc), 0.0);\n"    // 대기 입구 (카메라가 안이면 카메라 위치)
+		"  float r = length(x);\n"
+		"  vec3 s = normalize(lightPos - atmoCenter);\n"
+		"  float mu = dot(x, d) / r;\n"
+		"  float mus = dot(x, s) / r;\n"
+		"  float nu = dot(d, s);\n"
+		"  vec4 S = texture(inscatterLUT, vec3(atmoMuToU(mu, r), 0.5 * (mus + 1.0), atmoLayer));\n"
+		"  vec3 mie = S.rgb * (S.a / max(S.r, 1e-4)) * (betaR.r / betaR);\n"
+		"  float g = mieG;\n"
+		"  float phaseR = 3.0 / (16.0 * PI) * (1.0 + nu * nu);\n"
+		"  float phaseM = 3.0 / (8.0 * PI) * (1.0 - g * g) * (1.0 + nu * nu)\n"
+		"               / ((2.0 + g * g) * pow(1.0 + g * g - 2.0 * g * nu, 1.5));\n"
+		"  vec3 color = sunIntensity * (S.rgb * phaseR + mie * phaseM);\n"
+		"  vec3 T = atmoTransmittance(r, mu, atmoTop, atmoLayer);\n"
+		"  float alpha = 1.0 - dot(T, vec3(1.0 / 3.0));\n"
+		"  FragColor = vec4(color, alpha);\n"
+		"  BrightColor = vec4(0.0, 0.0, 0.0, alpha);\n"
+		"}\n";
+
+	Shader atmosphereShader(atmosphereVert, atmosphereFrag, true);
 
 	// Orbit / trail line shader ------------------------------------
 	const char* lineVert =
@@ -1044,7 +1138,7 @@ int main()
 		"uniform vec3 color;\n"
 		"void main(){ FragColor = vec4(color,1.0); }\n";
 
-	Shader lineShader(lineVert, lineFrag);
+	Shader lineShader(lineVert, lineFrag, true);
 
 	// Blur shader ---------------------------------------------------
 	const char* quadVert =
@@ -1076,7 +1170,7 @@ int main()
 		"  FragColor = vec4(result,1.0);\n"
 		"}\n";
 
-	Shader blurShader(quadVert, blurFrag);
+	Shader blurShader(quadVert, blurFrag, true);
 
 	// Final composite shader ---------------------------------------
 	const char* finalFrag =
@@ -1085,17 +1179,182 @@ int main()
 		"out vec4 FragColor;\n"
 		"uniform sampler2D sceneTex;\n"
 		"uniform sampler2D bloomTex;\n"
-		"uniform float exposure;\n"
+		"uniform float exposure;\n"           // 고정 노출 (자동 노출 꺼짐)
+		"uniform int autoExposure;\n"
+		"uniform sampler2D exposureTex;\n"    // 자동 노출 결과 (1x1)
 		"void main(){\n"
 		"  vec3 hdr   = texture(sceneTex, TexCoord).rgb;\n"
 		"  vec3 bloom = texture(bloomTex, TexCoord).rgb;\n"
 		"  vec3 col   = hdr + bloom;\n"
-		"  vec3 mapped = vec3(1.0) - exp(-col * exposure);\n"
+		"  float e = (autoExposure == 1) ? texelFetch(exposureTex, ivec2(0), 0).r : exposure;\n"
+		"  vec3 mapped = vec3(1.0) - exp(-col * e);\n"
 		"  mapped = pow(mapped, vec3(1.0/2.2));\n"
 		"  FragColor = vec4(mapped,1.0);\n"
 		"}\n";
 
-	Shader finalShader(quadVert, finalFrag);
+	Shader finalShader(quadVert, finalFrag, true);
+
+	// Inset composite shader (추적 중 보조 화면) ----------------------
+	const char* insetFrag =
+		"#version 330 core\n"
+		"in vec2 TexCoord;\n"
+		"out vec4 FragColor;\n"
+		"uniform sampler2D insetTex;\n"
+		"uniform float exposure;\n"
+		"uniform int autoExposure;\n"
+		"uniform sampler2D exposureTex;\n"
+		"uniform float borderPx;\n"
+		"void main(){\n"
+		"  vec2 size = vec2(textureSize(insetTex, 0));\n"
+		"  vec2 px = TexCoord * size;\n"
+		"  if(min(px.x, px.y) < borderPx || px.x > size.x - borderPx || px.y > size.y - borderPx){\n"
+		"    FragColor = vec4(0.6, 0.6, 0.6, 1.0);\n"
+		"    return;\n"
+		"  }\n"
+		"  vec3 col = texture(insetTex, TexCoord).rgb;\n"
+		"  float e = (autoExposure == 1) ? texelFetch(exposureTex, ivec2(0), 0).r : exposure;\n"
+		"  vec3 mapped = vec3(1.0) - exp(-col * e);\n"
+		"  FragColor = vec4(pow(mapped, vec3(1.0/2.2)), 1.0);\n"
+		"}\n";
+
+	Shader insetShader(quadVert, insetFrag, true);
+
+	// Temporal upscale resolve shader ---------------------------------
+	// 저해상도 지터 장면 + 움직임 벡터 + 히스토리 → 출력 해상도 HDR
+	const char* upscaleFrag =
+		"#version 330 core\n"
+		"in vec2 TexCoord;\n"
+		"out vec4 FragColor;\n"
+		"uniform sampler2D currentTex;\n"
+		"uniform sampler2D velocityTex;\n"
+		"uniform sampler2D depthTex;\n"
+		"uniform sampler2D historyTex;\n"
+		"uniform vec2 jitterUV;\n"           // 지터 이미지에서 이 픽셀 내용이 있는 위치까지
+		"uniform mat4 reprojection;\n"       // 지난 viewProj * 현재 viewProj 역행렬
+		"uniform float historyWeight;\n"
+		"float luma(vec3 c){ return dot(c, vec3(0.2126,0.7152,0.0722)); }\n"
+		"void main(){\n"
+		"  vec2 lowSize = vec2(textureSize(currentTex, 0));\n"
+		"  vec2 uv = TexCoord + jitterUV;\n"
+		"  ivec2 center = ivec2(uv * lowSize);\n"
+		"  vec3 cur = texture(currentTex, uv).rgb;\n"
+		// 3x3 이웃: 색 평균/분산 + 가장 가까운 깊이의 움직임 벡터 (가장자리 확장)
+		"  vec3 m1 = vec3(0.0), m2 = vec3(0.0);\n"
+		"  float closest = 1.0;\n"
+		"  ivec2 closestTexel = center;\n"
+		"  for(int y=-1;y<=1;y++) for(int x=-1;x<=1;x++){\n"
+		"    ivec2 t = clamp(center + ivec2(x,y), ivec2(0), ivec2(lowSize) - 1);\n"
+		"    vec3 c = texelFetch(currentTex, t, 0).rgb;\n"
+		"    m1 += c; m2 += c * c;\n"
+		"    float d = texelFetch(depthTex, t, 0).r;\n"
+		"    if(d < closest){ closest = d; closestTexel = t; }\n"
+		"  }\n"
+		"  vec2 vel = texelFetch(velocityTex, closestTexel, 0).rg;\n"
+		"  if(vel.x < -100.0){\n"               // 천체가 기록하지 않은 곳: 카메라 움직임만
+		"    vec4 prev = reprojection * vec4(TexCoord * 2.0 - 1.0, closest * 2.0 - 1.0, 1.0);\n"
+		"    vel = TexCoord - (prev.xy / prev.w * 0.5 + 0.5);\n"
+		"  }\n"
+		"  vec2 prevUV = TexCoord - vel;\n"
+		"  float w = historyWeight;\n"
+		"  if(any(lessThan(prevUV, vec2(0.0))) || any(greaterThan(prevUV, vec2(1.0)))) w = 0.0;\n"
+		"  w *= clamp(1.0 - length(vel * lowSize) * 0.05, 0.5, 1.0);\n"   // 빠르게 움직이면 현재 값 비중을 늘림
+		// 분산 범위로 제한 (최소/최대 상자보다 좁아서 경계의 잔상이 덜 남음)
+		"  m1 /= 9.0; m2 /= 9.0;\n"
+		"  vec3 sigma = sqrt(max(m2 - m1 * m1, vec3(0.0)));\n"
+		"  vec3 hist = clamp(texture(historyTex, prevUV).rgb, m1 - 1.25 * sigma, m1 + 1.25 * sigma);\n"
+		// 밝기 역수 가중: 태양 같은 HDR 밝은 점이 히스토리를 지배하지 않게
+		"  float wc = (1.0 - w) / (1.0 + luma(cur));\n"
+		"  float wh = w / (1.0 + luma(hist));\n"
+		"  FragColor = vec4((cur * wc + hist * wh) / max(wc + wh, 1e-5), 1.0);\n"
+		"}\n";
+
+	Shader upscaleShader(quadVert, upscaleFrag, true);
+
+	// Auto exposure shaders ----------------------------------------
+	// (1) HDR → 1/8 해상도 휘도 (블록 안 4점 평균)
+	const char* exposureLumFrag =
+		"#version 330 core\n"
+		"in vec2 TexCoord;\n"
+		"out float Luminance;\n"
+		"uniform sampler2D sceneTex;\n"
+		"void main(){\n"
+		"  vec2 texel = 2.0 / vec2(textureSize(sceneTex, 0));\n"
+		"  vec3 c = texture(sceneTex, TexCoord + vec2(-texel.x, -texel.y)).rgb\n"
+		"         + texture(sceneTex, TexCoord + vec2( texel.x, -texel.y)).rgb\n"
+		"         + texture(sceneTex, TexCoord + vec2(-texel.x,  texel.y)).rgb\n"
+		"         + texture(sceneTex, TexCoord + vec2( texel.x,  texel.y)).rgb;\n"
+		"  Luminance = dot(c * 0.25, vec3(0.2126, 0.7152, 0.0722));\n"
+		"}\n";
+
+	// (2) 축소 픽셀 하나 = 점 하나 → log2 휘도 구간 위치로 보내 가산 누적
+	const char* exposureHistVert =
+		"#version 330 core\n"
+		"uniform sampler2D lumTex;\n"
+		"uniform int lumWidth;\n"
+		"uniform int bins;\n"
+		"uniform float minLog2;\n"
+		"uniform float rangeLog2;\n"
+		"void main(){\n"
+		"  ivec2 p = ivec2(gl_VertexID % lumWidth, gl_VertexID / lumWidth);\n"
+		"  float L = texelFetch(lumTex, p, 0).r;\n"
+		"  float bin = 0.0;\n"   // 0 번 구간 = 빈 공간
+		"  if(L > 1e-5){\n"
+		"    float t = clamp((log2(L) - minLog2) / rangeLog2, 0.0, 0.9999);\n"
+		"    bin = 1.0 + floor(t * float(bins - 1));\n"
+		"  }\n"
+		"  gl_Position = vec4((bin + 0.5) / float(bins) * 2.0 - 1.0, 0.0, 0.0, 1.0);\n"
+		"}\n";
+
+	const char* exposureHistFrag =
+		"#version 330 core\n"
+		"out float Count;\n"
+		"void main(){ Count = 1.0; }\n";
+
+	// (3) 히스토그램 → 목표 노출 → 이전 값에서 지수 감쇠로 이동
+	const char* exposureAdaptFrag =
+		"#version 330 core\n"
+		"in vec2 TexCoord;\n"
+		"out float Exposure;\n"
+		"uniform sampler2D histogramTex;\n"
+		"uniform sampler2D prevExposure;\n"
+		"uniform int bins;\n"
+		"uniform float minLog2;\n"
+		"uniform float rangeLog2;\n"
+		"uniform float lowPercent;\n"
+		"uniform float highPercent;\n"
+		"uniform float keyValue;\n"
+		"uniform float minExposure;\n"
+		"uniform float maxExposure;\n"
+		"uniform float speedToBright;\n"
+		"uniform float speedToDark;\n"
+		"uniform float dt;\n"
+		"uniform int resetExposure;\n"
+		"void main(){\n"
+		"  float prev = texelFetch(prevExposure, ivec2(0), 0).r;\n"
+		"  float total = 0.0;\n"
+		"  for(int i = 1; i < bins; i++) total += texelFetch(histogramTex, ivec2(i, 0), 0).r;\n"
+		"  if(total < 1.0){ Exposure = prev; return; }\n"   // 화면이 비어 있으면 유지
+		"  float lo = total * lowPercent;\n"
+		"  float hi = total * highPercent;\n"
+		"  float acc = 0.0, sum = 0.0, weight = 0.0;\n"
+		"  for(int i = 1; i < bins; i++){\n"
+		"    float c = texelFetch(histogramTex, ivec2(i, 0), 0).r;\n"
+		"    float take = clamp(acc + c, lo, hi) - clamp(acc, lo, hi);\n"   // [lo, hi] 안의 몫
+		"    acc += c;\n"
+		"    sum += take * (minLog2 + (float(i - 1) + 0.5) / float(bins - 1) * rangeLog2);\n"
+		"    weight += take;\n"
+		"  }\n"
+		"  float avgLum = exp2(sum / max(weight, 1e-4));\n"
+		"  float target = clamp(keyValue / avgLum, minExposure, maxExposure);\n"
+		"  if(resetExposure == 1 || prev <= 0.0){ Exposure = target; return; }\n"
+		"  float rate = (target < prev) ? speedToBright : speedToDark;\n"
+		"  float k = 1.0 - exp(-dt * rate);\n"
+		"  Exposure = exp2(mix(log2(prev), log2(target), k));\n"   // 로그 공간에서 보간
+		"}\n";
+
+	Shader exposureLumShader(quadVert, exposureLumFrag, true);
+	Shader exposureHistShader(exposureHistVert, exposureHistFrag, true);
+	Shader exposureAdaptShader(quadVert, exposureAdaptFrag, true);
 
 	// =====================
 	// Axis Line Shader
@@ -1114,7 +1373,7 @@ int main()
 		"out vec4 FragColor;\n"
 		"void main(){ FragColor = vec4(1.0); }\n";
 
-	Shader axisShader(axisVert, axisFrag);
+	Shader axisShader(axisVert, axisFrag, true);
 
 	// 기하 생성 ----------------------------------------------------
 	unsigned int sphereVAO, sphereIndexCount;
@@ -1124,66 +1383,102 @@ int main()
 	unsigned int quadVAO, quadVBO;
 	createQuad(quadVAO, quadVBO);
 
-	// 행성 -------------------------------------------------------
-	unsigned int texSun = loadTextureWithCheck("textures/2k_sun.jpg");
-	unsigned int texMercury = loadTextureWithCheck("textures/2k_mercury.jpg");
-	unsigned int texVenus = loadTextureWithCheck("textures/2k_venus_surface.jpg");
-	unsigned int texEarth = loadTextureWithCheck("textures/2k_earth_daymap.jpg");
-	unsigned int texMars = loadTextureWithCheck("textures/2k_mars.jpg");
-	unsigned int texJupiter = loadTextureWithCheck("textures/2k_jupiter.jpg");
-	unsigned int texSaturn = loadTextureWithCheck("textures/2k_saturn.jpg");
-	unsigned int texUranus = loadTextureWithCheck("textures/2k_uranus.jpg");
-	unsigned int texNeptune = loadTextureWithCheck("textures/2k_neptune.jpg");
-	unsigned int texAsgard = loadTextureWithCheck("textures/2k_asgard.jpg");
-
-	// 위성 ---------------------------------------------------
-	unsigned int texMoon = loadTextureWithCheck("textures/2k_moon.jpg");
-	unsigned int texEuropa = loadTextureWithCheck("textures/2k_europa.jpg");
-	unsigned int texTitan = loadTextureWithCheck("textures/2k_titan.jpg");
-	unsigned int texOberon = loadTextureWithCheck("textures/2k_oberon.jpg");
-	unsigned int texTriton = loadTextureWithCheck("textures/2k_triton.jpg");
-
-	// 고리 -----------------------------------------------------
-	unsigned int texJupiterRing = loadTextureWithCheck("textures/2k_jupiter_ring_alpha.png");
-	unsigned int texSaturnRing = loadTextureWithCheck("textures/2k_saturn_ring_alpha.png");
-	unsigned int texUranusRing = loadTextureWithCheck("textures/2k_uranus_ring_alpha.png");
-	unsigned int texNeptuneRing = loadTextureWithCheck("textures/2k_neptune_ring_alpha.png");
+	// 텍스처는 작업 스레드가 디코딩하고, 그동안은 1x1 자리 표시 텍스처로 그림
+	// (루프에서 프레임마다 예산 안에서 업로드 → 첫 프레임이 디코딩을 기다리지 않음)
+	// TextureCooker 로 만든 .ctex (블록 압축 + 밉맵) 가 원본 옆에 있으면 그것을 씀
+	CookedTexture::setEnabled(bench.cookedTextures);
+	if (bench.asyncTextures)
+		TextureStreamer::start(std::max(2, std::min(4, (int)std::thread::hardware_concurrency() - 1)));
+
+	// 태양 / 합성 소천체 -------------------------------------------
+	TextureRef texSun = loadTexture("textures/2k_sun.jpg", 0xFFC060FFu); // 자리 표시: 주황
+	TextureRef texMoon = loadTextureWithCheck("textures/2k_moon.jpg");
+
+	// 행성 / 위성 표면 텍스처는 아래에서 카탈로그 경로로 로드
+	// 고리 텍스처는 RingRenderer 가 params.ring.texturePath 로 배열 한 장에 모아 로드
 
 	// Skybox
-	unsigned int skyTex = loadTextureWithCheck("textures/2k_stars_milky_way.jpg");
+	TextureRef skyTex = loadTexture("textures/2k_stars_milky_way.jpg", 0x000000FFu); // 자리 표시: 검정
 
 	// 태양계 -------------------------------------------------------
+	// 천체 상태 (SoA) + 표면 텍스처 (카탈로그 경로 → 텍스처 캐시, 같은 파일은 한 번만 로드)
 	Sun sun;
-	setupSolarSystem(sun);
+	BodyStore bodies;
+	setupSolarSystem(sun, bodies, *catalog);
+	bodies.setMaterial(bodies.sunBody(), texSun.get());
+	std::vector<TextureRef> bodyTextures;
+	auto bodyTexture = [&](const std::string& path)
+	{
+		if (path.empty()) return texMoon.get(); // 경로가 없으면 달 텍스처
+		bodyTextures.push_back(loadTextureWithCheck(path.c_str()));
+		return bodyTextures.back().get();
+	};
+	for (int p = 0; p < (int)sun.getPlanets().size(); p++)
+	{
+		const Planet& planet = sun.getPlanets()[p];
+		bodies.setMaterial(bodies.planetBody(p), bodyTexture(planet.getParams().texturePath));
+
+		const auto& sats = planet.satellites();
+		for (int s = 0; s < (int)sats.size(); s++)
+			bodies.setMaterial(bodies.satelliteBody(p, s), bodyTexture(sats[s].getParams().texturePath));
+	}
+	for (int b : bodies.otherBodies())
+	{
+		std::string path = catalog->string(catalog->body(b).texture);
+		bool isStar = bodies.kind(b) == BodyKind::Star;
+		bodies.setMaterial(b, (isStar && path.empty()) ? texSun.get() : bodyTexture(path));
+	}
+	bodies.update(0.0f, SCALE_UNITS);
+	gBodies = &bodies;
+
+	// 고리 렌더러: 텍스처 레이어 등록 후 공용 메쉬 생성
+	RingRenderer ringRenderer;
+	for (auto& planet : sun.getPlanets())
+	{
+		if (planet.getParams().ring.enabled)
+			planet.setRingTextureLayer(ringRenderer.addLayer(planet.getParams().ring.texturePath));
+	}
+	ringRenderer.init();
+	ringRenderer.setShader(&ringShader);
+
+	// 대기 렌더러: 행성별 파라미터 등록 후 LUT 미리 계산
+	AtmosphereRenderer atmosphere;
+	for (auto& planet : sun.getPlanets())
+	{
+		if (planet.getParams().atmosphere.enabled)
+			planet.setAtmosphereLayer(atmosphere.addAtmosphere(planet.getParams().atmosphere));
+	}
+	atmosphere.init();
+	atmosphere.setShader(&atmosphereShader);
 
 	// HDR FBO ------------------------------------------------------
-	unsigned int hdrFBO;
-	glGenFramebuffers(1, &hdrFBO);
-	glBindFramebuffer(GL_FRAMEBUFFER, hdrFBO);
+	GpuFramebuffer hdrFBO("HDR FBO");
+	glBindFramebuffer(GL_FRAMEBUFFER, hdrFBO.get());
 
-	unsigned int colorBuffers[2];
-	glGenTextures(2, colorBuffers);
+	GpuRenderTexture colorBuffers[2] = {
+		GpuRenderTexture("HDR color"), GpuRenderTexture("HDR bright") };
 	for (int i = 0; i < 2; ++i)
 	{
-		glBindTexture(GL_TEXTURE_2D, colorBuffers[i]);
+		glBindTexture(GL_TEXTURE_2D, colorBuffers[i].get());
 		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F,
 			SCR_WIDTH, SCR_HEIGHT, 0,
 			GL_RGBA, GL_FLOAT, nullptr);
+		colorBuffers[i].setBytes(GpuRegistry::imageBytes(SCR_WIDTH, SCR_HEIGHT, 1, 8, false));
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 		glFramebufferTexture2D(GL_FRAMEBUFFER,
 			GL_COLOR_ATTACHMENT0 + i,
 			GL_TEXTURE_2D,
-			colorBuffers[i], 0);
+			colorBuffers[i].get(), 0);
 	}
 
-	unsigned int rboDepth;
-	glGenRenderbuffers(1, &rboDepth);
-	glBindRenderbuffer(GL_RENDERBUFFER, rboDepth);
+	GpuRenderbuffer rboDepth("HDR depth");
+	glBindRenderbuffer(GL_RENDERBUFFER, rboDepth.get());
 	glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT,
 		SCR_WIDTH, SCR_HEIGHT);
+	rboDepth.setBytes(GpuRegistry::imageBytes(SCR_WIDTH, SCR_HEIGHT, 1, 4, false));
 	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT,
-		GL_RENDERBUFFER, rboDepth);
+		GL_RENDERBUFFER, rboDepth.get());
 
 	unsigned int attachments[2] = { GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1 };
 	glDrawBuffers(2, attachments);
@@ -1194,24 +1489,190 @@ int main()
 	glBindFramebuffer(GL_FRAMEBUFFER, 0);
 
 	// ping-pong FBO ------------------------------------------------
-	unsigned int pingFBO[2];
-	unsigned int pingColor[2];
-	glGenFramebuffers(2, pingFBO);
-	glGenTextures(2, pingColor);
+	GpuFramebuffer pingFBO[2] = { GpuFramebuffer("ping FBO"), GpuFramebuffer("pong FBO") };
+	GpuRenderTexture pingColor[2] = { GpuRenderTexture("ping color"), GpuRenderTexture("pong color") };
 	for (int i = 0; i < 2; ++i)
 	{
-		glBindFramebuffer(GL_FRAMEBUFFER, pingFBO[i]);
-		glBindTexture(GL_TEXTURE_2D, pingColor[i]);
+		glBindFramebuffer(GL_FRAMEBUFFER, pingFBO[i].get());
+		glBindTexture(GL_TEXTURE_2D, pingColor[i].get());
 		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F,
 			SCR_WIDTH, SCR_HEIGHT, 0,
 			GL_RGBA, GL_FLOAT, nullptr);
+		pingColor[i].setBytes(GpuRegistry::imageBytes(SCR_WIDTH, SCR_HEIGHT, 1, 8, false));
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
-			GL_TEXTURE_2D, pingColor[i], 0);
+			GL_TEXTURE_2D, pingColor[i].get(), 0);
 	}
 	glBindFramebuffer(GL_FRAMEBUFFER, 0);
 
+	// 최종 출력 FBO ------------------------------------------------
+	// 창이 있으면 기본 프레임버퍼(0), 헤드리스면 오프스크린 LDR 타깃에 합성
+	unsigned int outputFBO = 0;
+	GpuFramebuffer outputTarget;
+	GpuRenderTexture outputColor;
+	GpuRenderbuffer outputDepth;
+	if (bench.headless)
+	{
+		outputTarget = GpuFramebuffer("output FBO");
+		outputFBO = outputTarget.get();
+		glBindFramebuffer(GL_FRAMEBUFFER, outputFBO);
+
+		outputColor = GpuRenderTexture("output color");
+		glBindTexture(GL_TEXTURE_2D, outputColor.get());
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8,
+			SCR_WIDTH, SCR_HEIGHT, 0,
+			GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+		outputColor.setBytes(GpuRegistry::imageBytes(SCR_WIDTH, SCR_HEIGHT, 1, 4, false));
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+			GL_TEXTURE_2D, outputColor.get(), 0);
+
+		outputDepth = GpuRenderbuffer("output depth");
+		glBindRenderbuffer(GL_RENDERBUFFER, outputDepth.get());
+		glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24,
+			SCR_WIDTH, SCR_HEIGHT);
+		outputDepth.setBytes(GpuRegistry::imageBytes(SCR_WIDTH, SCR_HEIGHT, 1, 4, false));
+		glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT,
+			GL_RENDERBUFFER, outputDepth.get());
+
+		if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+			std::cerr << "Output framebuffer not complete!\n";
+
+		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	}
+
+	// 자동 노출 (F8 로 켜고 끄기) ------------------------------------
+	AutoExposure autoExposure;
+	autoExposure.init(SCR_WIDTH, SCR_HEIGHT);
+	autoExposure.setShaders(&exposureLumShader, &exposureHistShader, &exposureAdaptShader);
+	bool autoExposureOn = true;
+
+	// 추적 중 보조 화면 (태양계 조감, 1/4 해상도) ----------------------
+	PictureInPicture inset;
+	inset.init(SCR_WIDTH, SCR_HEIGHT);
+	inset.setShaders(&sceneShader, &lineShader, &insetShader);
+	CommandList insetList;
+
+	// 시간 누적 업스케일 (--render-scale, F6 로 켜고 끄기) -------------------
+	TemporalUpscaler upscaler;
+	upscaler.init(SCR_WIDTH, SCR_HEIGHT, bench.renderScale < 1.0f ? bench.renderScale : 0.5f);
+	upscaler.setShader(&upscaleShader);
+	upscaler.setEnabled(bench.renderScale < 1.0f);
+	std::cout << "[Upscale] internal " << upscaler.getRenderWidth() << "x" << upscaler.getRenderHeight()
+		<< " -> " << SCR_WIDTH << "x" << SCR_HEIGHT << (upscaler.isEnabled() ? "" : " (off, F6)") << "\n";
+	std::vector<glm::mat4> prevExtraBodyModels;
+	std::vector<int> extraMeshBodies;      // 메쉬로 그릴 합성 소천체 번호 (나머지는 임포스터)
+
+	// 구 임포스터 (화면 반지름 16 픽셀 미만) ----------------------------
+	SphereImpostors impostors;
+	impostors.init();
+	impostors.setShader(&impostorShader);
+	gImpostors = &impostors;
+
+	// 소행성대 / 카이퍼 벨트 (카탈로그 소천체, 정점 셰이더가 케플러 풀이) ------------
+	AsteroidBelt belt;
+	belt.init(*catalog);
+	belt.setShader(&beltShader);
+	belt.setDensity(bench.beltDensity);
+
+	// 근접 지형 (추적 중인 행성, 타일은 작업 스레드 2개가 생성) ------------
+	PlanetTerrain terrain;
+	terrain.init(2);
+	terrain.setShader(&terrainShader);
+	gTerrain = &terrain;
+
+	// 가상 텍스처 (<텍스처>.vtex 가 있는 행성만, 헤드리스는 동기식) -------------
+	VirtualTextureSystem virtualTextures;
+	if (bench.virtualTextures && virtualTextures.init(bench.headless))
+	{
+		virtualTextures.setFeedbackShader(&vtFeedbackShader);
+		for (const Planet& planet : sun.getPlanets())
+			virtualTextures.add(&planet, vtex::pathFor(planet.getParams().texturePath));
+		virtualTextures.start(2);
+		if (virtualTextures.getTextureCount() > 0)
+			gVirtualTextures = &virtualTextures;
+	}
+
+	// 명령 목록 재생 장치 + 기록 작업 스레드 -------------------------------
+	std::unique_ptr<RenderDevice> renderDevice = RenderDevice::create();
+	CommandRecorder commandRecorder;
+	commandRecorder.start();
+	std::vector<CommandList> trailLists;   // 행성계 하나당 목록 하나
+	CommandList overlayList;               // 자전축 등 기타 선
+	std::vector<CommandList> bodyLists(commandRecorder.getThreadCount() + 1); // 합성 소천체 구간별 목록
+	std::vector<glm::mat4> extraBodyModels;
+
+	// 셰이더 상태 수거 -----------------------------------------------
+	// 위의 초기화 작업 동안 드라이버가 컴파일을 진행했으므로 여기서는 남은 것만 대기
+	{
+		double waitStart = glfwGetTime();
+		Shader* programs[] = { &skyShader, &sceneShader, &ringShader, &atmosphereShader, &lineShader,
+			&blurShader, &finalShader, &exposureLumShader, &exposureHistShader, &exposureAdaptShader,
+			&axisShader, &insetShader, &upscaleShader, &impostorShader, &terrainShader, &beltShader };
+		for (Shader* program : programs)
+			program->finish();
+
+		std::cout << "[Shader] " << sizeof(programs) / sizeof(programs[0]) << " programs ready (waited "
+			<< (int)((glfwGetTime() - waitStart) * 1000.0) << " ms";
+		if (Shader::getCacheHits() + Shader::getCacheMisses() > 0)
+		{
+			std::cout << ", cache " << Shader::getCacheHits() << " hit / "
+				<< Shader::getCacheMisses() << " miss";
+		}
+		std::cout << ")\n";
+	}
+
+	sceneShader.use();
+	sceneShader.setFloat("ringAlpha", 1.0f);   // 기본값: 불투명
+	// 샘플러 유닛은 종류별로 미리 나눠 둠 (대기가 있는 첫 행성 전에도 sampler2D / sampler2DArray 가 0번에 겹치지 않게)
+	sceneShader.setInt("diffuseMap", 0);
+	sceneShader.setInt("ringShadowTex", 1);
+	sceneShader.setInt("nightMap", 2);
+	sceneShader.setInt("cloudMap", 3);
+	sceneShader.setInt("transmittanceLUT", 4);
+
+	// 임포스터: 대기 / 구름 / 야간 / 일식 없음 (샘플러는 종류별로 다른 유닛)
+	impostorShader.use();
+	impostorShader.setInt("ringShadowTex", 1);
+	impostorShader.setInt("nightMap", 2);
+	impostorShader.setInt("cloudMap", 3);
+	impostorShader.setInt("transmittanceLUT", 4);
+	impostorShader.setInt("isSun", 0);
+	impostorShader.setFloat("emissionStrength", 1.0f);
+	impostorShader.setFloat("ringAlpha", 1.0f);
+	impostorShader.setFloat("atmoLayer", -1.0f);
+	impostorShader.setInt("hasNightMap", 0);
+	impostorShader.setFloat("cloudOpacity", 0.0f);
+	ShadowCasters::applyEmpty(impostorShader);
+
+	// 근접 지형: 대기 / 그림자는 sceneShader 처럼 행성마다 설정
+	terrainShader.use();
+	terrainShader.setInt("ringShadowTex", 1);
+	terrainShader.setInt("nightMap", 2);
+	terrainShader.setInt("cloudMap", 3);
+	terrainShader.setInt("transmittanceLUT", 4);
+	terrainShader.setInt("isSun", 0);
+	terrainShader.setFloat("emissionStrength", 1.0f);
+	terrainShader.setFloat("ringAlpha", 1.0f);
+
+	// 헤드리스 벤치마크 통계
+	FrameStats frameStats;
+	if (bench.headless)
+		frameStats.init();
+	int frameIndex = 0;
+
+	// 프레임 녹화 (PBO 비동기 리드백)
+	FrameCapture capture;
+	if (bench.capture.enabled)
+		capture.start(bench.capture, SCR_WIDTH, SCR_HEIGHT);
+
+	// 프레임 서버 (--serve): 소켓 명령이 올 때만 그리고 결과는 공유 메모리 슬롯에 공개
+	FrameServer frameServer;
+	if (!bench.serveSocket.empty() && !frameServer.start(bench.serveSocket, SCR_WIDTH, SCR_HEIGHT))
+		return -1;
+
 	float lastTime = (float)glfwGetTime();
 	float simYears = 0.0f;
 
@@ -1219,242 +1680,664 @@ int main()
 	// simYears는 "년" 단위이므로 1일 = 1/365년
 	const float SIM_SPEED = 1.0f / 365.0f;
 
+	// 렌더 온 디맨드: 일시 정지 + 카메라 정지 상태면 다시 그리지 않음 (F7 로 끄기)
+	RedrawTracker redrawTracker;
+	gRedraw = &redrawTracker;
+	const double REDRAW_IDLE_WAIT_SEC = 0.25;
+
+	// 프레임 페이싱: 목표 주사율 직전에 입력을 읽고 표시까지 기다림 (창 모드)
+	FramePacer pacer;
+	if (!bench.headless && bench.framePacing)
+	{
+		double hz = bench.targetFps;
+		if (hz <= 0.0)
+		{
+			const GLFWvidmode* mode = glfwGetVideoMode(glfwGetPrimaryMonitor());
+			hz = (mode && mode->refreshRate > 0) ? mode->refreshRate : 60.0;
+		}
+		pacer.setTargetHz(hz);
+
+		// 모니터 주사율이 목표면 수직 동기에 맞추고, --fps 로 정했으면 페이서가 직접 제한
+		glfwSwapInterval(bench.targetFps > 0 ? 0 : 1);
+	}
+
+	// 장면 단계를 건너뛴 프레임도 궤도선 / 합성에서 쓰는 값 (천체 위치는 bodies 에 남아 있음)
+	bool horizontal = true; // 블룸 결과: pingColor[!horizontal]
+	unsigned int sceneColorTex = colorBuffers[0].get(); // 합성할 HDR 장면 (업스케일 시 복원 결과)
+
+	// 헤드리스 / 서버 모드는 모든 텍스처가 올라간 뒤 시작 (재현 가능한 프레임)
+	if (bench.headless)
+		TextureStreamer::finish();
+	const double TEXTURE_UPLOAD_BUDGET_MS = 3.0; // 창 모드 프레임당 업로드 예산
+	bool firstFrameReported = false;
+
 	// 루프 ---------------------------------------------------------
-	while (!glfwWindowShouldClose(window))
+	while (frameServer.isRunning() ||
+		(bench.headless ? frameIndex < bench.frames : !glfwWindowShouldClose(window)))
 	{
+		if (pacer.isEnabled())
+		{
+			// 다음 표시 시점 - 예상 작업 시간까지 잠들었다가 입력을 가능한 한 늦게 읽음
+			pacer.waitForInputSlot();
+			glfwPollEvents();
+			pacer.markInputSampled();
+		}
+
 		float now = (float)glfwGetTime();
 		float dt = now - lastTime;
 		lastTime = now;
-		std::vector<glm::vec3> planetWorldPositions;
 
-		bool w = glfwGetKey(window, GLFW_KEY_W) == GLFW_PRESS;
-		bool s = glfwGetKey(window, GLFW_KEY_S) == GLFW_PRESS;
-		bool a = glfwGetKey(window, GLFW_KEY_A) == GLFW_PRESS;
-		bool d = glfwGetKey(window, GLFW_KEY_D) == GLFW_PRESS;
-		cam.processKeyboard(w, s, a, d, dt);
+		bool timeJumped = false; // 서버가 시각을 직접 지정한 프레임
 
-		// ===========================
-		// Simulation Speed Control
-		// Shift = speed up
-		// Ctrl  = slow down
-		// + 100x / - 100x
-		// ===========================
-		if (glfwGetKey(window, GLFW_KEY_LEFT_SHIFT) == GLFW_PRESS ||
-			glfwGetKey(window, GLFW_KEY_RIGHT_SHIFT) == GLFW_PRESS)
+		if (frameServer.isRunning())
 		{
-			simSpeedMultiplier += dt * 2.0f;
-			if (simSpeedMultiplier > 100.0f)
-				simSpeedMultiplier = 100.0f;
-		}
+			// 서버 모드: 다음 render / stream 명령까지 대기한 뒤 받은 상태를 반영
+			FrameRequest req;
+			if (!frameServer.waitForFrame(req))
+				break; // quit
+			dt = bench.fixedDtSec;
 
-		if (glfwGetKey(window, GLFW_KEY_LEFT_CONTROL) == GLFW_PRESS ||
-			glfwGetKey(window, GLFW_KEY_RIGHT_CONTROL) == GLFW_PRESS)
-		{
-			simSpeedMultiplier -= dt * 2.0f;
-			if (simSpeedMultiplier < 0.1f)
-				simSpeedMultiplier = 0.1f;
+			if (req.hasTracking)
+			{
+				trackingIndex = req.trackingIndex;
+				if (trackingIndex < 0)
+					cam.stopTracking();
+			}
+			if (req.hasPose)
+				cam.setPose(req.position, req.target);
+			for (int i = 0; i < (int)fabs(req.zoomSteps); i++)
+				cam.processMouseScroll(req.zoomSteps > 0.0f ? 1.0f : -1.0f);
+			if (req.hasSpeed)
+				simSpeedMultiplier = req.simSpeed;
+			if (req.hasTime)
+			{
+				simYears = req.simYears;
+				timeJumped = true;
+			}
+			frameStats.beginFrame();
 		}
-
-		// 행성 추적 ------------------------------------------------
-		// [추가] 추적 대상 선택 (숫자키 1 ~ 8)
-		if (glfwGetKey(window, GLFW_KEY_1) == GLFW_PRESS) trackingIndex = 0; // 수성
-		if (glfwGetKey(window, GLFW_KEY_2) == GLFW_PRESS) trackingIndex = 1; // 금성
-		if (glfwGetKey(window, GLFW_KEY_3) == GLFW_PRESS) trackingIndex = 2; // 지구
-		if (glfwGetKey(window, GLFW_KEY_4) == GLFW_PRESS) trackingIndex = 3; // 화성
-		if (glfwGetKey(window, GLFW_KEY_5) == GLFW_PRESS) trackingIndex = 4; // 목성
-		if (glfwGetKey(window, GLFW_KEY_6) == GLFW_PRESS) trackingIndex = 5; // 토성
-		if (glfwGetKey(window, GLFW_KEY_7) == GLFW_PRESS) trackingIndex = 6; // 천왕성
-		if (glfwGetKey(window, GLFW_KEY_8) == GLFW_PRESS) trackingIndex = 7; // 해왕성
-		if (glfwGetKey(window, GLFW_KEY_9) == GLFW_PRESS) trackingIndex = 8; // 아스가르드
-
-		// [추가] 추적 해제 (ESC)
-		if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
+		else if (bench.headless)
 		{
-			trackingIndex = -1;
-			gCamera->stopTracking();
+			// 고정 시뮬레이션 스텝 + 스크립트 카메라 → 재현 가능한 프레임
+			dt = bench.fixedDtSec;
+			applyScriptedCamera(cam, frameIndex, bench.frames);
+			frameStats.beginFrame();
 		}
-		static bool zeroKeyPressed = false; // 이전 프레임 키 상태 저장
-		if (glfwGetKey(window, GLFW_KEY_0) == GLFW_PRESS)
+		else
 		{
-			if (!zeroKeyPressed) // 방금 눌리기 시작했다면
+			bool w = glfwGetKey(window, GLFW_KEY_W) == GLFW_PRESS;
+			bool s = glfwGetKey(window, GLFW_KEY_S) == GLFW_PRESS;
+			bool a = glfwGetKey(window, GLFW_KEY_A) == GLFW_PRESS;
+			bool d = glfwGetKey(window, GLFW_KEY_D) == GLFW_PRESS;
+			cam.processKeyboard(w, s, a, d, dt);
+
+			// ===========================
+			// Simulation Speed Control
+			// Shift = speed up
+			// Ctrl  = slow down
+			// + 100x / - 100x
+			// ===========================
+			if (glfwGetKey(window, GLFW_KEY_LEFT_SHIFT) == GLFW_PRESS ||
+				glfwGetKey(window, GLFW_KEY_RIGHT_SHIFT) == GLFW_PRESS)
 			{
-				isPaused = !isPaused; // 상태 반전 (On <-> Off)
-				std::cout << "Simulation " << (isPaused ? "PAUSED" : "RESUMED") << std::endl;
-				zeroKeyPressed = true;
+				simSpeedMultiplier += dt * 2.0f;
+				if (simSpeedMultiplier > 100.0f)
+					simSpeedMultiplier = 100.0f;
+			}
+
+			if (glfwGetKey(window, GLFW_KEY_LEFT_CONTROL) == GLFW_PRESS ||
+				glfwGetKey(window, GLFW_KEY_RIGHT_CONTROL) == GLFW_PRESS)
+			{
+				simSpeedMultiplier -= dt * 2.0f;
+				if (simSpeedMultiplier < 0.1f)
+					simSpeedMultiplier = 0.1f;
+			}
+
+			// 행성 추적 ------------------------------------------------
+			// [추가] 추적 대상 선택 (숫자키 1 ~ 8)
+			if (glfwGetKey(window, GLFW_KEY_1) == GLFW_PRESS) trackingIndex = 0; // 수성
+			if (glfwGetKey(window, GLFW_KEY_2) == GLFW_PRESS) trackingIndex = 1; // 금성
+			if (glfwGetKey(window, GLFW_KEY_3) == GLFW_PRESS) trackingIndex = 2; // 지구
+			if (glfwGetKey(window, GLFW_KEY_4) == GLFW_PRESS) trackingIndex = 3; // 화성
+			if (glfwGetKey(window, GLFW_KEY_5) == GLFW_PRESS) trackingIndex = 4; // 목성
+			if (glfwGetKey(window, GLFW_KEY_6) == GLFW_PRESS) trackingIndex = 5; // 토성
+			if (glfwGetKey(window, GLFW_KEY_7) == GLFW_PRESS) trackingIndex = 6; // 천왕성
+			if (glfwGetKey(window, GLFW_KEY_8) == GLFW_PRESS) trackingIndex = 7; // 해왕성
+			if (glfwGetKey(window, GLFW_KEY_9) == GLFW_PRESS) trackingIndex = 8; // 아스가르드
+
+			// [추가] 추적 해제 (ESC)
+			if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
+			{
+				trackingIndex = -1;
+				gCamera->stopTracking();
+			}
+			static bool zeroKeyPressed = false; // 이전 프레임 키 상태 저장
+			if (glfwGetKey(window, GLFW_KEY_0) == GLFW_PRESS)
+			{
+				if (!zeroKeyPressed) // 방금 눌리기 시작했다면
+				{
+					isPaused = !isPaused; // 상태 반전 (On <-> Off)
+					std::cout << "Simulation " << (isPaused ? "PAUSED" : "RESUMED") << std::endl;
+					zeroKeyPressed = true;
+				}
+			}
+			else
+			{
+				zeroKeyPressed = false; // 키를 떼면 리셋
+			}
+
+			// F9 : 녹화 시작 / 정지
+			static bool f9KeyPressed = false;
+			if (glfwGetKey(window, GLFW_KEY_F9) == GLFW_PRESS)
+			{
+				if (!f9KeyPressed)
+				{
+					if (capture.isRecording())
+						capture.stop();
+					else
+						capture.start(bench.capture, SCR_WIDTH, SCR_HEIGHT);
+					f9KeyPressed = true;
+				}
+			}
+			else
+			{
+				f9KeyPressed = false;
+			}
+
+			// [ / ] : 소천체 벨트 밀도 절반 / 두 배
+			static bool bracketKeyPressed = false;
+			bool bracketDown = glfwGetKey(window, GLFW_KEY_LEFT_BRACKET) == GLFW_PRESS;
+			bool bracketUp = glfwGetKey(window, GLFW_KEY_RIGHT_BRACKET) == GLFW_PRESS;
+			if (bracketDown || bracketUp)
+			{
+				if (!bracketKeyPressed && belt.getCount() > 0)
+				{
+					float d = belt.getDensity();
+					if (bracketUp) d = d > 0.0f ? d * 2.0f : 1.0f / 64.0f;
+					else d = d > 1.0f / 64.0f ? d * 0.5f : 0.0f;
+					belt.setDensity(d);
+					redrawTracker.invalidateScene();
+					std::cout << "[Belt] density " << belt.getDensity() << " (" << belt.getDrawCount()
+						<< " / " << belt.getCount() << " bodies)\n";
+					bracketKeyPressed = true;
+				}
+			}
+			else
+			{
+				bracketKeyPressed = false;
+			}
+
+			// F7 : 렌더 온 디맨드 켜기 / 끄기
+			static bool f7KeyPressed = false;
+			if (glfwGetKey(window, GLFW_KEY_F7) == GLFW_PRESS)
+			{
+				if (!f7KeyPressed)
+				{
+					redrawTracker.setEnabled(!redrawTracker.isEnabled());
+					std::cout << "Render on demand " << (redrawTracker.isEnabled() ? "ON" : "OFF") << std::endl;
+					f7KeyPressed = true;
+				}
+			}
+			else
+			{
+				f7KeyPressed = false;
+			}
+
+			// F8 : 자동 노출 켜기 / 끄기
+			static bool f8KeyPressed = false;
+			if (glfwGetKey(window, GLFW_KEY_F8) == GLFW_PRESS)
+			{
+				if (!f8KeyPressed)
+				{
+					autoExposureOn = !autoExposureOn;
+					if (autoExposureOn) autoExposure.reset();
+					std::cout << "Auto exposure " << (autoExposureOn ? "ON" : "OFF") << std::endl;
+					f8KeyPressed = true;
+				}
+			}
+			else
+			{
+				f8KeyPressed = false;
+			}
+
+			// F6 : 시간 누적 업스케일 켜기 / 끄기
+			static bool f6KeyPressed = false;
+			if (glfwGetKey(window, GLFW_KEY_F6) == GLFW_PRESS)
+			{
+				if (!f6KeyPressed)
+				{
+					upscaler.setEnabled(!upscaler.isEnabled());
+					redrawTracker.invalidateScene();
+					std::cout << "Temporal upscale " << (upscaler.isEnabled() ? "ON" : "OFF") << std::endl;
+					f6KeyPressed = true;
+				}
+			}
+			else
+			{
+				f6KeyPressed = false;
 			}
-		}
-		else
-		{
-			zeroKeyPressed = false; // 키를 떼면 리셋
 		}
 
-		if (!isPaused) {
+		if (!isPaused && !timeJumped) {
 			simYears += dt * SIM_SPEED * simSpeedMultiplier;
 		}
 
+		// 근접 지형이 있는 행성 가까이에서는 근평면을 고도에 맞춰 당김 (지난 프레임 위치 기준)
+		float nearPlane = 0.1f;
+		if (trackingIndex >= 0 && trackingIndex < (int)sun.getPlanets().size())
+		{
+			const PlanetParams& tp = sun.getPlanets()[trackingIndex].getParams();
+			if (tp.terrain.enabled)
+			{
+				float altitude = glm::distance(cam.getPosition(), bodies.worldPosition(bodies.planetBody(trackingIndex)))
+					- tp.radiusRender * SCALE_UNITS * (1.0f + tp.terrain.heightScale);
+				nearPlane = glm::clamp(altitude * 0.5f, 0.002f, 0.1f);
+			}
+		}
+
 		glm::mat4 view = cam.getViewMatrix();
 		glm::mat4 proj = glm::perspective(glm::radians(cam.getFOV()),
 			(float)SCR_WIDTH / (float)SCR_HEIGHT,
-			0.1f, 3000.0f);
+			nearPlane, 3000.0f);
 
-		// ================================
-		// 1) HDR FBO : 태양 / 지구 / 달 등 모든 천체
-		// ================================
-		glBindFramebuffer(GL_FRAMEBUFFER, hdrFBO);
-		glViewport(0, 0, SCR_WIDTH, SCR_HEIGHT);
-		glClearColor(0, 0, 0, 1);
-		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-		glEnable(GL_DEPTH_TEST);
-
-		sceneShader.use();
-		sceneShader.setMat4("view", view);
-		sceneShader.setMat4("proj", proj);
-		sceneShader.setVec3("lightPos", glm::vec3(0.0f));
-		sceneShader.setVec3("lightColor", glm::vec3(1.0f, 1.0f, 0.9f));
-		sceneShader.setVec3("viewPos", cam.getPosition());
+		// 디코딩이 끝난 텍스처를 예산 안에서 업로드 (자리 표시 → 실제 이미지, ID 는 그대로)
+		if (TextureStreamer::pump(TEXTURE_UPLOAD_BUDGET_MS) && TextureStreamer::pendingCount() == 0)
+		{
+			std::cout << "[Texture] All textures resident after "
+				<< (int)(glfwGetTime() * 1000.0) << " ms\n";
+		}
 
-		glBindVertexArray(sphereVAO);
+		// 다시 그릴 범위 결정 (헤드리스 / 녹화 중 / F7 로 끈 경우는 항상 전부)
+		RedrawLevel redraw = RedrawLevel::Scene;
+		if (!bench.headless && !capture.isRecording())
+		{
+			RedrawState state;
+			state.simYears = simYears;
+			state.view = view;
+			state.fov = cam.getFOV();
+			state.width = SCR_WIDTH;
+			state.height = SCR_HEIGHT;
+			state.trackingIndex = trackingIndex;
+			state.autoExposure = autoExposureOn;
+			state.settleSceneFrames = upscaler.isEnabled() ? TemporalUpscaler::JITTER_PHASES : 0;
+			if (terrain.isStreaming() || virtualTextures.isStreaming() || TextureStreamer::pendingCount() > 0)
+				redrawTracker.invalidateScene(); // 타일 / 텍스처가 도착하는 동안은 계속 그림
+			redraw = redrawTracker.update(state, dt);
+		}
 
-		// 1-1. 태양 그리기 -------------------------------------------
-		glActiveTexture(GL_TEXTURE0);
-		glBindTexture(GL_TEXTURE_2D, texSun);
-		sceneShader.setInt("diffuseMap", 0);
-		sceneShader.setInt("isSun", 1);
-		sceneShader.setFloat("emissionStrength", 4.0f);
+		if (redraw == RedrawLevel::None)
+		{
+			// 바뀐 것이 없음: 화면의 마지막 프레임을 그대로 두고 입력 / 창 이벤트를 기다림
+			glfwWaitEventsTimeout(REDRAW_IDLE_WAIT_SEC);
+			lastTime = (float)glfwGetTime(); // 기다린 시간은 dt 에 넣지 않음
+			pacer.resync();
+			continue;
+		}
 
-		// 태양 자전 업데이트 (배속 + 일시정지 반영)
-		float dtSimDaysForSun = (isPaused ? 0.0f : dt * simSpeedMultiplier);
-		sun.advanceSpin(dtSimDaysForSun);
+		// 태양이 관리하는 행성 리스트 가져오기
+		auto& planets = sun.getPlanets();
 
-		// 회전 포함된 태양 모델 행렬 생성
-		glm::mat4 sunModel = sun.buildModelMatrix(7.0f);
+		if (redraw == RedrawLevel::Scene)
+		{
+			// ================================
+			// 1) HDR FBO : 태양 / 지구 / 달 등 모든 천체
+			// ================================
+			// 업스케일 중이면 저해상도 + 지터 투영으로 그림
+			glm::mat4 sceneProj = upscaler.beginFrame(view, proj);
+			bool upscale = upscaler.isEnabled();
+			int sceneW = upscale ? upscaler.getRenderWidth() : (int)SCR_WIDTH;
+			int sceneH = upscale ? upscaler.getRenderHeight() : (int)SCR_HEIGHT;
+
+			glBindFramebuffer(GL_FRAMEBUFFER, upscale ? upscaler.getSceneFBO() : hdrFBO.get());
+			glViewport(0, 0, sceneW, sceneH);
+			glClearColor(0, 0, 0, 1);
+			glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+			if (upscale)
+				upscaler.clearVelocity();
+			glEnable(GL_DEPTH_TEST);
+
+			sceneShader.use();
+			sceneShader.setMat4("view", view);
+			sceneShader.setMat4("proj", sceneProj);
+			sceneShader.setMat4("currViewProj", upscaler.getViewProj());
+			sceneShader.setMat4("prevViewProj", upscaler.getPrevViewProj());
+
+			impostors.setView(cam.getPosition(), cam.getFOV(), sceneH);
+			impostors.begin();
+
+			const Planet* terrainTarget =
+				(trackingIndex >= 0 && trackingIndex < (int)planets.size()) ? &planets[trackingIndex] : nullptr;
+			terrain.beginFrame(terrainTarget, view, sceneProj, cam.getPosition(), cam.getFOV(), sceneH);
+			virtualTextures.beginFrame();
+			sceneShader.setVec3("lightPos", glm::vec3(0.0f));
+			sceneShader.setVec3("lightColor", glm::vec3(1.0f, 1.0f, 0.9f));
+			sceneShader.setVec3("viewPos", cam.getPosition());
+			sceneShader.setFloat("sunRadius", SUN_RENDER_RADIUS);
+
+			// 고리 그림자용 텍스처 배열 (diffuseMap 과 겹치지 않게 1번 유닛)
+			glActiveTexture(GL_TEXTURE1);
+			glBindTexture(GL_TEXTURE_2D_ARRAY, ringRenderer.getTextureArray());
+			sceneShader.setInt("ringShadowTex", 1);
+
+			glBindVertexArray(sphereVAO);
+
+			// 1-1. 태양 그리기 -------------------------------------------
+			glActiveTexture(GL_TEXTURE0);
+			glBindTexture(GL_TEXTURE_2D, texSun.get());
+			sceneShader.setInt("diffuseMap", 0);
+			sceneShader.setInt("isSun", 1);
+			sceneShader.setFloat("emissionStrength", 4.0f);
 
-		// 태양 텍스처 + 파라미터
-		glActiveTexture(GL_TEXTURE0);
-		glBindTexture(GL_TEXTURE_2D, texSun);
-		sceneShader.setInt("diffuseMap", 0);
-		sceneShader.setInt("isSun", 1);
-		sceneShader.setFloat("emissionStrength", 4.0f);
+			// 모든 천체 자전 (배속 + 일시정지 반영) + 위치 / 모델 행렬을 한 번에 계산
+			float dtSimDays = (isPaused ? 0.0f : dt * simSpeedMultiplier);
+			bodies.advanceSpin(dtSimDays);
+			bodies.update(simYears, SCALE_UNITS);
 
-		// 렌더링
-		sceneShader.setMat4("model", sunModel);
-		glDrawElements(GL_TRIANGLES, sphereIndexCount, GL_UNSIGNED_INT, 0);
+			// 회전 포함된 태양 모델 행렬
+			const glm::mat4& sunModel = bodies.model(bodies.sunBody());
 
-		// 1-2. 모든 행성 순회 및 그리기 -----------------------------
-		// 태양이 관리하는 행성 리스트 가져오기
-		auto& planets = sun.getPlanets();
+			// 태양 텍스처 + 파라미터
+			glActiveTexture(GL_TEXTURE0);
+			glBindTexture(GL_TEXTURE_2D, texSun.get());
+			sceneShader.setInt("diffuseMap", 0);
+			sceneShader.setInt("isSun", 1);
+			sceneShader.setFloat("emissionStrength", 4.0f);
+
+			// 렌더링
+			sceneShader.setMat4("model", sunModel);
+			sceneShader.setMat4("prevModel", bodies.prevModel(bodies.sunBody()));
+			glDrawElements(GL_TRIANGLES, sphereIndexCount, GL_UNSIGNED_INT, 0);
+
+			// 보조 화면: 주 패스가 계산한 행렬 / 위치만 모아 둠 (추적 중일 때만)
+			bool insetOn = (trackingIndex >= 0 && trackingIndex < (int)planets.size());
+			inset.begin();
+			if (insetOn)
+				inset.addBody(sunModel, glm::vec3(0.0f), SUN_RENDER_RADIUS, texSun.get(), 4.0f, 3.0f);
+
+			// 1-2. 모든 행성 순회 및 그리기 -----------------------------
+			int pIdx = 0; // 행성 인덱스 카운터
+
+			ringRenderer.begin();
+			atmosphere.begin();
+
+			// 일식 / 고리 그림자 가림체
+			//  - 행성과 위성: 같은 행성계(행성 + 위성 + 고리)만 검사
+			//  - 고리: 고리가 있는 행성계의 구들만 검사
+			ShadowCasters systemCasters;
+			ShadowCasters ringCasters;
+
+			for (auto& planet : planets)
+			{
+				// A. 천체 번호 → 위치 / 행렬 / 텍스처 (BodyStore::update 에서 계산됨)
+				int body = bodies.planetBody(pIdx);
+				const glm::vec3& planetWorldPos = bodies.worldPosition(body);
+				const glm::mat4& planetModel = bodies.model(body);
+				unsigned int currentTex = bodies.material(body);
+				int satCount = (int)planet.satellites().size();
+
+				// 이 행성계의 그림자 가림체
+				const RingParams& ringP = planet.getParams().ring;
+				systemCasters.clear();
+				systemCasters.addSphere(planetWorldPos, bodies.worldRadius(body));
+				for (int s = 0; s < satCount; s++)
+				{
+					int satBody = bodies.satelliteBody(pIdx, s);
+					systemCasters.addSphere(bodies.worldPosition(satBody), bodies.worldRadius(satBody));
+					if (ringP.enabled)
+						ringCasters.addSphere(bodies.worldPosition(satBody), bodies.worldRadius(satBody));
+				}
+				if (ringP.enabled)
+				{
+					ringCasters.addSphere(planetWorldPos, bodies.worldRadius(body));
+					systemCasters.addRing(planetModel,
+						ringP.innerRadius, ringP.outerRadius, ringP.alpha, ringP.textureLayer);
+				}
+				systemCasters.apply(sceneShader);
+
+				// ==========================================
+				// [추가] 카메라 추적 로직 (핵심!)
+				// ==========================================
+				if (trackingIndex == pIdx)
+				{
+					// 1. 현재 추적 모드가 꺼져있다면 -> 켜기
+					if (!gCamera->getIsTracking()) {
+						gCamera->startTracking(planetWorldPos);
+					}
+					// 2. 매 프레임 행성의 새로운 위치를 카메라에 전달
+					const PlanetParams& pp = planet.getParams();
+					gCamera->setMinTrackDistance(pp.terrain.enabled ?
+						pp.radiusRender * SCALE_UNITS * 1.02f : 2.0f);
+					gCamera->updateTargetPosition(planetWorldPos);
+				}
+				// ==========================================
+
+				// C. 행성 렌더링
+				const AtmosphereParams& atmoP = planet.getParams().atmosphere;
+				float planetRadius = planet.getParams().radiusRender * SCALE_UNITS;
+				atmosphere.applySurface(sceneShader, atmoP.lutLayer, planetWorldPos, planetRadius);
+				if (terrain.covers(&planet, planetWorldPos, planetRadius))
+				{
+					terrainShader.use();
+					terrainShader.setMat4("currViewProj", upscaler.getViewProj());
+					terrainShader.setMat4("prevViewProj", upscaler.getPrevViewProj());
+					terrainShader.setVec3("lightPos", glm::vec3(0.0f));
+					terrainShader.setVec3("lightColor", glm::vec3(1.0f, 1.0f, 0.9f));
+					terrainShader.setVec3("viewPos", cam.getPosition());
+					terrainShader.setFloat("sunRadius", SUN_RENDER_RADIUS);
+					systemCasters.apply(terrainShader);
+					atmosphere.applySurface(terrainShader, atmoP.lutLayer, planetWorldPos, planetRadius);
+					sceneShader.use();
+				}
+				renderPlanet(planet, body, sceneShader, sphereIndexCount, sphereVAO);
+
+				// 고리 등록 (Saturn / Jupiter 등) — 불투명 천체를 모두 그린 뒤 한 번에 렌더
+				if (ringP.enabled)
+				{
+					ringRenderer.add(planetModel,
+						ringP.innerRadius,
+						ringP.outerRadius,
+						ringP.alpha,
+						ringP.textureLayer);
+				}
 
-		planetWorldPositions.clear();
-		planetWorldPositions.reserve(planets.size());
+				// 대기 껍질 등록 — 불투명 천체 뒤에 한꺼번에 그림
+				atmosphere.add(atmoP.lutLayer, planetWorldPos, planetRadius);
+
+				// 행성별 위성 렌더링 (위성은 대기 없음)
+				atmosphere.applySurface(sceneShader, -1, planetWorldPos, 0.0f);
+				renderSatellites(planet, pIdx, sceneShader, sphereVAO, sphereIndexCount);
+
+				// 보조 화면 등록 (주 패스와 같은 행렬 / 위치)
+				if (insetOn)
+				{
+					inset.addBody(planetModel, planetWorldPos, planetRadius, currentTex, 0.0f, 1.5f);
+					inset.addOrbit(&planet.orbitGeometry(), pIdx == trackingIndex);
+
+					for (int s = 0; s < satCount; s++)
+					{
+						int satBody = bodies.satelliteBody(pIdx, s);
+						inset.addBody(bodies.model(satBody), bodies.worldPosition(satBody),
+							bodies.worldRadius(satBody), bodies.material(satBody), 0.0f, 0.0f);
+					}
+				}
 
-		int pIdx = 0; // 행성 인덱스 카운터
+				// [추가] 루프 끝날 때 인덱스 증가
+				pIdx++;
+			}
 
-		for (auto& planet : planets)
-		{
-			// A. 텍스처 자동 선택 (이름 기반)
-			std::string pName = planet.getParams().name;
-			unsigned int currentTex = texMercury; // 기본값
-
-			if (pName == "Mercury") currentTex = texMercury;
-			else if (pName == "Venus")   currentTex = texVenus;
-			else if (pName == "Earth")   currentTex = texEarth;
-			else if (pName == "Mars")    currentTex = texMars;
-			else if (pName == "Jupiter") currentTex = texJupiter;
-			else if (pName == "Saturn")  currentTex = texSaturn;
-			else if (pName == "Uranus")  currentTex = texUranus;
-			else if (pName == "Neptune") currentTex = texNeptune;
-			else if (pName == "Asgard") currentTex = texAsgard;
-
-			// B. 물리 업데이트 및 위치 계산 (Helper 함수 사용)
-			// 이 함수 내부에서 recordTrail()도 호출됨
-			glm::vec3 planetWorldPos;
-			updatePlanetPhysics(planet, simYears, orbitToXZ, SCALE_UNITS, planetWorldPos);
-
-			// 행성 world 좌표를 저장
-			planetWorldPositions.push_back(planetWorldPos);
-
-			// ==========================================
-			// [추가] 카메라 추적 로직 (핵심!)
-			// ==========================================
-			if (trackingIndex == pIdx)
+			// 1-2a. 그 밖의 카탈로그 천체 (두 번째 항성, 위성의 위성 ...): 고리 / 대기 없이 구 하나
+			//       항성은 태양처럼 발광, 나머지는 조명 + 작으면 임포스터 (질량중심은 그리지 않음)
+			ShadowCasters::applyEmpty(sceneShader);
+			atmosphere.applySurface(sceneShader, -1, glm::vec3(0.0f), 0.0f);
+			for (int b : bodies.otherBodies())
 			{
-				// 1. 현재 추적 모드가 꺼져있다면 -> 켜기
-				if (!gCamera->getIsTracking()) {
-					gCamera->startTracking(planetWorldPos);
+				BodyKind kind = bodies.kind(b);
+				if (kind == BodyKind::Barycenter) continue;
+
+				bool isStar = (kind == BodyKind::Star);
+				unsigned int currentTex = bodies.material(b);
+				if (!isStar && impostors.shouldUse(bodies.worldPosition(b), bodies.worldRadius(b)))
+				{
+					impostors.add(bodies.model(b), bodies.prevModel(b), currentTex);
+					continue;
 				}
-				// 2. 매 프레임 행성의 새로운 위치를 카메라에 전달
-				gCamera->updateTargetPosition(planetWorldPos);
-			}
-			// ==========================================
 
-			// C. 행성 렌더링
-			renderPlanet(planet, currentTex, sceneShader, sphereIndexCount, dt, SCALE_UNITS, planetWorldPos, sphereVAO);
+				glActiveTexture(GL_TEXTURE0);
+				glBindTexture(GL_TEXTURE_2D, currentTex);
+				sceneShader.setInt("isSun", isStar ? 1 : 0);
+				sceneShader.setFloat("emissionStrength", isStar ? 4.0f : 1.0f);
+				sceneShader.setMat4("model", bodies.model(b));
+				sceneShader.setMat4("prevModel", bodies.prevModel(b));
+				glBindVertexArray(sphereVAO);
+				glDrawElements(GL_TRIANGLES, sphereIndexCount, GL_UNSIGNED_INT, 0);
+				glBindVertexArray(0);
+			}
 
-			// 고리 렌더 (Saturn / Jupiter 등)
-			if (planet.getParams().ring.enabled && planet.ring)
+			// 1-2b. 합성 소천체 (--bodies N) : 구간별로 작업 스레드에서 기록 후 한 번에 재생
+			if (bench.extraBodies > 0)
 			{
-				glm::mat4 planetModel =
-					planet.buildModelMatrix(SCALE_UNITS, planetWorldPos);
+				prevExtraBodyModels.swap(extraBodyModels);
+				buildExtraBodies(bench.extraBodies, simYears, extraBodyModels);
+				if (prevExtraBodyModels.size() != extraBodyModels.size())
+					prevExtraBodyModels = extraBodyModels;
+
+				// 작게 보이는 것은 임포스터로, 나머지만 작업 스레드에서 메쉬로 기록
+				extraMeshBodies.clear();
+				for (int i = 0; i < bench.extraBodies; i++)
+				{
+					const glm::mat4& m = extraBodyModels[i];
+					if (impostors.shouldUse(glm::vec3(m[3]), glm::length(glm::vec3(m[0]))))
+						impostors.add(m, prevExtraBodyModels[i], texMoon.get());
+					else
+						extraMeshBodies.push_back(i);
+				}
+				int meshCount = (int)extraMeshBodies.size();
+				ShadowCasters::applyEmpty(sceneShader);
+				atmosphere.applySurface(sceneShader, -1, glm::vec3(0.0f), 0.0f);
+
+				int chunk = (meshCount + (int)bodyLists.size() - 1) / (int)bodyLists.size();
+				commandRecorder.record(bodyLists, [&](int listIdx, CommandList& cmd)
+				{
+					cmd.reset();
+					int first = listIdx * chunk;
+					int last = std::min(first + chunk, meshCount);
+					if (first >= last) return;
+
+					cmd.setPipeline(makePipeline(sceneShader.ID));
+					cmd.bindTexture(0, TextureTarget::Texture2D, texMoon.get());
+					cmd.setInt("diffuseMap", 0);
+					cmd.setInt("isSun", 0);
+					cmd.setFloat("emissionStrength", 1.0f);
+					for (int k = first; k < last; k++)
+					{
+						int i = extraMeshBodies[k];
+						cmd.setMat4("model", extraBodyModels[i]);
+						cmd.setMat4("prevModel", prevExtraBodyModels[i]);
+						cmd.drawIndexed(Primitive::Triangles, sphereVAO, sphereIndexCount);
+					}
+				});
+				renderDevice->submit(bodyLists);
+			}
 
-				planet.ring->setShader(&ringShader);
+			// 1-2b. 구 임포스터 (작게 보이는 행성 / 위성 / 소천체, 텍스처별 인스턴싱) ----
+			impostorShader.use();
+			impostorShader.setVec3("lightPos", glm::vec3(0.0f));
+			impostorShader.setVec3("lightColor", glm::vec3(1.0f, 1.0f, 0.9f));
+			impostorShader.setVec3("viewPos", cam.getPosition());
+			impostorShader.setFloat("sunRadius", SUN_RENDER_RADIUS);
+			impostorShader.setMat4("currViewProj", upscaler.getViewProj());
+			impostorShader.setMat4("prevViewProj", upscaler.getPrevViewProj());
+			impostors.render(view, sceneProj);
+
+			// 1-2c. 소천체 벨트 (점 스프라이트, 드로우 1번) ----------------------
+			beltShader.use();
+			beltShader.setVec3("lightPos", glm::vec3(0.0f));
+			beltShader.setVec3("lightColor", glm::vec3(1.0f, 1.0f, 0.9f));
+			beltShader.setVec3("viewPos", cam.getPosition());
+			beltShader.setMat4("currViewProj", upscaler.getViewProj());
+			beltShader.setMat4("prevViewProj", upscaler.getPrevViewProj());
+			belt.render(view, sceneProj, simYears, SCALE_UNITS, cam.getFOV(), sceneH);
+
+			// 대기 / 고리 셰이더는 Velocity 를 쓰지 않음 → 업스케일 타깃의 움직임 벡터(2번)는 잠금
+			//  (아래 천체의 값이나 VELOCITY_UNWRITTEN 이 남아 깊이 + 카메라 재투영으로 처리됨)
+			glColorMaski(2, GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+
+			// 1-3. 대기 (산란광 더하기 + 뒤쪽 감쇠) ------------------------
+			atmosphere.render(view, sceneProj, cam.getPosition(), glm::vec3(0.0f), sphereVAO, sphereIndexCount);
+
+			// 1-4. 고리 (반투명, 먼 것부터 한 번의 인스턴싱 드로우) ------------
+			ringShader.use();
+			ringShader.setVec3("lightPos", glm::vec3(0.0f));
+			ringShader.setFloat("sunRadius", SUN_RENDER_RADIUS);
+			ringCasters.apply(ringShader);
+			ringRenderer.render(view, sceneProj, cam.getPosition(), cam.getFOV(), sceneH);
+			glColorMaski(2, GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+
+			// 1-5. 보조 화면 (조감 카메라, 일식 그림자 / 대기 / 고리 생략) -------------
+			if (insetOn)
+			{
+				ShadowCasters::applyEmpty(sceneShader);
+				atmosphere.applySurface(sceneShader, -1, glm::vec3(0.0f), 0.0f);
+				inset.record(insetList, bodies.worldPosition(bodies.planetBody(trackingIndex)),
+					sphereVAO, sphereIndexCount, ringRenderer.getTextureArray());
+				renderDevice->submit(insetList);
+			}
 
-				// ★ 알파 블렌딩 켜기
-				glEnable(GL_BLEND);
-				glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+			// 1-5b. 가상 텍스처 피드백 (저해상도 다시 그리기 → 비동기 리드백) -----------
+			virtualTextures.renderFeedback(view, sceneProj, sphereVAO, sphereIndexCount, sceneW, sceneH);
 
-				planet.ring->render(planetModel, view, proj);
+			glBindFramebuffer(GL_FRAMEBUFFER, 0);
 
-				// ★ 다시 끄기 (다른 렌더에 영향 X)
-				glDisable(GL_BLEND);
+			// 1-6. 업스케일 복원 (출력 해상도 히스토리) ---------------------
+			if (upscale)
+			{
+				upscaler.resolve(quadVAO);
+				sceneColorTex = upscaler.getOutputTexture();
+			}
+			else
+			{
+				sceneColorTex = colorBuffers[0].get();
 			}
+			glViewport(0, 0, SCR_WIDTH, SCR_HEIGHT);
 
-			// 행성별 위성 렌더링
-			renderSatellites(planet, sceneShader,
-				dt, simYears, SCALE_UNITS,
-				sphereVAO, sphereIndexCount,
-				planetWorldPos,
-				texMoon,
-				texEuropa,
-				texTitan);
-
-			// [추가] 루프 끝날 때 인덱스 증가
-			pIdx++;
-		}
+			// ================================
+			// 2) Bloom Blur
+			// ================================
+			horizontal = true;
+			bool first = true;
+			int passes = 10;
 
-		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+			blurShader.use();
+			glDisable(GL_DEPTH_TEST);
 
-		// ================================
-		// 2) Bloom Blur
-		// ================================
-		bool horizontal = true;
-		bool first = true;
-		int passes = 10;
+			// ★ 풀스크린 Quad VAO 바인딩
+			glBindVertexArray(quadVAO);
 
-		blurShader.use();
-		glDisable(GL_DEPTH_TEST);
+			for (int i = 0; i < passes; ++i)
+			{
+				glBindFramebuffer(GL_FRAMEBUFFER, pingFBO[horizontal].get());
+				blurShader.setBool("horizontal", horizontal);
 
-		// ★ 풀스크린 Quad VAO 바인딩
-		glBindVertexArray(quadVAO);
+				glActiveTexture(GL_TEXTURE0);
+				if (first)
+					glBindTexture(GL_TEXTURE_2D, upscale ? upscaler.getBrightTexture() : colorBuffers[1].get());
+				else
+					glBindTexture(GL_TEXTURE_2D, pingColor[!horizontal].get());
+				blurShader.setInt("image", 0);
 
-		for (int i = 0; i < passes; ++i)
-		{
-			glBindFramebuffer(GL_FRAMEBUFFER, pingFBO[horizontal]);
-			blurShader.setBool("horizontal", horizontal);
+				glDrawArrays(GL_TRIANGLES, 0, 6);
 
-			glActiveTexture(GL_TEXTURE0);
-			if (first)
-				glBindTexture(GL_TEXTURE_2D, colorBuffers[1]);
-			else
-				glBindTexture(GL_TEXTURE_2D, pingColor[!horizontal]);
-			blurShader.setInt("image", 0);
-
-			glDrawArrays(GL_TRIANGLES, 0, 6);
+				horizontal = !horizontal;
+				if (first) first = false;
+			}
 
-			horizontal = !horizontal;
-			if (first) first = false;
 		}
 
-		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		// 자동 노출: HDR 장면 → 히스토그램 → 노출값 (GPU 안에서만 처리)
+		if (autoExposureOn)
+			autoExposure.update(sceneColorTex, quadVAO, dt);
+
+		glBindFramebuffer(GL_FRAMEBUFFER, outputFBO);
 
 		// ================================
 		// 3) 기본 프레임버퍼: Skybox → Composite (기존 코드 유지)
@@ -1469,7 +2352,7 @@ int main()
 		skyShader.setMat4("proj", proj);
 
 		glActiveTexture(GL_TEXTURE0);
-		glBindTexture(GL_TEXTURE_2D, skyTex);
+		glBindTexture(GL_TEXTURE_2D, skyTex.get());
 		skyShader.setInt("skyTex", 0);
 
 		glBindVertexArray(sphereVAO);
@@ -1478,14 +2361,20 @@ int main()
 		// (2) Composite
 		finalShader.use();
 		glActiveTexture(GL_TEXTURE0);
-		glBindTexture(GL_TEXTURE_2D, colorBuffers[0]);
+		glBindTexture(GL_TEXTURE_2D, sceneColorTex);
 		finalShader.setInt("sceneTex", 0);
 
 		glActiveTexture(GL_TEXTURE1);
-		glBindTexture(GL_TEXTURE_2D, pingColor[!horizontal]);
+		glBindTexture(GL_TEXTURE_2D, pingColor[!horizontal].get());
 		finalShader.setInt("bloomTex", 1);
 		finalShader.setFloat("exposure", 1.2f);
 
+		glActiveTexture(GL_TEXTURE2);
+		glBindTexture(GL_TEXTURE_2D, autoExposure.getExposureTexture());
+		finalShader.setInt("exposureTex", 2);
+		finalShader.setInt("autoExposure", autoExposureOn ? 1 : 0);
+		glActiveTexture(GL_TEXTURE0);
+
 		glEnable(GL_BLEND);
 		glBlendFunc(GL_ONE, GL_ONE);
 
@@ -1498,15 +2387,15 @@ int main()
 		// ================================
 		// 4) 궤도 / 트레일 (모든 행성 루프 처리)
 		// ================================
-		glEnable(GL_DEPTH_TEST);
-
-		int planetIdx = 0;
-
-		// 다시 행성 리스트를 순회하며 궤적 그리기
-		for (auto& planet : planets)
+		// 행성계마다 작업 스레드에서 명령 목록을 기록하고, 여기서 순서대로 재생
+		trailLists.resize(planets.size());
+		commandRecorder.record(trailLists, [&](int planetIdx, CommandList& cmd)
 		{
+			cmd.reset();
+			Planet& planet = planets[planetIdx];
+
 			// 행성 궤적 (white + green)
-			planet.drawTrail(lineShader, view, proj, simYears);
+			planet.drawTrail(cmd, lineShader, view, proj, simYears);
 			// -----------------------------------------------------
 			// 위성 궤도 트레일 렌더링
 			// -----------------------------------------------------
@@ -1514,14 +2403,13 @@ int main()
 			{
 				glm::mat4 satTrailModel =
 					glm::translate(glm::mat4(1.0f),
-						planetWorldPositions[planetIdx]);
+						bodies.worldPosition(bodies.planetBody(planetIdx)));
 
 				// 위성 궤적 (white + green)
-				sat.drawTrail(lineShader, view, proj, satTrailModel, simYears);
+				sat.drawTrail(cmd, lineShader, view, proj, satTrailModel, simYears);
 			}
-
-			planetIdx++;
-		}
+		});
+		renderDevice->submit(trailLists);
 
 		// ==============================
 		// ★ 선택된 행성의 자전축 렌더링
@@ -1534,20 +2422,52 @@ int main()
 				Planet& P = plist[trackingIndex];
 
 				// 1) 행성 위치 구하기 (이미 업데이트된 worldPos 저장되어 있어야 함)
-				glm::vec3 pos = planetWorldPositions[trackingIndex];
+				glm::vec3 pos = bodies.worldPosition(bodies.planetBody(trackingIndex));
 
 				// 2) 행성의 자전축 방향 계산
 				float tilt = P.getParams().axialTiltDeg;
 				glm::vec3 axisDir = computeAxisDir(tilt);
 
 				// 3) 선 그리기
-				drawAxisLine(pos, axisDir,
+				overlayList.reset();
+				drawAxisLine(overlayList, pos, axisDir,
 					axisShader,
 					cam.getViewMatrix(),
 					proj);
+				renderDevice->submit(overlayList);
 			}
 		}
 
+		// 추적 중이면 보조 화면을 오른쪽 아래에 합성 (장면을 건너뛴 프레임은 지난 결과 재사용)
+		if (trackingIndex >= 0 && trackingIndex < (int)planets.size())
+		{
+			inset.composite(outputFBO, SCR_WIDTH, SCR_HEIGHT, quadVAO,
+				autoExposure.getExposureTexture(), autoExposureOn, 1.2f);
+		}
+
+		// 합성이 끝난 프레임을 PBO 로 비동기 리드백
+		if (capture.isRecording())
+			capture.captureFrame(outputFBO);
+
+		// 서버 모드: 같은 프레임을 공유 메모리 슬롯에 공개하고 클라이언트에 알림
+		if (frameServer.isRunning())
+			frameServer.publishFrame(outputFBO, simYears);
+
+		if (!firstFrameReported)
+		{
+			// glfwInit 부터 첫 프레임 합성까지 (텍스처 디코딩은 기다리지 않음)
+			std::cout << "[Startup] First frame after " << (int)(glfwGetTime() * 1000.0) << " ms ("
+				<< TextureStreamer::pendingCount() << " textures still loading)\n";
+			firstFrameReported = true;
+		}
+
+		if (bench.headless)
+		{
+			frameStats.endFrame();
+			frameIndex++;
+			continue;
+		}
+
 		// ===========================
 		// Update Window Title (Show Speed)
 		// ===========================
@@ -1558,7 +2478,76 @@ int main()
 			glfwSetWindowTitle(window, ss.str().c_str());
 		}
 
+		if (pacer.isEnabled())
+		{
+			// 작업 시간 예측용: 스왑 (수직 동기 대기) 전에 렌더 완료 시점만 기록
+			glFinish();
+			pacer.markRenderDone();
+		}
+
 		glfwSwapBuffers(window);
-		glfwPollEvents();
+
+		if (pacer.isEnabled())
+		{
+			// 드라이버가 프레임을 앞서 쌓지 않게 표시 완료까지 기다림 (큐 깊이 1)
+			glFinish();
+			pacer.markPresented();
+		}
+		else
+		{
+			glfwPollEvents();
+		}
+	}
+
+	capture.stop();
+	frameServer.stop();
+	gRedraw = nullptr;
+
+	terrain.shutdown();
+	terrain.report(std::cout);
+	if (TextureStreamer::isRunning())
+	{
+		TextureStreamer::stop();
+		TextureStreamer::report(std::cout);
+	}
+	gTerrain = nullptr;
+	virtualTextures.shutdown();
+	virtualTextures.report(std::cout);
+	gVirtualTextures = nullptr;
+
+	if (!bench.headless)
+	{
+		std::cout << "[Redraw] " << redrawTracker.getSceneFrames() << " scene, "
+			<< redrawTracker.getCompositeFrames() << " composite-only, "
+			<< redrawTracker.getIdleFrames() << " idle frames\n";
+		pacer.report(std::cout);
 	}
+
+	if (bench.headless)
+	{
+		glFinish();
+		frameStats.finish();
+		std::cout << "[Benchmark] " << SCR_WIDTH << "x" << SCR_HEIGHT
+			<< ", dt " << bench.fixedDtSec << " s, speed x" << bench.simSpeed
+			<< ", simulated " << simYears << " years\n";
+		frameStats.report(std::cout, bench.warmupFrames);
+		if (!bench.serveSocket.empty())
+			frameServer.report(std::cout);
+
+		const RenderDevice::Stats& rs = renderDevice->getStats();
+		long long stateTotal = rs.stateChanges + rs.stateSkipped;
+		std::cout << "[RenderDevice] " << renderDevice->getName() << ": " << rs.draws << " draws, "
+			<< rs.stateChanges << " state changes, " << rs.stateSkipped << " redundant skipped ("
+			<< (stateTotal > 0 ? 100.0 * rs.stateSkipped / stateTotal : 0.0) << "%), "
+			<< commandRecorder.getThreadCount() << " recording threads\n";
+	}
+	commandRecorder.stop();
+
+	// GPU 메모리 사용량 보고 후 남은 GL 오브젝트 정리 (컨텍스트가 살아 있을 때)
+	TextureCache::report(std::cout);
+	GpuRegistry::report(std::cout);
+	GpuRegistry::shutdown();
+
+	glfwTerminate();
+	return 0;
 }
@@ -1,112 +1,246 @@
 ﻿#include "planetRing.h"
 #include "Shader.h"
+#include "Texture.h"
 
 #include <GL/glew.h>
 #include <glm/glm.hpp>
-#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/constants.hpp>
 
-#include <vector>
+#include <algorithm>
 #include <cmath>
+#include <cstddef>
 
-PlanetRing::PlanetRing()
-    : vao(0), vbo(0), textureID(0),
-    innerRadius(1.0f), outerRadius(1.5f),
-    alpha(1.0f), shader(nullptr)
+// 공용 메쉬에 미리 만들어 두는 분할 수 (작은 것부터)
+static const int RING_LODS[] = { 32, 64, 128, 256, 512, 1024 };
+
+RingRenderer::RingRenderer()
+    : instanceCapacity(0),
+    lastSegments(0), shader(nullptr)
 {
 }
 
-PlanetRing::~PlanetRing()
+RingRenderer::~RingRenderer()
 {
 }
 
-void PlanetRing::setShader(Shader* shaderPtr)
+void RingRenderer::setShader(Shader* shaderPtr)
 {
     shader = shaderPtr;
 }
 
-void PlanetRing::init(unsigned int texID,
-    float innerR,
-    float outerR,
-    float alphaVal)
+int RingRenderer::addLayer(const std::string& texturePath)
 {
-    textureID = texID;       // main.cpp에서 전달됨
-    innerRadius = innerR;
-    outerRadius = outerR;
-    alpha = alphaVal;
+    for (int i = 0; i < (int)layerPaths.size(); i++)
+    {
+        if (layerPaths[i] == texturePath)
+            return i;
+    }
+
+    layerPaths.push_back(texturePath);
+    return (int)layerPaths.size() - 1;
+}
+
+void RingRenderer::init()
+{
+    createMesh();
+
+    // 인스턴스 버퍼: 매 프레임 다시 채움
+    instanceVBO = GpuBuffer("ring instances");
+
+    glBindVertexArray(vao.get());
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVBO.get());
+    glBufferData(GL_ARRAY_BUFFER, 0, nullptr, GL_STREAM_DRAW);
+
+    // location 2 : 내경, 외경, 투명도, 레이어
+    glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE,
+        sizeof(Instance), (void*)offsetof(Instance, params));
+    glEnableVertexAttribArray(2);
+    glVertexAttribDivisor(2, 1);
+
+    // location 3~6 : 모델 행렬 (열 4개)
+    for (int c = 0; c < 4; c++)
+    {
+        glVertexAttribPointer(3 + c, 4, GL_FLOAT, GL_FALSE,
+            sizeof(Instance),
+            (void*)(offsetof(Instance, model) + sizeof(glm::vec4) * c));
+        glEnableVertexAttribArray(3 + c);
+        glVertexAttribDivisor(3 + c, 1);
+    }
+
+    glBindVertexArray(0);
 
-    createMesh(512);
+    textureArray = loadTextureArray(layerPaths);
 }
 
-void PlanetRing::createMesh(int segments)
+void RingRenderer::createMesh()
 {
+    // 반지름 1 고리: (cos, sin) + (u = 반지름 방향 0/1, v = 각도 방향)
+    //  - 실제 내경/외경은 정점 셰이더에서 인스턴스 값으로 적용
     std::vector<float> verts;
-    verts.reserve((segments + 1) * 2 * 5);
 
-    for (int i = 0; i <= segments; i++)
+    lodSegments.clear();
+    lodFirst.clear();
+    lodCount.clear();
+
+    for (int segments : RING_LODS)
     {
-        float t = float(i) / segments;              // 0~1, 각도 비율
-        float ang = t * glm::two_pi<float>();
-
-        float c = cos(ang);
-        float s = sin(ang);
-
-        // inner (반지름 0쪽)
-        verts.push_back(c * innerRadius);
-        verts.push_back(0.0f);
-        verts.push_back(s * innerRadius);
-        verts.push_back(0.0f);   // u = 반지름 방향 (안쪽)
-        verts.push_back(t);      // v = 각도 방향 (둘레)
-
-        // outer (반지름 1쪽)
-        verts.push_back(c * outerRadius);
-        verts.push_back(0.0f);
-        verts.push_back(s * outerRadius);
-        verts.push_back(1.0f);   // u = 반지름 방향 (바깥쪽)
-        verts.push_back(t);      // v = 각도 방향 (둘레)
+        lodSegments.push_back(segments);
+        lodFirst.push_back((int)(verts.size() / 4));
+        lodCount.push_back((segments + 1) * 2);
+
+        for (int i = 0; i <= segments; i++)
+        {
+            float t = float(i) / segments;              // 0~1, 각도 비율
+            float ang = t * glm::two_pi<float>();
+
+            float c = cos(ang);
+            float s = sin(ang);
+
+            // inner
+            verts.push_back(c);
+            verts.push_back(s);
+            verts.push_back(0.0f);   // u = 반지름 방향 (안쪽)
+            verts.push_back(t);      // v = 각도 방향 (둘레)
+
+            // outer
+            verts.push_back(c);
+            verts.push_back(s);
+            verts.push_back(1.0f);   // u = 반지름 방향 (바깥쪽)
+            verts.push_back(t);      // v = 각도 방향 (둘레)
+        }
     }
 
-    glGenVertexArrays(1, &vao);
-    glGenBuffers(1, &vbo);
+    vao = GpuVertexArray("ring mesh VAO");
+    vbo = GpuBuffer("ring mesh");
 
-    glBindVertexArray(vao);
-    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    glBindVertexArray(vao.get());
+    glBindBuffer(GL_ARRAY_BUFFER, vbo.get());
 
     glBufferData(GL_ARRAY_BUFFER,
         verts.size() * sizeof(float),
         verts.data(),
         GL_STATIC_DRAW);
+    vbo.setBytes(verts.size() * sizeof(float));
 
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE,
-        5 * sizeof(float), (void*)0);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE,
+        4 * sizeof(float), (void*)0);
     glEnableVertexAttribArray(0);
 
     glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE,
-        5 * sizeof(float), (void*)(3 * sizeof(float)));
+        4 * sizeof(float), (void*)(2 * sizeof(float)));
     glEnableVertexAttribArray(1);
 
     glBindVertexArray(0);
 }
 
-void PlanetRing::render(const glm::mat4& planetModel,
-    const glm::mat4& view,
-    const glm::mat4& proj)
+void RingRenderer::begin()
 {
-    if (!shader) return;
+    instances.clear();
+}
 
+void RingRenderer::add(const glm::mat4& planetModel,
+    float innerR,
+    float outerR,
+    float alpha,
+    int layer)
+{
+    if (layer < 0) return;
+
+    Instance inst;
+    inst.params = glm::vec4(innerR, outerR, alpha, (float)layer);
+    inst.model = planetModel;   // 행성의 modelMatrix를 그대로 사용 (추가 회전 X)
+    instances.push_back(inst);
+}
+
+void RingRenderer::render(const glm::mat4& view,
+    const glm::mat4& proj,
+    const glm::vec3& camPos,
+    float fovDeg,
+    int viewportHeight)
+{
+    if (!shader || instances.empty() || !textureArray) return;
+
+    int n = (int)instances.size();
+
+    // 1) 카메라 거리 계산 + 화면상 크기로 분할 수 결정
+    //    - 반지름 r 픽셀인 원을 N 분할하면 현의 오차 ≈ r * (π/N)^2 / 2
+    //    - 오차를 0.5 픽셀 이하로 유지하려면 N ≥ π * sqrt(r)
+    float pixelsPerUnit = (viewportHeight * 0.5f) / tan(glm::radians(fovDeg) * 0.5f);
+    float maxRadiusPx = 0.0f;
+
+    sortKeys.resize(n);
+    order.resize(n);
+
+    for (int i = 0; i < n; i++)
+    {
+        const Instance& inst = instances[i];
+
+        glm::vec3 center = glm::vec3(inst.model[3]);
+        float scale = glm::length(glm::vec3(inst.model[0]));
+        float outerWorld = inst.params.y * scale;
+
+        float dist = glm::distance(center, camPos);
+        sortKeys[i] = dist;
+        order[i] = i;
+
+        // 카메라가 고리 안에 있으면 가장 촘촘하게
+        float radiusPx = (dist > outerWorld)
+            ? outerWorld / dist * pixelsPerUnit
+            : (float)viewportHeight * 4.0f;
+        maxRadiusPx = std::max(maxRadiusPx, radiusPx);
+    }
+
+    int wanted = (int)ceil(glm::pi<float>() * sqrt(maxRadiusPx));
+    int lod = (int)lodSegments.size() - 1;
+    for (int i = 0; i < (int)lodSegments.size(); i++)
+    {
+        if (lodSegments[i] >= wanted)
+        {
+            lod = i;
+            break;
+        }
+    }
+    lastSegments = lodSegments[lod];
+
+    // 2) 먼 고리부터 (back-to-front) 그리도록 정렬
+    std::sort(order.begin(), order.end(),
+        [this](int a, int b) { return sortKeys[a] > sortKeys[b]; });
+
+    sorted.resize(n);
+    for (int i = 0; i < n; i++)
+        sorted[i] = instances[order[i]];
+
+    if (n > instanceCapacity)
+    {
+        instanceCapacity = n;
+        instanceVBO.setBytes(instanceCapacity * sizeof(Instance));
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVBO.get());
+    glBufferData(GL_ARRAY_BUFFER, instanceCapacity * sizeof(Instance), nullptr, GL_STREAM_DRAW); // orphan
+    glBufferSubData(GL_ARRAY_BUFFER, 0, n * sizeof(Instance), sorted.data());
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    // 3) 한 번의 드로우콜
     shader->use();
     shader->setMat4("view", view);
     shader->setMat4("proj", proj);
 
-    // 행성의 modelMatrix를 그대로 사용 (추가 회전 X)
-    glm::mat4 model = planetModel;
-
-    shader->setMat4("model", model);
-    shader->setFloat("alpha", alpha);
-
     glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, textureID);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, textureArray.get());
     shader->setInt("ringTex", 0);
 
-    glBindVertexArray(vao);
-    glDrawArrays(GL_TRIANGLE_STRIP, 0, (512 + 1) * 2);
-}
\ No newline at end of file
+    // ★ 알파 블렌딩 켜기 (깊이 테스트는 유지, 쓰기만 끔)
+    glEnable(GL_BLEND);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glDepthMask(GL_FALSE);
+
+    glBindVertexArray(vao.get());
+    glDrawArraysInstanced(GL_TRIANGLE_STRIP, lodFirst[lod], lodCount[lod], n);
+    glBindVertexArray(0);
+
+    // ★ 다시 끄기 (다른 렌더에 영향 X)
+    glDepthMask(GL_TRUE);
+    glDisable(GL_BLEND);
+    glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+}
@@ -1,43 +1,80 @@
 #pragma once
 #include <string>
+#include <vector>
 #include <glm/glm.hpp>
 
+#include "GpuResource.h"
+#include "TextureCache.h"
+
 class Shader;
 
 // ====================================================
-// PlanetRing
-//  -  ޽  
-//  - ؽó ε ܺ(main.cpp/Planet.cpp) 
+// RingRenderer
+//  -  ༺    νϽ ο 
+//  - ޽:  1 ¥  (annulus) ϳ LOD  
+//  - νϽ:   + (, ܰ, , ؽó ̾)
+//  - ؽó:   ؽó 2D 迭 ؽó   
 // ====================================================
-class PlanetRing
+class RingRenderer
 {
 public:
-    PlanetRing();
-    ~PlanetRing();
+    RingRenderer();
+    ~RingRenderer();
 
-    // ܺο textureID ޹޴ ʱȭ
-    void init(unsigned int texID,
-        float innerR,
-        float outerR,
-        float alpha = 1.0f);
+    //  ؽó  ( δ  ̾ ȯ) - init()  ȣ
+    int addLayer(const std::string& texturePath);
+
+    //  ޽ / νϽ  / 迭 ؽó 
+    void init();
 
     // ringShader 
     void setShader(Shader* shaderPtr);
 
-    // 
-    void render(const glm::mat4& planetModel,
-        const glm::mat4& view,
-        const glm::mat4& proj);
+    // Ӹ: begin() -> add() * N -> render()
+    void begin();
+    void add(const glm::mat4& planetModel,
+        float innerR,
+        float outerR,
+        float alpha,
+        int layer);
+
+    // ī޶󿡼        ׸
+    //  -   ȭ鿡 ̴  ũ(ȼ) 
+    void render(const glm::mat4& view,
+        const glm::mat4& proj,
+        const glm::vec3& camPos,
+        float fovDeg,
+        int viewportHeight);
+
+    int getLastSegments() const { return lastSegments; }
+    unsigned int getTextureArray() const { return textureArray.get(); }
 
 private:
-    unsigned int vao, vbo;       //  ޽
-    unsigned int textureID;      // ο ޵ ؽó ID
+    struct Instance
+    {
+        glm::vec4 params;   // , ܰ, , ̾
+        glm::mat4 model;
+    };
+
+    GpuVertexArray vao;          //   ޽ ( LOD  ̾ )
+    GpuBuffer vbo;
+    GpuBuffer instanceVBO;       // νϽ 
+    int instanceCapacity;        // instanceVBO  Ҵ νϽ 
+    TextureRef textureArray;     //  ؽó 迭 (TextureCache )
+
+    std::vector<int> lodSegments; // LOD   
+    std::vector<int> lodFirst;    // LOD   
+    std::vector<int> lodCount;    // LOD   
+
+    std::vector<std::string> layerPaths;
+    std::vector<Instance> instances;
+    std::vector<float> sortKeys;
+    std::vector<int> order;
+    std::vector<Instance> sorted;
 
-    float innerRadius;
-    float outerRadius;
-    float alpha;
+    int lastSegments;
 
     Shader* shader;
 
-    void createMesh(int segments);
+    void createMesh();
 };
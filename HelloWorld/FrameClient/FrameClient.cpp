@@ -0,0 +1,316 @@
+﻿// =====================================================
+// FrameClient — 프레임 서버(--serve) 시험용 로컬 클라이언트
+//  - 소켓으로 명령을 보내고 공유 메모리 슬롯의 프레임을 복사 없이 읽음
+//  - render 모드: 프레임마다 카메라를 옮기고 render 요청
+//                 → 요청부터 픽셀을 읽을 수 있을 때까지의 왕복 지연
+//  - stream 모드: stream N 으로 연속 렌더링
+//                 → 처리량(fps)과 공개 시점부터 수신까지의 지연
+//  - 프로토콜: ../ConsoleApplication1/FrameServerProtocol.h
+//
+// 빌드 (Linux):
+//  g++ -std=c++14 -O2 -I../ConsoleApplication1 FrameClient.cpp -o FrameClient
+// 사용:
+//  FrameClient SOCKET [--frames N] [--mode render|stream|both] [--quit]
+// =====================================================
+#include "FrameServerProtocol.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <time.h>
+#include <unistd.h>
+
+using frameserver::RingHeader;
+using frameserver::SlotHeader;
+
+static uint64_t monotonicNs()
+{
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+// -------------------------------------------------------------
+// 명령 소켓 (줄 단위)
+// -------------------------------------------------------------
+struct Connection
+{
+    int fd = -1;
+    std::string inBuf;
+
+    bool open(const char* path)
+    {
+        sockaddr_un addr;
+        memset(&addr, 0, sizeof(addr));
+        addr.sun_family = AF_UNIX;
+        if (strlen(path) >= sizeof(addr.sun_path)) return false;
+        strcpy(addr.sun_path, path);
+
+        fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        return fd >= 0 && connect(fd, (sockaddr*)&addr, sizeof(addr)) == 0;
+    }
+
+    bool send(const std::string& line)
+    {
+        std::string msg = line + "\n";
+        return ::send(fd, msg.data(), msg.size(), MSG_NOSIGNAL) == (ssize_t)msg.size();
+    }
+
+    bool readLine(std::string& line)
+    {
+        for (;;)
+        {
+            size_t eol = inBuf.find('\n');
+            if (eol != std::string::npos)
+            {
+                line.assign(inBuf, 0, eol);
+                inBuf.erase(0, eol + 1);
+                return true;
+            }
+            char buf[4096];
+            ssize_t n = recv(fd, buf, sizeof(buf), 0);
+            if (n <= 0) return false;
+            inBuf.append(buf, (size_t)n);
+        }
+    }
+};
+
+// -------------------------------------------------------------
+// 프레임 링 (공유 메모리)
+// -------------------------------------------------------------
+struct FrameRing
+{
+    RingHeader* header = nullptr;
+    size_t bytes = 0;
+    long long torn = 0;     // 읽으려던 프레임이 이미 덮어쓰인 횟수
+
+    bool open(const std::string& name)
+    {
+        int fd = shm_open(name.c_str(), O_RDWR, 0);
+        if (fd < 0) return false;
+
+        // 먼저 헤더만 보고 전체 크기를 알아낸 뒤 다시 맵핑
+        void* mem = mmap(nullptr, sizeof(RingHeader), PROT_READ, MAP_SHARED, fd, 0);
+        if (mem == MAP_FAILED) { close(fd); return false; }
+        const RingHeader* h = (const RingHeader*)mem;
+        bool ok = h->magic == frameserver::MAGIC && h->version == frameserver::VERSION;
+        bytes = (size_t)(h->dataOffset + h->slotBytes * h->slotCount);
+        munmap(mem, sizeof(RingHeader));
+        if (!ok) { close(fd); return false; }
+
+        // readingSlot 을 써야 하므로 읽기 / 쓰기로 맵핑
+        mem = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+        if (mem == MAP_FAILED) return false;
+        header = (RingHeader*)mem;
+        return true;
+    }
+
+    // 슬롯을 고정하고 기대한 프레임이면 픽셀 포인터 반환 (다 쓰면 release)
+    const unsigned char* acquire(int slot, uint64_t seq)
+    {
+        header->readingSlot.store(slot);
+        if (header->slots[slot].seq.load() != seq)
+        {
+            header->readingSlot.store(-1);
+            torn++;
+            return nullptr;
+        }
+        return (const unsigned char*)header + header->dataOffset + header->slotBytes * (size_t)slot;
+    }
+
+    void release() { header->readingSlot.store(-1); }
+};
+
+// 픽셀을 실제로 읽었다는 증거 (전체 바이트 합)
+static uint64_t checksum(const unsigned char* p, size_t n)
+{
+    uint64_t sum = 0;
+    for (size_t i = 0; i < n; i++) sum += p[i];
+    return sum;
+}
+
+static double percentile(std::vector<double> v, double p)
+{
+    if (v.empty()) return 0.0;
+    std::sort(v.begin(), v.end());
+    size_t idx = (size_t)(p * (double)(v.size() - 1) + 0.5);
+    return v[std::min(idx, v.size() - 1)];
+}
+
+static void printLatency(const char* label, const std::vector<double>& ms)
+{
+    if (ms.empty()) return;
+    double sum = 0.0;
+    for (double v : ms) sum += v;
+    printf("  %-8s avg %8.3f  p50 %8.3f  p95 %8.3f  p99 %8.3f  max %8.3f ms\n", label,
+        sum / ms.size(), percentile(ms, 0.50), percentile(ms, 0.95), percentile(ms, 0.99),
+        percentile(ms, 1.0));
+}
+
+// "frame SEQ SLOT TAG" 응답 파싱
+static bool parseFrame(const std::string& line, uint64_t& seq, int& slot, uint64_t& tag)
+{
+    unsigned long long s = 0, t = 0;
+    if (sscanf(line.c_str(), "frame %llu %d %llu", &s, &slot, &t) != 3) return false;
+    seq = s;
+    tag = t;
+    return true;
+}
+
+// -------------------------------------------------------------
+// render 모드: 요청 → 응답 → 픽셀 읽기 까지의 왕복 시간
+// -------------------------------------------------------------
+static bool runRender(Connection& conn, FrameRing& ring, int frames)
+{
+    std::vector<double> rttMs;
+    uint64_t sum = 0;
+    uint64_t start = monotonicNs();
+
+    for (int i = 0; i < frames; i++)
+    {
+        // 태양 주위를 한 바퀴 도는 카메라 (프레임마다 장면이 바뀜)
+        float a = 6.2831853f * (float)i / (float)frames;
+        char cmd[128];
+        snprintf(cmd, sizeof(cmd), "camera %.3f 60 %.3f 0 0 0", 200.0f * cosf(a), 200.0f * sinf(a));
+
+        uint64_t t0 = monotonicNs();
+        if (!conn.send(cmd) || !conn.send("render " + std::to_string(i + 1)))
+            return false;
+
+        std::string line;
+        uint64_t seq = 0, tag = 0;
+        int slot = -1;
+        do
+        {
+            if (!conn.readLine(line)) return false;
+        } while (!parseFrame(line, seq, slot, tag) || tag != (uint64_t)(i + 1));
+
+        const unsigned char* pixels = ring.acquire(slot, seq);
+        if (pixels)
+        {
+            sum += checksum(pixels, ring.header->slotBytes);
+            ring.release();
+        }
+        rttMs.push_back((monotonicNs() - t0) / 1.0e6);
+    }
+
+    double sec = (monotonicNs() - start) / 1.0e9;
+    printf("[render] %d frames in %.3f s (%.1f fps), checksum %llu\n",
+        frames, sec, frames / sec, (unsigned long long)sum);
+    printLatency("RTT", rttMs);
+    return true;
+}
+
+// -------------------------------------------------------------
+// stream 모드: 연속 렌더링 처리량 + 공개 → 수신 지연
+// -------------------------------------------------------------
+static bool runStream(Connection& conn, FrameRing& ring, int frames)
+{
+    std::vector<double> latencyMs;
+    uint64_t sum = 0;
+    uint64_t start = monotonicNs();
+
+    if (!conn.send("track 2") || !conn.send("stream " + std::to_string(frames)))
+        return false;
+
+    int received = 0;
+    while (received < frames)
+    {
+        std::string line;
+        if (!conn.readLine(line)) return false;
+
+        uint64_t seq = 0, tag = 0;
+        int slot = -1;
+        if (!parseFrame(line, seq, slot, tag)) continue;
+        received++;
+
+        const unsigned char* pixels = ring.acquire(slot, seq);
+        if (!pixels) continue;
+
+        uint64_t published = ring.header->slots[slot].publishNs;
+        sum += checksum(pixels, ring.header->slotBytes);
+        ring.release();
+        latencyMs.push_back((monotonicNs() - published) / 1.0e6);
+    }
+
+    double sec = (monotonicNs() - start) / 1.0e9;
+    printf("[stream] %d frames in %.3f s (%.1f fps), checksum %llu\n",
+        frames, sec, frames / sec, (unsigned long long)sum);
+    printLatency("publish", latencyMs);
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        fprintf(stderr, "usage: FrameClient SOCKET [--frames N] [--mode render|stream|both] [--quit]\n");
+        return 1;
+    }
+
+    const char* socketPath = argv[1];
+    int frames = 120;
+    std::string mode = "both";
+    bool sendQuit = false;
+    for (int i = 2; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc) frames = std::max(1, atoi(argv[++i]));
+        else if (strcmp(argv[i], "--mode") == 0 && i + 1 < argc) mode = argv[++i];
+        else if (strcmp(argv[i], "--quit") == 0) sendQuit = true;
+        else
+        {
+            fprintf(stderr, "[FrameClient] Unknown argument: %s\n", argv[i]);
+            return 1;
+        }
+    }
+
+    Connection conn;
+    if (!conn.open(socketPath))
+    {
+        fprintf(stderr, "[FrameClient] Cannot connect to %s\n", socketPath);
+        return 1;
+    }
+
+    // hello W H SLOTS SHM_NAME
+    std::string line;
+    int w = 0, h = 0, slots = 0;
+    char shmName[256] = { 0 };
+    if (!conn.readLine(line) ||
+        sscanf(line.c_str(), "hello %d %d %d %255s", &w, &h, &slots, shmName) != 4)
+    {
+        fprintf(stderr, "[FrameClient] Unexpected greeting: %s\n", line.c_str());
+        return 1;
+    }
+
+    FrameRing ring;
+    if (!ring.open(shmName))
+    {
+        fprintf(stderr, "[FrameClient] Cannot map frame ring %s\n", shmName);
+        return 1;
+    }
+    printf("[FrameClient] %dx%d, %d slots in %s\n", w, h, slots, shmName);
+
+    bool ok = true;
+    if (mode == "render" || mode == "both") ok = ok && runRender(conn, ring, frames);
+    if (mode == "stream" || mode == "both") ok = ok && runStream(conn, ring, frames);
+    if (!ok)
+    {
+        fprintf(stderr, "[FrameClient] Connection lost\n");
+        return 1;
+    }
+    printf("  torn reads: %lld\n", ring.torn);
+
+    if (sendQuit)
+        conn.send("quit");
+    return 0;
+}
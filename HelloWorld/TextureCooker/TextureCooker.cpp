@@ -0,0 +1,206 @@
+﻿// =====================================================
+// TextureCooker — JPG / PNG 를 블록 압축 + 밉맵 컨테이너(.ctex)로 변환하는 오프라인 도구
+//  - 원본 옆에 같은 이름의 .ctex 를 만듦 (textures/2k_mars.jpg -> textures/2k_mars.ctex)
+//  - 렌더러는 .ctex 가 있으면 디코딩 / glGenerateMipmap 없이 맵핑해서 바로 올림
+//  - 형식 (--format auto 기본)
+//      BC1 : 알파 없는 이미지 (JPG 등)
+//      BC3 : 알파가 있는 이미지 (고리 PNG: 색 + 알파가 모두 필요)
+//      BC4 : 단일 채널 이미지 (회색조 PNG, 또는 --format bc4 로 알파만 추출)
+//  - 밉 레벨은 1x1 까지 2x2 평균으로 만듦 (glGenerateMipmap 과 같은 박스 필터)
+//  - 컨테이너 형식: ../ConsoleApplication1/CookedTexture.h
+//
+// 빌드:
+//  g++ -std=c++14 -O2 -I../ConsoleApplication1 -I"../../External Libs/utils" TextureCooker.cpp -o TextureCooker
+// 사용:
+//  TextureCooker [--format auto|bc1|bc3|bc4] [--fast] FILE...
+//  예) TextureCooker textures/*.jpg textures/*.png
+// =====================================================
+#ifdef _WIN32
+#define _CRT_SECURE_NO_WARNINGS
+#endif
+
+#include "CookedTexture.h"
+
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_image.h"
+#define STB_IMAGE_RESIZE_IMPLEMENTATION
+#include "stb_image_resize2.h"
+#define STB_DXT_IMPLEMENTATION
+#include "stb_dxt.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+struct Level
+{
+    int width, height;
+    std::vector<unsigned char> pixels;   // RGBA8 (BC4 는 1 채널)
+};
+
+// 블록 하나 (4x4) 를 가장자리 픽셀로 채워서 압축 (크기가 4 의 배수가 아닌 레벨용)
+static void encodeLevel(const Level& lv, ctex::Format format, int dxtMode,
+    std::vector<unsigned char>& out)
+{
+    int bw = (lv.width + 3) / 4, bh = (lv.height + 3) / 4;
+    size_t blockSize = ctex::blockBytes(format);
+    out.resize((size_t)bw * bh * blockSize);
+
+    int channels = (format == ctex::Format::BC4) ? 1 : 4;
+    unsigned char block[16 * 4];
+
+    for (int by = 0; by < bh; by++)
+    {
+        for (int bx = 0; bx < bw; bx++)
+        {
+            for (int y = 0; y < 4; y++)
+            {
+                int sy = std::min(by * 4 + y, lv.height - 1);
+                for (int x = 0; x < 4; x++)
+                {
+                    int sx = std::min(bx * 4 + x, lv.width - 1);
+                    memcpy(block + (y * 4 + x) * channels,
+                        lv.pixels.data() + ((size_t)sy * lv.width + sx) * channels, channels);
+                }
+            }
+
+            unsigned char* dst = out.data() + ((size_t)by * bw + bx) * blockSize;
+            if (format == ctex::Format::BC4)
+                stb_compress_bc4_block(dst, block);
+            else
+                stb_compress_dxt_block(dst, block, format == ctex::Format::BC3 ? 1 : 0, dxtMode);
+        }
+    }
+}
+
+static bool cook(const std::string& path, const std::string& formatArg, int dxtMode)
+{
+    int w, h, srcChannels;
+    unsigned char* data = stbi_load(path.c_str(), &w, &h, &srcChannels, 4);
+    if (!data)
+    {
+        fprintf(stderr, "[Cooker] Failed to load %s: %s\n", path.c_str(), stbi_failure_reason());
+        return false;
+    }
+
+    ctex::Format format;
+    if (formatArg == "bc1") format = ctex::Format::BC1;
+    else if (formatArg == "bc3") format = ctex::Format::BC3;
+    else if (formatArg == "bc4") format = ctex::Format::BC4;
+    else if (srcChannels == 1) format = ctex::Format::BC4;
+    else if (srcChannels == 2 || srcChannels == 4) format = ctex::Format::BC3;
+    else format = ctex::Format::BC1;
+
+    // 레벨 0: BC4 는 한 채널만 (알파가 있으면 알파, 없으면 R)
+    std::vector<Level> levels(1);
+    levels[0].width = w;
+    levels[0].height = h;
+    if (format == ctex::Format::BC4)
+    {
+        int src = (srcChannels == 2 || srcChannels == 4) ? 3 : 0;
+        levels[0].pixels.resize((size_t)w * h);
+        for (size_t i = 0; i < (size_t)w * h; i++)
+            levels[0].pixels[i] = data[i * 4 + src];
+    }
+    else
+    {
+        levels[0].pixels.assign(data, data + (size_t)w * h * 4);
+    }
+    stbi_image_free(data);
+
+    // 밉 체인 (알파 가중 없이 채널별 평균 = glGenerateMipmap 과 같음)
+    stbir_pixel_layout layout = (format == ctex::Format::BC4) ? STBIR_1CHANNEL : STBIR_4CHANNEL;
+    int channels = (format == ctex::Format::BC4) ? 1 : 4;
+    while ((levels.back().width > 1 || levels.back().height > 1) && (int)levels.size() < ctex::MAX_LEVELS)
+    {
+        const Level& prev = levels.back();
+        Level next;
+        next.width = std::max(1, prev.width / 2);
+        next.height = std::max(1, prev.height / 2);
+        next.pixels.resize((size_t)next.width * next.height * channels);
+        stbir_resize_uint8_linear(prev.pixels.data(), prev.width, prev.height, 0,
+            next.pixels.data(), next.width, next.height, 0, layout);
+        levels.push_back(std::move(next));
+    }
+
+    // 파일 배치: 헤더 + 레벨 표 + 16 바이트 정렬된 레벨 데이터
+    ctex::FileHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = ctex::MAGIC;
+    header.version = ctex::VERSION;
+    header.format = (uint32_t)format;
+    header.width = (uint32_t)w;
+    header.height = (uint32_t)h;
+    header.levels = (uint32_t)levels.size();
+
+    std::vector<ctex::LevelEntry> table(levels.size());
+    std::vector<std::vector<unsigned char>> blocks(levels.size());
+    uint64_t offset = sizeof(header) + sizeof(ctex::LevelEntry) * table.size();
+    for (size_t i = 0; i < levels.size(); i++)
+    {
+        encodeLevel(levels[i], format, dxtMode, blocks[i]);
+        offset = (offset + 15) & ~(uint64_t)15;
+        table[i].width = (uint32_t)levels[i].width;
+        table[i].height = (uint32_t)levels[i].height;
+        table[i].offset = offset;
+        table[i].size = blocks[i].size();
+        offset += blocks[i].size();
+    }
+
+    std::string outPath = ctex::pathFor(path);
+    FILE* fp = fopen(outPath.c_str(), "wb");
+    if (!fp)
+    {
+        fprintf(stderr, "[Cooker] Cannot write %s\n", outPath.c_str());
+        return false;
+    }
+    fwrite(&header, sizeof(header), 1, fp);
+    fwrite(table.data(), sizeof(ctex::LevelEntry), table.size(), fp);
+    for (size_t i = 0; i < levels.size(); i++)
+    {
+        static const unsigned char zeros[16] = { 0 };
+        long pos = ftell(fp);
+        fwrite(zeros, 1, (size_t)(table[i].offset - (uint64_t)pos), fp);
+        fwrite(blocks[i].data(), 1, blocks[i].size(), fp);
+    }
+    bool ok = ferror(fp) == 0;
+    fclose(fp);
+
+    // 비교용: 런타임 RGB(A)8 업로드 + 밉맵 크기 (RGB 는 드라이버가 보통 4 바이트로 저장)
+    double rawMiB = (double)w * h * (channels == 1 ? 1 : 4) * 4.0 / 3.0 / (1024.0 * 1024.0);
+    const char* names[] = { "", "BC1", "", "BC3", "BC4" };
+    printf("%s -> %s: %dx%d, %d levels, %s, %.2f MiB (uncompressed + mips %.2f MiB)\n",
+        path.c_str(), outPath.c_str(), w, h, (int)levels.size(), names[(int)format],
+        offset / (1024.0 * 1024.0), rawMiB);
+    return ok;
+}
+
+int main(int argc, char** argv)
+{
+    std::string format = "auto";
+    int dxtMode = STB_DXT_HIGHQUAL;
+    std::vector<std::string> files;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--format") == 0 && i + 1 < argc) format = argv[++i];
+        else if (strcmp(argv[i], "--fast") == 0) dxtMode = STB_DXT_NORMAL;
+        else files.push_back(argv[i]);
+    }
+
+    if (files.empty() || (format != "auto" && format != "bc1" && format != "bc3" && format != "bc4"))
+    {
+        fprintf(stderr, "usage: TextureCooker [--format auto|bc1|bc3|bc4] [--fast] FILE...\n");
+        return 1;
+    }
+
+    int failed = 0;
+    for (const std::string& f : files)
+    {
+        if (!cook(f, format, dxtMode))
+            failed++;
+    }
+    return failed == 0 ? 0 : 1;
+}
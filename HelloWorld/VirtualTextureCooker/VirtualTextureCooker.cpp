@@ -0,0 +1,209 @@
+﻿// =====================================================
+// VirtualTextureCooker — 8k~16k 행성 텍스처를 가상 텍스처 타일 파일(.vtex)로 변환하는 오프라인 도구
+//  - 크기가 2 의 거듭제곱이 아니면 가장 가까운 2 의 거듭제곱으로 리샘플링
+//  - 레벨마다 2x2 평균으로 줄이고 PAGE x PAGE 페이지 + BORDER 테두리 타일로 잘라 BC1 압축
+//    (테두리: 가로는 경도 방향으로 반대편을, 세로는 가장자리 행을 반복)
+//  - 렌더러는 행성 텍스처 옆에 같은 이름의 .vtex 가 있으면 가상 텍스처로 그림
+//    예) textures/2k_earth_daymap.jpg -> textures/2k_earth_daymap.vtex
+//  - 파일 형식: ../ConsoleApplication1/VirtualTextureFormat.h
+//  - 원본 전체를 메모리에 올림 (16k x 8k 는 RGBA8 로 약 0.7 GiB)
+//
+// 빌드:
+//  g++ -std=c++14 -O2 -pthread -I../ConsoleApplication1 -I"../../External Libs/utils" VirtualTextureCooker.cpp -o VirtualTextureCooker
+// 사용:
+//  VirtualTextureCooker [--fast] IMAGE OUT.vtex
+//  예) VirtualTextureCooker 16k_earth_daymap.jpg ../ConsoleApplication1/textures/2k_earth_daymap.vtex
+// =====================================================
+#ifdef _WIN32
+#define _CRT_SECURE_NO_WARNINGS
+#endif
+
+#include "VirtualTextureFormat.h"
+
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_image.h"
+#define STB_IMAGE_RESIZE_IMPLEMENTATION
+#include "stb_image_resize2.h"
+#define STB_DXT_IMPLEMENTATION
+#include "stb_dxt.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct Level
+{
+    int width, height;
+    std::vector<unsigned char> pixels;   // RGBA8
+};
+
+static int nearestPowerOfTwo(int v)
+{
+    int p = 1;
+    while (p * 2 <= v) p *= 2;
+    return (v - p > p * 2 - v) ? p * 2 : p;
+}
+
+// 타일 하나: 테두리 포함 TILE x TILE 을 모아서 블록별로 BC1 압축
+static void encodeTile(const Level& lv, int pageX, int pageY, int dxtMode, unsigned char* out)
+{
+    const int blocks = vtex::TILE / 4;
+    unsigned char block[16 * 4];
+
+    int x0 = pageX * vtex::PAGE - vtex::BORDER;
+    int y0 = pageY * vtex::PAGE - vtex::BORDER;
+
+    for (int by = 0; by < blocks; by++)
+    {
+        for (int bx = 0; bx < blocks; bx++)
+        {
+            for (int y = 0; y < 4; y++)
+            {
+                int sy = std::min(std::max(y0 + by * 4 + y, 0), lv.height - 1);
+                for (int x = 0; x < 4; x++)
+                {
+                    int sx = ((x0 + bx * 4 + x) % lv.width + lv.width) % lv.width;
+                    memcpy(block + (y * 4 + x) * 4,
+                        lv.pixels.data() + ((size_t)sy * lv.width + sx) * 4, 4);
+                }
+            }
+            stb_compress_dxt_block(out + ((size_t)by * blocks + bx) * 8, block, 0, dxtMode);
+        }
+    }
+}
+
+static bool cook(const std::string& path, const std::string& outPath, int dxtMode)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    int w, h, srcChannels;
+    unsigned char* data = stbi_load(path.c_str(), &w, &h, &srcChannels, 4);
+    if (!data)
+    {
+        fprintf(stderr, "[VTCooker] Failed to load %s: %s\n", path.c_str(), stbi_failure_reason());
+        return false;
+    }
+
+    std::vector<Level> levels(1);
+    levels[0].width = std::max(nearestPowerOfTwo(w), vtex::PAGE);
+    levels[0].height = std::max(nearestPowerOfTwo(h), 4);
+    if (levels[0].width != w || levels[0].height != h)
+    {
+        levels[0].pixels.resize((size_t)levels[0].width * levels[0].height * 4);
+        stbir_resize_uint8_linear(data, w, h, 0, levels[0].pixels.data(),
+            levels[0].width, levels[0].height, 0, STBIR_4CHANNEL);
+    }
+    else
+    {
+        levels[0].pixels.assign(data, data + (size_t)w * h * 4);
+    }
+    stbi_image_free(data);
+
+    if (levels[0].width / vtex::PAGE > vtex::MAX_PAGES || levels[0].height / vtex::PAGE > vtex::MAX_PAGES)
+    {
+        fprintf(stderr, "[VTCooker] %s is too large (max %d texels per side)\n",
+            path.c_str(), vtex::MAX_PAGES * vtex::PAGE);
+        return false;
+    }
+
+    // 가장 거친 레벨 = 긴 변이 페이지 하나에 들어가는 레벨
+    while (std::max(levels.back().width, levels.back().height) > vtex::PAGE)
+    {
+        const Level& prev = levels.back();
+        Level next;
+        next.width = std::max(1, prev.width / 2);
+        next.height = std::max(1, prev.height / 2);
+        next.pixels.resize((size_t)next.width * next.height * 4);
+        stbir_resize_uint8_linear(prev.pixels.data(), prev.width, prev.height, 0,
+            next.pixels.data(), next.width, next.height, 0, STBIR_4CHANNEL);
+        levels.push_back(std::move(next));
+    }
+
+    // 레벨 표 + 타일 목록
+    struct TileRef { int level, x, y; };
+    std::vector<vtex::LevelEntry> table(levels.size());
+    std::vector<TileRef> tiles;
+    for (size_t i = 0; i < levels.size(); i++)
+    {
+        memset(&table[i], 0, sizeof(table[i]));
+        table[i].pagesX = (uint32_t)((levels[i].width + vtex::PAGE - 1) / vtex::PAGE);
+        table[i].pagesY = (uint32_t)((levels[i].height + vtex::PAGE - 1) / vtex::PAGE);
+        table[i].firstTile = (uint32_t)tiles.size();
+        for (uint32_t y = 0; y < table[i].pagesY; y++)
+            for (uint32_t x = 0; x < table[i].pagesX; x++)
+                tiles.push_back({ (int)i, (int)x, (int)y });
+    }
+
+    // 타일 압축 (스레드마다 다음 타일 번호를 가져감)
+    std::vector<unsigned char> blob(tiles.size() * vtex::TILE_BYTES);
+    std::atomic<size_t> next(0);
+    std::vector<std::thread> workers;
+    int threadCount = std::max(1, (int)std::thread::hardware_concurrency());
+    for (int t = 0; t < threadCount; t++)
+    {
+        workers.emplace_back([&]()
+        {
+            for (size_t i = next++; i < tiles.size(); i = next++)
+            {
+                const TileRef& r = tiles[i];
+                encodeTile(levels[r.level], r.x, r.y, dxtMode, blob.data() + i * vtex::TILE_BYTES);
+            }
+        });
+    }
+    for (auto& t : workers)
+        t.join();
+
+    vtex::FileHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = vtex::MAGIC;
+    header.version = vtex::VERSION;
+    header.width = (uint32_t)levels[0].width;
+    header.height = (uint32_t)levels[0].height;
+    header.levels = (uint32_t)levels.size();
+    header.tileCount = (uint32_t)tiles.size();
+    header.dataOffset = sizeof(header) + sizeof(vtex::LevelEntry) * table.size();
+
+    FILE* fp = fopen(outPath.c_str(), "wb");
+    if (!fp)
+    {
+        fprintf(stderr, "[VTCooker] Cannot write %s\n", outPath.c_str());
+        return false;
+    }
+    fwrite(&header, sizeof(header), 1, fp);
+    fwrite(table.data(), sizeof(vtex::LevelEntry), table.size(), fp);
+    fwrite(blob.data(), 1, blob.size(), fp);
+    bool ok = ferror(fp) == 0;
+    fclose(fp);
+
+    double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    printf("%s -> %s: %dx%d, %d levels, %d tiles, %.1f MiB (RGBA8 + mips %.1f MiB), %.1f s\n",
+        path.c_str(), outPath.c_str(), levels[0].width, levels[0].height, (int)levels.size(),
+        (int)tiles.size(), (header.dataOffset + blob.size()) / (1024.0 * 1024.0),
+        (double)levels[0].width * levels[0].height * 4.0 * 4.0 / 3.0 / (1024.0 * 1024.0), sec);
+    return ok;
+}
+
+int main(int argc, char** argv)
+{
+    int dxtMode = STB_DXT_HIGHQUAL;
+    std::vector<std::string> files;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--fast") == 0) dxtMode = STB_DXT_NORMAL;
+        else files.push_back(argv[i]);
+    }
+
+    if (files.size() != 2)
+    {
+        fprintf(stderr, "usage: VirtualTextureCooker [--fast] IMAGE OUT.vtex\n");
+        return 1;
+    }
+
+    return cook(files[0], files[1], dxtMode) ? 0 : 1;
+}